@@ -750,6 +750,54 @@ nextval_internal(Oid relid, bool check_permissions)
 	cycle = pgsform->seqcycle;
 	ReleaseSysCache(pgstuple);
 
+	/*
+	 * Take values from the range reserved by the local tablet server, so backends of the node
+	 * share a single reservation in the sequences data table instead of updating it on each cache
+	 * miss.
+	 */
+	if (IsYugaByteEnabled() && YBCIsTServerSequenceCacheEnabled())
+	{
+		int64_t first_val;
+		int64_t last_val;
+		int64_t num_vals;
+		HandleYBStatus(YBCReserveSequenceValues(MyDatabaseId,
+												relid,
+												yb_catalog_cache_version,
+												incby,
+												minv,
+												maxv,
+												cycle,
+												cache,
+												&first_val,
+												&last_val,
+												&num_vals));
+		if (num_vals == 0)
+		{
+			char		buf[100];
+
+			snprintf(buf, sizeof(buf), INT64_FORMAT, incby > 0 ? maxv : minv);
+			if (incby > 0)
+				ereport(ERROR,
+						(errcode(ERRCODE_SEQUENCE_GENERATOR_LIMIT_EXCEEDED),
+						 errmsg("nextval: reached maximum value of sequence \"%s\" (%s)",
+								RelationGetRelationName(seqrel), buf)));
+			else
+				ereport(ERROR,
+						(errcode(ERRCODE_SEQUENCE_GENERATOR_LIMIT_EXCEEDED),
+						 errmsg("nextval: reached minimum value of sequence \"%s\" (%s)",
+								RelationGetRelationName(seqrel), buf)));
+		}
+
+		elm->increment = incby;
+		elm->last = first_val;	/* last returned number */
+		elm->cached = last_val;	/* last fetched number */
+		elm->last_valid = true;
+
+		last_used_seq = elm;
+		relation_close(seqrel, NoLock);
+		return first_val;
+	}
+
 retry:
 	rescnt = 0;
 	if (IsYugaByteEnabled())
@@ -5983,6 +5983,16 @@ AfterTriggerSaveEvent(EState *estate, ResultRelInfo *relinfo,
 			}
 		}
 
+		/*
+		 * In YugaByte mode, queue the row referenced by the new FK row so that
+		 * references of all rows of the statement are read in one batch when
+		 * the first check fires.
+		 */
+		if (IsYBBackedRelation(rel) && row_trigger && newtup != NULL &&
+			(event == TRIGGER_EVENT_INSERT || event == TRIGGER_EVENT_UPDATE) &&
+			RI_FKey_trigger_type(trigger->tgfoid) == RI_TRIGGER_FK)
+			YBAddForeignKeyReferenceIntent(trigger, rel, newtup);
+
 		/*
 		 * In YugaByte mode we also use the tuplestore to store/pass tuples
 		 * within a query execution.
@@ -250,6 +250,9 @@ static void ri_ReportViolation(const RI_ConstraintInfo *riinfo,
 
 static void BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx,
 					const RI_ConstraintInfo *riinfo, HeapTuple tup, void **data, int64_t *bytes);
+static void YBGetReferencedTupleId(Relation pk_rel, Relation fk_rel,
+					const RI_ConstraintInfo *riinfo, HeapTuple tup,
+					Oid *ref_table_id, char **tuple_id, int64_t *tuple_id_size);
 
 
 /* ----------
@@ -403,25 +406,23 @@ RI_FKey_check(TriggerData *trigdata)
 	 */
 	if (IsYBRelation(pk_rel))
 	{
-		/*
-		 * Get the referenced index table.
-		 * For primary key index, we need to use the base table relation.
-		 */
-		Relation idx_rel = RelationIdGetRelation(riinfo->conindid);
-		if (idx_rel->rd_index != NULL)
-		{
-			ref_table_id = idx_rel->rd_index->indisprimary ?
-					idx_rel->rd_index->indrelid : riinfo->conindid;
-		}
+		bool		reference_exists = false;
 
-		BuildYBTupleId(
-			pk_rel /* Primary table */,
-			fk_rel /* Reference table */,
-			ref_table_id == pk_rel->rd_id ? pk_rel : idx_rel /* Reference index */,
-			riinfo, new_row, (void **)&tuple_id, &tuple_id_size);
-		RelationClose(idx_rel);
+		YBGetReferencedTupleId(pk_rel, fk_rel, riinfo, new_row,
+							   &ref_table_id, &tuple_id, &tuple_id_size);
 
-		if (tuple_id != NULL && YBCForeignKeyReferenceExists(ref_table_id, tuple_id, tuple_id_size))
+		/*
+		 * This also reads references queued by YBAddForeignKeyReferenceIntent
+		 * for the same table in a single batch, so the following checks of the
+		 * statement are served from the cache.
+		 */
+		if (tuple_id != NULL)
+			HandleYBStatus(YBCForeignKeyReferenceExists(YBCGetDatabaseOid(pk_rel),
+														 ref_table_id,
+														 tuple_id,
+														 tuple_id_size,
+														 &reference_exists));
+		if (reference_exists)
 		{
 			elog(DEBUG1, "Skipping FK check for table %d, ybctid %s", ref_table_id, tuple_id);
 			heap_close(pk_rel, RowShareLock);
@@ -507,6 +508,41 @@ RI_FKey_check(TriggerData *trigdata)
 }
 
 
+/*
+ * YBAddForeignKeyReferenceIntent -
+ *
+ *	Queue the row referenced by a new or updated FK row to be checked.  Called
+ *	when the check trigger event is queued, so all references of a statement
+ *	are known before the first check fires and can be read in one batch.
+ */
+void
+YBAddForeignKeyReferenceIntent(Trigger *trigger, Relation fk_rel, HeapTuple new_row)
+{
+	const RI_ConstraintInfo *riinfo;
+	Relation	pk_rel;
+	Oid			ref_table_id = InvalidOid;
+	char	   *tuple_id = NULL;
+	int64_t		tuple_id_size = 0;
+
+	riinfo = ri_FetchConstraintInfo(trigger, fk_rel, false);
+
+	/* Rows with NULL keys are not looked up, see RI_FKey_check. */
+	if (riinfo->confmatchtype == FKCONSTR_MATCH_PARTIAL ||
+		ri_NullCheck(RelationGetDescr(fk_rel), new_row, riinfo, false) != RI_KEYS_NONE_NULL)
+		return;
+
+	pk_rel = heap_open(riinfo->pk_relid, RowShareLock);
+	if (IsYBRelation(pk_rel))
+	{
+		YBGetReferencedTupleId(pk_rel, fk_rel, riinfo, new_row,
+							   &ref_table_id, &tuple_id, &tuple_id_size);
+		if (tuple_id != NULL)
+			YBCAddForeignKeyReferenceIntent(ref_table_id, tuple_id, tuple_id_size);
+	}
+	heap_close(pk_rel, RowShareLock);
+}
+
+
 /* ----------
  * RI_FKey_check_ins -
  *
@@ -2690,6 +2726,34 @@ ri_PerformCheck(const RI_ConstraintInfo *riinfo,
 	return SPI_processed != 0;
 }
 
+/*
+ * Get the id of the referenced table (or unique index) and the ybctid of the
+ * row in it that is referenced by tup.
+ */
+static void
+YBGetReferencedTupleId(Relation pk_rel, Relation fk_rel,
+					   const RI_ConstraintInfo *riinfo, HeapTuple tup,
+					   Oid *ref_table_id, char **tuple_id, int64_t *tuple_id_size)
+{
+	/*
+	 * Get the referenced index table.
+	 * For primary key index, we need to use the base table relation.
+	 */
+	Relation idx_rel = RelationIdGetRelation(riinfo->conindid);
+	if (idx_rel->rd_index != NULL)
+	{
+		*ref_table_id = idx_rel->rd_index->indisprimary ?
+				idx_rel->rd_index->indrelid : riinfo->conindid;
+	}
+
+	BuildYBTupleId(
+		pk_rel /* Primary table */,
+		fk_rel /* Reference table */,
+		*ref_table_id == pk_rel->rd_id ? pk_rel : idx_rel /* Reference index */,
+		riinfo, tup, (void **)tuple_id, tuple_id_size);
+	RelationClose(idx_rel);
+}
+
 static void
 BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx_rel,
 				const RI_ConstraintInfo *riinfo, HeapTuple tup,
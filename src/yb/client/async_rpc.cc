@@ -240,6 +240,16 @@ bool AsyncRpc::IsLocalCall() const {
   return tablet_invoker_.IsLocalCall();
 }
 
+Result<Slice> AsyncRpc::GetSidecar(int idx) const {
+  if (!exchange_response_) {
+    return retrier().controller().GetSidecar(idx);
+  }
+  if (idx < 0 || static_cast<size_t>(idx) >= exchange_response_->sidecars.size()) {
+    return STATUS_FORMAT(InvalidArgument, "Index $0 does not reference a valid sidecar", idx);
+  }
+  return exchange_response_->sidecars[idx];
+}
+
 namespace {
 
 void SetTransactionMetadata(const TransactionMetadata& metadata, tserver::WriteRequestPB* req) {
@@ -342,6 +352,61 @@ void AsyncRpcBase<Req, Resp>::SendRpcToTserver(int attempt_num) {
   AsyncRpc::SendRpcToTserver(attempt_num);
 }
 
+template <class Req, class Resp>
+bool AsyncRpcBase<Req, Resp>::CallViaSharedExchange(
+    tserver::TServerSharedExchangeMethod method, std::function<void()> send_via_rpc) {
+  exchange_response_.reset();
+  auto* exchange = tablet_invoker_.client().shared_exchange();
+  if (!exchange || !exchange->exchange()->ServerRunning() ||
+      tablet_invoker_.current_ts().permanent_uuid() != exchange->exchange()->server_id()) {
+    return false;
+  }
+
+  // Reset controller, so status of the previous attempt does not affect this one.
+  PrepareController();
+  const size_t request_size = req_.ByteSize();
+  auto status = exchange->Send(
+      static_cast<uint32_t>(method), request_size,
+      [this](uint8_t* out) { req_.SerializeWithCachedSizesToArray(out); },
+      retrier().deadline(),
+      [this, send_via_rpc = std::move(send_via_rpc)](Result<SharedExchangeResponse> response) {
+        SharedExchangeResponseReceived(std::move(response), send_via_rpc);
+      });
+  // Failure means that request was not sent.
+  return status.ok();
+}
+
+template <class Req, class Resp>
+void AsyncRpcBase<Req, Resp>::SharedExchangeResponseReceived(
+    Result<SharedExchangeResponse> response, const std::function<void()>& send_via_rpc) {
+  if (!response.ok()) {
+    Finished(response.status());
+    return;
+  }
+  Status status;
+  if (response->failed) {
+    AppStatusPB status_pb;
+    if (status_pb.ParseFromArray(response->body.data(), static_cast<int>(response->body.size()))) {
+      status = StatusFromPB(status_pb);
+    } else {
+      status = STATUS(Corruption, "Failed to parse status received via shared memory exchange");
+    }
+    if (status.IsServiceUnavailable()) {
+      // Tablet server is too busy, RPC layer will handle it with backoff.
+      send_via_rpc();
+      return;
+    }
+  }
+
+  resp_.Clear();
+  if (status.ok() &&
+      !resp_.ParseFromArray(response->body.data(), static_cast<int>(response->body.size()))) {
+    status = STATUS(Corruption, "Failed to parse response received via shared memory exchange");
+  }
+  exchange_response_ = std::move(*response);
+  Finished(status);
+}
+
 WriteRpc::WriteRpc(AsyncRpcData* data)
     : AsyncRpcBase(data, YBConsistencyLevel::STRONG) {
   TRACE_TO(trace_, "WriteRpc initiated to $0", data->tablet->tablet_id());
@@ -431,9 +496,17 @@ void WriteRpc::CallRemoteMethod() {
   TRACE_TO(trace, "SendRpcToTserver");
   ADOPT_TRACE(trace.get());
 
-  tablet_invoker_.proxy()->WriteAsync(
-      req_, &resp_, PrepareController(),
-      std::bind(&WriteRpc::Finished, this, Status::OK()));
+  auto send_via_rpc = [this] {
+    tablet_invoker_.proxy()->WriteAsync(
+        req_, &resp_, PrepareController(),
+        std::bind(&WriteRpc::Finished, this, Status::OK()));
+  };
+  if (CallViaSharedExchange(tserver::TServerSharedExchangeMethod::kWrite, send_via_rpc)) {
+    TRACE_TO(trace, "Sent via shared memory exchange");
+    return;
+  }
+
+  send_via_rpc();
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
 
@@ -505,7 +578,7 @@ void WriteRpc::SwapRequestsAndResponses(bool skip_responses = false) {
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
           Slice rows_data = CHECK_RESULT(
-              retrier().controller().GetSidecar(ql_response.rows_data_sidecar()));
+              GetSidecar(ql_response.rows_data_sidecar()));
           ql_op->mutable_rows_data()->assign(rows_data.cdata(), rows_data.size());
         }
         ql_idx++;
@@ -521,7 +594,7 @@ void WriteRpc::SwapRequestsAndResponses(bool skip_responses = false) {
         pgsql_op->mutable_response()->Swap(resp_.mutable_pgsql_response_batch(pgsql_idx));
         const auto& pgsql_response = pgsql_op->response();
         if (pgsql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
+          Slice rows_data = CHECK_RESULT(GetSidecar(
               pgsql_response.rows_data_sidecar()));
           down_cast<YBPgsqlWriteOp*>(yb_op)->mutable_rows_data()->assign(
               util::to_char_ptr(rows_data.data()), rows_data.size());
@@ -644,9 +717,17 @@ void ReadRpc::CallRemoteMethod() {
   TRACE_TO(trace, "SendRpcToTserver");
   ADOPT_TRACE(trace.get());
 
-  tablet_invoker_.proxy()->ReadAsync(
-      req_, &resp_, PrepareController(),
-      std::bind(&ReadRpc::Finished, this, Status::OK()));
+  auto send_via_rpc = [this] {
+    tablet_invoker_.proxy()->ReadAsync(
+        req_, &resp_, PrepareController(),
+        std::bind(&ReadRpc::Finished, this, Status::OK()));
+  };
+  if (CallViaSharedExchange(tserver::TServerSharedExchangeMethod::kRead, send_via_rpc)) {
+    TRACE_TO(trace, "Sent via shared memory exchange");
+    return;
+  }
+
+  send_via_rpc();
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
 
@@ -715,7 +796,7 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         ql_op->mutable_response()->Swap(resp_.mutable_ql_batch(ql_idx));
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
+          Slice rows_data = CHECK_RESULT(GetSidecar(
               ql_response.rows_data_sidecar()));
           ql_op->mutable_rows_data()->assign(util::to_char_ptr(rows_data.data()), rows_data.size());
         }
@@ -732,7 +813,7 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         pgsql_op->mutable_response()->Swap(resp_.mutable_pgsql_batch(pgsql_idx));
         const auto& pgsql_response = pgsql_op->response();
         if (pgsql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
+          Slice rows_data = CHECK_RESULT(GetSidecar(
               pgsql_response.rows_data_sidecar()));
           down_cast<YBPgsqlReadOp*>(yb_op)->mutable_rows_data()->assign(
               util::to_char_ptr(rows_data.data()), rows_data.size());
@@ -14,6 +14,8 @@
 #ifndef YB_CLIENT_ASYNC_RPC_H_
 #define YB_CLIENT_ASYNC_RPC_H_
 
+#include <boost/optional.hpp>
+
 #include "yb/client/tablet_rpc.h"
 
 #include "yb/common/read_hybrid_time.h"
@@ -21,6 +23,9 @@
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tserver/tserver_service.proxy.h"
+#include "yb/tserver/tserver_shared_mem.h"
+
+#include "yb/util/shared_mem_exchange.h"
 
 namespace yb {
 namespace client {
@@ -103,6 +108,10 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   // Is this a local call?
   bool IsLocalCall() const;
 
+  // Returns sidecar of the response, that was received either via RPC or via shared memory
+  // exchange.
+  Result<Slice> GetSidecar(int idx) const;
+
   // Pointer back to the batcher. Processes the write response when it
   // completes, regardless of success or failure.
   scoped_refptr<Batcher> batcher_;
@@ -119,6 +128,9 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   MonoTime start_;
   std::shared_ptr<AsyncRpcMetrics> async_rpc_metrics_;
   rpc::RpcCommandPtr retained_self_;
+
+  // Response of the last attempt, if it was sent via shared memory exchange.
+  boost::optional<SharedExchangeResponse> exchange_response_;
 };
 
 template <class Req, class Resp>
@@ -134,6 +146,16 @@ class AsyncRpcBase : public AsyncRpc {
   bool CommonResponseCheck(const Status& status);
   void SendRpcToTserver(int attempt_num) override;
 
+  // Sends request via shared memory exchange, when the tablet server that should receive it runs
+  // on the same host. Returns false if request was not sent and should be sent via RPC.
+  // Response is processed on the thread of the exchange client. send_via_rpc is invoked from
+  // there when the tablet server is too busy to handle request received via exchange.
+  bool CallViaSharedExchange(
+      tserver::TServerSharedExchangeMethod method, std::function<void()> send_via_rpc);
+
+  void SharedExchangeResponseReceived(
+      Result<SharedExchangeResponse> response, const std::function<void()>& send_via_rpc);
+
  protected: // TODO replace with private
   const tserver::TabletServerErrorPB* response_error() const override {
     return resp_.has_error() ? &resp_.error() : nullptr;
@@ -314,6 +314,9 @@ class YBClient::Data {
   scoped_refptr<internal::MetaCache> meta_cache_;
   scoped_refptr<MetricEntity> metric_entity_;
 
+  // Shared memory exchange of the local tablet server, if any.
+  std::atomic<SharedExchangeClient*> shared_exchange_{nullptr};
+
   // Set of hostnames and IPs on the local host.
   // This is initialized at client startup.
   std::unordered_set<std::string> local_host_names_;
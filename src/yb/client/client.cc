@@ -1076,6 +1076,14 @@ void YBClient::SetLocalTabletServer(const string& ts_uuid,
   data_->meta_cache_->SetLocalTabletServer(ts_uuid, proxy, local_tserver);
 }
 
+void YBClient::SetSharedExchange(SharedExchangeClient* exchange) {
+  data_->shared_exchange_.store(exchange, std::memory_order_release);
+}
+
+SharedExchangeClient* YBClient::shared_exchange() const {
+  return data_->shared_exchange_.load(std::memory_order_acquire);
+}
+
 Result<bool> YBClient::IsLoadBalanced(uint32_t num_servers) {
   IsLoadBalancedRequestPB req;
   IsLoadBalancedResponsePB resp;
@@ -1365,6 +1373,13 @@ Status YBClient::OpenTable(const TableId& table_id, shared_ptr<YBTable>* table)
   return Status::OK();
 }
 
+YBTablePtr YBClient::OpenTable(const YBTableInfo& info, std::vector<std::string> partitions) {
+  std::shared_ptr<YBTable> result(new YBTable(this, info));
+  result->table_type_ = info.table_type;
+  result->partitions_ = std::move(partitions);
+  return result;
+}
+
 shared_ptr<YBSession> YBClient::NewSession() {
   return std::make_shared<YBSession>(this);
 }
@@ -86,6 +86,7 @@ namespace yb {
 
 class CloudInfoPB;
 class MetricEntity;
+class SharedExchangeClient;
 
 namespace master {
 class ReplicationInfoPB;
@@ -476,6 +477,12 @@ class YBClient {
                             const std::shared_ptr<tserver::TabletServerServiceProxy>& proxy,
                             const tserver::LocalTabletServer* local_tserver);
 
+  // Sets shared memory exchange of the tablet server running on the same host. Read and write
+  // requests to tablets led by this tablet server are sent via exchange instead of RPC.
+  void SetSharedExchange(SharedExchangeClient* exchange);
+
+  SharedExchangeClient* shared_exchange() const;
+
   // List only those tables whose names pass a substring match on 'filter'.
   //
   // 'tables' is appended to only on success.
@@ -529,6 +536,10 @@ class YBClient {
     return result;
   }
 
+  // Open the table using already known schema and partitions, i.e. received from table cache of
+  // local tablet server. No RPCs are performed.
+  YBTablePtr OpenTable(const YBTableInfo& info, std::vector<std::string> partitions);
+
   // Create a new session for interacting with the cluster.
   // User is responsible for destroying the session object.
   // This is a fully local operation (no RPCs or blocking).
@@ -62,6 +62,7 @@ DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(delay_init_tablet_peer_ms);
 DECLARE_bool(fail_in_apply_if_no_metadata);
 DECLARE_bool(delete_intents_sst_files);
+DECLARE_uint64(apply_intents_ingest_threshold_bytes);
 
 namespace yb {
 namespace client {
@@ -1663,6 +1664,50 @@ TEST_F_EX(QLTransactionTest, DeleteFlushedIntents, QLTransactionTestSingleTablet
   }, 15s, "Intents and files are removed"));
 }
 
+// Transaction applied to the empty regular DB is ingested as an SST file with the same boundary
+// values as a flushed one. While the regular DB holds a snapshot, intents are applied through the
+// memtable instead.
+TEST_F_EX(QLTransactionTest, IngestAppliedIntents, QLTransactionTestSingleTablet) {
+  FLAGS_apply_intents_ingest_threshold_bytes = 1;
+
+  auto wait_applied = [this] {
+    return WaitFor(
+        [this] { return CountIntents(cluster_.get()) == 0; }, kIntentsCleanupTime,
+        "Intents applied");
+  };
+
+  auto check_regular_files = [this](size_t expected_files) {
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      SCOPED_TRACE(Format("Peer: $0", peer->permanent_uuid()));
+      std::vector<rocksdb::LiveFileMetaData> files;
+      peer->tablet()->TEST_db()->GetLiveFilesMetaData(&files);
+      ASSERT_EQ(expected_files, files.size()) << AsString(files);
+      for (const auto& file : files) {
+        ASSERT_TRUE(file.largest.user_frontier != nullptr) << AsString(file);
+        ASSERT_FALSE(file.largest.user_values.empty()) << AsString(file);
+      }
+    }
+  };
+
+  WriteData();
+  ASSERT_OK(wait_applied());
+  ASSERT_NO_FATALS(check_regular_files(1));
+  VerifyData();
+
+  std::vector<std::pair<rocksdb::DB*, const rocksdb::Snapshot*>> snapshots;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    auto* db = peer->tablet()->TEST_db();
+    snapshots.emplace_back(db, db->GetSnapshot());
+  }
+  WriteData(WriteOpType::INSERT, 1);
+  ASSERT_OK(wait_applied());
+  for (const auto& db_and_snapshot : snapshots) {
+    db_and_snapshot.first->ReleaseSnapshot(db_and_snapshot.second);
+  }
+  ASSERT_NO_FATALS(check_regular_files(1));
+  VerifyData(2);
+}
+
 // Test performs transactional writes to get flushed intents.
 // Then performs non transactional writes and checks that log size stabilizes, meaning
 // log gc is working.
@@ -14,7 +14,10 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
 
+#include "yb/common/json_util.h"
 #include "yb/common/jsonb.h"
+#include "yb/common/ql_value.h"
+
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
@@ -151,5 +154,92 @@ TEST(JsonbTest, TestArrays) {
   VerifyArray(document);
 }
 
+TEST(JsonbTest, TestToJsonString) {
+  for (const std::string json : {
+      R"#({ "b" : 1, "a" : { "d" : true, "q" : { "p" : 4294967295, "r" : -2147483648 },
+            "f" : -1.5, "g" : 3.25e100, "n" : null, "s" : "x\"y" },
+            "a1" : [1, 2, 3.0, false, true, { "k1" : 1, "k2" : [100, 200, 300], "k3" : true}],
+            "e" : {}, "l" : [], "u" : 18446744073709551615, "i" : -9223372036854775808 })#",
+      R"#([1, "a", [], {}])#",
+      R"#("scalar")#",
+      R"#(1.5)#"}) {
+    Jsonb jsonb;
+    ASSERT_OK(jsonb.FromString(json));
+    rapidjson::Document document;
+    ASSERT_OK(jsonb.ToRapidJson(&document));
+    std::string result;
+    ASSERT_OK(jsonb.ToJsonString(&result));
+    ASSERT_EQ(WriteRapidJsonToString(document), result);
+  }
+}
+
+class JsonbLargeObjectTest : public YBTest {
+ protected:
+  static constexpr int kNumKeys = 1000;
+
+  void SetUp() override {
+    YBTest::SetUp();
+    std::string json = "{";
+    for (int i = 0; i != kNumKeys; ++i) {
+      json += Format("$0\"key$1\" : { \"nested\" : $1, \"other\" : [1, 2, 3] }",
+                     i ? ", " : "", i);
+    }
+    json += "}";
+    ASSERT_OK(jsonb_.FromString(json));
+
+    // j->'keyN'->>'nested'
+    auto* op = json_ops_.add_json_operations();
+    op->set_json_operator(JsonOperatorPB::JSON_OBJECT);
+    field_ = op->mutable_operand()->mutable_value();
+    op = json_ops_.add_json_operations();
+    op->set_json_operator(JsonOperatorPB::JSON_TEXT);
+    op->mutable_operand()->mutable_value()->set_string_value("nested");
+  }
+
+  void ApplyForKey(int key) {
+    field_->set_string_value(Format("key$0", key));
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb_.SerializedJsonb(), json_ops_, &result_));
+    ASSERT_EQ(std::to_string(key), result_.value().string_value());
+  }
+
+  Jsonb jsonb_;
+  QLJsonColumnOperationsPB json_ops_;
+  QLValuePB* field_ = nullptr;
+  QLValue result_;
+};
+
+TEST_F(JsonbLargeObjectTest, TestApplyJsonbOperators) {
+  for (int key = 0; key != kNumKeys; ++key) {
+    ASSERT_NO_FATALS(ApplyForKey(key));
+  }
+}
+
+// Measures time of evaluating j->'field'->>'nested' on an object with many keys.
+TEST_F(JsonbLargeObjectTest, TestApplyJsonbOperatorsPerf) {
+  if (!AllowSlowTests()) {
+    LOG(INFO) << "Skipping benchmark";
+    return;
+  }
+
+  constexpr int kNumIterations = 1000000;
+  auto start = MonoTime::Now();
+  for (int i = 0; i != kNumIterations; ++i) {
+    ASSERT_NO_FATALS(ApplyForKey(i % kNumKeys));
+  }
+  auto passed = MonoTime::Now() - start;
+  LOG(INFO) << "Applied json operators " << kNumIterations << " times in " << passed << ", "
+            << passed.ToNanoseconds() / kNumIterations << "ns per row";
+
+  std::string text;
+  start = MonoTime::Now();
+  constexpr int kNumToString = 1000;
+  for (int i = 0; i != kNumToString; ++i) {
+    ASSERT_OK(jsonb_.ToJsonString(&text));
+  }
+  passed = MonoTime::Now() - start;
+  LOG(INFO) << "Converted jsonb of " << jsonb_.SerializedJsonb().size() << " bytes to string "
+            << kNumToString << " times in " << passed;
+}
+
 }  // namespace common
 }  // namespace yb
@@ -646,12 +646,103 @@ Status Jsonb::ToJsonString(std::string* json) const {
 }
 
 Status Jsonb::ToJsonStringInternal(const Slice& jsonb, std::string* json) {
-  rapidjson::Document document;
-  RETURN_NOT_OK(FromJsonbInternal(jsonb, &document));
-  *DCHECK_NOTNULL(json) = WriteRapidJsonToString(document);
+  rapidjson::StringBuffer buffer;
+  JsonWriter writer(buffer);
+  RETURN_NOT_OK(WriteJsonb(jsonb, &writer));
+  DCHECK_NOTNULL(json)->assign(buffer.GetString(), buffer.GetSize());
+  return Status::OK();
+}
+
+Status Jsonb::WriteJsonb(const Slice& jsonb, JsonWriter* writer) {
+  if (jsonb.size() < sizeof(JsonbHeader)) {
+    return STATUS(InvalidArgument, "Not enough data to process");
+  }
+  JsonbHeader jsonb_header = BigEndian::Load32(jsonb.data());
+  const size_t metadata_begin_offset = sizeof(JsonbHeader);
+  const size_t nelems = GetCount(jsonb_header);
+
+  if ((jsonb_header & kJBObject) == kJBObject) {
+    const size_t data_begin_offset = ComputeDataOffset(nelems, kJBObject);
+    writer->StartObject();
+    for (size_t i = 0; i < nelems; i++) {
+      Slice key;
+      RETURN_NOT_OK(GetObjectKey(i, jsonb, metadata_begin_offset, data_begin_offset, &key));
+      Slice json_value;
+      JEntry value_metadata;
+      RETURN_NOT_OK(GetObjectValue(i, jsonb, metadata_begin_offset, data_begin_offset, nelems,
+                                   &json_value, &value_metadata));
+      writer->Key(key.cdata(), key.size(), /* copy */ true);
+      RETURN_NOT_OK(WriteJsonbValue(value_metadata, json_value, writer));
+    }
+    writer->EndObject();
+    return Status::OK();
+  }
+
+  if ((jsonb_header & kJBArray) != kJBArray) {
+    return STATUS(InvalidArgument, "Invalid json type!");
+  }
+
+  // Scalars are stored as an array with one element, so only this element is written for them.
+  const bool is_scalar = (jsonb_header & kJBScalar) && nelems == 1;
+  const size_t data_begin_offset = ComputeDataOffset(nelems, kJBArray);
+  if (!is_scalar) {
+    writer->StartArray();
+  }
+  for (size_t i = 0; i < nelems; i++) {
+    Slice result;
+    JEntry element_metadata;
+    RETURN_NOT_OK(GetArrayElement(i, jsonb, metadata_begin_offset, data_begin_offset, &result,
+                                  &element_metadata));
+    RETURN_NOT_OK(WriteJsonbValue(element_metadata, result, writer));
+  }
+  if (!is_scalar) {
+    writer->EndArray();
+  }
   return Status::OK();
 }
 
+Status Jsonb::WriteJsonbValue(JEntry element_metadata, const Slice& json_value,
+                              JsonWriter* writer) {
+  // Numbers are written the same way as rapidjson writes values of a json document, so the result
+  // is the same as for the document built by FromJsonbInternal.
+  switch (GetJEType(element_metadata)) {
+    case kJEIsString:
+      writer->String(json_value.cdata(), json_value.size(), /* copy */ true);
+      return Status::OK();
+    case kJEIsInt:
+      writer->Int(util::DecodeInt32FromKey(json_value));
+      return Status::OK();
+    case kJEIsUInt:
+      writer->Uint(BigEndian::Load32(json_value.data()));
+      return Status::OK();
+    case kJEIsInt64:
+      writer->Int64(util::DecodeInt64FromKey(json_value));
+      return Status::OK();
+    case kJEIsUInt64:
+      writer->Uint64(BigEndian::Load64(json_value.data()));
+      return Status::OK();
+    case kJEIsDouble:
+      writer->Double(util::DecodeDoubleFromKey(json_value));
+      return Status::OK();
+    case kJEIsFloat:
+      writer->Double(util::DecodeFloatFromKey(json_value));
+      return Status::OK();
+    case kJEIsBoolFalse:
+      writer->Bool(false);
+      return Status::OK();
+    case kJEIsBoolTrue:
+      writer->Bool(true);
+      return Status::OK();
+    case kJEIsNull:
+      writer->Null();
+      return Status::OK();
+    case kJEIsObject: FALLTHROUGH_INTENDED;
+    case kJEIsArray:
+      return WriteJsonb(json_value, writer);
+  }
+  return STATUS_FORMAT(Corruption, "Unknown jsonb entry type: $0", GetJEType(element_metadata));
+}
+
 Status Jsonb::ApplyJsonbOperatorToArray(const Slice& jsonb, const QLJsonOperationPB& json_op,
                                         const JsonbHeader& jsonb_header,
                                         Slice* result, JEntry* element_metadata) {
@@ -691,7 +782,8 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
   size_t metadata_begin_offset = sizeof(jsonb_header);
   size_t data_begin_offset = ComputeDataOffset(num_kv_pairs, kJBObject);
 
-  // Binary search to find the key.
+  // Binary search to find the key. Keys are compared in place, since they are serialized in the
+  // same byte order as std::string comparison, that was used to sort them.
   int64_t low = 0, high = num_kv_pairs - 1;
   auto search_key_slice = Slice(search_key);
   while (low <= high) {
@@ -699,12 +791,12 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
     Slice mid_key;
     RETURN_NOT_OK(GetObjectKey(mid, jsonb, metadata_begin_offset, data_begin_offset, &mid_key));
 
-    if (mid_key == search_key_slice) {
-      RETURN_NOT_OK(GetObjectValue(mid, jsonb, sizeof(jsonb_header),
-                                   ComputeDataOffset(num_kv_pairs, kJBObject), num_kv_pairs,
-                                   result, element_metadata));
+    const int cmp = mid_key.compare(search_key_slice);
+    if (cmp == 0) {
+      RETURN_NOT_OK(GetObjectValue(mid, jsonb, metadata_begin_offset, data_begin_offset,
+                                   num_kv_pairs, result, element_metadata));
       return Status::OK();
-    } else if (mid_key.ToBuffer() > search_key) {
+    } else if (cmp > 0) {
       high = mid - 1;
     } else {
       low = mid + 1;
@@ -714,10 +806,15 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
 }
 
 Status Jsonb::ApplyJsonbOperators(const QLJsonColumnOperationsPB& json_ops, QLValue* result) const {
+  return ApplyJsonbOperators(serialized_jsonb_, json_ops, result);
+}
+
+Status Jsonb::ApplyJsonbOperators(const Slice& jsonb, const QLJsonColumnOperationsPB& json_ops,
+                                  QLValue* result) {
   const int num_ops = json_ops.json_operations().size();
 
   Slice jsonop_result;
-  Slice operand(serialized_jsonb_);
+  Slice operand(jsonb);
   JEntry element_metadata;
   for (int i = 0; i < num_ops; i++) {
     const QLJsonOperationPB &op = json_ops.json_operations().Get(i);
@@ -15,6 +15,8 @@
 #define YB_COMMON_JSONB_H
 
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include "yb/common/common_fwd.h"
 
@@ -86,6 +88,11 @@ class Jsonb {
   CHECKED_STATUS ApplyJsonbOperators(const QLJsonColumnOperationsPB& json_ops,
                                      QLValue* result) const;
 
+  // Applies json operators to serialized jsonb in place, e.g. to a value stored in a table row.
+  static CHECKED_STATUS ApplyJsonbOperators(const Slice& jsonb,
+                                            const QLJsonColumnOperationsPB& json_ops,
+                                            QLValue* result);
+
   const std::string& SerializedJsonb() const;
 
   // Use with extreme care since this destroys the internal state of the object. The only purpose
@@ -114,6 +121,13 @@ class Jsonb {
                                        std::string* result);
 
   static CHECKED_STATUS ToJsonStringInternal(const Slice& jsonb, std::string* json);
+
+  typedef rapidjson::Writer<rapidjson::StringBuffer> JsonWriter;
+
+  // Writes json for serialized jsonb directly to the writer, without building a json document.
+  static CHECKED_STATUS WriteJsonb(const Slice& jsonb, JsonWriter* writer);
+  static CHECKED_STATUS WriteJsonbValue(JEntry element_metadata, const Slice& json_value,
+                                        JsonWriter* writer);
   static size_t ComputeDataOffset(const size_t num_entries, const uint32_t container_type);
   static CHECKED_STATUS ToJsonbInternal(const rapidjson::Value& document, std::string* jsonb);
   static CHECKED_STATUS ToJsonbProcessObject(const rapidjson::Value& document,
@@ -37,9 +37,9 @@ CHECKED_STATUS QLExprExecutor::EvalExpr(const QLExpressionPB& ql_expr,
       QLExprResult temp;
       const QLJsonColumnOperationsPB& json_ops = ql_expr.json_column();
       RETURN_NOT_OK(table_row.ReadColumn(json_ops.column_id(), temp.Writer()));
-      common::Jsonb jsonb;
-      temp.MoveToJsonb(&jsonb);
-      RETURN_NOT_OK(jsonb.ApplyJsonbOperators(json_ops, &result_writer.NewValue()));
+      // Navigate serialized jsonb of the row in place, instead of copying it for each row.
+      RETURN_NOT_OK(common::Jsonb::ApplyJsonbOperators(
+          temp.Value().jsonb_value(), json_ops, &result_writer.NewValue()));
       break;
     }
 
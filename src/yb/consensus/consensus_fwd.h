@@ -14,6 +14,8 @@
 #ifndef YB_CONSENSUS_CONSENSUS_FWD_H
 #define YB_CONSENSUS_CONSENSUS_FWD_H
 
+#include <memory>
+
 #include "yb/gutil/ref_counted.h"
 #include "yb/util/enums.h"
 
@@ -47,6 +49,11 @@ typedef std::vector<ConsensusRoundPtr> ConsensusRounds;
 class ConsensusServiceProxy;
 typedef std::unique_ptr<ConsensusServiceProxy> ConsensusServiceProxyPtr;
 
+class MultiRaftHeartbeatBatcher;
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+class MultiRaftManager;
+
 class LeaderElection;
 typedef scoped_refptr<LeaderElection> LeaderElectionPtr;
 
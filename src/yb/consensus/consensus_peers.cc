@@ -48,6 +48,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/map-util.h"
@@ -85,6 +86,12 @@ TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
 DECLARE_int32(raft_heartbeat_interval_ms);
 
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, true,
+            "Coalesce heartbeats of different tablets to the same server into a single "
+            "MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
                  "UpdateConsensus RPC.");
@@ -499,8 +506,10 @@ Peer::~Peer() {
   CHECK_EQ(state_, kPeerClosed) << "Peer cannot be implicitly closed";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr multi_raft_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      multi_raft_batcher_(std::move(multi_raft_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -508,6 +517,12 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
                                ConsensusResponsePB* response,
                                rpc::RpcController* controller,
                                const rpc::ResponseCallback& callback) {
+  // Only requests without operations are coalesced, so replication latency is not affected.
+  if (multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher &&
+      trigger_mode == RequestTriggerMode::kAlwaysSend && request->ops_size() == 0) {
+    multi_raft_batcher_->AddRequestToBatch(request, response, controller, callback);
+    return;
+  }
   controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
@@ -544,13 +559,16 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  auto batcher = multi_raft_manager_ ? multi_raft_manager_->AddOrGetBatcher(hostport) : nullptr;
+  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy), std::move(batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
@@ -313,7 +313,8 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr multi_raft_batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -346,12 +347,15 @@ class RpcPeerProxy : public PeerProxy {
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  // multi_raft_manager is used to coalesce heartbeats to the same server, could be nullptr.
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -363,6 +367,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
@@ -0,0 +1,189 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_header.pb.h"
+
+#include "yb/tserver/tserver.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+using namespace std::literals;
+
+DEFINE_int32(multi_raft_heartbeat_window_ms, 5,
+             "Heartbeats of different tablets to the same server are collected for this long "
+             "before being sent in a single MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(multi_raft_heartbeat_window_ms, advanced);
+
+DEFINE_int32(multi_raft_batch_size, 512,
+             "Max number of heartbeats sent in a single MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger)
+    : hostport_(hostport),
+      messenger_(messenger),
+      proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)) {}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() = default;
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(
+    const ConsensusRequestPB* request, ConsensusResponsePB* response,
+    rpc::RpcController* controller, rpc::ResponseCallback callback) {
+  if (!batching_supported_.load(std::memory_order_acquire)) {
+    controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+    proxy_->UpdateConsensusAsync(*request, response, controller, callback);
+    return;
+  }
+
+  MultiRaftConsensusDataPtr data_to_send;
+  bool schedule_flush = false;
+  MultiRaftConsensusDataPtr batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<MultiRaftConsensusData>();
+      schedule_flush = true;
+    }
+    batch = current_batch_;
+    *batch->batch_req.add_consensus_request() = *request;
+    batch->response_callback_data.push_back({request, response, controller, std::move(callback)});
+    if (batch->response_callback_data.size() >=
+            static_cast<size_t>(std::max(FLAGS_multi_raft_batch_size, 1))) {
+      data_to_send.swap(current_batch_);
+    }
+  }
+
+  if (data_to_send) {
+    SendBatch(data_to_send);
+    return;
+  }
+
+  if (schedule_flush) {
+    std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+    messenger_->scheduler().Schedule(
+        [weak_self, batch](const Status& status) {
+          auto self = weak_self.lock();
+          if (self) {
+            self->FlushBatch(batch);
+          }
+        },
+        std::max(FLAGS_multi_raft_heartbeat_window_ms, 0) * 1ms);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FlushBatch(const MultiRaftConsensusDataPtr& data) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_batch_ != data) {
+      // Already sent because it became full.
+      return;
+    }
+    current_batch_.reset();
+  }
+  SendBatch(data);
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(const MultiRaftConsensusDataPtr& data) {
+  data->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  proxy_->MultiRaftUpdateConsensusAsync(
+      data->batch_req, &data->batch_resp, &data->controller,
+      [self = shared_from_this(), data] {
+        self->ProcessBatchResponse(data);
+      });
+}
+
+void MultiRaftHeartbeatBatcher::ProcessBatchResponse(const MultiRaftConsensusDataPtr& data) {
+  auto status = data->controller.status();
+  if (!status.ok()) {
+    const auto* error_response = data->controller.error_response();
+    if (error_response &&
+        (error_response->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD ||
+         error_response->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_SERVICE)) {
+      LOG(INFO) << "Server " << hostport_ << " does not support MultiRaftUpdateConsensus, "
+                << "sending heartbeats one by one";
+      batching_supported_.store(false, std::memory_order_release);
+      SendIndividually(data);
+      return;
+    }
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << "MultiRaftUpdateConsensus to " << hostport_ << " failed: " << status;
+    // Each heartbeat fails with status of the batch, and is retried by its peer in the next
+    // heartbeat period. Resending all of them one by one would only add load to the server that
+    // already failed to handle them in time.
+    for (auto& callback_data : data->response_callback_data) {
+      callback_data.controller->ShareCall(data->controller);
+      callback_data.callback();
+    }
+    return;
+  }
+
+  const auto num_responses = static_cast<size_t>(data->batch_resp.consensus_response_size());
+  LOG_IF(DFATAL, num_responses != data->response_callback_data.size())
+      << "Wrong number of responses from " << hostport_ << ": " << num_responses
+      << ", expected: " << data->response_callback_data.size();
+  for (size_t i = 0; i != data->response_callback_data.size(); ++i) {
+    auto& callback_data = data->response_callback_data[i];
+    if (i < num_responses) {
+      callback_data.response->Swap(data->batch_resp.mutable_consensus_response(i));
+    } else {
+      auto* error = callback_data.response->mutable_error();
+      error->set_code(tserver::TabletServerErrorPB::UNKNOWN_ERROR);
+      StatusToPB(STATUS(IllegalState, "No response in MultiRaftUpdateConsensus batch"),
+                 error->mutable_status());
+    }
+    callback_data.controller->ShareCall(data->controller);
+    callback_data.callback();
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendIndividually(const MultiRaftConsensusDataPtr& data) {
+  for (auto& callback_data : data->response_callback_data) {
+    callback_data.controller->set_timeout(
+        MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+    proxy_->UpdateConsensusAsync(
+        *callback_data.request, callback_data.response, callback_data.controller,
+        callback_data.callback);
+  }
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& batcher = batchers_[hostport];
+  if (!batcher) {
+    batcher = std::make_shared<MultiRaftHeartbeatBatcher>(hostport, proxy_cache_, messenger_);
+  }
+  return batcher;
+}
+
+} // namespace consensus
+} // namespace yb
@@ -0,0 +1,106 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/consensus.pb.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_util.h"
+
+namespace yb {
+namespace consensus {
+
+// Coalesces heartbeats of tablets, whose leaders are on this server, going to the same server into
+// a single MultiRaftUpdateConsensus RPC. Heartbeats are collected for a short window, so idle
+// tablets produce one RPC per destination server instead of one RPC per tablet.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(
+      const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger);
+
+  ~MultiRaftHeartbeatBatcher();
+
+  // Adds heartbeat request to the current batch. Request, response and controller should remain
+  // valid until callback is invoked. Callback is invoked in the same way as after
+  // UpdateConsensusAsync.
+  void AddRequestToBatch(
+      const ConsensusRequestPB* request, ConsensusResponsePB* response,
+      rpc::RpcController* controller, rpc::ResponseCallback callback);
+
+ private:
+  struct ResponseCallbackData {
+    const ConsensusRequestPB* request;
+    ConsensusResponsePB* response;
+    rpc::RpcController* controller;
+    rpc::ResponseCallback callback;
+  };
+
+  struct MultiRaftConsensusData {
+    MultiRaftConsensusRequestPB batch_req;
+    MultiRaftConsensusResponsePB batch_resp;
+    rpc::RpcController controller;
+    std::vector<ResponseCallbackData> response_callback_data;
+  };
+
+  using MultiRaftConsensusDataPtr = std::shared_ptr<MultiRaftConsensusData>;
+
+  // Sends batch, if it is still the current one.
+  void FlushBatch(const MultiRaftConsensusDataPtr& data);
+
+  void SendBatch(const MultiRaftConsensusDataPtr& data);
+
+  void ProcessBatchResponse(const MultiRaftConsensusDataPtr& data);
+
+  // Sends requests of the batch using UpdateConsensus RPC, one per tablet. Used when destination
+  // server does not support MultiRaftUpdateConsensus.
+  void SendIndividually(const MultiRaftConsensusDataPtr& data);
+
+  const HostPort hostport_;
+  rpc::Messenger* const messenger_;
+  ConsensusServiceProxyPtr proxy_;
+
+  // Cleared when destination server does not know about MultiRaftUpdateConsensus, i.e. runs
+  // older version.
+  std::atomic<bool> batching_supported_{true};
+
+  std::mutex mutex_;
+  MultiRaftConsensusDataPtr current_batch_;
+};
+
+// Keeps heartbeat batchers for all destination servers. Shared by all tablets of the server.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+ private:
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  std::unordered_map<HostPort, MultiRaftHeartbeatBatcherPtr, HostPortHash> batchers_;
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
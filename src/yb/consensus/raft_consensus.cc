@@ -226,9 +226,10 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     TableType table_type,
     ThreadPool* raft_pool,
     RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id) {
+    const yb::OpId& split_op_id,
+    MultiRaftManager* multi_raft_manager) {
   auto rpc_factory = std::make_unique<RpcPeerProxyFactory>(
-      messenger, proxy_cache, local_peer_pb.cloud_info());
+      messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager);
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
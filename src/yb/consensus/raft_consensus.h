@@ -112,7 +112,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     TableType table_type,
     ThreadPool* raft_pool,
     RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id);
+    const yb::OpId& split_op_id,
+    MultiRaftManager* multi_raft_manager = nullptr);
 
   // Creates RaftConsensus.
   // split_op_id is the ID of split tablet Raft operation requesting split of this tablet or unset.
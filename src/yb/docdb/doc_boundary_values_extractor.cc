@@ -13,26 +13,48 @@
 //
 //
 
+#include <limits>
+
+#include "yb/gutil/endian.h"
+
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_ttl_util.h"
+#include "yb/docdb/value.h"
+
+DEFINE_bool(docdb_track_value_column_bounds, false,
+            "Record min/max values of top level non-key columns in SST file boundaries, and use "
+            "them to skip files during QL scans with conditions on those columns. Should only be "
+            "enabled when rows are never updated or deleted after being inserted, e.g. for "
+            "time-series data, since a skipped file could contain a newer version of a row.");
 
 namespace yb {
 namespace docdb {
 
 Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
 
+Status GetTtlExpiration(const rocksdb::UserBoundaryValues& values, MicrosTime* out);
+
 Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
                          size_t index,
                          PrimitiveValue* out);
 
+Status GetValueColumnPrimitiveValue(const rocksdb::UserBoundaryValues& values,
+                                    ColumnId column_id,
+                                    PrimitiveValue* out);
+
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+// Expiration time of records with explicit TTL.
+constexpr rocksdb::UserBoundaryTag kTtlExpirationTag = 2;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
+// Tags for non-key column values, tag is kValueColumnsStart + column id.
+constexpr rocksdb::UserBoundaryTag kValueColumnsStart = 1U << 16;
 
 // Wrapper for UserBoundaryValue that stores DocHybridTime.
 class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
@@ -80,17 +102,75 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
-// Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
+// Wrapper for UserBoundaryValue that stores expiration time of record with explicit TTL, i.e. its
+// physical hybrid time plus TTL in microseconds. Records without explicit TTL have zero expiration,
+// records that never expire have max one. Stored in big endian, so encoded values are ordered.
+class TtlExpirationValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit TtlExpirationValue(MicrosTime expiration) {
+    BigEndian::Store64(buffer_, expiration);
+  }
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != sizeof(MicrosTime)) {
+      return STATUS_FORMAT(Corruption, "Wrong size of encoded TTL expiration: $0", data.size());
+    }
+
+    *value = std::make_shared<TtlExpirationValue>(BigEndian::Load64(data.data()));
+    return Status::OK();
+  }
+
+  // Value shared by all records without explicit TTL, so they don't allocate anything.
+  static const rocksdb::UserBoundaryValuePtr& NoExpiration() {
+    static const rocksdb::UserBoundaryValuePtr kNoExpiration =
+        std::make_shared<TtlExpirationValue>(0);
+    return kNoExpiration;
+  }
+
+  virtual ~TtlExpirationValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kTtlExpirationTag;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, sizeof(buffer_));
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const TtlExpirationValue*>(&pre_rhs);
+    return Encode().compare(Slice(rhs->buffer_, sizeof(rhs->buffer_)));
+  }
+
+  MicrosTime value() const {
+    return BigEndian::Load64(buffer_);
+  }
+
+ private:
+  char buffer_[sizeof(MicrosTime)];
+};
+
+// Wrapper for UserBoundaryValue that stores key encoded PrimitiveValue of range component with
+// specified index, or of non-key column with specified id.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
-  explicit PrimitiveBoundaryValue(size_t index, Slice slice) : index_(index) {
+  explicit PrimitiveBoundaryValue(rocksdb::UserBoundaryTag tag, Slice slice) : tag_(tag) {
     buffer_.assign(slice.data(), slice.end());
   }
 
   static CHECKED_STATUS Create(size_t index, Slice data, rocksdb::UserBoundaryValuePtr* value) {
     CHECK_NOTNULL(value);
 
-    *value = std::make_shared<PrimitiveBoundaryValue>(index, data);
+    *value = std::make_shared<PrimitiveBoundaryValue>(TagForIndex(index), data);
+    return Status::OK();
+  }
+
+  static CHECKED_STATUS CreateForColumn(
+      ColumnId column_id, Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+
+    *value = std::make_shared<PrimitiveBoundaryValue>(TagForColumn(column_id), data);
     return Status::OK();
   }
 
@@ -100,8 +180,12 @@ class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
     return static_cast<uint32_t>(kRangeComponentsStart + index);
   }
 
+  static rocksdb::UserBoundaryTag TagForColumn(ColumnId column_id) {
+    return static_cast<uint32_t>(kValueColumnsStart + column_id.rep());
+  }
+
   rocksdb::UserBoundaryTag Tag() override {
-    return TagForIndex(index_);
+    return tag_;
   }
 
   Slice Encode() override {
@@ -132,7 +216,7 @@ class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
     return Encode().compare(rhs->Encode());
   }
  private:
-  size_t index_; // Index of corresponding range component.
+  rocksdb::UserBoundaryTag tag_; // Tag of corresponding range component or non-key column.
   boost::container::small_vector<uint8_t, 128> buffer_;
 };
 
@@ -147,6 +231,13 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kTtlExpirationTag) {
+      return TtlExpirationValue::Create(data, value);
+    }
+    if (tag >= kValueColumnsStart) {
+      return PrimitiveBoundaryValue::CreateForColumn(
+          ColumnId(tag - kValueColumnsStart), data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -177,6 +268,8 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
 
+    RETURN_NOT_OK(ExtractTtlExpiration(slices.back(), value, values));
+
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
       values->push_back(std::move(temp));
@@ -184,6 +277,68 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
 
     DCHECK(PerformSanityCheck(user_key, slices, *values));
 
+    if (FLAGS_docdb_track_value_column_bounds) {
+      return ExtractValueColumn(user_key, value, values);
+    }
+
+    return Status::OK();
+  }
+
+  // Adds expiration of the record, so it could be checked whether records of a file could outlive
+  // the table TTL. TTL merge records are also taken into account, since they extend lifetime of
+  // earlier records.
+  CHECKED_STATUS ExtractTtlExpiration(
+      Slice encoded_doc_ht, Slice value, rocksdb::UserBoundaryValues* values) {
+    ValueType value_type;
+    MonoDelta ttl;
+    RETURN_NOT_OK(Value::DecodePrimitiveValueType(value, &value_type, nullptr, &ttl));
+    if (ttl.Equals(Value::kMaxTtl)) {
+      values->push_back(TtlExpirationValue::NoExpiration());
+      return Status::OK();
+    }
+
+    auto expiration = std::numeric_limits<MicrosTime>::max();
+    if (ttl.ToMilliseconds() != kResetTTL) {
+      DocHybridTime doc_ht;
+      RETURN_NOT_OK(doc_ht.FullyDecodeFrom(encoded_doc_ht));
+      auto write_time = doc_ht.hybrid_time().GetPhysicalValueMicros();
+      auto ttl_us = static_cast<MicrosTime>(std::max<int64_t>(ttl.ToMicroseconds(), 0));
+      if (ttl_us < expiration - write_time) {
+        expiration = write_time + ttl_us;
+      }
+    }
+    values->push_back(std::make_shared<TtlExpirationValue>(expiration));
+    return Status::OK();
+  }
+
+  // Adds value of top level non-key column, i.e. record of form <doc key> <column id> <doc ht>.
+  // Records of any other form, as well as tombstones and collections, are ignored.
+  CHECKED_STATUS ExtractValueColumn(
+      Slice user_key, Slice value, rocksdb::UserBoundaryValues* values) {
+    auto doc_key_size = VERIFY_RESULT(DocKey::EncodedSize(user_key, DocKeyPart::WHOLE_DOC_KEY));
+    Slice subkeys(user_key.data() + doc_key_size, user_key.end());
+    if (subkeys.empty() || DecodeValueType(subkeys) != ValueType::kColumnId) {
+      return Status::OK();
+    }
+    PrimitiveValue column;
+    RETURN_NOT_OK(column.DecodeFromKey(&subkeys));
+    // Intents DB records have intent types between subkeys and doc ht, so they are skipped here.
+    if (subkeys.empty() || DecodeValueType(subkeys) != ValueType::kHybridTime) {
+      return Status::OK();
+    }
+
+    Value column_value;
+    RETURN_NOT_OK(column_value.Decode(value));
+    if (!column_value.primitive_value().IsPrimitive()) {
+      return Status::OK();
+    }
+    KeyBytes encoded_value;
+    column_value.primitive_value().AppendToKey(&encoded_value);
+
+    rocksdb::UserBoundaryValuePtr temp;
+    RETURN_NOT_OK(PrimitiveBoundaryValue::CreateForColumn(
+        column.GetColumnId(), encoded_value.AsSlice(), &temp));
+    values->push_back(std::move(temp));
     return Status::OK();
   }
 
@@ -243,6 +398,27 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
   return primitive_value->value(out);
 }
 
+// Used in tests
+Status GetValueColumnPrimitiveValue(const rocksdb::UserBoundaryValues& values,
+                                    ColumnId column_id,
+                                    PrimitiveValue* out) {
+  auto value = rocksdb::UserValueWithTag(values, PrimitiveBoundaryValue::TagForColumn(column_id));
+  if (!value) {
+    return STATUS_SUBSTITUTE(NotFound, "Not found value for column $0", column_id.rep());
+  }
+  const auto* primitive_value = down_cast<PrimitiveBoundaryValue*>(value.get());
+  return primitive_value->value(out);
+}
+
+Status GetTtlExpiration(const rocksdb::UserBoundaryValues& values, MicrosTime* out) {
+  auto value = rocksdb::UserValueWithTag(values, kTtlExpirationTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for TTL expiration");
+  }
+  *out = down_cast<TtlExpirationValue*>(value.get())->value();
+  return Status::OK();
+}
+
 Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out) {
   auto value = rocksdb::UserValueWithTag(values, kDocHybridTimeTag);
   if (!value) {
@@ -256,5 +432,9 @@ rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
 
+rocksdb::UserBoundaryTag TagForValueColumn(ColumnId column_id) {
+  return PrimitiveBoundaryValue::TagForColumn(column_id);
+}
+
 } // namespace docdb
 } // namespace yb
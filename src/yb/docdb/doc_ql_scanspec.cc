@@ -18,6 +18,8 @@
 #include "yb/docdb/doc_expr.h"
 #include "yb/rocksdb/db/compaction.h"
 
+DECLARE_bool(docdb_track_value_column_bounds);
+
 using std::vector;
 
 namespace yb {
@@ -281,6 +283,7 @@ Result<KeyBytes> DocQLScanSpec::Bound(const bool lower_bound) const {
 }
 
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index);
+rocksdb::UserBoundaryTag TagForValueColumn(ColumnId column_id);
 
 namespace {
 
@@ -306,30 +309,119 @@ bool GreaterOrEquals(const Slice& lhs, const Slice& rhs) {
   return lhs.compare(rhs) >= 0;
 }
 
+// Inclusive lower and upper bounds of non-key column value, empty bound means unbounded.
+struct ValueColumnBounds {
+  KeyBytes lower;
+  KeyBytes upper;
+};
+
+typedef std::map<rocksdb::UserBoundaryTag, ValueColumnBounds> ValueColumnBoundsMap;
+
+// Collects bounds of non-key columns from relational conditions of the form <column> op <value>,
+// possibly joined with AND. All other conditions don't restrict bounds.
+void CollectValueColumnBounds(
+    const Schema& schema, const QLConditionPB& condition, ValueColumnBoundsMap* out) {
+  const auto& operands = condition.operands();
+  if (condition.op() == QL_OP_AND) {
+    for (const auto& operand : operands) {
+      if (operand.expr_case() == QLExpressionPB::ExprCase::kCondition) {
+        CollectValueColumnBounds(schema, operand.condition(), out);
+      }
+    }
+    return;
+  }
+
+  if (operands.size() != 2) {
+    return;
+  }
+  bool column_first = true;
+  const QLExpressionPB* col_expr = &operands.Get(0);
+  const QLExpressionPB* val_expr = &operands.Get(1);
+  if (col_expr->expr_case() != QLExpressionPB::ExprCase::kColumnId) {
+    std::swap(col_expr, val_expr);
+    column_first = false;
+  }
+  if (col_expr->expr_case() != QLExpressionPB::ExprCase::kColumnId ||
+      val_expr->expr_case() != QLExpressionPB::ExprCase::kValue ||
+      IsNull(val_expr->value())) {
+    return;
+  }
+  const ColumnId column_id(col_expr->column_id());
+  auto column_idx = schema.find_column_by_id(column_id);
+  if (column_idx == Schema::kColumnNotFound || schema.is_key_column(column_idx)) {
+    return;
+  }
+
+  bool lower;
+  bool upper;
+  switch (condition.op()) {
+    case QL_OP_EQUAL:
+      lower = upper = true;
+      break;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL:
+      // <column> <= <value> restricts upper bound, <value> <= <column> restricts lower bound.
+      lower = !column_first;
+      upper = column_first;
+      break;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL:
+      lower = column_first;
+      upper = !column_first;
+      break;
+    default:
+      return;
+  }
+
+  // Non-key column values are stored in ascending order, like the boundary extractor encodes them.
+  KeyBytes encoded_value;
+  PrimitiveValue::FromQLValuePB(val_expr->value(), ColumnSchema::SortingType::kNotSpecified)
+      .AppendToKey(&encoded_value);
+  auto& bounds = (*out)[TagForValueColumn(column_id)];
+  if (lower && (bounds.lower.empty() || bounds.lower < encoded_value)) {
+    bounds.lower = encoded_value;
+  }
+  if (upper && (bounds.upper.empty() || encoded_value < bounds.upper)) {
+    bounds.upper = encoded_value;
+  }
+}
+
 class RangeBasedFileFilter : public rocksdb::ReadFileFilter {
  public:
   RangeBasedFileFilter(const std::vector<PrimitiveValue>& lower_bounds,
-      const std::vector<PrimitiveValue>& upper_bounds)
+      const std::vector<PrimitiveValue>& upper_bounds,
+      ValueColumnBoundsMap value_column_bounds)
       : lower_bounds_(EncodePrimitiveValues(lower_bounds, upper_bounds.size())),
-      upper_bounds_(EncodePrimitiveValues(upper_bounds, lower_bounds.size())) {
+      upper_bounds_(EncodePrimitiveValues(upper_bounds, lower_bounds.size())),
+      value_column_bounds_(std::move(value_column_bounds)) {
   }
 
   bool Filter(const rocksdb::FdWithBoundaries& file) const override {
     for (size_t i = 0; i != lower_bounds_.size(); ++i) {
-      auto lower_bound = lower_bounds_[i].AsSlice();
-      auto upper_bound = upper_bounds_[i].AsSlice();
-      rocksdb::UserBoundaryTag tag = TagForRangeComponent(i);
-      auto smallest = ValueOrEmpty(file.smallest.user_value_with_tag(tag));
-      auto largest = ValueOrEmpty(file.largest.user_value_with_tag(tag));
-      if (!GreaterOrEquals(upper_bound, smallest) || !GreaterOrEquals(largest, lower_bound)) {
+      if (!Overlaps(file, TagForRangeComponent(i), lower_bounds_[i], upper_bounds_[i])) {
+        return false;
+      }
+    }
+    for (const auto& tag_and_bounds : value_column_bounds_) {
+      const auto& bounds = tag_and_bounds.second;
+      if (!Overlaps(file, tag_and_bounds.first, bounds.lower, bounds.upper)) {
         return false;
       }
     }
     return true;
   }
  private:
+  static bool Overlaps(const rocksdb::FdWithBoundaries& file, rocksdb::UserBoundaryTag tag,
+                       const KeyBytes& lower_bound, const KeyBytes& upper_bound) {
+    auto smallest = ValueOrEmpty(file.smallest.user_value_with_tag(tag));
+    auto largest = ValueOrEmpty(file.largest.user_value_with_tag(tag));
+    return GreaterOrEquals(upper_bound.AsSlice(), smallest) &&
+           GreaterOrEquals(largest, lower_bound.AsSlice());
+  }
+
   std::vector<KeyBytes> lower_bounds_;
   std::vector<KeyBytes> upper_bounds_;
+  ValueColumnBoundsMap value_column_bounds_;
 };
 
 } // namespace
@@ -337,10 +429,15 @@ class RangeBasedFileFilter : public rocksdb::ReadFileFilter {
 std::shared_ptr<rocksdb::ReadFileFilter> DocQLScanSpec::CreateFileFilter() const {
   auto lower_bound = range_components(true);
   auto upper_bound = range_components(false);
-  if (lower_bound.empty() && upper_bound.empty()) {
+  ValueColumnBoundsMap value_column_bounds;
+  if (FLAGS_docdb_track_value_column_bounds && condition_) {
+    CollectValueColumnBounds(schema_, *condition_, &value_column_bounds);
+  }
+  if (lower_bound.empty() && upper_bound.empty() && value_column_bounds.empty()) {
     return std::shared_ptr<rocksdb::ReadFileFilter>();
   } else {
-    return std::make_shared<RangeBasedFileFilter>(std::move(lower_bound), std::move(upper_bound));
+    return std::make_shared<RangeBasedFileFilter>(
+        std::move(lower_bound), std::move(upper_bound), std::move(value_column_bounds));
   }
 }
 
@@ -587,6 +587,13 @@ Status DocWriteBatch::ReplaceInList(
   }
 }
 
+Status DocWriteBatch::DeleteTable(
+    const Schema& schema, const ReadHybridTime& read_ht, const CoarseTimePoint deadline) {
+  SCHECK(schema.has_cotable_id() || schema.has_pgtable_id(), InvalidArgument,
+         "Table-level tombstone could be written only for colocated table");
+  return DeleteSubDoc(DocPath(DocKey(schema).Encode()), read_ht, deadline);
+}
+
 void DocWriteBatch::Clear() {
   put_batch_.clear();
   cache_.Clear();
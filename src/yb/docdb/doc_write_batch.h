@@ -188,6 +188,14 @@ class DocWriteBatch {
                         read_ht, deadline, query_id, user_timestamp);
   }
 
+  // Deletes all rows of a colocated table by writing a single tombstone for the document key that
+  // consists only of the table id. Since this key is a prefix of the keys of all rows of the table,
+  // readers and compactions treat this tombstone as covering the whole key range of the table.
+  CHECKED_STATUS DeleteTable(
+      const Schema& schema,
+      const ReadHybridTime& read_ht = ReadHybridTime::Max(),
+      const CoarseTimePoint deadline = CoarseTimePoint::max());
+
   void Clear();
   bool IsEmpty() const { return put_batch_.empty(); }
 
@@ -23,6 +23,7 @@
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/common/hybrid_time.h"
+#include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/docdb_test_base.h"
@@ -63,6 +64,7 @@ using namespace std::chrono_literals;
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(docdb_sort_weak_intents_in_tests);
+DECLARE_bool(docdb_track_value_column_bounds);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -73,6 +75,10 @@ CHECKED_STATUS GetPrimitiveValue(const rocksdb::UserBoundaryValues &values,
     size_t index,
     PrimitiveValue *out);
 CHECKED_STATUS GetDocHybridTime(const rocksdb::UserBoundaryValues &values, DocHybridTime *out);
+CHECKED_STATUS GetTtlExpiration(const rocksdb::UserBoundaryValues &values, MicrosTime *out);
+CHECKED_STATUS GetValueColumnPrimitiveValue(const rocksdb::UserBoundaryValues &values,
+    ColumnId column_id,
+    PrimitiveValue *out);
 
 YB_STRONGLY_TYPED_BOOL(InitMarkerExpired);
 YB_STRONGLY_TYPED_BOOL(UseIntermediateFlushes);
@@ -1937,6 +1943,85 @@ SubDocKey(DocKey([], ["k1"]), ["s3"; HT{ physical: 2000 }]) -> "v3"; ttl: 0.000s
       )#");
 }
 
+TEST_F(DocDBTest, ExpiredFiles) {
+  auto retention_policy = std::make_shared<ManualHistoryRetentionPolicy>();
+  DocDBCompactionFilterFactory filter_factory(retention_policy, &KeyBounds::kNoBounds);
+  retention_policy->SetTableTTLForTests(2ms);
+
+  auto expired_files = [this, &filter_factory]() {
+    std::vector<rocksdb::LiveFileMetaData> files;
+    rocksdb()->GetLiveFilesMetaData(&files);
+    // Factory expects files ordered from newest to oldest.
+    sort(files.begin(), files.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.name > rhs.name;
+    });
+    std::vector<const rocksdb::FileBoundaryValuesBase*> largest_values;
+    for (const auto& file : files) {
+      largest_values.push_back(&file.largest);
+    }
+    std::vector<std::string> result;
+    auto indexes = filter_factory.ExpiredFiles(largest_values, rocksdb::ForDeletion::kFalse);
+    // Manual policy does not have state to commit, so both modes should report the same files.
+    EXPECT_EQ(indexes, filter_factory.ExpiredFiles(largest_values, rocksdb::ForDeletion::kTrue));
+    for (auto index : indexes) {
+      result.push_back(files[index].name);
+    }
+    return result;
+  };
+
+  auto earliest_expiration = [this, &filter_factory]() {
+    std::vector<rocksdb::LiveFileMetaData> files;
+    rocksdb()->GetLiveFilesMetaData(&files);
+    std::vector<const rocksdb::FileBoundaryValuesBase*> largest_values;
+    for (const auto& file : files) {
+      largest_values.push_back(&file.largest);
+    }
+    return filter_factory.EarliestExpirationTime(largest_values);
+  };
+
+  auto write_and_flush = [this](const std::string& key, const Value& value, HybridTime ht) {
+    ASSERT_OK(SetPrimitive(
+        DocPath(DocKey(PrimitiveValues(key)).Encode(), PrimitiveValue(ColumnId(10))), value, ht));
+    ASSERT_OK(FlushRocksDbAndWait());
+  };
+
+  ASSERT_NO_FATALS(write_and_flush("k1", Value(PrimitiveValue("v1")), 1000_usec_ht));
+  ASSERT_NO_FATALS(write_and_flush("k2", Value(PrimitiveValue("v2")), 2000_usec_ht));
+  auto files = SSTableFileNames();
+  ASSERT_EQ(2U, files.size());
+  ASSERT_EQ(3000U, earliest_expiration());
+
+  retention_policy->SetHistoryCutoff(3500_usec_ht);
+  // Records of the first file expired at 3000us, records of the second one expire at 4000us.
+  ASSERT_EQ(std::vector<std::string>{ files[0] }, expired_files());
+
+  // Record with explicit TTL expires at 13000us, so nothing could be dropped before that.
+  ASSERT_NO_FATALS(write_and_flush("k3", Value(PrimitiveValue("v3"), 10ms), 3000_usec_ht));
+  {
+    std::vector<rocksdb::LiveFileMetaData> live_files;
+    rocksdb()->GetLiveFilesMetaData(&live_files);
+    MicrosTime max_expiration = 0;
+    for (const auto& file : live_files) {
+      MicrosTime expiration;
+      ASSERT_OK(GetTtlExpiration(file.largest.user_values, &expiration));
+      max_expiration = std::max(max_expiration, expiration);
+    }
+    ASSERT_EQ(13000U, max_expiration);
+  }
+  ASSERT_EQ(13000U, earliest_expiration());
+  ASSERT_TRUE(expired_files().empty());
+  retention_policy->SetHistoryCutoff(12000_usec_ht);
+  ASSERT_TRUE(expired_files().empty());
+
+  retention_policy->SetHistoryCutoff(14000_usec_ht);
+  ASSERT_EQ(3U, expired_files().size());
+
+  // Record that never expires keeps all files.
+  ASSERT_NO_FATALS(write_and_flush("k4", Value(PrimitiveValue("v4"), 0ms), 4000_usec_ht));
+  ASSERT_TRUE(expired_files().empty());
+  ASSERT_GT(earliest_expiration(), 14000U);
+}
+
 // Test table tombstones for colocated tables.
 TEST_F(DocDBTest, TableTombstoneCompaction) {
   constexpr PgTableOid pgtable_id(0x4001);
@@ -2040,6 +2125,49 @@ SubDocKey(DocKey(PgTableId=16385, [], ["r1"]), [SystemColumnId(0); HT{ physical:
       )#");
 }
 
+// Test table tombstones for colocated tables identified by cotable id.
+TEST_F(DocDBTest, CoTableTombstoneCompaction) {
+  Uuid cotable_id;
+  ASSERT_OK(cotable_id.FromString("11111111-2222-3333-4444-555555555555"));
+  HybridTime t = 1000_usec_ht;
+
+  for (int i = 1; i <= 2; ++i) {
+    DocKey doc_key(cotable_id);
+    doc_key.ResizeRangeComponents(1);
+    doc_key.SetRangeComponent(PrimitiveValue(Format("r$0", i)), 0 /* idx */);
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key.Encode(), PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn)),
+        Value(PrimitiveValue()),
+        t));
+    t = server::HybridClock::AddPhysicalTimeToHybridTime(t, 1ms);
+  }
+  ASSERT_OK(SetPrimitive(
+      DocPath(DocKey(cotable_id).Encode()), Value(PrimitiveValue::kTombstone), t));
+  t = server::HybridClock::AddPhysicalTimeToHybridTime(t, 1ms);
+  {
+    DocKey doc_key(cotable_id);
+    doc_key.ResizeRangeComponents(1);
+    doc_key.SetRangeComponent(PrimitiveValue("r1"), 0 /* idx */);
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key.Encode(), PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn)),
+        Value(PrimitiveValue()),
+        t));
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(Format(R"#(
+SubDocKey(DocKey(CoTableId=$0, [], []), [HT{ physical: 3000 }]) -> DEL
+SubDocKey(DocKey(CoTableId=$0, [], ["r1"]), [SystemColumnId(0); HT{ physical: 4000 }]) -> null
+SubDocKey(DocKey(CoTableId=$0, [], ["r1"]), [SystemColumnId(0); HT{ physical: 1000 }]) -> null
+SubDocKey(DocKey(CoTableId=$0, [], ["r2"]), [SystemColumnId(0); HT{ physical: 2000 }]) -> null
+      )#", cotable_id.ToString()));
+
+  // Major compaction removes the table tombstone together with all rows it covers.
+  FullyCompactHistoryBefore(10000_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(Format(R"#(
+SubDocKey(DocKey(CoTableId=$0, [], ["r1"]), [SystemColumnId(0); HT{ physical: 4000 }]) -> null
+      )#", cotable_id.ToString()));
+}
+
 TEST_F(DocDBTest, MinorCompactionNoDeletions) {
   ASSERT_OK(DisableCompactions());
   const DocKey doc_key(PrimitiveValues("k"));
@@ -2549,6 +2677,175 @@ TEST_F_EX(DocDBTest, BoundaryValuesMultiFiles, DocDBTestBoundaryValues) {
   TestBoundaryValues(350);
 }
 
+TEST_F(DocDBTest, ValueColumnBoundaryValues) {
+  FLAGS_docdb_track_value_column_bounds = true;
+  const ColumnId kValueColumn(20);
+  const ColumnId kCollectionColumn(21);
+
+  for (int i = 0; i != 2; ++i) {
+    for (int64_t j = 0; j != 10; ++j) {
+      auto key = DocKey(PrimitiveValues("key_" + std::to_string(i * 10 + j))).Encode();
+      ASSERT_OK(SetPrimitive(
+          DocPath(key, PrimitiveValue(kValueColumn)), PrimitiveValue(i * 1000 + j * 10),
+          HybridTime::FromMicros(1000 + j)));
+      // Collection elements and tombstones should not affect bounds.
+      ASSERT_OK(SetPrimitive(
+          DocPath(key, PrimitiveValue(kCollectionColumn), PrimitiveValue("elem")),
+          PrimitiveValue("value"), HybridTime::FromMicros(1000 + j)));
+      ASSERT_OK(DeleteSubDoc(
+          DocPath(key, PrimitiveValue(kValueColumn)), HybridTime::FromMicros(2000 + j)));
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(2, files.size());
+  sort(files.begin(), files.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.name < rhs.name;
+  });
+
+  for (size_t i = 0; i != files.size(); ++i) {
+    PrimitiveValue temp;
+    ASSERT_OK(GetValueColumnPrimitiveValue(files[i].smallest.user_values, kValueColumn, &temp));
+    ASSERT_EQ(PrimitiveValue(static_cast<int64_t>(i * 1000)), temp);
+    ASSERT_OK(GetValueColumnPrimitiveValue(files[i].largest.user_values, kValueColumn, &temp));
+    ASSERT_EQ(PrimitiveValue(static_cast<int64_t>(i * 1000 + 90)), temp);
+    ASSERT_NOK(GetValueColumnPrimitiveValue(
+        files[i].smallest.user_values, kCollectionColumn, &temp));
+  }
+}
+
+TEST_F(DocDBTest, ValueColumnFileFilter) {
+  FLAGS_docdb_track_value_column_bounds = true;
+  const ColumnId kKeyColumn(10);
+  const ColumnId kValueColumn(20);
+  constexpr size_t kNumFiles = 2;
+  constexpr size_t kKeysPerFile = 10;
+
+  for (size_t i = 0; i != kNumFiles; ++i) {
+    for (size_t j = 0; j != kKeysPerFile; ++j) {
+      auto key = DocKey(PrimitiveValues("key_" + std::to_string(i * kKeysPerFile + j))).Encode();
+      ASSERT_OK(SetPrimitive(
+          DocPath(key, PrimitiveValue(kValueColumn)),
+          PrimitiveValue(static_cast<int64_t>(i * 1000 + j * 10)),
+          HybridTime::FromMicros(1000 + j)));
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  Schema schema({ ColumnSchema("k", STRING), ColumnSchema("v", INT64) },
+                { kKeyColumn, kValueColumn }, 1);
+
+  // Returns number of records read from regular DB with file filter for condition v >= value.
+  auto count_records = [this, &schema, kValueColumn](int64_t value) -> size_t {
+    QLConditionPB condition;
+    condition.set_op(QL_OP_GREATER_THAN_EQUAL);
+    condition.add_operands()->set_column_id(kValueColumn.rep());
+    condition.add_operands()->mutable_value()->set_int64_value(value);
+    const std::vector<PrimitiveValue> hashed_components;
+    DocQLScanSpec scan_spec(
+        schema, boost::none, boost::none, hashed_components, &condition, nullptr /* if_req */,
+        rocksdb::kDefaultQueryId);
+
+    rocksdb::ReadOptions read_opts;
+    read_opts.file_filter = scan_spec.CreateFileFilter();
+    EXPECT_TRUE(read_opts.file_filter != nullptr);
+    std::unique_ptr<rocksdb::Iterator> iter(rocksdb()->NewIterator(read_opts));
+    size_t result = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++result;
+    }
+    return result;
+  };
+
+  // Every file overlaps the condition.
+  ASSERT_EQ(kNumFiles * kKeysPerFile, count_records(0));
+  // Only the second file could contain matching values, so the first one is skipped.
+  ASSERT_EQ(kKeysPerFile, count_records(1000));
+  // Bounds are inclusive.
+  ASSERT_EQ(kKeysPerFile, count_records(1000 + (kKeysPerFile - 1) * 10));
+  // No file could contain matching values.
+  ASSERT_EQ(0U, count_records(2000));
+}
+
+TEST_F(DocDBTest, IngestBatch) {
+  auto make_key = [](const std::string& key) {
+    return SubDocKey(DocKey(PrimitiveValues(key)), 1000_usec_ht).Encode();
+  };
+
+  ConsensusFrontiers frontiers;
+  set_op_id(OpId(1, 10), &frontiers);
+  set_hybrid_time(1000_usec_ht, &frontiers);
+
+  IngestBatch batch;
+  for (const auto& key : {"key_c", "key_a", "key_b"}) {
+    batch.Put(make_key(key).AsSlice(), Value(PrimitiveValue(std::string("value_") + key)).Encode());
+  }
+  const auto sst_path = GetTestPath("ingested.sst");
+  ASSERT_OK(batch.Ingest(sst_path, frontiers, rocksdb()));
+  ASSERT_FALSE(env_->FileExists(sst_path));
+
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey([], ["key_a"]), [HT{ physical: 1000 }]) -> "value_key_a"
+SubDocKey(DocKey([], ["key_b"]), [HT{ physical: 1000 }]) -> "value_key_b"
+SubDocKey(DocKey([], ["key_c"]), [HT{ physical: 1000 }]) -> "value_key_c"
+      )#");
+
+  // Ingested file has the same boundary values as a flushed one, so file filters and dropping of
+  // expired files work for it.
+  {
+    std::vector<rocksdb::LiveFileMetaData> files;
+    rocksdb()->GetLiveFilesMetaData(&files);
+    ASSERT_EQ(1U, files.size());
+    DocHybridTime doc_ht;
+    ASSERT_OK(GetDocHybridTime(files[0].largest.user_values, &doc_ht));
+    ASSERT_EQ(1000_usec_ht, doc_ht.hybrid_time());
+    MicrosTime ttl_expiration;
+    ASSERT_OK(GetTtlExpiration(files[0].largest.user_values, &ttl_expiration));
+    ASSERT_TRUE(files[0].largest.user_frontier != nullptr);
+    ASSERT_EQ(OpId(1, 10),
+              down_cast<ConsensusFrontier&>(*files[0].largest.user_frontier).op_id());
+  }
+
+  // Batch that overlaps with existing data could not be ingested.
+  IngestBatch overlapping_batch;
+  overlapping_batch.Put(make_key("key_0").AsSlice(), Value(PrimitiveValue("value")).Encode());
+  overlapping_batch.Put(make_key("key_d").AsSlice(), Value(PrimitiveValue("value")).Encode());
+  auto status = overlapping_batch.Ingest(sst_path, frontiers, rocksdb());
+  ASSERT_TRUE(status.IsNotSupported()) << status;
+  ASSERT_FALSE(env_->FileExists(sst_path));
+
+  // Overlap with records that are still in the memtable is detected as well.
+  ASSERT_OK(SetPrimitive(
+      DocPath(DocKey(PrimitiveValues("key_x")).Encode()), PrimitiveValue("value"), 2000_usec_ht));
+  IngestBatch memtable_overlap_batch;
+  memtable_overlap_batch.Put(make_key("key_w").AsSlice(), Value(PrimitiveValue("value")).Encode());
+  memtable_overlap_batch.Put(make_key("key_z").AsSlice(), Value(PrimitiveValue("value")).Encode());
+  status = memtable_overlap_batch.Ingest(sst_path, frontiers, rocksdb());
+  ASSERT_TRUE(status.IsNotSupported()) << status;
+  ASSERT_FALSE(env_->FileExists(sst_path));
+
+  // File is not built while snapshot is held, records could still be written through memtable.
+  IngestBatch snapshot_batch;
+  snapshot_batch.Put(make_key("key_e").AsSlice(), Value(PrimitiveValue("value_e")).Encode());
+  const auto* snapshot = rocksdb()->GetSnapshot();
+  status = snapshot_batch.Ingest(sst_path, frontiers, rocksdb());
+  rocksdb()->ReleaseSnapshot(snapshot);
+  ASSERT_TRUE(status.IsNotSupported()) << status;
+  ASSERT_FALSE(env_->FileExists(sst_path));
+  rocksdb::WriteBatch write_batch;
+  snapshot_batch.AppendTo(&write_batch);
+  ASSERT_OK(rocksdb()->Write(rocksdb::WriteOptions(), &write_batch));
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey([], ["key_a"]), [HT{ physical: 1000 }]) -> "value_key_a"
+SubDocKey(DocKey([], ["key_b"]), [HT{ physical: 1000 }]) -> "value_key_b"
+SubDocKey(DocKey([], ["key_c"]), [HT{ physical: 1000 }]) -> "value_key_c"
+SubDocKey(DocKey([], ["key_e"]), [HT{ physical: 1000 }]) -> "value_e"
+SubDocKey(DocKey([], ["key_x"]), [HT{ physical: 2000 }]) -> "value"
+      )#");
+}
+
 TEST_F(DocDBTest, BloomFilterTest) {
   // Turn off "next instead of seek" optimization, because this test rely on DocDB to do seeks.
   FLAGS_max_nexts_to_avoid_seek = 0;
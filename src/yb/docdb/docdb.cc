@@ -928,6 +928,16 @@ CHECKED_STATUS BuildSubDocument(
         return Status::OK();
       }
     }
+    // Check the lower bound before building descendant, so values filtered out by it are not
+    // counted in num_values_observed.
+    if (!data.low_subkey->CanInclude(key)) {
+      VLOG(3) << "Filtered by low_subkey: " << data.low_subkey->ToString()
+              << ", key: " << SubDocKey::DebugSliceToString(key);
+      // The value provided is lower than what we are looking for, seek to the lower bound.
+      SeekToLowerBound(*data.low_subkey, iter);
+      continue;
+    }
+
     SubDocument descendant{PrimitiveValue(ValueType::kInvalid)};
     // TODO: what if the key we found is the same as before?
     //       We'll get into an infinite recursion then.
@@ -943,14 +953,6 @@ CHECKED_STATUS BuildSubDocument(
       continue;
     }
 
-    if (!data.low_subkey->CanInclude(key)) {
-      VLOG(3) << "Filtered by low_subkey: " << data.low_subkey->ToString()
-              << ", key: " << SubDocKey::DebugSliceToString(key);
-      // The value provided is lower than what we are looking for, seek to the lower bound.
-      SeekToLowerBound(*data.low_subkey, iter);
-      continue;
-    }
-
     // We use num_values_observed as a conservative figure for lower bound and
     // current_values_observed for upper bound so we don't lose any data we should be including.
     if (!data.low_index->CanInclude(*num_values_observed)) {
@@ -1124,13 +1126,12 @@ yb::Status GetSubDocument(
   // max_overwrite_ht.
   //
   // First, check for an ancestor at the ID level: a table tombstone.  Currently, this is only
-  // supported for YSQL colocated tables.  Since iterators only ever pertain to one table, there is
+  // supported for colocated tables.  Since iterators only ever pertain to one table, there is
   // no need to create a prefix scope here.
   if (data.table_tombstone_time && *data.table_tombstone_time == DocHybridTime::kInvalid) {
     // Only check for table tombstones if the table is colocated, as signified by the prefix of
-    // kPgTableOid.
-    // TODO: adjust when fixing issue #3551
-    if (key_slice[0] == ValueTypeAsChar::kPgTableOid) {
+    // kPgTableOid or kTableId.
+    if (key_slice[0] == ValueTypeAsChar::kPgTableOid || key_slice[0] == ValueTypeAsChar::kTableId) {
       // Seek to the ID level to look for a table tombstone.  Since this seek is expensive, cache
       // the result in data.table_tombstone_time to avoid double seeking for the lifetime of the
       // DocRowwiseIterator.
@@ -1415,13 +1416,16 @@ Slice DocHybridTimeBuffer::EncodeWithValueType(const DocHybridTime& doc_ht) {
   return Slice(buffer_.data(), end);
 }
 
+namespace {
+
+template <class RegularBatch>
 CHECKED_STATUS IntentToWriteRequest(
     const Slice& transaction_id_slice,
     HybridTime commit_ht,
     const Slice& reverse_index_key,
     const Slice& reverse_index_value,
     rocksdb::Iterator* intent_iter,
-    rocksdb::WriteBatch* regular_batch,
+    RegularBatch* regular_batch,
     IntraTxnWriteId* write_id) {
   DocHybridTimeBuffer doc_ht_buffer;
   intent_iter->Seek(reverse_index_value);
@@ -1484,9 +1488,10 @@ CHECKED_STATUS IntentToWriteRequest(
   return Status::OK();
 }
 
-Status PrepareApplyIntentsBatch(
+template <class RegularBatch>
+CHECKED_STATUS DoPrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
-    rocksdb::WriteBatch* regular_batch,
+    RegularBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
   // regular_batch or intents_batch could be null. In this case we don't fill apply batch for
   // appropriate DB.
@@ -1563,5 +1568,23 @@ Status PrepareApplyIntentsBatch(
   return Status::OK();
 }
 
+}  // namespace
+
+Status PrepareApplyIntentsBatch(
+    const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    rocksdb::WriteBatch* regular_batch,
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
+  return DoPrepareApplyIntentsBatch(
+      transaction_id, commit_ht, key_bounds, regular_batch, intents_db, intents_batch);
+}
+
+Status PrepareApplyIntentsBatch(
+    const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    IngestBatch* regular_batch, rocksdb::DB* intents_db) {
+  return DoPrepareApplyIntentsBatch(
+      transaction_id, commit_ht, key_bounds, regular_batch, intents_db,
+      nullptr /* intents_batch */);
+}
+
 }  // namespace docdb
 }  // namespace yb
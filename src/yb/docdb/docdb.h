@@ -194,6 +194,12 @@ CHECKED_STATUS PrepareApplyIntentsBatch(
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
 
+// Same as above, but regular records are collected to regular_batch, so they could be ingested to
+// the regular DB as an SST file. Intents are not removed.
+CHECKED_STATUS PrepareApplyIntentsBatch(
+    const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    IngestBatch* regular_batch, rocksdb::DB* intents_db);
+
 // A visitor class that could be overridden to consume results of scanning SubDocuments.
 // See e.g. SubDocumentBuildingVisitor (used in implementing GetSubDocument) as example usage.
 // We can scan any SubDocument from a node in the document tree.
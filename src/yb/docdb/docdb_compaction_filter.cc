@@ -13,11 +13,15 @@
 
 #include "yb/docdb/docdb_compaction_filter.h"
 
+#include <limits>
 #include <memory>
 
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
@@ -34,9 +38,19 @@ using rocksdb::CompactionFilter;
 using rocksdb::VectorToString;
 using rocksdb::FilterDecision;
 
+DEFINE_bool(docdb_drop_expired_files, true,
+            "Delete SST files of tables with default time to live without reading them, when all "
+            "records in a file have expired.");
+TAG_FLAG(docdb_drop_expired_files, advanced);
+TAG_FLAG(docdb_drop_expired_files, runtime);
+
 namespace yb {
 namespace docdb {
 
+Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+
+Status GetTtlExpiration(const rocksdb::UserBoundaryValues& values, MicrosTime* out);
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(
@@ -336,6 +350,93 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
       key_bounds_);
 }
 
+namespace {
+
+// Returns files whose records have all expired by table TTL at history cutoff of retention.
+std::vector<size_t> FindExpiredFiles(
+    const HistoryRetentionDirective& retention,
+    const std::vector<const rocksdb::FileBoundaryValuesBase*>& largest_values) {
+  std::vector<size_t> result;
+  if (retention.table_ttl.Equals(Value::kMaxTtl) ||
+      retention.retain_delete_markers_in_major_compaction ||
+      !retention.history_cutoff.is_valid()) {
+    return result;
+  }
+  const auto history_cutoff = retention.history_cutoff.GetPhysicalValueMicros();
+  const auto table_ttl = static_cast<MicrosTime>(
+      std::max<int64_t>(retention.table_ttl.ToMicroseconds(), 0));
+
+  for (size_t i = 0; i != largest_values.size(); ++i) {
+    const auto& values = largest_values[i]->user_values;
+    // Records with explicit TTL, including TTL merge records, could keep alive records of other
+    // files, so nothing is dropped while any of them has not expired yet. The same applies to
+    // files written before TTL expiration was tracked.
+    MicrosTime ttl_expiration;
+    if (!GetTtlExpiration(values, &ttl_expiration).ok() || ttl_expiration >= history_cutoff) {
+      return std::vector<size_t>();
+    }
+    DocHybridTime max_doc_ht;
+    if (!GetDocHybridTime(values, &max_doc_ht).ok()) {
+      continue;
+    }
+    auto max_write_time = max_doc_ht.hybrid_time().GetPhysicalValueMicros();
+    if (max_write_time < history_cutoff && table_ttl < history_cutoff - max_write_time) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+std::vector<size_t> DocDBCompactionFilterFactory::ExpiredFiles(
+    const std::vector<const rocksdb::FileBoundaryValuesBase*>& largest_values,
+    rocksdb::ForDeletion for_deletion) {
+  if (!GetAtomicFlag(&FLAGS_docdb_drop_expired_files)) {
+    return std::vector<size_t>();
+  }
+  auto result = FindExpiredFiles(retention_policy_->ProposedExpirationDirective(), largest_values);
+  if (!for_deletion || result.empty()) {
+    return result;
+  }
+  // Files are about to be deleted, so reads below history cutoff should be rejected from now on.
+  // Cutoff is committed the same way as for compaction filter, and files are checked against it.
+  return FindExpiredFiles(retention_policy_->GetRetentionDirective(), largest_values);
+}
+
+uint64_t DocDBCompactionFilterFactory::EarliestExpirationTime(
+    const std::vector<const rocksdb::FileBoundaryValuesBase*>& largest_values) {
+  constexpr auto kNever = std::numeric_limits<MicrosTime>::max();
+  const auto table_ttl_value = retention_policy_->ProposedExpirationDirective().table_ttl;
+  if (table_ttl_value.Equals(Value::kMaxTtl)) {
+    return kNever;
+  }
+  const auto table_ttl = static_cast<MicrosTime>(
+      std::max<int64_t>(table_ttl_value.ToMicroseconds(), 0));
+
+  // Same conditions as in FindExpiredFiles: history cutoff should pass explicit TTL expiration of
+  // all files, and max write time plus table TTL of at least one file. History cutoff is not
+  // ahead of the physical time, except for clock skew, that could only delay the check.
+  MicrosTime max_ttl_expiration = 0;
+  MicrosTime min_write_expiration = kNever;
+  for (const auto* values : largest_values) {
+    MicrosTime ttl_expiration;
+    if (!GetTtlExpiration(values->user_values, &ttl_expiration).ok()) {
+      return kNever;
+    }
+    max_ttl_expiration = std::max(max_ttl_expiration, ttl_expiration);
+    DocHybridTime max_doc_ht;
+    if (!GetDocHybridTime(values->user_values, &max_doc_ht).ok()) {
+      continue;
+    }
+    auto max_write_time = max_doc_ht.hybrid_time().GetPhysicalValueMicros();
+    if (max_write_time < kNever - table_ttl) {
+      min_write_expiration = std::min(min_write_expiration, max_write_time + table_ttl);
+    }
+  }
+  return std::max(max_ttl_expiration, min_write_expiration);
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
@@ -349,6 +450,12 @@ HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective()
           ShouldRetainDeleteMarkersInMajorCompaction::kFalse};
 }
 
+HistoryRetentionDirective ManualHistoryRetentionPolicy::ProposedExpirationDirective() {
+  return {history_cutoff_.load(std::memory_order_acquire), nullptr,
+          table_ttl_.load(std::memory_order_acquire),
+          ShouldRetainDeleteMarkersInMajorCompaction::kFalse};
+}
+
 void ManualHistoryRetentionPolicy::SetHistoryCutoff(HybridTime history_cutoff) {
   history_cutoff_.store(history_cutoff, std::memory_order_release);
 }
@@ -154,6 +154,12 @@ class HistoryRetentionPolicy {
  public:
   virtual ~HistoryRetentionPolicy() = default;
   virtual HistoryRetentionDirective GetRetentionDirective() = 0;
+
+  // Returns directive with table TTL, history cutoff and retention of delete markers, that is
+  // enough to check whether files have expired. Unlike GetRetentionDirective it does not commit
+  // history cutoff and does not fill deleted columns, and history cutoff is not computed for tables
+  // without TTL, so it is cheap enough to be called by every compaction check.
+  virtual HistoryRetentionDirective ProposedExpirationDirective() = 0;
 };
 
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
@@ -163,6 +169,18 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+
+  // Returns files whose records have all expired by table TTL at history cutoff. History cutoff
+  // is committed only when found files are going to be deleted.
+  std::vector<size_t> ExpiredFiles(
+      const std::vector<const rocksdb::FileBoundaryValuesBase*>& largest_values,
+      rocksdb::ForDeletion for_deletion) override;
+
+  // Returns the earliest physical time, when history cutoff could pass expiration of records of
+  // some file.
+  uint64_t EarliestExpirationTime(
+      const std::vector<const rocksdb::FileBoundaryValuesBase*>& largest_values) override;
+
   const char* Name() const override;
 
  private:
@@ -176,6 +194,8 @@ class ManualHistoryRetentionPolicy : public HistoryRetentionPolicy {
  public:
   HistoryRetentionDirective GetRetentionDirective() override;
 
+  HistoryRetentionDirective ProposedExpirationDirective() override;
+
   void SetHistoryCutoff(HybridTime history_cutoff);
 
   void AddDeletedColumn(ColumnId col);
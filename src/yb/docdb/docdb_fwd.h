@@ -22,6 +22,7 @@ namespace docdb {
 class ConsensusFrontier;
 class DocPath;
 class DocWriteBatch;
+class IngestBatch;
 class IntentAwareIterator;
 class KeyValueWriteBatchPB;
 class QLWriteOperation;
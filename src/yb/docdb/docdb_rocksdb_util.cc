@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -20,12 +21,16 @@
 
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/rate_limiter.h"
+#include "yb/rocksdb/sst_file_writer.h"
 #include "yb/rocksdb/table.h"
+#include "yb/rocksdb/write_batch.h"
 #include "yb/rocksdb/db/db_impl.h"
+#include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/version_edit.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/db/writebuffer.h"
 #include "yb/rocksdb/table/filtering_iterator.h"
+#include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/compression.h"
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
@@ -35,7 +40,9 @@
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/priority_thread_pool.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
 #include "yb/gutil/sysinfo.h"
@@ -112,6 +119,11 @@ DEFINE_int32(priority_thread_pool_size, -1,
              "If -1 and max_background_compactions is specified - use max_background_compactions. "
              "If -1 and max_background_compactions is not specified - use sqrt(num_cpus).");
 
+DEFINE_bool(rocksdb_concurrent_memtable_writes, true,
+            "Whether concurrent writes to the regular RocksDB of a tablet should insert into "
+            "memtable in parallel.");
+TAG_FLAG(rocksdb_concurrent_memtable_writes, advanced);
+
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
@@ -484,12 +496,21 @@ void InitRocksDBOptions(
 
   options->max_write_buffer_number = FLAGS_rocksdb_max_write_buffer_number;
 
-  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
-      0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  SetMemTableConcurrentWrites(rocksdb::ConcurrentWrites::kFalse, options);
 
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 }
 
+void SetMemTableConcurrentWrites(
+    rocksdb::ConcurrentWrites concurrent_writes, rocksdb::Options* options) {
+  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+      0 /* lookahead */, concurrent_writes);
+  options->allow_concurrent_memtable_write = concurrent_writes;
+  // Let followers of the write group spin shortly before blocking, since their memtable inserts
+  // are usually done quickly by the group.
+  options->enable_write_thread_adaptive_yield = concurrent_writes;
+}
+
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix) {
   options->log_prefix = log_prefix;
   options->info_log = std::make_shared<YBRocksDBLogger>(options->log_prefix);
@@ -575,6 +596,132 @@ Status RocksDBPatcher::SetHybridTimeFilter(HybridTime value) {
   return impl_->SetHybridTimeFilter(value);
 }
 
+namespace {
+
+size_t TotalSize(const SliceParts& parts) {
+  size_t result = 0;
+  for (int i = 0; i != parts.num_parts; ++i) {
+    result += parts.parts[i].size();
+  }
+  return result;
+}
+
+char* AppendLengthPrefixed(const SliceParts& parts, size_t size, char* out) {
+  out = rocksdb::EncodeVarint32(out, static_cast<uint32_t>(size));
+  for (int i = 0; i != parts.num_parts; ++i) {
+    memcpy(out, parts.parts[i].data(), parts.parts[i].size());
+    out += parts.parts[i].size();
+  }
+  return out;
+}
+
+Slice DecodeLengthPrefixed(const char** input) {
+  uint32_t size = 0;
+  // Records are written by IngestBatch::Put, so the varint is always complete.
+  *input = rocksdb::GetVarint32Ptr(*input, *input + 5, &size);
+  Slice result(*input, size);
+  *input += size;
+  return result;
+}
+
+Slice RecordKey(const char* record) {
+  return DecodeLengthPrefixed(&record);
+}
+
+std::pair<Slice, Slice> DecodeRecord(const char* record) {
+  auto key = DecodeLengthPrefixed(&record);
+  return std::make_pair(key, DecodeLengthPrefixed(&record));
+}
+
+} // namespace
+
+IngestBatch::IngestBatch() = default;
+
+IngestBatch::~IngestBatch() = default;
+
+void IngestBatch::Put(const SliceParts& key, const SliceParts& value) {
+  const auto key_size = TotalSize(key);
+  const auto value_size = TotalSize(value);
+  const auto record_size = rocksdb::VarintLength(key_size) + key_size +
+                           rocksdb::VarintLength(value_size) + value_size;
+  auto* record = static_cast<char*>(CHECK_NOTNULL(arena_.AllocateBytes(record_size)));
+  auto* end = AppendLengthPrefixed(key, key_size, record);
+  end = AppendLengthPrefixed(value, value_size, end);
+  DCHECK_EQ(end, record + record_size);
+  records_.push_back(record);
+  data_size_ += key_size + value_size;
+}
+
+void IngestBatch::AppendTo(rocksdb::WriteBatch* write_batch) const {
+  for (const auto* record : records_) {
+    auto key_value = DecodeRecord(record);
+    write_batch->Put(key_value.first, key_value.second);
+  }
+}
+
+Status IngestBatch::Ingest(
+    const std::string& sst_path, const rocksdb::UserFrontiers& frontiers, rocksdb::DB* db) {
+  if (records_.empty()) {
+    return Status::OK();
+  }
+
+  // AddFile refuses to add a file while snapshots are held, so don't even sort records.
+  uint64_t num_snapshots = 0;
+  if (db->GetIntProperty(rocksdb::DB::Properties::kNumSnapshots, &num_snapshots) &&
+      num_snapshots != 0) {
+    return STATUS(NotSupported, "Cannot add a file while holding snapshots");
+  }
+
+  auto options = db->GetOptions();
+  const auto* comparator = options.comparator;
+  std::sort(records_.begin(), records_.end(), [comparator](const char* lhs, const char* rhs) {
+    return comparator->Compare(RecordKey(lhs), RecordKey(rhs)) < 0;
+  });
+
+  // Check for overlap before building the file, since on a live DB the key range of the batch
+  // usually overlaps with existing data. AddFile performs the authoritative check, this one only
+  // avoids writing a file that would be rejected anyway.
+  {
+    rocksdb::ReadOptions read_options;
+    read_options.total_order_seek = true;
+    std::unique_ptr<rocksdb::Iterator> iter(db->NewIterator(read_options));
+    iter->Seek(RecordKey(records_.front()));
+    RETURN_NOT_OK(iter->status());
+    if (iter->Valid() && comparator->Compare(iter->key(), RecordKey(records_.back())) <= 0) {
+      return STATUS(NotSupported, "Cannot add overlapping range");
+    }
+  }
+
+  bool ingested = false;
+  auto se = ScopeExit([&options, &sst_path, &ingested] {
+    if (ingested) {
+      return;
+    }
+    // Files could be absent, depending on the stage where we failed.
+    for (const auto& path : {sst_path, rocksdb::TableBaseToDataFileName(sst_path)}) {
+      if (options.env->FileExists(path).ok()) {
+        options.env->CleanupFile(path);
+      }
+    }
+  });
+
+  rocksdb::SstFileWriter writer(
+      rocksdb::EnvOptions(), rocksdb::ImmutableCFOptions(options), comparator,
+      options.boundary_extractor.get());
+  RETURN_NOT_OK(writer.Open(sst_path));
+  writer.SetFrontiers(frontiers);
+  for (const auto* record : records_) {
+    auto key_value = DecodeRecord(record);
+    RETURN_NOT_OK(writer.Add(key_value.first, key_value.second));
+  }
+  rocksdb::ExternalSstFileInfo file_info;
+  RETURN_NOT_OK(writer.Finish(&file_info));
+
+  RETURN_NOT_OK(db->AddFile(&file_info, true /* move_file */));
+  ingested = true;
+  return Status::OK();
+}
+
 void ForceRocksDBCompact(rocksdb::DB* db) {
   auto status = db->CompactRange(
       rocksdb::CompactRangeOptions(), /* begin = */ nullptr, /* end = */ nullptr);
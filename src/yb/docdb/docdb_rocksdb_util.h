@@ -25,10 +25,12 @@
 
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/db.h"
+#include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 
 #include "yb/tablet/tablet_options.h"
 
+#include "yb/util/memory/arena.h"
 #include "yb/util/slice.h"
 
 namespace yb {
@@ -105,6 +107,48 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
 // Request RocksDB compaction and wait until it completes.
 void ForceRocksDBCompact(rocksdb::DB* db);
 
+// Collects put records of a large write, for instance records produced by applying intents of a
+// transaction, so they could be added to the DB as a single SST file instead of being written
+// through the memtable. Records are produced out of key order, so each of them is stored once in
+// an arena and only pointers to them are sorted.
+class IngestBatch {
+ public:
+  IngestBatch();
+  ~IngestBatch();
+
+  void Put(const SliceParts& key, const SliceParts& value);
+
+  void Put(const Slice& key, const Slice& value) {
+    Put(SliceParts(&key, 1), SliceParts(&value, 1));
+  }
+
+  bool empty() const {
+    return records_.empty();
+  }
+
+  // Total size of keys and values of collected records.
+  size_t data_size() const {
+    return data_size_;
+  }
+
+  // Appends collected records to write_batch, used when they could not be ingested.
+  void AppendTo(rocksdb::WriteBatch* write_batch) const;
+
+  // Writes collected records sorted by key to a new SST file at sst_path and adds this file to the
+  // DB. User values of the file are filled by the boundary extractor of the DB and its frontiers
+  // are set to the specified ones, as for a file written by flush.
+  // Fails with NotSupported without writing the file when the DB holds snapshots or the key range
+  // of the batch overlaps with existing keys. The file is removed in case of failure.
+  CHECKED_STATUS Ingest(
+      const std::string& sst_path, const rocksdb::UserFrontiers& frontiers, rocksdb::DB* db);
+
+ private:
+  Arena arena_;
+  // Each record is encoded as length prefixed key followed by length prefixed value.
+  std::vector<const char*> records_;
+  size_t data_size_ = 0;
+};
+
 // Initialize the RocksDB 'options'.
 // The 'statistics' object provided by the caller will be used by RocksDB to maintain the stats for
 // the tablet.
@@ -113,6 +157,12 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Sets whether writers joined to the same RocksDB write group insert to memtable concurrently.
+// Memtable with concurrent inserts could not erase single deleted records in memory, so it should
+// not be used for intents DB. InitRocksDBOptions disables concurrent writes.
+void SetMemTableConcurrentWrites(
+    rocksdb::ConcurrentWrites concurrent_writes, rocksdb::Options* options);
+
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
 
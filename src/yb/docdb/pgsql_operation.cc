@@ -294,8 +294,7 @@ Status PgsqlWriteOperation::ApplyDelete(const DocOperationApplyData& data) {
 }
 
 Status PgsqlWriteOperation::ApplyTruncateColocated(const DocOperationApplyData& data) {
-  RETURN_NOT_OK(data.doc_write_batch->DeleteSubDoc(DocPath(
-      encoded_doc_key_.as_slice()), data.read_time, data.deadline));
+  RETURN_NOT_OK(data.doc_write_batch->DeleteTable(schema_, data.read_time, data.deadline));
   response_->set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
   return Status::OK();
 }
@@ -557,8 +556,11 @@ Result<size_t> PgsqlReadOperation::ExecuteBatch(const common::YQLStorageIf& ql_s
                                          &table_iter_));
     row.Clear();
 
-    SCHECK(VERIFY_RESULT(table_iter_->HasNext()), Corruption,
-           "Given ybctid is not associated with any row in table");
+    if (!VERIFY_RESULT(table_iter_->HasNext())) {
+      SCHECK(request_.skip_missing_batch_arguments(), Corruption,
+             "Given ybctid is not associated with any row in table");
+      continue;
+    }
     RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
 
     // Populate result set.
@@ -639,6 +641,18 @@ Status PgsqlReadOperation::PopulateAggregate(const QLTableRow& table_row,
 }
 
 Status PgsqlReadOperation::GetIntents(const Schema& schema, KeyValueWriteBatchPB* out) {
+  if (!request_.batch_arguments().empty()) {
+    // Lock each row of the batch instead of the whole hash key of the first one.
+    for (const auto& batch_argument : request_.batch_arguments()) {
+      DocKey doc_key(schema);
+      RETURN_NOT_OK(doc_key.DecodeFrom(batch_argument.ybctid().value().binary_value()));
+      auto pair = out->mutable_read_pairs()->Add();
+      pair->set_key(doc_key.Encode().data());
+      pair->set_value(std::string(1, ValueTypeAsChar::kNullLow));
+    }
+    return Status::OK();
+  }
+
   auto pair = out->mutable_read_pairs()->Add();
 
   if (request_.partition_column_values().empty()) {
@@ -110,6 +110,8 @@ string PrimitiveValue::ToString() const {
       return "SSforward";
     case ValueType::kSSReverse:
       return "SSreverse";
+    case ValueType::kSSRankIndex:
+      return "SSrankindex";
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending:
       return "false";
@@ -253,6 +255,7 @@ void PrimitiveValue::AppendToKey(KeyBytes* key_bytes) const {
     case ValueType::kCounter: return;
     case ValueType::kSSForward: return;
     case ValueType::kSSReverse: return;
+    case ValueType::kSSRankIndex: return;
     case ValueType::kFalse: return;
     case ValueType::kTrue: return;
     case ValueType::kFalseDescending: return;
@@ -426,6 +429,7 @@ string PrimitiveValue::ToValue() const {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSRankIndex: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
@@ -602,6 +606,7 @@ Status PrimitiveValue::DecodeKey(rocksdb::Slice* slice, PrimitiveValue* out) {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSRankIndex: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
@@ -969,6 +974,7 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSRankIndex: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
@@ -1307,6 +1313,7 @@ bool PrimitiveValue::operator==(const PrimitiveValue& other) const {
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSRankIndex: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kTrueDescending: FALLTHROUGH_INTENDED;
     case ValueType::kLowest: FALLTHROUGH_INTENDED;
@@ -1385,6 +1392,7 @@ int PrimitiveValue::CompareTo(const PrimitiveValue& other) const {
     case ValueType::kCounter: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSRankIndex: FALLTHROUGH_INTENDED;
     case ValueType::kFalse: FALLTHROUGH_INTENDED;
     case ValueType::kTrue: FALLTHROUGH_INTENDED;
     case ValueType::kFalseDescending: FALLTHROUGH_INTENDED;
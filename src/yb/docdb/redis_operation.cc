@@ -20,6 +20,9 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/subdocument.h"
 
+#include "yb/gutil/endian.h"
+
+#include "yb/util/kv_util.h"
 #include "yb/util/stol_utils.h"
 #include "yb/util/redis_util.h"
 
@@ -30,6 +33,11 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_bool(redis_use_sorted_set_rank_index,
+    true,
+    "Use order-statistic index of sorted set to find start of ZRANGE and ZREVRANGE, instead of "
+    "scanning the set from its first member. The index is maintained regardless of this flag.");
+
 namespace yb {
 namespace docdb {
 
@@ -484,6 +492,149 @@ void GetNormalizedBounds(int64 low_idx, int64 high_idx, int64 card, bool reverse
   }
 }
 
+// Sorted set keeps order-statistic index next to its forward and reverse mappings, so rank based
+// queries could seek close to the requested rank instead of counting members from the start.
+// The index consists of two levels of counted buckets. Bucket of a score is the prefix of its order
+// preserving encoding, so members of one bucket are adjacent in the forward mapping:
+//   kSSRankIndex -> { kRankIndexTopLevel -> { bucket -> count },
+//                     kRankIndexBottomLevel -> { bucket -> count } }
+// Each top level bucket covers 2^(kRankIndexBottomLevelBits - kRankIndexTopLevelBits) bottom
+// level buckets.
+constexpr int64_t kRankIndexTopLevel = 1;
+constexpr int64_t kRankIndexBottomLevel = 2;
+constexpr int kRankIndexTopLevelBits = 12;
+constexpr int kRankIndexBottomLevelBits = 24;
+
+// Maps (level, bucket) to change of number of members in this bucket.
+typedef std::map<std::pair<int64_t, int64_t>, int64_t> RankIndexDeltas;
+
+uint64_t EncodedScore(double score) {
+  std::string encoded;
+  util::AppendDoubleToKey(score, &encoded);
+  return BigEndian::Load64(encoded.data());
+}
+
+void AddRankIndexDelta(double score, int64_t delta, RankIndexDeltas* deltas) {
+  const auto encoded = EncodedScore(score);
+  const auto top_bucket = static_cast<int64_t>(encoded >> (64 - kRankIndexTopLevelBits));
+  const auto bottom_bucket = static_cast<int64_t>(encoded >> (64 - kRankIndexBottomLevelBits));
+  (*deltas)[{kRankIndexTopLevel, top_bucket}] += delta;
+  (*deltas)[{kRankIndexBottomLevel, bottom_bucket}] += delta;
+}
+
+KeyBytes RankIndexLevelKey(const RedisKeyValuePB& kv, int64_t level) {
+  auto result = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  PrimitiveValue(ValueType::kSSRankIndex).AppendToKey(&result);
+  PrimitiveValue(level).AppendToKey(&result);
+  return result;
+}
+
+// Builds subdocument that updates rank index of sorted set with specified deltas.
+CHECKED_STATUS UpdateRankIndex(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, const RankIndexDeltas& deltas,
+    SubDocument* index) {
+  for (const auto& delta : deltas) {
+    if (delta.second == 0) {
+      continue;
+    }
+    auto encoded_key = RankIndexLevelKey(kv, delta.first.first);
+    PrimitiveValue(delta.first.second).AppendToKey(&encoded_key);
+    SubDocument subdoc_count;
+    bool subdoc_count_found = false;
+    GetSubDocumentData data = { encoded_key, &subdoc_count, &subdoc_count_found };
+    RETURN_NOT_OK(GetSubDocument(iterator, data, /* projection */ nullptr,
+                                 SeekFwdSuffices::kFalse));
+    const int64_t count = (subdoc_count_found ? subdoc_count.GetInt64() : 0) + delta.second;
+    SubDocument* level = index->GetOrAddChild(PrimitiveValue(delta.first.first)).first;
+    level->SetChild(PrimitiveValue(delta.first.second),
+                    count == 0 ? SubDocument(ValueType::kTombstone)
+                               : SubDocument(PrimitiveValue(count)));
+  }
+  return Status::OK();
+}
+
+// Finds bucket of rank index level that contains member with specified rank. Rank is relative to
+// the first bucket of the level and is updated to be relative to the found bucket.
+// Returns -1 if level does not contain enough members or contains invalid counts.
+int64_t FindRankIndexBucket(const SubDocument& level, int64_t* rank, int64_t* total) {
+  *total = 0;
+  int64_t result = -1;
+  for (const auto& bucket : level.object_container()) {
+    if (bucket.first.value_type() != ValueType::kInt64 ||
+        bucket.second.value_type() != ValueType::kInt64 || bucket.second.GetInt64() <= 0) {
+      return -1;
+    }
+    const int64_t count = bucket.second.GetInt64();
+    if (result < 0 && *rank < *total + count) {
+      result = bucket.first.GetInt64();
+      *rank -= *total;
+    }
+    *total += count;
+  }
+  return result;
+}
+
+// Uses rank index of sorted set to find key in the forward mapping, such that member with
+// specified rank is located after it. start_rank is filled with rank of the first member after
+// this key.
+// Returns false when index could not be used, e.g. set was created before the index was
+// introduced and index does not cover all its members.
+Result<bool> FindRankIndexStart(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, int64_t card, int64_t rank,
+    const KeyBytes& forward_key, KeyBytes* start_key, int64_t* start_rank) {
+  SubDocument top_level;
+  bool top_level_found = false;
+  auto top_level_key = RankIndexLevelKey(kv, kRankIndexTopLevel);
+  GetSubDocumentData top_level_data = { top_level_key, &top_level, &top_level_found };
+  RETURN_NOT_OK(GetSubDocument(iterator, top_level_data, /* projection */ nullptr,
+                               SeekFwdSuffices::kFalse));
+  if (!top_level_found || !IsObjectType(top_level.value_type())) {
+    return false;
+  }
+  int64_t total = 0;
+  int64_t rank_in_bucket = rank;
+  const int64_t top_bucket = FindRankIndexBucket(top_level, &rank_in_bucket, &total);
+  if (total != card || top_bucket < 0) {
+    return false;
+  }
+
+  constexpr int kBucketShift = kRankIndexBottomLevelBits - kRankIndexTopLevelBits;
+  auto bottom_level_key = RankIndexLevelKey(kv, kRankIndexBottomLevel);
+  KeyBytes low_bucket_key = bottom_level_key;
+  PrimitiveValue(top_bucket << kBucketShift).AppendToKey(&low_bucket_key);
+  KeyBytes high_bucket_key = bottom_level_key;
+  PrimitiveValue((top_bucket + 1) << kBucketShift).AppendToKey(&high_bucket_key);
+  SliceKeyBound low_subkey(low_bucket_key, BoundType::kInclusiveLower);
+  SliceKeyBound high_subkey(high_bucket_key, BoundType::kExclusiveUpper);
+
+  SubDocument bottom_level;
+  bool bottom_level_found = false;
+  GetSubDocumentData bottom_level_data = { bottom_level_key, &bottom_level, &bottom_level_found };
+  bottom_level_data.low_subkey = &low_subkey;
+  bottom_level_data.high_subkey = &high_subkey;
+  RETURN_NOT_OK(GetSubDocument(iterator, bottom_level_data, /* projection */ nullptr,
+                               SeekFwdSuffices::kFalse));
+  if (!bottom_level_found || !IsObjectType(bottom_level.value_type())) {
+    return false;
+  }
+  const int64_t top_bucket_rank = rank - rank_in_bucket;
+  const int64_t top_bucket_count = top_level.GetChild(PrimitiveValue(top_bucket))->GetInt64();
+  const int64_t bottom_bucket = FindRankIndexBucket(bottom_level, &rank_in_bucket, &total);
+  if (total != top_bucket_count || bottom_bucket < 0) {
+    return false;
+  }
+
+  *start_key = forward_key;
+  start_key->AppendValueType(ValueType::kDouble);
+  start_key->AppendUInt64(
+      static_cast<uint64_t>(bottom_bucket) << (64 - kRankIndexBottomLevelBits));
+  *start_rank = rank - rank_in_bucket;
+  VLOG(3) << "Rank " << rank << " found in top level bucket " << top_bucket << " starting at "
+          << top_bucket_rank << ", bottom level bucket " << bottom_bucket << " starting at "
+          << *start_rank;
+  return true;
+}
+
 } // anonymous namespace
 
 void RedisWriteOperation::InitializeIterator(const DocOperationApplyData& data) {
@@ -607,10 +758,12 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
         SubDocument kv_entries_card;
         SubDocument kv_entries_forward;
         SubDocument kv_entries_reverse;
+        SubDocument kv_entries_rank_index;
 
         // The top level mapping.
         SubDocument kv_entries;
 
+        RankIndexDeltas rank_index_deltas;
         int new_elements_added = 0;
         int return_value = 0;
         for (int i = 0; i < kv.subkey_size(); i++) {
@@ -684,6 +837,7 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
                                               SubDocument(ValueType::kTombstone));
             kv_entries_forward.SetChild(PrimitiveValue::Double(score_to_remove),
                                         SubDocument(subdoc_forward_tombstone));
+            AddRankIndexDelta(score_to_remove, -1, &rank_index_deltas);
           }
 
           if (should_add_entry) {
@@ -702,6 +856,10 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
             // Add the reverse mapping to the entries.
             kv_entries_reverse.SetChild(PrimitiveValue(kv.value(i)),
                                         SubDocument(PrimitiveValue::Double(score_to_add)));
+
+            if (!subdoc_reverse_found || should_remove_existing_entry) {
+              AddRankIndexDelta(score_to_add, 1, &rank_index_deltas);
+            }
           }
         }
 
@@ -722,6 +880,13 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
                               SubDocument(kv_entries_reverse));
         }
 
+        RETURN_NOT_OK(UpdateRankIndex(
+            iterator_.get(), kv, rank_index_deltas, &kv_entries_rank_index));
+        if (kv_entries_rank_index.object_num_keys() > 0) {
+          kv_entries.SetChild(PrimitiveValue(ValueType::kSSRankIndex),
+                              SubDocument(kv_entries_rank_index));
+        }
+
         if (kv_entries.object_num_keys() > 0) {
           RETURN_NOT_OK(kv_entries.ConvertToRedisSortedSet());
           if (data_type == REDIS_TYPE_NONE) {
@@ -942,6 +1107,8 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       SubDocument values_card;
       SubDocument values_forward;
       SubDocument values_reverse;
+      SubDocument values_rank_index;
+      RankIndexDeltas rank_index_deltas;
       num_keys = kv.subkey_size();
       for (int i = 0; i < kv.subkey_size(); i++) {
         // Check whether the value is already in the document.
@@ -970,6 +1137,7 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
                                SubDocument(ValueType::kTombstone));
           values_forward.SetChild(PrimitiveValue::Double(doc_reverse.GetDouble()),
                           SubDocument(doc_forward));
+          AddRankIndexDelta(doc_reverse.GetDouble(), -1, &rank_index_deltas);
         } else {
           // If the key is absent, it doesn't contribute to the count of keys being deleted.
           num_keys--;
@@ -982,6 +1150,10 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       values.SetChild(PrimitiveValue(ValueType::kCounter), SubDocument(values_card));
       values.SetChild(PrimitiveValue(ValueType::kSSForward), SubDocument(values_forward));
       values.SetChild(PrimitiveValue(ValueType::kSSReverse), SubDocument(values_reverse));
+      RETURN_NOT_OK(UpdateRankIndex(iterator_.get(), kv, rank_index_deltas, &values_rank_index));
+      if (values_rank_index.object_num_keys() > 0) {
+        values.SetChild(PrimitiveValue(ValueType::kSSRankIndex), SubDocument(values_rank_index));
+      }
 
       break;
     }
@@ -1555,6 +1727,20 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
 
       bool add_keys = request_.get_collection_range_request().with_scores();
 
+      // Skip members before the bucket containing the lower bound, so indexes are counted from the
+      // start of this bucket.
+      KeyBytes start_key;
+      SliceKeyBound low_subkey;
+      int64_t start_rank = 0;
+      if (FLAGS_redis_use_sorted_set_rank_index &&
+          VERIFY_RESULT(FindRankIndexStart(
+              iterator_.get(), request_.key_value(), card, low_idx_normalized, encoded_doc_key,
+              &start_key, &start_rank))) {
+        low_subkey = SliceKeyBound(start_key, BoundType::kInclusiveLower);
+        low_idx_normalized -= start_rank;
+        high_idx_normalized -= start_rank;
+      }
+
       IndexBound low_bound = IndexBound(low_idx_normalized, true /* is_lower */);
       IndexBound high_bound = IndexBound(high_idx_normalized, false /* is_lower */);
 
@@ -1562,6 +1748,7 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
       bool doc_found = false;
       GetSubDocumentData data = { encoded_doc_key, &doc, &doc_found};
       data.deadline_info = deadline_info_.get_ptr();
+      data.low_subkey = &low_subkey;
       data.low_index = &low_bound;
       data.high_index = &high_bound;
 
@@ -47,7 +47,8 @@ SubDocument::~SubDocument() {
     case ValueType::kRedisSet: FALLTHROUGH_INTENDED;
     case ValueType::kRedisTS: FALLTHROUGH_INTENDED;
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
-    case ValueType::kSSReverse:
+    case ValueType::kSSReverse: FALLTHROUGH_INTENDED;
+    case ValueType::kSSRankIndex:
       if (has_valid_container()) {
         delete &object_container();
       }
@@ -70,6 +70,8 @@ namespace docdb {
     ((kSSReverse, '\'')) /* ASCII code 39 */ \
     ((kRedisSet, '(')) /* ASCII code 40 */ \
     ((kRedisList, ')')) /* ASCII code 41*/ \
+    /* Order-statistic index of sorted set: number of members per score bucket. */ \
+    ((kSSRankIndex, '*')) /* ASCII code 42 */ \
     /* This is the redis timeseries type. */ \
     ((kRedisTS, '+')) /* ASCII code 43 */ \
     ((kRedisSortedSet, ',')) /* ASCII code 44 */ \
@@ -204,7 +206,7 @@ constexpr inline bool IsObjectType(const ValueType value_type) {
   return value_type == ValueType::kRedisTS || value_type == ValueType::kObject ||
       value_type == ValueType::kRedisSet || value_type == ValueType::kRedisSortedSet ||
       value_type == ValueType::kSSForward || value_type == ValueType::kSSReverse ||
-      value_type == ValueType::kRedisList;
+      value_type == ValueType::kSSRankIndex || value_type == ValueType::kRedisList;
 }
 
 constexpr inline bool IsCollectionType(const ValueType value_type) {
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "yb/util/slice.h"
+#include "yb/util/strongly_typed_bool.h"
 #include "yb/rocksdb/metadata.h"
 
 namespace rocksdb {
@@ -49,6 +50,8 @@ struct CompactionFilterContext {
 
 YB_DEFINE_ENUM(FilterDecision, (kKeep)(kDiscard));
 
+YB_STRONGLY_TYPED_BOOL(ForDeletion);
+
 class CompactionFilter {
  public:
   // Context information of a compaction run
@@ -155,6 +158,30 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Called by compaction picker with largest boundary values of all files of the column family,
+  // ordered from newest to oldest. Returns indexes of files that contain only records the
+  // compaction filter would discard, so they could be deleted without being read. Deleting the
+  // returned files must not make any record of the remaining files visible again.
+  //
+  // Compaction checks call it with ForDeletion::kFalse under the DB mutex, so in this case it
+  // should be cheap and must not have side effects. With ForDeletion::kTrue the returned files are
+  // deleted right away, so the factory should fix the state they were checked against, as it does
+  // for compaction filters it creates.
+  virtual std::vector<size_t> ExpiredFiles(
+      const std::vector<const FileBoundaryValuesBase*>& largest_values,
+      ForDeletion for_deletion) {
+    return std::vector<size_t>();
+  }
+
+  // Called with the same arguments as ExpiredFiles, once per version of the column family.
+  // Returns the earliest time, in microseconds since epoch, when any of the files could become
+  // expired. Compaction picker does not call ExpiredFiles before this time, so it could avoid
+  // checking files on each compaction check.
+  virtual uint64_t EarliestExpirationTime(
+      const std::vector<const FileBoundaryValuesBase*>& largest_values) {
+    return 0;
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
@@ -255,6 +255,17 @@ class DB {
   // Note: consider setting options.sync = true.
   virtual Status Write(const WriteOptions& options, WriteBatch* updates) = 0;
 
+  // Apply the specified updates directly to the memtable, without writing WAL.
+  // Intended for updates that were already made durable and ordered by the caller, for instance
+  // replicated through Raft, and that are usually written by a single thread. Writes are still
+  // serialized with concurrent Write calls. Batches are grouped only when other writers are
+  // already waiting.
+  virtual Status DirectWrite(WriteBatch* updates) {
+    WriteOptions options;
+    options.disableWAL = true;
+    return Write(options, updates);
+  }
+
   // If the database contains an entry for "key" store the
   // corresponding value in *value and return OK.
   //
@@ -863,7 +874,8 @@ class DB {
     return AddFile(DefaultColumnFamily(), file_path, move_file);
   }
 
-  // Load table file with information "file_info" into "column_family"
+  // Load table file with information "file_info" into "column_family".
+  // User values and frontiers of "file_info" are stored in the metadata of the added file.
   virtual Status AddFile(ColumnFamilyHandle* column_family,
                          const ExternalSstFileInfo* file_info,
                          bool move_file = false) = 0;
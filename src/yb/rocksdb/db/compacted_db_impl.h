@@ -71,6 +71,9 @@ class CompactedDBImpl : public DBImpl {
                        WriteBatch* updates) override {
     return STATUS(NotSupported, "Not supported in compacted db mode.");
   }
+  virtual Status DirectWrite(WriteBatch* updates) override {
+    return STATUS(NotSupported, "Not supported in compacted db mode.");
+  }
   using DBImpl::CompactRange;
   virtual Status CompactRange(const CompactRangeOptions& options,
                               ColumnFamilyHandle* column_family,
@@ -35,6 +35,7 @@
 
 #include <gflags/gflags.h>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/column_family.h"
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/util/log_buffer.h"
@@ -1145,10 +1146,104 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 }
 
 #ifndef ROCKSDB_LITE
+namespace {
+
+std::vector<const FileBoundaryValuesBase*> LargestValues(const std::vector<FileMetaData*>& files) {
+  std::vector<const FileBoundaryValuesBase*> result;
+  result.reserve(files.size());
+  for (const auto* file : files) {
+    result.push_back(&file->largest);
+  }
+  return result;
+}
+
+}  // namespace
+
+const std::vector<FileMetaData*>* CompactionPicker::ExpirationCandidates(
+    const VersionStorageInfo* vstorage) const {
+  if (ioptions_.compaction_filter_factory == nullptr) {
+    return nullptr;
+  }
+  // Factory should see all files of the column family, so only level 0 setups are supported.
+  for (int level = 1; level < vstorage->num_levels(); ++level) {
+    if (vstorage->NumLevelFiles(level) != 0) {
+      return nullptr;
+    }
+  }
+  const int kLevel0 = 0;
+  const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(kLevel0);
+  return level_files.empty() ? nullptr : &level_files;
+}
+
+bool CompactionPicker::MayHaveExpiredFiles(const VersionStorageInfo* vstorage) const {
+  if (!vstorage->earliest_expiration_time()) {
+    const auto* level_files = ExpirationCandidates(vstorage);
+    vstorage->set_earliest_expiration_time(
+        level_files ? ioptions_.compaction_filter_factory->EarliestExpirationTime(
+                          LargestValues(*level_files))
+                    : std::numeric_limits<uint64_t>::max());
+  }
+  return ioptions_.env->NowMicros() >= *vstorage->earliest_expiration_time();
+}
+
+std::vector<FileMetaData*> CompactionPicker::ExpiredFiles(
+    const VersionStorageInfo* vstorage, ForDeletion for_deletion) const {
+  std::vector<FileMetaData*> result;
+  const auto* level_files = ExpirationCandidates(vstorage);
+  if (level_files == nullptr) {
+    return result;
+  }
+  auto* factory = ioptions_.compaction_filter_factory;
+  for (auto index : factory->ExpiredFiles(LargestValues(*level_files), for_deletion)) {
+    DCHECK_LT(index, level_files->size());
+    auto* file = (*level_files)[index];
+    if (!file->being_compacted) {
+      result.push_back(file);
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<Compaction> CompactionPicker::PickExpiredFilesCompaction(
+    const std::string& cf_name,
+    const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer) {
+  // Cheap checks go first, so the factory is asked to prepare files for deletion only when there
+  // is something to delete.
+  if (!MayHaveExpiredFiles(vstorage) || ExpiredFiles(vstorage, ForDeletion::kFalse).empty()) {
+    return nullptr;
+  }
+  auto expired_files = ExpiredFiles(vstorage, ForDeletion::kTrue);
+  if (expired_files.empty()) {
+    return nullptr;
+  }
+
+  std::vector<CompactionInputFiles> inputs;
+  inputs.emplace_back();
+  inputs[0].level = 0;
+  for (auto* f : expired_files) {
+    char tmp_fsize[16];
+    AppendHumanBytes(f->fd.GetTotalFileSize(), tmp_fsize, sizeof(tmp_fsize));
+    LOG_TO_BUFFER(log_buffer, "[%s] Picking expired file %" PRIu64 " with size %s for deletion",
+                  cf_name.c_str(), f->fd.GetNumber(), tmp_fsize);
+  }
+  inputs[0].files = std::move(expired_files);
+  auto c = std::make_unique<Compaction>(
+      vstorage, mutable_cf_options, std::move(inputs), 0 /* output_level */,
+      0 /* target_file_size */, 0 /* max_grandparent_overlap_bytes */, 0 /* output_path_id */,
+      kNoCompression, std::vector<FileMetaData*>(), /* is manual */ false,
+      vstorage->CompactionScore(0),
+      /* is deletion compaction */ true, CompactionReason::kExpiredFiles);
+  level0_compactions_in_progress_.insert(c.get());
+  return c;
+}
+
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  return vstorage->CompactionScore(kLevel0) >= 1 ||
+         (MayHaveExpiredFiles(vstorage) && !ExpiredFiles(vstorage, ForDeletion::kFalse).empty());
 }
 
 struct UniversalCompactionPicker::SortedRun {
@@ -1353,6 +1448,14 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  // Dropping expired files is cheap and reduces amount of data the regular compaction would
+  // have to rewrite, so it goes first.
+  auto expired_files_compaction = PickExpiredFilesCompaction(
+      cf_name, mutable_cf_options, vstorage, log_buffer);
+  if (expired_files_compaction) {
+    return expired_files_compaction;
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
@@ -1846,13 +1949,23 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
 bool FIFOCompactionPicker::NeedsCompaction(const VersionStorageInfo* vstorage)
     const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  return vstorage->CompactionScore(kLevel0) >= 1 ||
+         (MayHaveExpiredFiles(vstorage) && !ExpiredFiles(vstorage, ForDeletion::kFalse).empty());
 }
 
 std::unique_ptr<Compaction> FIFOCompactionPicker::PickCompaction(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage, LogBuffer* log_buffer) {
   assert(vstorage->num_levels() == 1);
+  // Expired files are deleted regardless of total size, so FIFO compaction with unlimited
+  // max_table_files_size could be used to purge data expired by TTL.
+  if (level0_compactions_in_progress_.empty()) {
+    auto c = PickExpiredFilesCompaction(cf_name, mutable_cf_options, vstorage, log_buffer);
+    if (c) {
+      return c;
+    }
+  }
+
   const int kLevel0 = 0;
   const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(kLevel0);
   uint64_t total_size = 0;
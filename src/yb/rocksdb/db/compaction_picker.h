@@ -32,6 +32,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/env.h"
@@ -186,6 +187,28 @@ class CompactionPicker {
                        const CompactionInputFiles& output_level_inputs,
                        std::vector<FileMetaData*>* grandparents);
 
+#ifndef ROCKSDB_LITE
+  // Returns level 0 files, whose boundary values are passed to compaction filter factory to check
+  // expiration. Returns nullptr if there are no such files, or files at other levels.
+  const std::vector<FileMetaData*>* ExpirationCandidates(const VersionStorageInfo* vstorage) const;
+
+  // Returns false if no file of the version could be expired yet. The earliest expiration time is
+  // computed once per version, so this check does not look at files and does not call factory.
+  bool MayHaveExpiredFiles(const VersionStorageInfo* vstorage) const;
+
+  // Returns level 0 files that compaction filter factory reported as expired, i.e. files that
+  // could be deleted without being read. Files that are being compacted are not returned.
+  std::vector<FileMetaData*> ExpiredFiles(
+      const VersionStorageInfo* vstorage, ForDeletion for_deletion) const;
+
+  // Returns deletion compaction of expired level 0 files, or nullptr if there are no such files.
+  std::unique_ptr<Compaction> PickExpiredFilesCompaction(
+      const std::string& cf_name,
+      const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage,
+      LogBuffer* log_buffer);
+#endif  // ROCKSDB_LITE
+
   const ImmutableCFOptions& ioptions_;
 
   // A helper function to SanitizeCompactionInputFiles() that
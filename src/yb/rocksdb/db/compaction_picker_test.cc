@@ -24,6 +24,7 @@
 #include <string>
 #include <utility>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/util/logging.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/testharness.h"
@@ -38,6 +39,55 @@ class CountingLogger : public Logger {
   size_t log_count;
 };
 
+// Reports files with largest sequence number not greater than specified one as expired.
+class SeqNoExpirationFilterFactory : public CompactionFilterFactory {
+ public:
+  explicit SeqNoExpirationFilterFactory(SequenceNumber max_expired_seqno)
+      : max_expired_seqno_(max_expired_seqno) {}
+
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override {
+    return nullptr;
+  }
+
+  std::vector<size_t> ExpiredFiles(
+      const std::vector<const FileBoundaryValuesBase*>& largest_values,
+      ForDeletion for_deletion) override {
+    ++num_calls_;
+    if (for_deletion) {
+      ++num_deletion_calls_;
+    }
+    std::vector<size_t> result;
+    for (size_t i = 0; i != largest_values.size(); ++i) {
+      if (largest_values[i]->seqno <= max_expired_seqno_) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  uint64_t EarliestExpirationTime(
+      const std::vector<const FileBoundaryValuesBase*>& largest_values) override {
+    ++num_earliest_expiration_calls_;
+    return earliest_expiration_time_;
+  }
+
+  const char* Name() const override { return "SeqNoExpirationFilterFactory"; }
+
+  void set_earliest_expiration_time(uint64_t value) { earliest_expiration_time_ = value; }
+
+  size_t num_calls() const { return num_calls_; }
+  size_t num_deletion_calls() const { return num_deletion_calls_; }
+  size_t num_earliest_expiration_calls() const { return num_earliest_expiration_calls_; }
+
+ private:
+  SequenceNumber max_expired_seqno_;
+  uint64_t earliest_expiration_time_ = 0;
+  size_t num_calls_ = 0;
+  size_t num_deletion_calls_ = 0;
+  size_t num_earliest_expiration_calls_ = 0;
+};
+
 class CompactionPickerTest : public testing::Test {
  public:
   const Comparator* ucmp_;
@@ -504,6 +554,103 @@ TEST_F(CompactionPickerTest, NeedsCompactionFIFO) {
               vstorage_->CompactionScore(0) >= 1);
   }
 }
+
+TEST_F(CompactionPickerTest, ExpiredFilesUniversal) {
+  const uint64_t kFileSize = 100000;
+
+  SeqNoExpirationFilterFactory filter_factory(450);
+  ioptions_.compaction_filter_factory = &filter_factory;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 401, 450);
+  Add(0, 3U, "260", "300", kFileSize, 0, 260, 300);
+  UpdateVersionStorageInfo();
+
+  // Number of files is below compaction trigger, but expired files should be deleted anyway.
+  ASSERT_LT(vstorage_->CompactionScore(0), 1);
+  ASSERT_TRUE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  // Checks should not ask the factory to prepare files for deletion.
+  ASSERT_EQ(0U, filter_factory.num_deletion_calls());
+
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction != nullptr);
+  ASSERT_TRUE(compaction->deletion_compaction());
+  ASSERT_EQ(CompactionReason::kExpiredFiles, compaction->compaction_reason());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(2U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(3U, compaction->input(0, 1)->fd.GetNumber());
+  ASSERT_EQ(1U, filter_factory.num_deletion_calls());
+
+  // Files that are already being deleted should not be picked again.
+  ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  ASSERT_EQ(1U, filter_factory.num_deletion_calls());
+}
+
+TEST_F(CompactionPickerTest, ExpiredFilesFIFO) {
+  const uint64_t kFileSize = 100000;
+
+  fifo_options_.max_table_files_size = std::numeric_limits<uint64_t>::max();
+  ioptions_.compaction_options_fifo = fifo_options_;
+  SeqNoExpirationFilterFactory filter_factory(300);
+  ioptions_.compaction_filter_factory = &filter_factory;
+  FIFOCompactionPicker fifo_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleFIFO);
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 401, 450);
+  UpdateVersionStorageInfo();
+  // Total size is within limits and nothing is expired.
+  ASSERT_FALSE(fifo_compaction_picker.NeedsCompaction(vstorage_.get()));
+
+  NewVersionStorage(1, kCompactionStyleFIFO);
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 401, 450);
+  Add(0, 3U, "260", "300", kFileSize, 0, 260, 300);
+  UpdateVersionStorageInfo();
+  ASSERT_TRUE(fifo_compaction_picker.NeedsCompaction(vstorage_.get()));
+
+  std::unique_ptr<Compaction> compaction(
+      fifo_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction != nullptr);
+  ASSERT_TRUE(compaction->deletion_compaction());
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(3U, compaction->input(0, 0)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, ExpiredFilesNotCheckedBeforeEarliestExpiration) {
+  const uint64_t kFileSize = 100000;
+
+  SeqNoExpirationFilterFactory filter_factory(450);
+  filter_factory.set_earliest_expiration_time(std::numeric_limits<uint64_t>::max());
+  ioptions_.compaction_filter_factory = &filter_factory;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 401, 450);
+  UpdateVersionStorageInfo();
+
+  // Earliest expiration time is computed once per version, and files are not checked before it.
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  }
+  ASSERT_EQ(1U, filter_factory.num_earliest_expiration_calls());
+  ASSERT_EQ(0U, filter_factory.num_calls());
+
+  filter_factory.set_earliest_expiration_time(0);
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 401, 450);
+  UpdateVersionStorageInfo();
+  ASSERT_TRUE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  ASSERT_EQ(2U, filter_factory.num_earliest_expiration_calls());
+  ASSERT_EQ(1U, filter_factory.num_calls());
+}
 #endif  // ROCKSDB_LITE
 
 TEST_F(CompactionPickerTest, CompactionPriMinOverlapping1) {
@@ -56,6 +56,7 @@
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/priority_thread_pool.h"
+#include "yb/util/span_tracer.h"
 
 #include "yb/rocksdb/db/auto_roll_logger.h"
 #include "yb/rocksdb/db/builder.h"
@@ -3495,8 +3496,8 @@ Result<FileNumbersHolder> DBImpl::BackgroundCompaction(
     // file if there is alive snapshot pointing to it
     assert(c->num_input_files(1) == 0);
     assert(c->level() == 0);
-    assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+    assert(c->column_family_data()->ioptions()->compaction_style == kCompactionStyleFIFO ||
+           c->compaction_reason() == CompactionReason::kExpiredFiles);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
@@ -3887,6 +3888,7 @@ std::unique_ptr<SuperVersion> DBImpl::InstallSuperVersionAndScheduleWork(
 Status DBImpl::GetImpl(const ReadOptions& read_options,
                        ColumnFamilyHandle* column_family, const Slice& key,
                        std::string* value, bool* value_found) {
+  SCOPED_SPAN("rocksdb.get");
   StopWatch sw(env_, stats_, DB_GET);
   PERF_TIMER_GUARD(get_snapshot_time);
 
@@ -4222,6 +4224,8 @@ Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
     return STATUS(InvalidArgument,
         "Non zero sequence numbers are not supported");
   }
+  meta.UpdateBoundariesExceptKey(file_info->smallest, UpdateBoundariesType::kSmallest);
+  meta.UpdateBoundariesExceptKey(file_info->largest, UpdateBoundariesType::kLargest);
 
   std::string db_base_fname;
   std::string db_data_fname;
@@ -4791,6 +4795,7 @@ Status DBImpl::WriteWithCallback(const WriteOptions& write_options,
 
 Status DBImpl::WriteImpl(const WriteOptions& write_options,
                          WriteBatch* my_batch, WriteCallback* callback) {
+  SCOPED_SPAN("rocksdb.write");
 
   if (my_batch == nullptr) {
     return STATUS(Corruption, "Batch is nullptr!");
@@ -4826,40 +4831,19 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
   StopWatch write_sw(env_, db_options_.statistics.get(), DB_WRITE);
 
   write_thread_.JoinBatchGroup(&w);
-  if (w.state == WriteThread::STATE_PARALLEL_FOLLOWER) {
-    // we are a non-leader in a parallel group
-    PERF_TIMER_GUARD(write_memtable_time);
-
-    if (!w.CallbackFailed()) {
-      ColumnFamilyMemTablesImpl column_family_memtables(
-          versions_->GetColumnFamilySet());
-      WriteBatchInternal::SetSequence(w.batch, w.sequence);
-      InsertFlags insert_flags{InsertFlag::kConcurrentMemtableWrites};
-      w.status = WriteBatchInternal::InsertInto(
-          w.batch, &column_family_memtables, &flush_scheduler_,
-          write_options.ignore_missing_column_families, 0 /*log_number*/, this, insert_flags);
-    }
-
-    if (write_thread_.CompleteParallelWorker(&w)) {
-      // we're responsible for early exit
-      auto last_sequence = w.parallel_group->last_sequence;
-      SetTickerCount(stats_, SEQUENCE_NUMBER, last_sequence);
-      versions_->SetLastSequence(last_sequence);
-      write_thread_.EarlyExitParallelGroup(&w);
-    }
-    assert(w.state == WriteThread::STATE_COMPLETED);
-    // STATE_COMPLETED conditional below handles exit
-
-    status = w.FinalStatus();
-  }
-  if (w.state == WriteThread::STATE_COMPLETED) {
-    // write is complete and leader has updated sequence
-    RecordTick(stats_, WRITE_DONE_BY_OTHER);
-    return w.FinalStatus();
+  if (w.state != WriteThread::STATE_GROUP_LEADER) {
+    return CompleteFollowerWrite(write_options.ignore_missing_column_families, &w);
   }
-  // else we are the leader of the write batch group
-  assert(w.state == WriteThread::STATE_GROUP_LEADER);
 
+  PERF_TIMER_STOP(write_pre_and_post_process_time);
+  return WriteAsBatchGroupLeader(write_options, &w);
+}
+
+Status DBImpl::WriteAsBatchGroupLeader(const WriteOptions& write_options,
+                                       WriteThread::Writer* leader) {
+  PERF_TIMER_GUARD(write_pre_and_post_process_time);
+  auto& w = *leader;
+  Status status;
   WriteContext context;
   mutex_.Lock();
 
@@ -4877,75 +4861,7 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
   assert(!single_column_family_mode_ ||
          versions_->GetColumnFamilySet()->NumberOfColumnFamilies() == 1);
 
-  uint64_t max_total_wal_size = (db_options_.max_total_wal_size == 0)
-                                    ? 4 * max_total_in_memory_state_
-                                    : db_options_.max_total_wal_size;
-  if (UNLIKELY(!single_column_family_mode_ &&
-               alive_log_files_.begin()->getting_flushed == false &&
-               total_log_size() > max_total_wal_size)) {
-    uint64_t flush_column_family_if_log_file = alive_log_files_.begin()->number;
-    alive_log_files_.begin()->getting_flushed = true;
-    RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
-        "Flushing all column families with data in WAL number %" PRIu64
-        ". Total log size is %" PRIu64 " while max_total_wal_size is %" PRIu64,
-        flush_column_family_if_log_file, total_log_size(), max_total_wal_size);
-    // no need to refcount because drop is happening in write thread, so can't
-    // happen while we're in the write thread
-    for (auto cfd : *versions_->GetColumnFamilySet()) {
-      if (cfd->IsDropped()) {
-        continue;
-      }
-      if (cfd->GetLogNumber() <= flush_column_family_if_log_file) {
-        status = SwitchMemtable(cfd, &context);
-        if (!status.ok()) {
-          break;
-        }
-        cfd->imm()->FlushRequested();
-        SchedulePendingFlush(cfd);
-      }
-    }
-    MaybeScheduleFlushOrCompaction();
-  } else if (UNLIKELY(write_buffer_.ShouldFlush())) {
-    RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
-        "Flushing column family with largest mem table size. Write buffer is "
-        "using %" PRIu64 " bytes out of a total of %" PRIu64 ".",
-        write_buffer_.memory_usage(), write_buffer_.buffer_size());
-    // no need to refcount because drop is happening in write thread, so can't
-    // happen while we're in the write thread
-    ColumnFamilyData* largest_cfd = nullptr;
-    size_t largest_cfd_size = 0;
-
-    for (auto cfd : *versions_->GetColumnFamilySet()) {
-      if (cfd->IsDropped()) {
-        continue;
-      }
-      if (!cfd->mem()->IsEmpty()) {
-        // We only consider active mem table, hoping immutable memtable is
-        // already in the process of flushing.
-        size_t cfd_size = cfd->mem()->ApproximateMemoryUsage();
-        if (largest_cfd == nullptr || cfd_size > largest_cfd_size) {
-          largest_cfd = cfd;
-          largest_cfd_size = cfd_size;
-        }
-      }
-    }
-    if (largest_cfd != nullptr) {
-      status = SwitchMemtable(largest_cfd, &context);
-      if (status.ok()) {
-        largest_cfd->imm()->FlushRequested();
-        SchedulePendingFlush(largest_cfd);
-        MaybeScheduleFlushOrCompaction();
-      }
-    }
-  }
-
-  if (UNLIKELY(status.ok() && !bg_error_.ok())) {
-    status = bg_error_;
-  }
-
-  if (UNLIKELY(status.ok() && !flush_scheduler_.Empty())) {
-    status = ScheduleFlushes(&context);
-  }
+  status = PreprocessWrite(&context);
 
   if (UNLIKELY(status.ok() && (write_controller_.IsStopped() ||
                                write_controller_.NeedsDelay()))) {
@@ -4999,11 +4915,12 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     // 4. Merges are not okay
     // 5. YugaByte-specific user-specified sequence numbers are currently not compatible with
     //    parallel memtable writes.
+    // 6. Single deletes are not okay, since in-memory erase (MemTable::Erase) is not thread safe.
     //
     // Rules 1..3 are enforced by checking the options
     // during startup (CheckConcurrentWritesSupported), so if
     // options.allow_concurrent_memtable_write is true then they can be
-    // assumed to be true.  Rule 4 is checked for each batch.  We could
+    // assumed to be true.  Rules 4 and 6 are checked for each batch.  We could
     // relax rules 2 and 3 if we could prevent write batches from referring
     // more than once to a particular key.
     bool parallel =
@@ -5015,7 +4932,7 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         total_count += WriteBatchInternal::Count(writer->batch);
         total_byte_size = WriteBatchInternal::AppendedByteSize(
             total_byte_size, WriteBatchInternal::ByteSize(writer->batch));
-        parallel = parallel && !writer->batch->HasMerge();
+        parallel = parallel && !writer->batch->HasMerge() && !writer->batch->HasSingleDelete();
       }
     }
 
@@ -5220,6 +5137,218 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
   return status;
 }
 
+Status DBImpl::DirectWrite(WriteBatch* batch) {
+  SCOPED_SPAN("rocksdb.direct_write");
+
+  if (batch == nullptr) {
+    return STATUS(Corruption, "Batch is nullptr!");
+  }
+
+  PERF_TIMER_GUARD(write_pre_and_post_process_time);
+  WriteThread::Writer w;
+  w.batch = batch;
+  w.sync = false;
+  w.disableWAL = true;
+  w.in_batch_group = false;
+
+  StopWatch write_sw(env_, db_options_.statistics.get(), DB_WRITE);
+
+  // Usually there is no other writer, so we become a leader right away. Otherwise our batch could
+  // be picked up by the group of a concurrent Write call.
+  write_thread_.JoinBatchGroup(&w);
+  if (w.state != WriteThread::STATE_GROUP_LEADER) {
+    return CompleteFollowerWrite(false /* ignore_missing_column_families */, &w);
+  }
+
+  // When other writers are already waiting, lead a regular batch group, so their batches could be
+  // inserted into the memtable in parallel with ours when allow_concurrent_memtable_write is set.
+  if (write_thread_.HasPendingWriters(&w)) {
+    PERF_TIMER_STOP(write_pre_and_post_process_time);
+    WriteOptions write_options;
+    write_options.disableWAL = true;
+    return WriteAsBatchGroupLeader(write_options, &w);
+  }
+
+  const size_t byte_size = WriteBatchInternal::ByteSize(batch);
+  WriteContext context;
+  Status status;
+  {
+    InstrumentedMutexLock l(&mutex_);
+
+    RecordTick(stats_, WRITE_DONE_BY_SELF);
+    default_cf_internal_stats_->AddDBStats(InternalDBStatsType::WRITE_DONE_BY_SELF, 1);
+
+    status = PreprocessWrite(&context);
+
+    if (UNLIKELY(status.ok() && (write_controller_.IsStopped() ||
+                                 write_controller_.NeedsDelay()))) {
+      PERF_TIMER_STOP(write_pre_and_post_process_time);
+      PERF_TIMER_GUARD(write_delay_time);
+      status = DelayWrite(byte_size);
+      PERF_TIMER_START(write_pre_and_post_process_time);
+    }
+  }
+
+  // Unlike WriteImpl we don't form a batch group and don't write WAL, so the batch is inserted
+  // into the memtable right away, while the rest of writers wait for us in the write thread.
+  if (status.ok()) {
+    last_batch_group_size_ = byte_size;
+    const auto count = WriteBatchInternal::Count(batch);
+    const SequenceNumber last_sequence = versions_->LastSequence() + count;
+
+    RecordTick(stats_, NUMBER_KEYS_WRITTEN, count);
+    RecordTick(stats_, BYTES_WRITTEN, byte_size);
+    MeasureTime(stats_, BYTES_PER_WRITE, byte_size);
+    PERF_TIMER_STOP(write_pre_and_post_process_time);
+
+    has_unpersisted_data_ = true;
+
+    {
+      PERF_TIMER_GUARD(write_memtable_time);
+
+      auto stats = default_cf_internal_stats_;
+      stats->AddDBStats(InternalDBStatsType::BYTES_WRITTEN, byte_size);
+      stats->AddDBStats(InternalDBStatsType::NUMBER_KEYS_WRITTEN, count);
+
+      WriteBatchInternal::SetSequence(batch, versions_->LastSequence() + 1);
+      InsertFlags insert_flags{InsertFlag::kFilterDeletes};
+      status = WriteBatchInternal::InsertInto(
+          batch, column_family_memtables_.get(), &flush_scheduler_,
+          false /* ignore_missing_column_families */, 0 /* log_number */, this, insert_flags);
+    }
+
+    if (status.ok()) {
+      SetTickerCount(stats_, SEQUENCE_NUMBER, last_sequence);
+      versions_->SetLastSequence(last_sequence);
+    } else {
+      // Memtable diverged from the state implied by the caller, see WriteImpl.
+      InstrumentedMutexLock l(&mutex_);
+      if (bg_error_.ok()) {
+        bg_error_ = status;
+      }
+    }
+    PERF_TIMER_START(write_pre_and_post_process_time);
+  }
+
+  if (db_options_.paranoid_checks && !status.ok() && !status.IsBusy()) {
+    InstrumentedMutexLock l(&mutex_);
+    if (bg_error_.ok()) {
+      bg_error_ = status;  // stop compaction & fail any further writes
+    }
+  }
+
+  write_thread_.ExitAsBatchGroupLeader(&w, &w, status);
+
+  return status;
+}
+
+Status DBImpl::CompleteFollowerWrite(bool ignore_missing_column_families,
+                                     WriteThread::Writer* w) {
+  if (w->state == WriteThread::STATE_PARALLEL_FOLLOWER) {
+    // we are a non-leader in a parallel group
+    PERF_TIMER_GUARD(write_memtable_time);
+
+    if (!w->CallbackFailed()) {
+      ColumnFamilyMemTablesImpl column_family_memtables(
+          versions_->GetColumnFamilySet());
+      WriteBatchInternal::SetSequence(w->batch, w->sequence);
+      InsertFlags insert_flags{InsertFlag::kConcurrentMemtableWrites};
+      w->status = WriteBatchInternal::InsertInto(
+          w->batch, &column_family_memtables, &flush_scheduler_,
+          ignore_missing_column_families, 0 /*log_number*/, this, insert_flags);
+    }
+
+    if (write_thread_.CompleteParallelWorker(w)) {
+      // we're responsible for early exit
+      auto last_sequence = w->parallel_group->last_sequence;
+      SetTickerCount(stats_, SEQUENCE_NUMBER, last_sequence);
+      versions_->SetLastSequence(last_sequence);
+      write_thread_.EarlyExitParallelGroup(w);
+    }
+  }
+  // write is complete and leader has updated sequence
+  assert(w->state == WriteThread::STATE_COMPLETED);
+  RecordTick(stats_, WRITE_DONE_BY_OTHER);
+  return w->FinalStatus();
+}
+
+// REQUIRES: mutex_ is held
+// REQUIRES: this thread is currently at the front of the writer queue
+Status DBImpl::PreprocessWrite(WriteContext* context) {
+  Status status;
+  uint64_t max_total_wal_size = (db_options_.max_total_wal_size == 0)
+                                    ? 4 * max_total_in_memory_state_
+                                    : db_options_.max_total_wal_size;
+  if (UNLIKELY(!single_column_family_mode_ &&
+               alive_log_files_.begin()->getting_flushed == false &&
+               total_log_size() > max_total_wal_size)) {
+    uint64_t flush_column_family_if_log_file = alive_log_files_.begin()->number;
+    alive_log_files_.begin()->getting_flushed = true;
+    RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
+        "Flushing all column families with data in WAL number %" PRIu64
+        ". Total log size is %" PRIu64 " while max_total_wal_size is %" PRIu64,
+        flush_column_family_if_log_file, total_log_size(), max_total_wal_size);
+    // no need to refcount because drop is happening in write thread, so can't
+    // happen while we're in the write thread
+    for (auto cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped()) {
+        continue;
+      }
+      if (cfd->GetLogNumber() <= flush_column_family_if_log_file) {
+        status = SwitchMemtable(cfd, context);
+        if (!status.ok()) {
+          break;
+        }
+        cfd->imm()->FlushRequested();
+        SchedulePendingFlush(cfd);
+      }
+    }
+    MaybeScheduleFlushOrCompaction();
+  } else if (UNLIKELY(write_buffer_.ShouldFlush())) {
+    RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
+        "Flushing column family with largest mem table size. Write buffer is "
+        "using %" PRIu64 " bytes out of a total of %" PRIu64 ".",
+        write_buffer_.memory_usage(), write_buffer_.buffer_size());
+    // no need to refcount because drop is happening in write thread, so can't
+    // happen while we're in the write thread
+    ColumnFamilyData* largest_cfd = nullptr;
+    size_t largest_cfd_size = 0;
+
+    for (auto cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped()) {
+        continue;
+      }
+      if (!cfd->mem()->IsEmpty()) {
+        // We only consider active mem table, hoping immutable memtable is
+        // already in the process of flushing.
+        size_t cfd_size = cfd->mem()->ApproximateMemoryUsage();
+        if (largest_cfd == nullptr || cfd_size > largest_cfd_size) {
+          largest_cfd = cfd;
+          largest_cfd_size = cfd_size;
+        }
+      }
+    }
+    if (largest_cfd != nullptr) {
+      status = SwitchMemtable(largest_cfd, context);
+      if (status.ok()) {
+        largest_cfd->imm()->FlushRequested();
+        SchedulePendingFlush(largest_cfd);
+        MaybeScheduleFlushOrCompaction();
+      }
+    }
+  }
+
+  if (UNLIKELY(status.ok() && !bg_error_.ok())) {
+    status = bg_error_;
+  }
+
+  if (UNLIKELY(status.ok() && !flush_scheduler_.Empty())) {
+    status = ScheduleFlushes(context);
+  }
+
+  return status;
+}
+
 // REQUIRES: mutex_ is held
 // REQUIRES: this thread is currently at the front of the writer queue
 Status DBImpl::DelayWrite(uint64_t num_bytes) {
@@ -101,6 +101,8 @@ class DBImpl : public DB {
   virtual Status Write(const WriteOptions& options,
                        WriteBatch* updates) override;
 
+  virtual Status DirectWrite(WriteBatch* updates) override;
+
   using DB::Get;
   virtual Status Get(const ReadOptions& options,
                      ColumnFamilyHandle* column_family, const Slice& key,
@@ -584,6 +586,17 @@ class DBImpl : public DB {
   //            `num_bytes` going through.
   Status DelayWrite(uint64_t num_bytes);
 
+  // Forms batch group led by the specified writer and writes it, see WriteImpl.
+  Status WriteAsBatchGroupLeader(const WriteOptions& write_options, WriteThread::Writer* leader);
+
+  // Completes write of the writer that was not chosen as a leader of its batch group.
+  Status CompleteFollowerWrite(bool ignore_missing_column_families, WriteThread::Writer* w);
+
+  // Switches memtables and schedules flushes required before the next write.
+  // REQUIRES: mutex_ is held
+  // REQUIRES: this thread is currently at the front of the writer queue
+  Status PreprocessWrite(WriteContext* context);
+
   Status ScheduleFlushes(WriteContext* context);
 
   Status SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context);
@@ -80,6 +80,9 @@ class DBImplReadOnly : public DBImpl {
                        WriteBatch* updates) override {
     return STATUS(NotSupported, "Not supported operation in read only mode.");
   }
+  virtual Status DirectWrite(WriteBatch* updates) override {
+    return STATUS(NotSupported, "Not supported operation in read only mode.");
+  }
   using DBImpl::CompactRange;
   virtual Status CompactRange(const CompactRangeOptions& options,
                               ColumnFamilyHandle* column_family,
@@ -5322,6 +5322,135 @@ TEST_F(DBTest, ConcurrentMemtableNotSupported) {
   ASSERT_NOK(db_->CreateColumnFamily(cf_options, "name", &handle));
 }
 
+// Memtable should track frontiers of all batches inserted concurrently by a write group.
+TEST_F(DBTest, ConcurrentMemtableWritesWithFrontiers) {
+  constexpr int kNumThreads = 8;
+  constexpr int kBatchesPerThread = 200;
+  constexpr int kKeysPerBatch = 10;
+
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.enable_write_thread_adaptive_yield = true;
+  options.memtable_factory.reset(new SkipListFactory);
+  options.create_if_missing = true;
+  DestroyAndReopen(options);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([this, t] {
+      WriteOptions write_options;
+      write_options.disableWAL = true;
+      for (int i = 0; i != kBatchesPerThread; ++i) {
+        const uint64_t op = t * kBatchesPerThread + i + 1;
+        test::TestUserFrontiers frontiers(op, op);
+        WriteBatch batch;
+        batch.SetFrontiers(&frontiers);
+        for (int k = 0; k != kKeysPerBatch; ++k) {
+          batch.Put(yb::Format("key_$0_$1", op, k), yb::ToString(op));
+        }
+        ASSERT_OK(db_->Write(write_options, &batch));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const uint64_t kNumOps = kNumThreads * kBatchesPerThread;
+  auto smallest = dbfull()->GetMutableMemTableFrontier(UpdateUserValueType::kSmallest);
+  ASSERT_TRUE(smallest);
+  ASSERT_EQ(1U, down_cast<test::TestUserFrontier&>(*smallest).Value());
+  auto largest = dbfull()->GetMutableMemTableFrontier(UpdateUserValueType::kLargest);
+  ASSERT_TRUE(largest);
+  ASSERT_EQ(kNumOps, down_cast<test::TestUserFrontier&>(*largest).Value());
+
+  for (uint64_t op = 1; op <= kNumOps; op += kNumOps / 10) {
+    ASSERT_EQ(yb::ToString(op), Get(yb::Format("key_$0_$1", op, kKeysPerBatch - 1)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(kNumOps, down_cast<test::TestUserFrontier&>(*dbfull()->GetFlushedFrontier()).Value());
+}
+
+// Direct writes should be serialized with regular writes and advance the sequence number,
+// including writes that trigger memtable switches.
+TEST_F(DBTest, DirectWriteWithConcurrentWrites) {
+  constexpr int kBatches = 1000;
+  constexpr int kKeysPerBatch = 10;
+
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.memtable_factory.reset(new SkipListFactory);
+  options.write_buffer_size = 64 << 10;
+  options.create_if_missing = true;
+  DestroyAndReopen(options);
+
+  std::thread regular_writer([this] {
+    WriteOptions write_options;
+    write_options.disableWAL = true;
+    for (int i = 0; i != kBatches; ++i) {
+      WriteBatch batch;
+      for (int k = 0; k != kKeysPerBatch; ++k) {
+        batch.Put(yb::Format("regular_$0_$1", i, k), yb::ToString(i));
+      }
+      ASSERT_OK(db_->Write(write_options, &batch));
+    }
+  });
+
+  for (int i = 0; i != kBatches; ++i) {
+    WriteBatch batch;
+    for (int k = 0; k != kKeysPerBatch; ++k) {
+      batch.Put(yb::Format("direct_$0_$1", i, k), yb::ToString(i));
+    }
+    ASSERT_OK(db_->DirectWrite(&batch));
+  }
+  regular_writer.join();
+
+  ASSERT_EQ(2U * kBatches * kKeysPerBatch, db_->GetLatestSequenceNumber());
+  for (int i = 0; i != kBatches; i += kBatches / 10) {
+    ASSERT_EQ(yb::ToString(i), Get(yb::Format("direct_$0_$1", i, kKeysPerBatch - 1)));
+    ASSERT_EQ(yb::ToString(i), Get(yb::Format("regular_$0_$1", i, kKeysPerBatch - 1)));
+  }
+}
+
+// Direct writes that wait for each other should be grouped and inserted into the memtable
+// concurrently.
+TEST_F(DBTest, ConcurrentDirectWrites) {
+  constexpr int kThreads = 4;
+  constexpr int kBatches = 1000;
+  constexpr int kKeysPerBatch = 10;
+
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.memtable_factory.reset(new SkipListFactory);
+  options.statistics = rocksdb::CreateDBStatistics();
+  options.create_if_missing = true;
+  DestroyAndReopen(options);
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t != kThreads; ++t) {
+    writers.emplace_back([this, t] {
+      for (int i = 0; i != kBatches; ++i) {
+        WriteBatch batch;
+        for (int k = 0; k != kKeysPerBatch; ++k) {
+          batch.Put(yb::Format("key_$0_$1_$2", t, i, k), yb::ToString(i));
+        }
+        ASSERT_OK(db_->DirectWrite(&batch));
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+
+  ASSERT_GT(TestGetTickerCount(options, WRITE_DONE_BY_OTHER), 0);
+  ASSERT_EQ(1U * kThreads * kBatches * kKeysPerBatch, db_->GetLatestSequenceNumber());
+  for (int t = 0; t != kThreads; ++t) {
+    for (int i = 0; i != kBatches; i += kBatches / 10) {
+      ASSERT_EQ(yb::ToString(i), Get(yb::Format("key_$0_$1_$2", t, i, kKeysPerBatch - 1)));
+    }
+  }
+}
+
 #endif  // ROCKSDB_LITE
 
 TEST_F(DBTest, SanitizeNumThreads) {
@@ -38,6 +38,7 @@
 #include <vector>
 
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/internal_stats.h"
 #include "yb/rocksdb/db/table_cache.h"
 #include "yb/rocksdb/db/version_set.h"
@@ -345,6 +346,28 @@ class VersionBuilder::Rep {
     }
   }
 
+  void RelocateMissingFiles(Env* env, const std::vector<DbPath>& db_paths) {
+    for (int level = 0; level < base_vstorage_->num_levels(); level++) {
+      for (auto& file_meta_pair : levels_[level].added_files) {
+        auto& fd = file_meta_pair.second->fd;
+        const uint64_t number = fd.GetNumber();
+        if (env->FileExists(TableFileName(db_paths, number, fd.GetPathId())).ok()) {
+          continue;
+        }
+        for (uint32_t path_id = 0; path_id < db_paths.size(); path_id++) {
+          if (path_id != fd.GetPathId() &&
+              env->FileExists(MakeTableFileName(db_paths[path_id].path, number)).ok()) {
+            RLOG(InfoLogLevel::INFO_LEVEL, info_log_,
+                "Table file %" PRIu64 " of path %" PRIu32 " found in %s",
+                number, fd.GetPathId(), db_paths[path_id].path.c_str());
+            fd.packed_number_and_path_id = PackFileNumberAndPathId(number, path_id);
+            break;
+          }
+        }
+      }
+    }
+  }
+
   void MaybeAddFile(VersionStorageInfo* vstorage, int level, FileMetaData* f) {
     if (levels_[level].deleted_files.count(f->fd.GetNumber()) > 0) {
       // f is to-be-delected table file
@@ -376,6 +399,9 @@ void VersionBuilder::LoadTableHandlers(InternalStats* internal_stats,
                                        int max_threads) {
   rep_->LoadTableHandlers(internal_stats, max_threads);
 }
+void VersionBuilder::RelocateMissingFiles(Env* env, const std::vector<DbPath>& db_paths) {
+  rep_->RelocateMissingFiles(env, db_paths);
+}
 void VersionBuilder::MaybeAddFile(VersionStorageInfo* vstorage, int level,
                                   FileMetaData* f) {
   rep_->MaybeAddFile(vstorage, level, f);
@@ -35,6 +35,7 @@ class VersionStorageInfo;
 class VersionEdit;
 struct FileMetaData;
 class InternalStats;
+struct DbPath;
 
 // A helper class so we can efficiently apply a whole sequence
 // of edits to a particular state without creating intermediate
@@ -50,6 +51,10 @@ class VersionBuilder {
   void Apply(VersionEdit* edit);
   void SaveTo(VersionStorageInfo* vstorage);
   void LoadTableHandlers(InternalStats* internal_stats, int max_threads = 1);
+  // Table files could be moved to another db path than the one recorded in the MANIFEST, for
+  // instance when DB is restored from a checkpoint that keeps all files in a single directory.
+  // Updates path ids of added files, that are missing in their own path, to their actual path.
+  void RelocateMissingFiles(Env* env, const std::vector<DbPath>& db_paths);
   void MaybeAddFile(VersionStorageInfo* vstorage, int level, FileMetaData* f);
 
  private:
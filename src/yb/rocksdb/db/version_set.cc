@@ -2781,6 +2781,10 @@ Status VersionSet::Recover(
       assert(builders_iter != builders.end());
       auto* builder = builders_iter->second->version_builder();
 
+      if (db_options_->db_paths.size() > 1) {
+        builder->RelocateMissingFiles(env_, db_options_->db_paths);
+      }
+
       if (db_options_->max_open_files == -1) {
         // unlimited table cache. Pre-load table handle now.
         // Need to do it out of the mutex.
@@ -46,6 +46,8 @@
 #include <utility>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/db/version_builder.h"
 #include "yb/rocksdb/db/version_edit.h"
@@ -171,6 +173,14 @@ class VersionStorageInfo {
   // Return idx'th highest score
   double CompactionScore(int idx) const { return compaction_score_[idx]; }
 
+  // Earliest time, in microseconds, when some file of this version could become expired, see
+  // CompactionFilterFactory::EarliestExpirationTime. Not set if it was not computed yet.
+  // Computed by compaction picker on first use, protected by DB mutex.
+  const boost::optional<uint64_t>& earliest_expiration_time() const {
+    return earliest_expiration_time_;
+  }
+  void set_earliest_expiration_time(uint64_t value) const { earliest_expiration_time_ = value; }
+
   void GetOverlappingInputs(
       int level,
       const InternalKey* begin,   // nullptr means before all keys
@@ -404,6 +414,7 @@ class VersionStorageInfo {
   // These are used to pick the best compaction level
   std::vector<double> compaction_score_;
   std::vector<int> compaction_level_;
+  mutable boost::optional<uint64_t> earliest_expiration_time_;
   int l0_delay_trigger_count_ = 0;  // Count used to trigger slow down and stop
                                     // for number of L0 files.
 
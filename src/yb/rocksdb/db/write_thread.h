@@ -218,6 +218,14 @@ class WriteThread {
       Writer* leader, Writer** last_writer,
       autovector<WriteThread::Writer*>* write_batch_group);
 
+  // Returns true if other writers joined after the leader, so EnterAsBatchGroupLeader could
+  // add them to the group.
+  //
+  // Writer* leader:         Writer that is STATE_GROUP_LEADER
+  bool HasPendingWriters(Writer* leader) const {
+    return newest_writer_.load(std::memory_order_acquire) != leader;
+  }
+
   // Causes JoinBatchGroup to return STATE_PARALLEL_FOLLOWER for all of the
   // non-leader members of this write batch group.  Sets Writer::sequence
   // before waking them up.
@@ -74,6 +74,8 @@ enum class CompactionReason {
   kManualCompaction,
   // DB::SuggestCompactRange() marked files for compaction
   kFilesMarkedForCompaction,
+  // Compaction filter factory reported files that contain only expired data
+  kExpiredFiles,
 };
 
 #ifndef ROCKSDB_LITE
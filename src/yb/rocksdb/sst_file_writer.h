@@ -24,10 +24,12 @@
 #include <string>
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/immutable_options.h"
+#include "yb/rocksdb/metadata.h"
 #include "yb/rocksdb/types.h"
 
 namespace rocksdb {
 
+class BoundaryValuesExtractor;
 class Comparator;
 
 // Table Properties that are specific to tables created by SstFileWriter.
@@ -65,18 +67,27 @@ struct ExternalSstFileInfo {
   bool is_split_sst;               // is SST split into metadata and data file(s)
   uint64_t num_entries;            // number of entries in file
   int32_t version;                 // file version
+  // User values and frontiers of the file, they are stored in the file metadata by AddFile.
+  FileBoundaryValuesBase smallest;
+  FileBoundaryValuesBase largest;
 };
 
 // SstFileWriter is used to create sst files that can be added to database later
 // All keys in files generated by SstFileWriter will have sequence number = 0
 class SstFileWriter {
  public:
+  // When boundary_extractor is specified, it is used to fill user values of the file, the same
+  // way as for files written by flush and compaction.
   SstFileWriter(const EnvOptions& env_options,
                 const ImmutableCFOptions& ioptions,
-                const Comparator* user_comparator);
+                const Comparator* user_comparator,
+                BoundaryValuesExtractor* boundary_extractor = nullptr);
 
   ~SstFileWriter();
 
+  // Sets frontiers of the file, that are returned in ExternalSstFileInfo by Finish.
+  void SetFrontiers(const UserFrontiers& frontiers);
+
   // Prepare SstFileWriter to write into file located at "file_path".
   Status Open(const std::string& file_path);
 
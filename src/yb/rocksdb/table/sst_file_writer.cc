@@ -23,6 +23,7 @@
 #include <vector>
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/db/filename.h"
+#include "yb/rocksdb/db/table_properties_collector.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/block_based_table_builder.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
@@ -88,10 +89,11 @@ class SstFileWriter::SstFileWriterPropertiesCollectorFactory
 
 struct SstFileWriter::Rep {
   Rep(const EnvOptions& _env_options, const ImmutableCFOptions& _ioptions,
-      const Comparator* _user_comparator)
+      const Comparator* _user_comparator, BoundaryValuesExtractor* _boundary_extractor)
       : env_options(_env_options),
         ioptions(_ioptions),
-        internal_comparator(std::make_shared<InternalKeyComparator>(_user_comparator)) {}
+        internal_comparator(std::make_shared<InternalKeyComparator>(_user_comparator)),
+        boundary_extractor(_boundary_extractor) {}
 
   std::unique_ptr<WritableFileWriter> base_file_writer;
   std::unique_ptr<WritableFileWriter> data_file_writer;
@@ -99,16 +101,23 @@ struct SstFileWriter::Rep {
   EnvOptions env_options;
   ImmutableCFOptions ioptions;
   InternalKeyComparatorPtr internal_comparator;
+  BoundaryValuesExtractor* boundary_extractor;
   ExternalSstFileInfo file_info;
 };
 
 SstFileWriter::SstFileWriter(const EnvOptions& env_options,
                              const ImmutableCFOptions& ioptions,
-                             const Comparator* user_comparator)
-    : rep_(new Rep(env_options, ioptions, user_comparator)) {}
+                             const Comparator* user_comparator,
+                             BoundaryValuesExtractor* boundary_extractor)
+    : rep_(new Rep(env_options, ioptions, user_comparator, boundary_extractor)) {}
 
 SstFileWriter::~SstFileWriter() { delete rep_; }
 
+void SstFileWriter::SetFrontiers(const UserFrontiers& frontiers) {
+  rep_->file_info.smallest.user_frontier = frontiers.Smallest().Clone();
+  rep_->file_info.largest.user_frontier = frontiers.Largest().Clone();
+}
+
 Status SstFileWriter::Open(const std::string& file_path) {
   Rep* r = rep_;
   Status s;
@@ -134,6 +143,10 @@ Status SstFileWriter::Open(const std::string& file_path) {
   }
 
   IntTblPropCollectorFactories int_tbl_prop_collector_factories;
+  for (const auto& factory : r->ioptions.table_properties_collector_factories) {
+    int_tbl_prop_collector_factories.emplace_back(
+        new UserKeyTablePropertiesCollectorFactory(factory));
+  }
   int_tbl_prop_collector_factories.emplace_back(
       new SstFileWriterPropertiesCollectorFactory(1 /* version */));
 
@@ -161,6 +174,10 @@ Status SstFileWriter::Open(const std::string& file_path) {
   r->file_info.num_entries = 0;
   r->file_info.sequence_number = 0;
   r->file_info.version = 1;
+  r->file_info.smallest.seqno = 0;
+  r->file_info.smallest.user_values.clear();
+  r->file_info.largest.seqno = 0;
+  r->file_info.largest.user_values.clear();
   return s;
 }
 
@@ -185,6 +202,20 @@ Status SstFileWriter::Add(const Slice& user_key, const Slice& value) {
   r->file_info.largest_key = user_key.ToString();
   r->file_info.file_size = r->builder->TotalFileSize();
 
+  if (r->boundary_extractor) {
+    boost::container::small_vector<UserBoundaryValuePtr, 10> user_values;
+    auto status = r->boundary_extractor->Extract(user_key, value, &user_values);
+    if (!status.ok()) {
+      return status;
+    }
+    for (const auto& user_value : user_values) {
+      UpdateUserValue(
+          &r->file_info.smallest.user_values, user_value, UpdateUserValueType::kSmallest);
+      UpdateUserValue(
+          &r->file_info.largest.user_values, user_value, UpdateUserValueType::kLargest);
+    }
+  }
+
   InternalKey ikey(user_key, 0 /* Sequence Number */,
                    ValueType::kTypeValue /* Put */);
   r->builder->Add(ikey.Encode(), value);
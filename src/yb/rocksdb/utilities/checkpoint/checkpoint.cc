@@ -43,10 +43,25 @@
 namespace rocksdb {
 namespace checkpoint {
 
+namespace {
+
+// Returns directory of the specified table file, since table files could be spread over db_paths.
+std::string TableFileDir(DB* db, const std::string& fname) {
+  for (const auto& db_path : db->GetDBOptions().db_paths) {
+    if (db->GetCheckpointEnv()->FileExists(db_path.path + fname).ok()) {
+      return db_path.path;
+    }
+  }
+  return db->GetName();
+}
+
+} // namespace
+
 // Builds an openable snapshot of RocksDB on the same disk, which
 // accepts an output directory on the same disk, and under the directory
 // (1) hard-linked SST files pointing to existing live SST files
 // SST files will be copied if output directory is on a different filesystem
+// SST files from all db_paths are placed directly to the output directory
 // (2) a copied manifest files and other files
 // The directory should not already exist and will be created by this API.
 // The directory will be an absolute path
@@ -112,19 +127,25 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
+    const std::string src_dir = is_table_file ? TableFileDir(db, src_fname) : db->GetName();
+    bool linked = false;
     if (is_table_file && same_fs) {
       RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
-      s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
+      s = db->GetCheckpointEnv()->LinkFile(src_dir + src_fname,
                                  full_private_path + src_fname);
       if (s.IsNotSupported()) {
-        same_fs = false;
+        // Other db paths could reside on other devices, while files from the db dir still could
+        // be linked.
+        same_fs = src_dir != db->GetName();
         s = Status::OK();
+      } else if (s.ok()) {
+        linked = true;
       }
     }
-    if (!is_table_file || !same_fs) {
+    if (s.ok() && !linked) {
       RLOG(db->GetOptions().info_log, "Copying %s", src_fname.c_str());
       std::string dest_name = full_private_path + src_fname;
-      s = CopyFile(db->GetCheckpointEnv(), db->GetName() + src_fname, dest_name,
+      s = CopyFile(db->GetCheckpointEnv(), src_dir + src_fname, dest_name,
                    type == kDescriptorFile ? manifest_file_size : 0);
     }
   }
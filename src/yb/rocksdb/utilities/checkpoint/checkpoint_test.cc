@@ -28,6 +28,8 @@
 #include <unistd.h>
 #endif
 #include <iostream>
+#include <limits>
+#include <set>
 #include <thread>
 #include <utility>
 #include "yb/rocksdb/db/db_impl.h"
@@ -354,6 +356,53 @@ TEST_F(DBTest, CheckpointCF) {
   ASSERT_OK(DestroyDB(snapshot_name, options));
 }
 
+// Checkpoint of DB with files in multiple paths keeps all files in the checkpoint dir, and DB opened
+// from it should find files recorded in other paths.
+TEST_F(DBTest, CheckpointMultiplePaths) {
+  const std::string snapshot_name = test::TmpDir(env_) + "/snapshot";
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.db_paths.emplace_back(dbname_, std::numeric_limits<uint64_t>::max());
+  options.db_paths.emplace_back(dbname_ + "_2", std::numeric_limits<uint64_t>::max());
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("a", "old_a"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("b", "old_b"));
+  ASSERT_OK(Flush());
+  CompactRangeOptions compact_options;
+  compact_options.target_path_id = 1;
+  ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+  ASSERT_OK(Put("a", "new_a"));
+  ASSERT_OK(Flush());
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(2U, files.size());
+  std::set<std::string> paths;
+  for (const auto& file : files) {
+    paths.insert(file.db_path);
+  }
+  ASSERT_EQ(2U, paths.size());
+
+  ASSERT_OK(checkpoint::CreateCheckpoint(db_, snapshot_name));
+
+  Options snapshot_options = options;
+  snapshot_options.create_if_missing = false;
+  snapshot_options.db_paths[0].path = snapshot_name;
+  snapshot_options.db_paths[1].path = snapshot_name + "_2";
+  DB* snapshot_db = nullptr;
+  ASSERT_OK(DB::Open(snapshot_options, snapshot_name, &snapshot_db));
+  std::string result;
+  ASSERT_OK(snapshot_db->Get(ReadOptions(), "a", &result));
+  ASSERT_EQ("new_a", result);
+  ASSERT_OK(snapshot_db->Get(ReadOptions(), "b", &result));
+  ASSERT_EQ("old_b", result);
+  delete snapshot_db;
+
+  ASSERT_OK(DestroyDB(snapshot_name, snapshot_options));
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -78,16 +78,51 @@ Acceptor::~Acceptor() {
   Shutdown();
 }
 
-Status Acceptor::Listen(const Endpoint& endpoint, Endpoint* bound_endpoint) {
+Result<Socket> CreateListeningSocket(
+    const Endpoint& endpoint, bool reuse_port, Endpoint* bound_endpoint) {
   Socket socket;
   RETURN_NOT_OK(socket.Init(endpoint.address().is_v6() ? Socket::FLAG_IPV6 : 0));
   RETURN_NOT_OK(socket.SetReuseAddr(true));
+  if (reuse_port) {
+    RETURN_NOT_OK(socket.SetReusePort(true));
+  }
   RETURN_NOT_OK(socket.Bind(endpoint));
   if (bound_endpoint) {
     RETURN_NOT_OK(socket.GetSocketAddress(bound_endpoint));
   }
   RETURN_NOT_OK(socket.SetNonBlocking(true));
   RETURN_NOT_OK(socket.Listen(FLAGS_rpc_acceptor_listen_backlog));
+  return std::move(socket);
+}
+
+void AcceptPendingConnections(
+    Socket* socket, Counter* connections_accepted, const NewSocketHandler& handler) {
+  for (;;) {
+    Socket new_sock;
+    Endpoint remote;
+    VLOG(2) << "calling accept() on socket " << socket->GetFd();
+    Status s = socket->Accept(&new_sock, &remote, Socket::FLAG_NONBLOCKING);
+    if (!s.ok()) {
+      if (!Socket::IsTemporarySocketError(s)) {
+        LOG(WARNING) << "Acceptor: accept failed: " << s.ToString();
+      }
+      return;
+    }
+    s = new_sock.SetNoDelay(true);
+    if (!s.ok()) {
+      LOG(WARNING) << "Acceptor with remote = " << remote
+                   << " failed to set TCP_NODELAY on a newly accepted socket: "
+                   << s.ToString();
+      continue;
+    }
+    connections_accepted->Increment();
+    handler(&new_sock, remote);
+  }
+}
+
+Status Acceptor::Listen(const Endpoint& endpoint, Endpoint* bound_endpoint) {
+  auto socket = VERIFY_RESULT(CreateListeningSocket(
+      endpoint, /* reuse_port= */ false, bound_endpoint));
 
   bool was_empty;
   {
@@ -148,27 +183,7 @@ void Acceptor::IoHandler(ev::io& io, int events) {
   }
 
   if (events & EV_READ) {
-    for (;;) {
-      Socket new_sock;
-      Endpoint remote;
-      VLOG(2) << "calling accept() on socket " << socket.GetFd();
-      Status s = socket.Accept(&new_sock, &remote, Socket::FLAG_NONBLOCKING);
-      if (!s.ok()) {
-        if (!Socket::IsTemporarySocketError(s)) {
-          LOG(WARNING) << "Acceptor: accept failed: " << s.ToString();
-        }
-        return;
-      }
-      s = new_sock.SetNoDelay(true);
-      if (!s.ok()) {
-        LOG(WARNING) << "Acceptor with remote = " << remote
-                     << " failed to set TCP_NODELAY on a newly accepted socket: "
-                     << s.ToString();
-        continue;
-      }
-      rpc_connections_accepted_->Increment();
-      handler_(&new_sock, remote);
-    }
+    AcceptPendingConnections(&socket, rpc_connections_accepted_.get(), handler_);
   }
 }
 
@@ -43,6 +43,7 @@
 #include "yb/util/thread.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/net/socket.h"
+#include "yb/util/result.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -55,6 +56,16 @@ namespace rpc {
 // Take ownership of the socket via Socket::Release
 typedef std::function<void(Socket *new_socket, const Endpoint& remote)> NewSocketHandler;
 
+// Creates non-blocking socket listening on endpoint.
+// With reuse_port several sockets could listen on the same endpoint, see Socket::SetReusePort.
+// Return bound address in bound_endpoint.
+Result<Socket> CreateListeningSocket(
+    const Endpoint& endpoint, bool reuse_port, Endpoint* bound_endpoint = nullptr);
+
+// Accepts all pending connections on listening socket and passes them to handler.
+void AcceptPendingConnections(
+    Socket* socket, Counter* connections_accepted, const NewSocketHandler& handler);
+
 // A acceptor that calls accept() to create new connections.
 class Acceptor {
  public:
@@ -0,0 +1,92 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include "yb/rpc/file_region.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "yb/util/errno.h"
+#include "yb/util/format.h"
+#include "yb/util/scope_exit.h"
+
+namespace yb {
+namespace rpc {
+
+Result<std::shared_ptr<ReadOnlyFile>> ReadOnlyFile::Open(const std::string& path) {
+  int fd;
+  do {
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    return STATUS_FORMAT(IOError, "Failed to open $0: $1", path, ErrnoToString(errno));
+  }
+  return std::make_shared<ReadOnlyFile>(fd, path);
+}
+
+ReadOnlyFile::~ReadOnlyFile() {
+  if (::close(fd_) != 0) {
+    PLOG(WARNING) << "Failed to close " << path_;
+  }
+}
+
+Result<RefCntBuffer> FileRegion::Read() const {
+  RefCntBuffer result(size_);
+  size_t read = 0;
+  while (read < size_) {
+    auto res = ::pread(fd(), result.data() + read, size_ - read, offset_ + read);
+    if (res < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return STATUS_FORMAT(IOError, "Failed to read $0: $1", ToString(), ErrnoToString(errno));
+    }
+    if (res == 0) {
+      return STATUS_FORMAT(IOError, "Unexpected end of file while reading $0", ToString());
+    }
+    read += res;
+  }
+  return result;
+}
+
+Status FileRegion::VisitMapped(const std::function<void(Slice)>& visitor) const {
+  if (empty()) {
+    visitor(Slice());
+    return Status::OK();
+  }
+  static const uint64_t kPageSize = sysconf(_SC_PAGESIZE);
+  auto map_offset = offset_ / kPageSize * kPageSize;
+  auto map_size = offset_ + size_ - map_offset;
+  auto* address = ::mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd(), map_offset);
+  if (address == MAP_FAILED) {
+    return STATUS_FORMAT(IOError, "Failed to map $0: $1", ToString(), ErrnoToString(errno));
+  }
+  auto se = ScopeExit([address, map_size] {
+    if (::munmap(address, map_size) != 0) {
+      PLOG(WARNING) << "Failed to unmap " << address;
+    }
+  });
+  visitor(Slice(static_cast<const uint8_t*>(address) + (offset_ - map_offset), size_));
+  return Status::OK();
+}
+
+std::string FileRegion::ToString() const {
+  return Format("{ path: $0 offset: $1 size: $2 }",
+                file_ ? file_->path() : std::string(), offset_, size_);
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,101 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+#ifndef YB_RPC_FILE_REGION_H
+#define YB_RPC_FILE_REGION_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/result.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace rpc {
+
+// File opened for reading, it is closed when the last reference is released.
+class ReadOnlyFile {
+ public:
+  static Result<std::shared_ptr<ReadOnlyFile>> Open(const std::string& path);
+
+  ReadOnlyFile(int fd, std::string path) : fd_(fd), path_(std::move(path)) {}
+  ~ReadOnlyFile();
+
+  ReadOnlyFile(const ReadOnlyFile&) = delete;
+  void operator=(const ReadOnlyFile&) = delete;
+
+  int fd() const {
+    return fd_;
+  }
+
+  const std::string& path() const {
+    return path_;
+  }
+
+ private:
+  const int fd_;
+  const std::string path_;
+};
+
+// Part of a file that is sent as the last sidecar of an RPC response.
+// Plain TCP stream sends it directly from the page cache to the socket, without copying it to
+// user space memory.
+class FileRegion {
+ public:
+  FileRegion() = default;
+
+  FileRegion(std::shared_ptr<ReadOnlyFile> file, uint64_t offset, size_t size)
+      : file_(std::move(file)), offset_(offset), size_(size) {}
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  explicit operator bool() const {
+    return !empty();
+  }
+
+  int fd() const {
+    return file_->fd();
+  }
+
+  uint64_t offset() const {
+    return offset_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // Reads region content to memory.
+  Result<RefCntBuffer> Read() const;
+
+  // Maps region to memory and invokes visitor with its content. Used to calculate checksums
+  // without copying data.
+  CHECKED_STATUS VisitMapped(const std::function<void(Slice)>& visitor) const;
+
+  std::string ToString() const;
+
+ private:
+  std::shared_ptr<ReadOnlyFile> file_;
+  uint64_t offset_ = 0;
+  size_t size_ = 0;
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_FILE_REGION_H
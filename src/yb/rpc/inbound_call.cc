@@ -175,6 +175,10 @@ bool InboundCall::ClientTimedOut() const {
 
 void InboundCall::QueueResponse(bool is_success) {
   TRACE_TO(trace_, is_success ? "Queueing success response" : "Queueing failure response");
+  auto span_trace_id = trace_->span_trace_id();
+  if (PREDICT_FALSE(span_trace_id != 0) && timing_.time_received) {
+    RecordSpan("rpc.inbound_call", span_trace_id, timing_.time_received, MonoTime::Now());
+  }
   LogTrace();
   bool expected = false;
   if (responded_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
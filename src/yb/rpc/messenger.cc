@@ -97,6 +97,27 @@ DEFINE_int32(rpc_workers_limit, 1024, "Workers limit for rpc server");
 
 DEFINE_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
+DEFINE_bool(rpc_acceptor_reuse_port, false,
+            "Listen RPC address with a separate SO_REUSEPORT socket in each reactor, so every "
+            "reactor accepts and serves its own connections, instead of accepting all connections "
+            "in a single acceptor thread. Note that other processes of the same user could bind "
+            "the same port while this is enabled.");
+TAG_FLAG(rpc_acceptor_reuse_port, advanced);
+
+DEFINE_bool(rpc_reactor_local_outbound_connections, false,
+            "Send outbound calls issued from a reactor thread over connections owned by that "
+            "reactor, instead of handing them over to the reactor selected by remote address. "
+            "Each reactor could open its own connections to the same server.");
+TAG_FLAG(rpc_reactor_local_outbound_connections, advanced);
+TAG_FLAG(rpc_reactor_local_outbound_connections, runtime);
+
+DEFINE_bool(rpc_thread_pool_work_stealing, false,
+            "Give each rpc worker thread its own task queue, so calls from a reactor are "
+            "executed by the same worker, and idle workers steal calls from busy ones.");
+TAG_FLAG(rpc_thread_pool_work_stealing, advanced);
+
+METRIC_DECLARE_counter(rpc_connections_accepted);
+
 namespace yb {
 namespace rpc {
 
@@ -194,6 +215,7 @@ void Messenger::Shutdown() {
     rpc_services_.clear();
 
     acceptor.swap(acceptor_);
+    reactor_listen_sockets_.clear();
 
     for (const auto& reactor : reactors_) {
       reactors.push_back(reactor.get());
@@ -228,12 +250,17 @@ void Messenger::Shutdown() {
 Status Messenger::ListenAddress(
     ConnectionContextFactoryPtr factory, const Endpoint& accept_endpoint,
     Endpoint* bound_endpoint) {
+  if (FLAGS_rpc_acceptor_reuse_port) {
+    return ListenAddressOnReactors(std::move(factory), accept_endpoint, bound_endpoint);
+  }
+
   Acceptor* acceptor;
   {
     std::lock_guard<percpu_rwlock> guard(lock_);
     if (!acceptor_) {
       acceptor_.reset(new Acceptor(
-          metric_entity_, std::bind(&Messenger::RegisterInboundSocket, this, factory, _1, _2)));
+          metric_entity_,
+          std::bind(&Messenger::RegisterInboundSocket, this, factory, _1, _2, nullptr)));
     }
     auto accept_host = accept_endpoint.address();
     auto& outbound_address = accept_host.is_v6() ? outbound_address_v6_
@@ -246,13 +273,59 @@ Status Messenger::ListenAddress(
   return acceptor->Listen(accept_endpoint, bound_endpoint);
 }
 
+Status Messenger::ListenAddressOnReactors(
+    ConnectionContextFactoryPtr factory, const Endpoint& accept_endpoint,
+    Endpoint* bound_endpoint) {
+  // When port is not specified, the first socket picks it and the rest reuse it.
+  Endpoint endpoint = accept_endpoint;
+  std::vector<ReactorListenSocket> sockets;
+  sockets.reserve(reactors_.size());
+  for (size_t i = 0; i != reactors_.size(); ++i) {
+    auto socket = VERIFY_RESULT(CreateListeningSocket(
+        endpoint, /* reuse_port= */ true, i == 0 ? &endpoint : nullptr));
+    sockets.push_back(ReactorListenSocket{factory, std::move(socket)});
+  }
+  if (bound_endpoint) {
+    *bound_endpoint = endpoint;
+  }
+
+  std::lock_guard<percpu_rwlock> guard(lock_);
+  if (closing_) {
+    return STATUS(ServiceUnavailable, "Messenger is closing");
+  }
+  auto accept_host = accept_endpoint.address();
+  auto& outbound_address = accept_host.is_v6() ? outbound_address_v6_ : outbound_address_v4_;
+  if (outbound_address.is_unspecified() && !accept_host.is_unspecified()) {
+    outbound_address = accept_host;
+  }
+  if (!rpc_connections_accepted_) {
+    rpc_connections_accepted_ = METRIC_rpc_connections_accepted.Instantiate(metric_entity_);
+  }
+  for (auto& socket : sockets) {
+    reactor_listen_sockets_.push_back(std::move(socket));
+  }
+  return Status::OK();
+}
+
 Status Messenger::StartAcceptor() {
   std::lock_guard<percpu_rwlock> guard(lock_);
+  if (!acceptor_ && reactor_listen_sockets_.empty()) {
+    return STATUS(IllegalState, "Trying to start acceptor w/o active addresses");
+  }
+  for (size_t i = 0; i != reactor_listen_sockets_.size(); ++i) {
+    auto* reactor = reactors_[i % reactors_.size()].get();
+    auto& listen_socket = reactor_listen_sockets_[i];
+    reactor->Listen(
+        std::move(listen_socket.socket), rpc_connections_accepted_,
+        std::bind(&Messenger::RegisterInboundSocket, this, listen_socket.factory, _1, _2,
+                  reactor));
+    reactors_listening_ = true;
+  }
+  reactor_listen_sockets_.clear();
   if (acceptor_) {
     return acceptor_->Start();
-  } else {
-    return STATUS(IllegalState, "Trying to start acceptor w/o active addresses");
   }
+  return Status::OK();
 }
 
 void Messenger::BreakConnectivityWith(const IpAddress& address) {
@@ -368,6 +441,13 @@ void Messenger::ShutdownAcceptor() {
   {
     std::lock_guard<percpu_rwlock> guard(lock_);
     acceptor.swap(acceptor_);
+    reactor_listen_sockets_.clear();
+    if (reactors_listening_) {
+      for (const auto& reactor : reactors_) {
+        reactor->StopListening();
+      }
+      reactors_listening_ = false;
+    }
   }
   if (acceptor) {
     acceptor->Shutdown();
@@ -390,7 +470,7 @@ rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
       }
       const ThreadPoolOptions& options = normal_thread_pool_->options();
       high_priority_thread_pool_.reset(new rpc::ThreadPool(
-          name_ + "-high-pri", options.queue_limit, options.max_workers));
+          name_ + "-high-pri", options.queue_limit, options.max_workers, options.work_stealing));
       return *high_priority_thread_pool_.get();
   }
   FATAL_INVALID_ENUM_VALUE(ServicePriority, priority);
@@ -474,7 +554,16 @@ class NotifyDisconnectedReactorTask : public ReactorTask {
 
 void Messenger::QueueOutboundCall(OutboundCallPtr call) {
   const auto& remote = call->conn_id().remote();
-  Reactor *reactor = RemoteToReactor(remote, call->conn_id().idx());
+  Reactor* reactor = nullptr;
+  if (GetAtomicFlag(&FLAGS_rpc_reactor_local_outbound_connections)) {
+    reactor = Reactor::Current();
+    if (reactor && reactor->messenger() != this) {
+      reactor = nullptr;
+    }
+  }
+  if (!reactor) {
+    reactor = RemoteToReactor(remote, call->conn_id().idx());
+  }
 
   if (TEST_ShouldArtificiallyRejectOutgoingCallsTo(remote.address())) {
     VLOG(1) << "TEST: Rejected connection to " << remote;
@@ -525,7 +614,8 @@ const std::shared_ptr<MemTracker>& Messenger::parent_mem_tracker() {
 }
 
 void Messenger::RegisterInboundSocket(
-    const ConnectionContextFactoryPtr& factory, Socket *new_socket, const Endpoint& remote) {
+    const ConnectionContextFactoryPtr& factory, Socket *new_socket, const Endpoint& remote,
+    Reactor* reactor) {
   if (TEST_ShouldArtificiallyRejectIncomingCallsFrom(remote.address())) {
     auto status = new_socket->Close();
     VLOG(1) << "TEST: Rejected connection from " << remote
@@ -544,8 +634,10 @@ void Messenger::RegisterInboundSocket(
     return;
   }
 
-  int idx = num_connections_accepted_.fetch_add(1) % num_connections_to_server_;
-  Reactor *reactor = RemoteToReactor(remote, idx);
+  if (!reactor) {
+    int idx = num_connections_accepted_.fetch_add(1) % num_connections_to_server_;
+    reactor = RemoteToReactor(remote, idx);
+  }
   reactor->RegisterInboundSocket(
       new_socket, remote, factory->Create(*receive_buffer_size), factory->buffer_tracker());
 }
@@ -558,7 +650,8 @@ Messenger::Messenger(const MessengerBuilder &bld)
       metric_entity_(bld.metric_entity_),
       io_thread_pool_(name_, FLAGS_io_thread_pool_size),
       scheduler_(&io_thread_pool_.io_service()),
-      normal_thread_pool_(new rpc::ThreadPool(name_, bld.queue_limit_, bld.workers_limit_)),
+      normal_thread_pool_(new rpc::ThreadPool(
+          name_, bld.queue_limit_, bld.workers_limit_, FLAGS_rpc_thread_pool_work_stealing)),
       rpc_metrics_(new RpcMetrics(bld.metric_entity_)),
       num_connections_to_server_(bld.num_connections_to_server_) {
 #ifndef NDEBUG
@@ -312,9 +312,16 @@ class Messenger : public ProxyContext {
   void BreakConnectivity(const IpAddress& address, bool incoming, bool outgoing);
   void RestoreConnectivity(const IpAddress& address, bool incoming, bool outgoing);
 
-  // Take ownership of the socket via Socket::Release
+  // Take ownership of the socket via Socket::Release.
+  // Connection is served by reactor, when it is specified.
   void RegisterInboundSocket(
-      const ConnectionContextFactoryPtr& factory, Socket *new_socket, const Endpoint& remote);
+      const ConnectionContextFactoryPtr& factory, Socket *new_socket, const Endpoint& remote,
+      Reactor* reactor);
+
+  // Listen address with a SO_REUSEPORT socket per reactor, see rpc_acceptor_reuse_port.
+  CHECKED_STATUS ListenAddressOnReactors(
+      ConnectionContextFactoryPtr factory, const Endpoint& accept_endpoint,
+      Endpoint* bound_endpoint);
 
   bool TEST_ShouldArtificiallyRejectOutgoingCallsTo(const IpAddress &remote);
 
@@ -342,6 +349,18 @@ class Messenger : public ProxyContext {
 
   // Acceptor which is listening on behalf of this messenger.
   std::unique_ptr<Acceptor> acceptor_;
+
+  struct ReactorListenSocket {
+    ConnectionContextFactoryPtr factory;
+    Socket socket;
+  };
+
+  // Sockets listening on behalf of reactors, when rpc_acceptor_reuse_port is set.
+  // Socket i is served by reactor i % reactors_.size(). Sockets are passed to reactors when
+  // acceptor is started.
+  std::vector<ReactorListenSocket> reactor_listen_sockets_;
+  scoped_refptr<Counter> rpc_connections_accepted_;
+  bool reactors_listening_ = false;
   IpAddress outbound_address_v4_;
   IpAddress outbound_address_v6_;
 
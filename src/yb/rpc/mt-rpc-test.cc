@@ -44,6 +44,7 @@
 
 METRIC_DECLARE_counter(rpc_connections_accepted);
 METRIC_DECLARE_counter(rpcs_queue_overflow);
+METRIC_DECLARE_counter(rpcs_shed_for_priority);
 
 using std::string;
 using std::shared_ptr;
@@ -237,6 +238,79 @@ TEST_F(MultiThreadedRpcTest, TestBlowOutServiceQueue) {
   ASSERT_EQ(1, rpcs_queue_overflow->value());
 }
 
+// Test that a queued call of less urgent priority class is dropped, when the service queue is
+// full and a more urgent call arrives.
+TEST_F(MultiThreadedRpcTest, TestShedLessUrgentCall) {
+  const size_t kMaxConcurrency = 2;
+
+  MessengerBuilder bld("messenger1");
+  bld.set_num_reactors(kMaxConcurrency);
+  bld.set_metric_entity(metric_entity());
+  std::unique_ptr<Messenger> server_messenger = ASSERT_RESULT(bld.Build());
+
+  Endpoint server_addr;
+  ASSERT_OK(server_messenger->ListenAddress(
+      CreateConnectionContextFactory<YBInboundConnectionContext>(),
+      Endpoint(), &server_addr));
+
+  std::unique_ptr<ServiceIf> service(new GenericCalculatorService());
+  auto service_name = service->service_name();
+  // Pool without workers, so calls stay in the queue until shutdown.
+  ThreadPool thread_pool("bogus_pool", kMaxConcurrency, 0UL);
+  scoped_refptr<ServicePool> service_pool(new ServicePool(kMaxConcurrency,
+                                                          &thread_pool,
+                                                          &server_messenger->scheduler(),
+                                                          std::move(service),
+                                                          metric_entity()));
+  ASSERT_OK(server_messenger->RegisterService(service_name, service_pool));
+  ASSERT_OK(server_messenger->StartAcceptor());
+
+  // Fill the service queue with bulk calls, then send a call of normal priority.
+  const RemoteMethod* methods[] = {
+      CalculatorServiceMethods::SleepMethod(), CalculatorServiceMethods::SleepMethod(),
+      CalculatorServiceMethods::AddMethod() };
+  scoped_refptr<yb::Thread> threads[3];
+  Status status[3];
+  CountDownLatch latch(1);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_OK(yb::Thread::Create("test", strings::Substitute("t$0", i),
+      &MultiThreadedRpcTest::SingleCall, this, HostPort::FromBoundEndpoint(server_addr),
+      methods[i], &status[i], &latch, &threads[i]));
+    // Give the call time to reach the service queue, so calls are queued in order.
+    SleepFor(MonoDelta::FromMilliseconds(500));
+  }
+
+  // One of bulk calls should be dropped in favor of the normal one.
+  latch.Wait();
+
+  ASSERT_OK(server_messenger->UnregisterService(service_name));
+  service_pool->Shutdown();
+  thread_pool.Shutdown();
+  server_messenger->Shutdown();
+
+  for (const auto& thread : threads) {
+    ASSERT_OK(ThreadJoiner(thread.get()).warn_every(500ms).Join());
+  }
+
+  int errors_backpressure = 0;
+  int errors_shutdown = 0;
+  for (const auto& s : status) {
+    IncrementBackpressureOrShutdown(&s, &errors_backpressure, &errors_shutdown);
+  }
+  ASSERT_EQ(1, errors_backpressure);
+  ASSERT_EQ(2, errors_shutdown);
+
+  // The normal priority call was accepted.
+  int add_backpressure = 0;
+  int add_shutdown = 0;
+  IncrementBackpressureOrShutdown(&status[2], &add_backpressure, &add_shutdown);
+  ASSERT_EQ(1, add_shutdown);
+
+  Counter* rpcs_shed_for_priority =
+      METRIC_rpcs_shed_for_priority.Instantiate(metric_entity()).get();
+  ASSERT_EQ(1, rpcs_shed_for_priority->value());
+}
+
 static void HammerServerWithTCPConns(const Endpoint& addr) {
   while (true) {
     Socket socket;
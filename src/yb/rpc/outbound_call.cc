@@ -206,6 +206,8 @@ OutboundCall::OutboundCall(const RemoteMethod* remote_method,
   if (Trace::CurrentTrace()) {
     Trace::CurrentTrace()->AddChildTrace(trace_.get());
   }
+  // Call made on behalf of a decided trace follows its decision, otherwise it is a root.
+  trace_->set_span_trace_id(DecideSpanTrace(trace_->span_trace_decision()));
 
   DVLOG(4) << "OutboundCall " << this << " constructed with state_: " << StateName(state_)
            << " and RPC timeout: "
@@ -364,6 +366,10 @@ bool OutboundCall::SetState(State new_state) {
 }
 
 void OutboundCall::InvokeCallback() {
+  auto span_trace_id = trace_->span_trace_id();
+  if (PREDICT_FALSE(span_trace_id != 0)) {
+    RecordSpan("rpc.outbound_call", span_trace_id, start_, MonoTime::Now());
+  }
   if (callback_thread_pool_) {
     callback_task_.SetOutboundCall(shared_from(this));
     callback_thread_pool_->Enqueue(&callback_task_);
@@ -380,6 +386,8 @@ void OutboundCall::InvokeCallbackSync() {
     return;
   }
 
+  // Callback continues the trace of this call.
+  ScopedSpanTraceId span_trace_id(trace_->span_trace_id());
   int64_t start_cycles = CycleClock::Now();
   callback_();
   // Clear the callback, since it may be holding onto reference counts
@@ -564,6 +572,8 @@ void OutboundCall::InitHeader(RequestHeader* header) {
       header->set_timeout_millis(timeout.ToMilliseconds());
     }
   }
+  // Sent even when 0, so callee does not sample calls of unsampled trace.
+  header->set_span_trace_id(trace_->span_trace_id());
   header->set_allocated_remote_method(remote_method_pool_->Take());
 }
 
@@ -18,6 +18,8 @@
 
 #include <boost/container/small_vector.hpp>
 
+#include "yb/rpc/file_region.h"
+
 #include "yb/util/memory/memory_usage.h"
 #include "yb/util/ref_cnt_buffer.h"
 
@@ -51,6 +53,10 @@ class OutboundData : public std::enable_shared_from_this<OutboundData> {
 
   virtual bool IsHeartbeat() const { return false; }
 
+  // Takes region of file that should be sent right after serialized data.
+  // Invoked only by streams that are able to send data directly from file to socket.
+  virtual FileRegion TakeFileRegion() { return FileRegion(); }
+
   virtual size_t ObjectSize() const = 0;
 
   virtual size_t DynamicMemoryUsage() const = 0;
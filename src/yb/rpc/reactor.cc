@@ -111,6 +111,8 @@ bool HasReactorStartedClosing(ReactorState state) {
   return state == ReactorState::kClosing || state == ReactorState::kClosed;
 }
 
+thread_local Reactor* current_reactor = nullptr;
+
 } // anonymous namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -218,6 +220,8 @@ void Reactor::ShutdownInternal() {
   }
   client_conns.clear();
 
+  listeners_.clear();
+
   // Tear down any inbound TCP connections.
   VLOG_WITH_PREFIX(1) << "tearing down inbound TCP connections...";
   for (const ConnectionPtr& conn : server_conns_) {
@@ -477,6 +481,7 @@ bool Reactor::IsCurrentThreadOrStartedClosing() const {
 void Reactor::RunThread() {
   ThreadRestrictions::SetWaitAllowed(false);
   ThreadRestrictions::SetIOAllowed(false);
+  current_reactor = this;
   DVLOG_WITH_PREFIX(6) << "Calling Reactor::RunThread()...";
   loop_.run(/* flags */ 0);
   VLOG_WITH_PREFIX(1) << "thread exiting.";
@@ -876,11 +881,65 @@ void Reactor::RegisterInboundSocket(
                                            ConnectionDirection::SERVER,
                                            &messenger()->rpc_metrics(),
                                            std::move(connection_context));
+  // Connections accepted by this reactor itself are registered without a task round trip.
+  if (IsCurrentThread() && !stopping_) {
+    RegisterConnection(conn);
+    return;
+  }
   ScheduleReactorFunctor([conn = std::move(conn)](Reactor* reactor) {
     reactor->RegisterConnection(conn);
   }, SOURCE_LOCATION());
 }
 
+Reactor* Reactor::Current() {
+  return current_reactor;
+}
+
+void Reactor::Listen(
+    Socket socket, const scoped_refptr<Counter>& connections_accepted, NewSocketHandler handler) {
+  // Task functor should be copyable, so socket is passed via shared pointer.
+  auto listener = std::make_shared<Listener>(Listener{
+      nullptr, std::move(socket), connections_accepted, std::move(handler)});
+  auto scheduled = ScheduleReactorFunctor([listener](Reactor* reactor) {
+    listener->io.reset(new ev::io);
+    listener->io->set(reactor->loop_);
+    listener->io->set<Reactor, &Reactor::AcceptHandler>(reactor);
+    listener->io->start(listener->socket.GetFd(), EV_READ);
+    VLOG(1) << reactor->LogPrefix() << "Accepting on socket fd " << listener->socket.GetFd();
+    auto* io = listener->io.get();
+    reactor->listeners_.emplace(io, std::move(*listener));
+  }, SOURCE_LOCATION());
+  LOG_IF_WITH_PREFIX(WARNING, !scheduled) << "Failed to schedule listen task";
+}
+
+void Reactor::StopListening() {
+  auto scheduled = ScheduleReactorFunctor([](Reactor* reactor) {
+    reactor->listeners_.clear();
+  }, SOURCE_LOCATION());
+  LOG_IF_WITH_PREFIX(WARNING, !scheduled) << "Failed to schedule stop listening task";
+}
+
+void Reactor::AcceptHandler(ev::io& io, int events) {
+  DCHECK(IsCurrentThread());
+
+  auto it = listeners_.find(&io);
+  if (it == listeners_.end()) {
+    LOG_WITH_PREFIX(ERROR) << "AcceptHandler for unknown socket: " << &io;
+    return;
+  }
+  auto& listener = it->second;
+  if (events & EV_ERROR) {
+    LOG_WITH_PREFIX(INFO) << "Listening socket failure: " << listener.socket.GetFd();
+    listeners_.erase(it);
+    return;
+  }
+
+  if (events & EV_READ) {
+    AcceptPendingConnections(
+        &listener.socket, listener.connections_accepted.get(), listener.handler);
+  }
+}
+
 bool Reactor::ScheduleReactorTask(ReactorTaskPtr task, bool schedule_even_closing) {
   bool was_empty;
   {
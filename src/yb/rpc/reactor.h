@@ -40,6 +40,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include <ev++.h> // NOLINT
 
@@ -48,6 +49,7 @@
 
 #include "yb/gutil/ref_counted.h"
 
+#include "yb/rpc/acceptor.h"
 #include "yb/rpc/outbound_call.h"
 
 #include "yb/util/thread.h"
@@ -361,6 +363,17 @@ class Reactor {
       Socket *socket, const Endpoint& remote, std::unique_ptr<ConnectionContext> connection_context,
       const MemTrackerPtr& mem_tracker);
 
+  // Start accepting connections from the listening socket in the reactor thread.
+  // handler is invoked in the reactor thread for each accepted connection.
+  void Listen(
+      Socket socket, const scoped_refptr<Counter>& connections_accepted, NewSocketHandler handler);
+
+  // Stop accepting connections from sockets passed to Listen.
+  void StopListening();
+
+  // Returns reactor whose thread is the current thread, or nullptr if there is no such reactor.
+  static Reactor* Current();
+
   // Schedule the given task's Run() method to be called on the reactor thread. If the reactor shuts
   // down before it is run, the Abort method will be called.
   // Returns true if task was scheduled.
@@ -421,6 +434,16 @@ class Reactor {
 
   void ShutdownConnection(const ConnectionPtr& conn);
 
+  // libev callback for listening sockets passed to Listen.
+  void AcceptHandler(ev::io& io, int events); // NOLINT
+
+  struct Listener {
+    std::unique_ptr<ev::io> io;
+    Socket socket;
+    scoped_refptr<Counter> connections_accepted;
+    NewSocketHandler handler;
+  };
+
   // parent messenger
   Messenger* const messenger_;
 
@@ -473,6 +496,9 @@ class Reactor {
   // List of current connections coming into the server.
   ConnectionList server_conns_;
 
+  // Sockets this reactor accepts connections from, keyed by their watchers.
+  std::unordered_map<ev::io*, Listener> listeners_;
+
   // Set of connections that should be completed before we can stop this thread.
   std::unordered_set<ConnectionPtr> waiting_conns_;
 
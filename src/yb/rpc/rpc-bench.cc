@@ -38,6 +38,7 @@
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rtest.proxy.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/hdr_histogram.h"
 #include "yb/util/test_util.h"
 
 using namespace std::literals; // NOLINT
@@ -61,8 +62,10 @@ class RpcBench : public RpcTestBase {
 
 class ClientThread {
  public:
-  explicit ClientThread(RpcBench *bench)
+  // When latencies is specified, latency of each call in microseconds is recorded to it.
+  explicit ClientThread(RpcBench *bench, HdrHistogram* latencies = nullptr)
     : bench_(bench),
+      latencies_(latencies),
       request_count_(0) {
   }
 
@@ -88,7 +91,11 @@ class ClientThread {
       req.set_y(request_count_);
       RpcController controller;
       controller.set_timeout(MonoDelta::FromSeconds(10));
+      auto start = MonoTime::Now();
       CHECK_OK(p.Add(req, &resp, &controller));
+      if (latencies_) {
+        latencies_->Increment((MonoTime::Now() - start).ToMicroseconds());
+      }
       CHECK_EQ(req.x() + req.y(), resp.result());
       request_count_++;
     }
@@ -96,6 +103,7 @@ class ClientThread {
 
   std::unique_ptr<std::thread> thread_;
   RpcBench *bench_;
+  HdrHistogram* latencies_;
   int request_count_;
 };
 
@@ -149,6 +157,54 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+// Compares shared queue and work stealing server thread pools for different number of workers.
+TEST_F(RpcBench, BenchmarkThreadPools) {
+#if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
+  constexpr int kNumThreads = 4;
+  const std::vector<size_t> kWorkerCounts = {1, 4};
+#else
+  constexpr int kNumThreads = 16;
+  const std::vector<size_t> kWorkerCounts = {1, 4, 16};
+#endif
+  constexpr uint64_t kMaxLatencyUs = 10000000;
+
+  for (auto num_workers : kWorkerCounts) {
+    for (auto work_stealing : {false, true}) {
+      TestServerOptions options;
+      options.n_worker_threads = num_workers;
+      options.work_stealing = work_stealing;
+      StartTestServerWithGeneratedCode(&server_hostport_, options);
+
+      HdrHistogram latencies(kMaxLatencyUs, 2);
+      should_run_.store(true, std::memory_order_release);
+      Stopwatch sw(Stopwatch::ALL_THREADS);
+      sw.start();
+      std::vector<std::unique_ptr<ClientThread>> threads;
+      for (int i = 0; i < kNumThreads; i++) {
+        auto thr = std::make_unique<ClientThread>(this, &latencies);
+        thr->Start();
+        threads.push_back(std::move(thr));
+      }
+
+      std::this_thread::sleep_for(5s);
+      should_run_.store(false, std::memory_order_release);
+
+      int total_reqs = 0;
+      for (const auto& thr : threads) {
+        thr->Join();
+        total_reqs += thr->request_count_;
+      }
+      sw.stop();
+
+      LOG(INFO) << "Workers: " << num_workers << ", work stealing: " << work_stealing
+                << ", reqs/sec: " << total_reqs / sw.elapsed().wall_seconds()
+                << ", p99 latency: " << latencies.ValueAtPercentile(99) << "us"
+                << ", CPU per req: "
+                << (sw.elapsed().user + sw.elapsed().system) / 1000.0 / total_reqs << "us";
+    }
+  }
+}
+
 } // namespace rpc
 } // namespace yb
 
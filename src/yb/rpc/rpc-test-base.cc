@@ -125,6 +125,11 @@ void GenericCalculatorService::Handle(InboundCallPtr incoming) {
   }
 }
 
+CallPriority GenericCalculatorService::GetCallPriority(const InboundCall& call) const {
+  return call.method_name() == CalculatorServiceMethods::kSleepMethodName
+      ? CallPriority::kBulk : CallPriority::kNormal;
+}
+
 void GenericCalculatorService::GenericCalculatorService::DoAdd(InboundCall* incoming) {
   Slice param(incoming->serialized_request());
   AddRequestPB req;
@@ -315,7 +320,7 @@ TestServer::TestServer(std::unique_ptr<ServiceIf> service,
                        const TestServerOptions& options)
     : service_name_(service->service_name()),
       messenger_(std::move(messenger)),
-      thread_pool_("rpc-test", kQueueLength, options.n_worker_threads) {
+      thread_pool_("rpc-test", kQueueLength, options.n_worker_threads, options.work_stealing) {
 
   // If it is CalculatorService then we should set messenger for it.
   CalculatorService* calculator_service = dynamic_cast<CalculatorService*>(service.get());
@@ -115,6 +115,9 @@ class GenericCalculatorService : public ServiceIf {
 
   void Handle(InboundCallPtr incoming) override;
 
+  // Sleep calls are considered bulk work, so they are shed first under overload.
+  CallPriority GetCallPriority(const InboundCall& call) const override;
+
   std::string service_name() const override {
     return rpc_test::CalculatorServiceIf::static_service_name();
   }
@@ -139,6 +142,7 @@ extern const MessengerOptions kDefaultServerMessengerOptions;
 struct TestServerOptions {
   MessengerOptions messenger_options = kDefaultServerMessengerOptions;
   size_t n_worker_threads = 3;
+  bool work_stealing = false;
   Endpoint endpoint;
 };
 
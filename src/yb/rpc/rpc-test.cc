@@ -47,6 +47,7 @@
 #endif
 
 #include "yb/gutil/map-util.h"
+#include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 
@@ -57,13 +58,17 @@
 
 #include "yb/util/countdown_latch.h"
 #include "yb/util/env.h"
+#include "yb/util/jsonwriter.h"
 #include "yb/util/logging_test_util.h"
+#include "yb/util/span_tracer.h"
 #include "yb/util/test_util.h"
+#include "yb/util/trace.h"
 
 #include "yb/util/memory/memory_usage_test_util.h"
 
 METRIC_DECLARE_histogram(handler_latency_yb_rpc_test_CalculatorService_Sleep);
 METRIC_DECLARE_histogram(rpc_incoming_queue_time);
+METRIC_DECLARE_counter(rpc_connections_accepted);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -75,6 +80,9 @@ DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
 DECLARE_string(vmodule);
+DECLARE_bool(rpc_acceptor_reuse_port);
+DECLARE_bool(rpc_reactor_local_outbound_connections);
+DECLARE_int32(span_trace_sample_every_n);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -117,6 +125,20 @@ void CheckParseEndpoint(const std::string& input, std::string expected = std::st
   ASSERT_EQ(expected, AsString(*endpoint));
 }
 
+// Returns number of collected spans that contain the specified JSON fragment.
+size_t CountSpans(const std::string& fragment) {
+  std::stringstream out;
+  JsonWriter writer(&out, JsonWriter::COMPACT);
+  DumpSpansAsChromeTrace(&writer);
+  const auto dump = out.str();
+  size_t result = 0;
+  for (auto pos = dump.find(fragment); pos != std::string::npos;
+       pos = dump.find(fragment, pos + fragment.size())) {
+    ++result;
+  }
+  return result;
+}
+
 } // namespace
 
 TEST_F(TestRpc, Endpoint) {
@@ -187,6 +209,62 @@ TEST_F(TestRpc, TestCall) {
   }
 }
 
+// Sampling decision of the root is propagated to the callee, so calls made on behalf of unsampled
+// root are not sampled again, even when every call would be sampled.
+TEST_F(TestRpc, SpanTraceDecisionPropagation) {
+  constexpr size_t kNumCalls = 10;
+  FLAGS_span_trace_sample_every_n = 1;
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  const auto inbound_spans = CountSpans("\"name\":\"rpc.inbound_call\"");
+  const auto outbound_spans = CountSpans("\"name\":\"rpc.outbound_call\"");
+  scoped_refptr<Trace> unsampled_root(new Trace);
+  unsampled_root->set_span_trace_id(0);
+  {
+    ADOPT_TRACE(unsampled_root.get());
+    for (size_t i = 0; i != kNumCalls; ++i) {
+      ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+    }
+  }
+  ASSERT_EQ(inbound_spans, CountSpans("\"name\":\"rpc.inbound_call\""));
+  ASSERT_EQ(outbound_spans, CountSpans("\"name\":\"rpc.outbound_call\""));
+
+  // Both caller and callee record spans of sampled root.
+  const auto trace_id = SampleSpanTrace();
+  scoped_refptr<Trace> sampled_root(new Trace);
+  sampled_root->set_span_trace_id(trace_id);
+  {
+    ADOPT_TRACE(sampled_root.get());
+    for (size_t i = 0; i != kNumCalls; ++i) {
+      ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+    }
+  }
+  ASSERT_EQ(2 * kNumCalls, CountSpans(StringPrintf("\"trace_id\":\"%016" PRIx64 "\"", trace_id)));
+}
+
+// Test making calls to server that accepts connections in each reactor.
+TEST_F(TestRpc, ReusePortAcceptors) {
+  FLAGS_rpc_acceptor_reuse_port = true;
+  FLAGS_rpc_reactor_local_outbound_connections = true;
+  constexpr int kNumClients = 10;
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  for (int i = 0; i != kNumClients; ++i) {
+    auto client_messenger = CreateAutoShutdownMessengerHolder(Format("Client$0", i));
+    Proxy p(client_messenger.get(), server_addr);
+    ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+  }
+
+  auto connections_accepted = METRIC_rpc_connections_accepted.Instantiate(metric_entity());
+  ASSERT_EQ(kNumClients, connections_accepted->value());
+}
+
 TEST_F(TestRpc, BigTimeout) {
   // Set up server.
   TestServerOptions options;
@@ -173,6 +173,10 @@ size_t RpcContext::AddRpcSidecar(const Slice& car) {
   return call_->AddRpcSidecar(car);
 }
 
+Result<size_t> RpcContext::AddRpcFileSidecar(FileRegion region) {
+  return call_->AddRpcFileSidecar(std::move(region));
+}
+
 void RpcContext::ResetRpcSidecars() {
   call_->ResetRpcSidecars();
 }
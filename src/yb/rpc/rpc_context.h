@@ -35,6 +35,7 @@
 #include <string>
 
 #include "yb/gutil/gscoped_ptr.h"
+#include "yb/rpc/file_region.h"
 #include "yb/rpc/rpc_header.pb.h"
 #include "yb/rpc/service_if.h"
 #include "yb/util/ref_cnt_buffer.h"
@@ -174,6 +175,12 @@ class RpcContext {
   // Returns the index of the sidecar.
   size_t AddRpcSidecar(const Slice& car);
 
+  // Adds part of file as the last RpcSidecar of the response. When connection is not encrypted
+  // it is sent directly from file to socket, otherwise it is read to memory.
+  //
+  // Returns the index of the sidecar.
+  Result<size_t> AddRpcFileSidecar(FileRegion region);
+
   // Removes all RpcSidecars.
   void ResetRpcSidecars();
 
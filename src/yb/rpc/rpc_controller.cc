@@ -80,6 +80,15 @@ void RpcController::Reset() {
   call_.reset();
 }
 
+void RpcController::ShareCall(const RpcController& other) {
+  CHECK(other.finished());
+  std::lock_guard<simple_spinlock> l(lock_);
+  if (call_) {
+    CHECK(finished());
+  }
+  call_ = other.call_;
+}
+
 bool RpcController::finished() const {
   if (call_) {
     return call_->IsFinished();
@@ -81,6 +81,10 @@ class RpcController {
   // Note that reset doesn't reset controller's properties except the call itself.
   void Reset();
 
+  // Makes this controller report status and error response of the finished call tracked by other.
+  // Used when a single call carries requests of several controllers, e.g. batched heartbeats.
+  void ShareCall(const RpcController& other);
+
   // Return true if the call has finished.
   // A call is finished if the server has responded, or if the call
   // has timed out.
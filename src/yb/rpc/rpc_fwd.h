@@ -122,6 +122,10 @@ constexpr size_t kMinBufferForSidecarSlices = 16;
 
 YB_DEFINE_ENUM(ServicePriority, (kNormal)(kHigh));
 
+// Scheduling class of an inbound call within its service pool, from most to least urgent.
+// Queued calls of a more urgent class are handled first and are shed last under overload.
+YB_DEFINE_ENUM(CallPriority, (kCritical)(kLatencySensitive)(kNormal)(kBulk)(kBackground));
+
 } // namespace rpc
 } // namespace yb
 
@@ -59,5 +59,9 @@ ServiceIf::~ServiceIf() {
 void ServiceIf::Shutdown() {
 }
 
+CallPriority ServiceIf::GetCallPriority(const InboundCall& call) const {
+  return CallPriority::kNormal;
+}
+
 } // namespace rpc
 } // namespace yb
@@ -68,6 +68,10 @@ class ServiceIf {
 
   virtual void Shutdown();
   virtual std::string service_name() const = 0;
+
+  // Scheduling class of the call, used by ServicePool to order queued calls and to pick calls to
+  // shed under overload. Called before the call is queued, so it should be cheap.
+  virtual CallPriority GetCallPriority(const InboundCall& call) const;
 };
 
 }  // namespace rpc
@@ -33,8 +33,12 @@
 #include "yb/rpc/service_pool.h"
 
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/asio/strand.hpp>
@@ -79,6 +83,11 @@ TAG_FLAG(backpressure_recovery_period_ms, runtime);
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
+DEFINE_bool(rpc_enable_call_scheduling, true,
+            "Handle queued calls of a service in order of their priority class and deadline, "
+            "instead of arrival order, and shed the least important calls when the service is "
+            "overloaded.");
+TAG_FLAG(rpc_enable_call_scheduling, advanced);
 
 METRIC_DEFINE_histogram(server, rpc_incoming_queue_time,
                         "RPC Queue Time",
@@ -106,6 +115,18 @@ METRIC_DEFINE_counter(server, rpcs_queue_overflow,
                       "Number of RPCs dropped because the service queue "
                       "was full.");
 
+METRIC_DEFINE_counter(server, rpcs_shed_for_priority,
+                      "RPCs Shed For Priority",
+                      yb::MetricUnit::kRequests,
+                      "Number of queued RPCs dropped to make room for RPCs of a more urgent "
+                      "priority class, while the service queue was full.");
+
+METRIC_DEFINE_counter(server, rpcs_shed_unreachable_deadline,
+                      "RPCs Shed With Unreachable Deadline",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPCs dropped during overload, because their estimated handling "
+                      "time would not fit before their deadline.");
+
 namespace yb {
 namespace rpc {
 
@@ -113,6 +134,11 @@ namespace {
 
 const CoarseDuration kTimeoutCheckGranularity = 100ms;
 const char* const kTimedOutInQueue = "Call waited in the queue past deadline";
+const char* const kUnreachableDeadline =
+    "The server is overloaded. Call could not be handled before its deadline.";
+
+// Weight of the previous value in the moving average of handling time, as a power of two.
+constexpr int kCostEstimateShift = 3;
 
 } // namespace
 
@@ -132,6 +158,10 @@ class ServicePoolImpl final : public InboundCallHandler {
         rpcs_timed_out_early_in_queue_(
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
+        rpcs_shed_for_priority_(METRIC_rpcs_shed_for_priority.Instantiate(entity)),
+        rpcs_shed_unreachable_deadline_(
+            METRIC_rpcs_shed_unreachable_deadline.Instantiate(entity)),
+        scheduling_enabled_(FLAGS_rpc_enable_call_scheduling),
         check_timeout_strand_(scheduler->io_service()),
         log_prefix_(Format("$0: ", service_->service_name())) {
 
@@ -181,7 +211,11 @@ class ServicePoolImpl final : public InboundCallHandler {
   void Enqueue(const InboundCallPtr& call) {
     TRACE_TO(call->trace(), "Inserting onto call queue");
 
+    auto priority = scheduling_enabled_ ? service_->GetCallPriority(*call) : CallPriority::kNormal;
     auto task = call->BindTask(this);
+    if (!task && scheduling_enabled_ && ShedLessUrgentCall(priority)) {
+      task = call->BindTask(this);
+    }
     if (!task) {
       Overflow(call, "service", queued_calls_.load(std::memory_order_relaxed));
       return;
@@ -193,6 +227,10 @@ class ServicePoolImpl final : public InboundCallHandler {
       ScheduleCheckTimeout(call_deadline);
     }
 
+    if (scheduling_enabled_) {
+      PushScheduledCall(call, priority);
+    }
+
     thread_pool_.Enqueue(task);
   }
 
@@ -229,7 +267,16 @@ class ServicePoolImpl final : public InboundCallHandler {
         CoarseMonoClock::Now().time_since_epoch(), std::memory_order_release);
   }
 
-  void Failure(const InboundCallPtr& call, const Status& status) override {
+  void Failure(const InboundCallPtr& failed_call, const Status& status) override {
+    InboundCallPtr call = failed_call;
+    if (scheduling_enabled_) {
+      // Task of the call could not be run, so one scheduled call should be dropped to keep number
+      // of scheduled calls in sync with number of tasks. We drop the least urgent one.
+      call = PopScheduledCall(/* most_urgent= */ false).call;
+      if (!call) {
+        return;
+      }
+    }
     if (!call->TryStartProcessing()) {
       return;
     }
@@ -247,19 +294,39 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   void Handle(InboundCallPtr incoming) override {
+    std::atomic<int64_t>* cost_estimate = nullptr;
+    if (scheduling_enabled_) {
+      // Tasks are not bound to the call they were created for, each task handles the most urgent
+      // call scheduled at the moment it runs.
+      auto scheduled = PopScheduledCall(/* most_urgent= */ true);
+      if (!scheduled.call) {
+        return;
+      }
+      incoming = std::move(scheduled.call);
+      cost_estimate = scheduled.cost_estimate;
+    }
+
     incoming->RecordHandlingStarted(incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
 
     const char* error_message;
+    Counter* metric = rpcs_timed_out_in_queue_.get();
     if (PREDICT_FALSE(incoming->ClientTimedOut())) {
       error_message = kTimedOutInQueue;
     } else if (PREDICT_FALSE(ShouldDropRequestDuringHighLoad(incoming))) {
       error_message = "The server is overloaded. Call waited in the queue past max_time_in_queue.";
+    } else if (PREDICT_FALSE(cost_estimate && IsDeadlineUnreachable(*incoming, *cost_estimate))) {
+      error_message = kUnreachableDeadline;
+      metric = rpcs_shed_unreachable_deadline_.get();
     } else {
       TRACE_TO(incoming->trace(), "Handling call");
 
       if (incoming->TryStartProcessing()) {
+        auto start = CoarseMonoClock::Now();
         service_->Handle(std::move(incoming));
+        if (cost_estimate) {
+          UpdateCostEstimate(CoarseMonoClock::Now() - start, cost_estimate);
+        }
       }
       return;
     }
@@ -270,10 +337,96 @@ class ServicePoolImpl final : public InboundCallHandler {
 
     // Respond as a failure, even though the client will probably ignore
     // the response anyway.
-    TimedOut(incoming.get(), error_message, rpcs_timed_out_in_queue_.get());
+    TimedOut(incoming.get(), error_message, metric);
   }
 
  private:
+  struct ScheduledCall {
+    CallPriority priority;
+    // Latest time when handling of the call could be started to complete it before deadline,
+    // according to estimated handling time of its method.
+    CoarseTimePoint latest_start;
+    // Arrival order, to keep FIFO order among calls with the same priority and deadline.
+    int64_t serial_no;
+    InboundCallPtr call;
+    // Moving average of handling time for method of this call, in nanoseconds.
+    std::atomic<int64_t>* cost_estimate;
+
+    bool operator<(const ScheduledCall& rhs) const {
+      return std::tie(priority, latest_start, serial_no) <
+             std::tie(rhs.priority, rhs.latest_start, rhs.serial_no);
+    }
+  };
+
+  void PushScheduledCall(const InboundCallPtr& call, CallPriority priority) {
+    std::lock_guard<std::mutex> lock(schedule_mutex_);
+    auto& cost_estimate = cost_estimates_[call->method_name()];
+    auto deadline = call->GetClientDeadline();
+    if (deadline != CoarseTimePoint::max()) {
+      deadline -= std::chrono::nanoseconds(cost_estimate.load(std::memory_order_relaxed));
+    }
+    scheduled_calls_.insert(
+        ScheduledCall{priority, deadline, ++last_serial_no_, call, &cost_estimate});
+  }
+
+  // Removes the most or the least urgent call from the schedule, returns empty call if the
+  // schedule is empty.
+  ScheduledCall PopScheduledCall(bool most_urgent) {
+    std::lock_guard<std::mutex> lock(schedule_mutex_);
+    if (scheduled_calls_.empty()) {
+      return ScheduledCall{CallPriority::kNormal, CoarseTimePoint(), 0, nullptr, nullptr};
+    }
+    auto it = most_urgent ? scheduled_calls_.begin() : std::prev(scheduled_calls_.end());
+    auto result = std::move(const_cast<ScheduledCall&>(*it));
+    scheduled_calls_.erase(it);
+    return result;
+  }
+
+  // Drops the least urgent scheduled call, when it is less urgent than priority.
+  // Returns true if a call was dropped, so there is room in the queue.
+  bool ShedLessUrgentCall(CallPriority priority) {
+    for (;;) {
+      InboundCallPtr call;
+      {
+        std::lock_guard<std::mutex> lock(schedule_mutex_);
+        if (scheduled_calls_.empty()) {
+          return false;
+        }
+        auto it = std::prev(scheduled_calls_.end());
+        if (it->priority <= priority) {
+          return false;
+        }
+        call = std::move(const_cast<ScheduledCall&>(*it).call);
+        scheduled_calls_.erase(it);
+      }
+      // Call could be already timed out, in this case we look for the next one.
+      if (call->TryStartProcessing()) {
+        TRACE_TO(call->trace(), "Shed in favor of more urgent call");
+        rpcs_shed_for_priority_->Increment();
+        Overflow(call, "service", max_queued_calls_);
+        return true;
+      }
+    }
+  }
+
+  // Under overload we don't start calls that most likely will not be completed before deadline.
+  bool IsDeadlineUnreachable(const InboundCall& call, const std::atomic<int64_t>& cost_estimate) {
+    auto deadline = call.GetClientDeadline();
+    if (deadline == CoarseTimePoint::max() || !IsUnderBackpressure()) {
+      return false;
+    }
+    auto cost = std::chrono::nanoseconds(cost_estimate.load(std::memory_order_relaxed));
+    return CoarseMonoClock::Now() + cost > deadline;
+  }
+
+  static void UpdateCostEstimate(CoarseDuration duration, std::atomic<int64_t>* cost_estimate) {
+    auto sample = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    auto old_value = cost_estimate->load(std::memory_order_relaxed);
+    // Races between concurrent updates could lose a sample, that is acceptable for an estimate.
+    cost_estimate->store(
+        old_value + ((sample - old_value) >> kCostEstimateShift), std::memory_order_relaxed);
+  }
+
   void TimedOut(InboundCall* call, const char* error_message, Counter* metric) {
     if (call->RespondTimedOutIfPending(error_message)) {
       metric->Increment();
@@ -281,6 +434,15 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   bool ShouldDropRequestDuringHighLoad(const InboundCallPtr& incoming) {
+    if (!IsUnderBackpressure()) {
+      return false;
+    }
+
+    return incoming->GetTimeInQueue().ToMilliseconds() > FLAGS_max_time_in_queue_ms;
+  }
+
+  // Returns true if the service had backpressure in the last backpressure_recovery_period_ms.
+  bool IsUnderBackpressure() {
     CoarseTimePoint last_backpressure_at(last_backpressure_at_.load(std::memory_order_acquire));
 
     // For testing purposes.
@@ -299,7 +461,7 @@ class ServicePoolImpl final : public InboundCallHandler {
       return false;
     }
 
-    return incoming->GetTimeInQueue().ToMilliseconds() > FLAGS_max_time_in_queue_ms;
+    return true;
   }
 
   void CheckTimeout(ScheduledTaskId task_id, CoarseTimePoint time, const Status& status) {
@@ -407,6 +569,8 @@ class ServicePoolImpl final : public InboundCallHandler {
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_timed_out_early_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  scoped_refptr<Counter> rpcs_shed_for_priority_;
+  scoped_refptr<Counter> rpcs_shed_unreachable_deadline_;
   scoped_refptr<AtomicGauge<int64_t>> rpcs_in_queue_;
   // Have to use CoarseDuration here, since CoarseTimePoint does not work with clang + libstdc++
   std::atomic<CoarseDuration> last_backpressure_at_{CoarseTimePoint().time_since_epoch()};
@@ -448,6 +612,16 @@ class ServicePoolImpl final : public InboundCallHandler {
 
   std::priority_queue<QueuedCheckDeadline> check_timeout_queue_;
 
+  const bool scheduling_enabled_;
+
+  // Calls waiting to be handled, ordered from the most urgent one. Each call has exactly one
+  // thread pool task, but task picks the most urgent call when it runs.
+  std::mutex schedule_mutex_;
+  std::set<ScheduledCall> scheduled_calls_;
+  int64_t last_serial_no_ = 0;
+  // Handling time estimate per method. Entries are never removed, so pointers to them are stable.
+  std::unordered_map<std::string, std::atomic<int64_t>> cost_estimates_;
+
   std::atomic<bool> closing_ = {false};
   CountDownLatch shutdown_complete_latch_{1};
   std::string log_prefix_;
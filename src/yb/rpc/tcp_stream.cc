@@ -13,6 +13,8 @@
 
 #include "yb/rpc/tcp_stream.h"
 
+#include <limits>
+
 #include "yb/rpc/outbound_data.h"
 #include "yb/rpc/rpc_util.h"
 
@@ -175,6 +177,17 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
         return FillIovResult{index, only_heartbeats};
       }
     }
+    if (data.file) {
+      if (offset >= data.file.size()) {
+        offset -= data.file.size();
+        continue;
+      }
+      // File content is not sent with writev, so the buffers before it are sent first.
+      if (index != 0) {
+        return FillIovResult{index, only_heartbeats};
+      }
+      return FillIovResult{0, only_heartbeats, &data.file, offset};
+    }
   }
 
   return FillIovResult{index, only_heartbeats};
@@ -200,9 +213,17 @@ Status TcpStream::DoWrite() {
     }
 
     int32_t written = 0;
-    auto status = fill_result.len != 0
-        ? socket_.Writev(iov, fill_result.len, &written)
-        : Status::OK();
+    Status status;
+    if (fill_result.len != 0) {
+      status = socket_.Writev(iov, fill_result.len, &written);
+    } else if (fill_result.file) {
+      const auto& file = *fill_result.file;
+      status = socket_.SendFile(
+          file.fd(), file.offset() + fill_result.file_offset,
+          static_cast<int32_t>(std::min<size_t>(
+              file.size() - fill_result.file_offset, std::numeric_limits<int32_t>::max())),
+          &written);
+    }
     DVLOG_WITH_PREFIX(4) << "Queued writes " << queued_bytes_to_send_ << " bytes. written "
                          << written << " . Status " << status << ", sending_.size(): "
                          << sending_.size();
@@ -509,6 +530,7 @@ StreamFactoryPtr TcpStream::Factory() {
 
 TcpStreamSendingData::TcpStreamSendingData(OutboundDataPtr data_, const MemTrackerPtr& mem_tracker)
     : data(std::move(data_)) {
+  file = data->TakeFileRegion();
   data->Serialize(&bytes);
   if (mem_tracker) {
     size_t memory_used = sizeof(*this);
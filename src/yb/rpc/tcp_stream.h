@@ -16,6 +16,7 @@
 
 #include <ev++.h>
 
+#include "yb/rpc/file_region.h"
 #include "yb/rpc/growable_buffer.h"
 #include "yb/rpc/stream.h"
 
@@ -35,16 +36,19 @@ struct TcpStreamSendingData {
     for (const auto& entry : bytes) {
       result += entry.size();
     }
-    return result;
+    return result + file.size();
   }
 
   void ClearBytes() {
     bytes.clear();
+    file = FileRegion();
     consumption = ScopedTrackedConsumption();
   }
 
   OutboundDataPtr data;
   SendingBytes bytes;
+  // Sent after bytes, directly from file to socket.
+  FileRegion file;
   ScopedTrackedConsumption consumption;
   bool skipped = false;
 };
@@ -67,6 +71,10 @@ class TcpStream : public Stream {
   struct FillIovResult {
     int len;
     bool only_heartbeats;
+    // When there is nothing to send with writev, but the next byte to send belongs to a file
+    // region, this is set to the region and the offset in it.
+    const FileRegion* file = nullptr;
+    size_t file_offset = 0;
   };
 
   CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
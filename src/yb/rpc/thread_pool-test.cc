@@ -27,9 +27,16 @@
 namespace yb {
 namespace rpc {
 
-class ThreadPoolTest : public YBTest {
+// Parameter is whether thread pool uses work stealing.
+class ThreadPoolTest : public YBTest, public ::testing::WithParamInterface<bool> {
+ protected:
+  ThreadPoolOptions Options(size_t queue_limit, size_t max_workers) {
+    return ThreadPoolOptions{"test", queue_limit, max_workers, GetParam()};
+  }
 };
 
+INSTANTIATE_TEST_CASE_P(WorkStealing, ThreadPoolTest, ::testing::Bool());
+
 enum class TestTaskState {
   IDLE,
   EXECUTED,
@@ -79,10 +86,10 @@ class TestTask final : public ThreadPoolTask {
   std::atomic<TestTaskState> state_ = { TestTaskState::IDLE };
 };
 
-TEST_F(ThreadPoolTest, TestSingleThread) {
+TEST_P(ThreadPoolTest, TestSingleThread) {
   constexpr size_t kTotalTasks = 100;
   constexpr size_t kTotalWorkers = 1;
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool(Options(kTotalTasks, kTotalWorkers));
 
   CountDownLatch latch(kTotalTasks);
   std::vector<TestTask> tasks(kTotalTasks);
@@ -96,10 +103,10 @@ TEST_F(ThreadPoolTest, TestSingleThread) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestSingleProducer) {
+TEST_P(ThreadPoolTest, TestSingleProducer) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool(Options(kTotalTasks, kTotalWorkers));
 
   CountDownLatch latch(kTotalTasks);
   std::vector<TestTask> tasks(kTotalTasks);
@@ -113,11 +120,11 @@ TEST_F(ThreadPoolTest, TestSingleProducer) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestMultiProducers) {
+TEST_P(ThreadPoolTest, TestMultiProducers) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
   constexpr size_t kProducers = 4;
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool(Options(kTotalTasks, kTotalWorkers));
 
   CountDownLatch latch(kTotalTasks);
   std::vector<TestTask> tasks(kTotalTasks);
@@ -143,11 +150,11 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestQueueOverflow) {
+TEST_P(ThreadPoolTest, TestQueueOverflow) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
   constexpr size_t kProducers = 4;
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool(Options(kTotalTasks, kTotalWorkers));
 
   CountDownLatch latch(kTotalTasks);
   std::vector<TestTask> tasks(kTotalTasks);
@@ -181,11 +188,11 @@ TEST_F(ThreadPoolTest, TestQueueOverflow) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestShutdown) {
+TEST_P(ThreadPoolTest, TestShutdown) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
   constexpr size_t kProducers = 4;
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool(Options(kTotalTasks, kTotalWorkers));
 
   CountDownLatch latch(kTotalTasks);
   std::vector<TestTask> tasks(kTotalTasks);
@@ -212,7 +219,7 @@ TEST_F(ThreadPoolTest, TestShutdown) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestOwns) {
+TEST_P(ThreadPoolTest, TestOwns) {
   class TestTask : public ThreadPoolTask {
    public:
     explicit TestTask(ThreadPool* thread_pool) : thread_pool_(thread_pool) {}
@@ -245,7 +252,7 @@ TEST_F(ThreadPoolTest, TestOwns) {
   constexpr size_t kTotalTasks = 1;
   constexpr size_t kTotalWorkers = 1;
 
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool(Options(kTotalTasks, kTotalWorkers));
   ASSERT_FALSE(pool.OwnsThisThread());
   TestTask task(&pool);
   pool.Enqueue(&task);
@@ -253,5 +260,99 @@ TEST_F(ThreadPoolTest, TestOwns) {
   ASSERT_TRUE(pool.Owns(task.thread()));
 }
 
+// Task that is blocked while tasks it submitted are not completed, so they should be executed by
+// another worker.
+TEST_P(ThreadPoolTest, TestBlockedWorker) {
+  class BlockingTask : public ThreadPoolTask {
+   public:
+    BlockingTask(ThreadPool* thread_pool, std::vector<TestTask>* tasks)
+        : thread_pool_(thread_pool), tasks_(tasks), tasks_latch_(tasks->size()) {}
+
+    void Run() override {
+      for (auto& task : *tasks_) {
+        task.SetLatch(&tasks_latch_);
+        ASSERT_TRUE(thread_pool_->Enqueue(&task));
+      }
+      tasks_completed_ = tasks_latch_.WaitFor(MonoDelta::FromSeconds(30));
+    }
+
+    void Done(const Status& status) override {
+      latch_.CountDown();
+    }
+
+    bool Wait() {
+      latch_.Wait();
+      return tasks_completed_;
+    }
+
+    virtual ~BlockingTask() {}
+
+   private:
+    ThreadPool* const thread_pool_;
+    std::vector<TestTask>* const tasks_;
+    CountDownLatch tasks_latch_;
+    CountDownLatch latch_{1};
+    bool tasks_completed_ = false;
+  };
+
+  constexpr size_t kTotalTasks = 100;
+  constexpr size_t kTotalWorkers = 2;
+
+  ThreadPool pool(Options(kTotalTasks, kTotalWorkers));
+  std::vector<TestTask> tasks(kTotalTasks);
+  BlockingTask blocking_task(&pool, &tasks);
+  ASSERT_TRUE(pool.Enqueue(&blocking_task));
+  ASSERT_TRUE(blocking_task.Wait());
+  for (auto& task : tasks) {
+    ASSERT_TRUE(task.IsCompleted());
+  }
+}
+
+// Tasks that wait for each other could complete only when each of them gets its own worker, even
+// when they are submitted while a worker is spinning.
+TEST_P(ThreadPoolTest, TestTasksWaitingForEachOther) {
+  class WaitingTask : public ThreadPoolTask {
+   public:
+    explicit WaitingTask(CountDownLatch* started) : started_(started) {}
+
+    void Run() override {
+      started_->CountDown();
+      all_started_ = started_->WaitFor(MonoDelta::FromSeconds(30));
+    }
+
+    void Done(const Status& status) override {
+      latch_.CountDown();
+    }
+
+    bool Wait() {
+      latch_.Wait();
+      return all_started_;
+    }
+
+    virtual ~WaitingTask() {}
+
+   private:
+    CountDownLatch* const started_;
+    CountDownLatch latch_{1};
+    bool all_started_ = false;
+  };
+
+  constexpr size_t kTotalWorkers = 4;
+  constexpr int kIterations = 10;
+
+  ThreadPool pool(Options(kTotalWorkers, kTotalWorkers));
+  for (int i = 0; i != kIterations; ++i) {
+    CountDownLatch started(kTotalWorkers);
+    std::vector<std::unique_ptr<WaitingTask>> tasks;
+    for (size_t j = 0; j != kTotalWorkers; ++j) {
+      tasks.emplace_back(new WaitingTask(&started));
+      ASSERT_TRUE(pool.Enqueue(tasks.back().get()));
+    }
+    for (auto& task : tasks) {
+      ASSERT_TRUE(task->Wait());
+    }
+  }
+}
+
 } // namespace rpc
 } // namespace yb
@@ -15,19 +15,40 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include <algorithm>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <mutex>
 #include <thread>
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/locks.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/thread.h"
 
+DEFINE_int32(rpc_thread_pool_spin_iterations, 100,
+             "Number of times an idle worker of a work stealing rpc thread pool looks for a task "
+             "before going to sleep.");
+TAG_FLAG(rpc_thread_pool_spin_iterations, advanced);
+TAG_FLAG(rpc_thread_pool_spin_iterations, runtime);
+
 namespace yb {
 namespace rpc {
 
+class ThreadPoolImpl {
+ public:
+  virtual ~ThreadPoolImpl() = default;
+
+  virtual const ThreadPoolOptions& options() const = 0;
+  virtual bool Enqueue(ThreadPoolTask* task) = 0;
+  virtual void Shutdown() = 0;
+  virtual bool Owns(Thread* thread) = 0;
+};
+
 namespace {
 
 class Worker;
@@ -153,11 +174,9 @@ class Worker {
   bool added_to_waiting_workers_ = false;
 };
 
-} // namespace
-
-class ThreadPool::Impl {
+class SharedQueueThreadPool : public ThreadPoolImpl {
  public:
-  explicit Impl(ThreadPoolOptions options)
+  explicit SharedQueueThreadPool(ThreadPoolOptions options)
       : share_(std::move(options)),
         queue_full_status_(STATUS_SUBSTITUTE(ServiceUnavailable,
                                              "Queue is full, max items: $0",
@@ -168,11 +187,11 @@ class ThreadPool::Impl {
     }
   }
 
-  const ThreadPoolOptions& options() const {
+  const ThreadPoolOptions& options() const override {
     return share_.options;
   }
 
-  bool Enqueue(ThreadPoolTask* task) {
+  bool Enqueue(ThreadPoolTask* task) override {
     ++adding_;
     if (closing_) {
       --adding_;
@@ -205,7 +224,7 @@ class ThreadPool::Impl {
     return true;
   }
 
-  void Shutdown() {
+  void Shutdown() override {
     // Block creating new workers.
     created_workers_ += workers_.size();
     {
@@ -235,7 +254,7 @@ class ThreadPool::Impl {
     }
   }
 
-  bool Owns(Thread* thread) {
+  bool Owns(Thread* thread) override {
     return thread && thread->user_data() == &share_;
   }
 
@@ -250,8 +269,403 @@ class ThreadPool::Impl {
   const Status queue_full_status_;
 };
 
+class StealingWorker;
+
+typedef cds::container::BasketQueue<cds::gc::DHP, StealingWorker*> ParkedWorkers;
+
+struct WorkStealingShare {
+  ThreadPoolOptions options;
+  // Tasks submitted before the first worker was created.
+  TaskQueue injected_tasks;
+  ParkedWorkers parked_workers;
+  // Created workers, the first num_workers entries are set.
+  std::unique_ptr<std::atomic<StealingWorker*>[]> workers;
+  std::atomic<size_t> num_workers{0};
+  // Spinning workers look for new tasks without sleeping, so there is no need to wake up other
+  // workers while there is a spinning one. Number of spinning workers is limited to avoid burning
+  // all cores when many workers are idle.
+  std::atomic<size_t> num_spinning{0};
+  const size_t max_spinning;
+  // Adds worker when all existing workers are busy.
+  std::function<void()> add_worker;
+
+  explicit WorkStealingShare(ThreadPoolOptions o)
+      : options(std::move(o)),
+        workers(new std::atomic<StealingWorker*>[options.max_workers]),
+        max_spinning(std::max<size_t>(1, std::thread::hardware_concurrency() / 2)) {
+    for (size_t i = 0; i != options.max_workers; ++i) {
+      workers[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  // Wakes one parked worker, returns false if there is no such worker.
+  bool WakeParkedWorker();
+
+  // Returns true if there are tasks that were not taken by workers.
+  bool HasQueuedTasks();
+};
+
+thread_local StealingWorker* current_stealing_worker = nullptr;
+
+// Threads submitting tasks, i.e. reactors, are spread over workers in order of their first
+// submission.
+std::atomic<size_t> next_thread_affinity{0};
+thread_local size_t thread_affinity = next_thread_affinity++;
+
+class StealingWorker {
+ public:
+  StealingWorker(WorkStealingShare* share, size_t index)
+      : share_(share), index_(index) {
+    auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
+    CHECK_OK(yb::Thread::Create(
+        kRpcThreadCategory, name, &StealingWorker::Execute, this, &thread_));
+  }
+
+  ~StealingWorker() {
+    Join();
+  }
+
+  StealingWorker(const StealingWorker& worker) = delete;
+  void operator=(const StealingWorker& worker) = delete;
+
+  WorkStealingShare* share() const {
+    return share_;
+  }
+
+  void Push(ThreadPoolTask* task) {
+    std::lock_guard<simple_spinlock> lock(queue_lock_);
+    queue_.push_back(task);
+    queue_size_.store(queue_.size(), std::memory_order_release);
+  }
+
+  bool HasQueuedTasks() const {
+    return queue_size_.load(std::memory_order_acquire) != 0;
+  }
+
+  // Owner takes tasks from the front of its queue, thieves take them from the back.
+  ThreadPoolTask* Pop(bool front) {
+    if (queue_size_.load(std::memory_order_acquire) == 0) {
+      return nullptr;
+    }
+    std::lock_guard<simple_spinlock> lock(queue_lock_);
+    if (queue_.empty()) {
+      return nullptr;
+    }
+    ThreadPoolTask* task;
+    if (front) {
+      task = queue_.front();
+      queue_.pop_front();
+    } else {
+      task = queue_.back();
+      queue_.pop_back();
+    }
+    queue_size_.store(queue_.size(), std::memory_order_release);
+    return task;
+  }
+
+  void Stop() {
+    stop_requested_ = true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    cond_.notify_one();
+  }
+
+  void Join() {
+    if (thread_) {
+      thread_->Join();
+      thread_.reset();
+    }
+  }
+
+  // Invoked when worker was popped from parked workers, see Worker::Notify.
+  bool Notify() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    added_to_parked_workers_ = false;
+    if (!waiting_task_) {
+      return false;
+    }
+    cond_.notify_one();
+    return true;
+  }
+
+  // Wakes the worker when it sleeps, so it would pick up the task just pushed to its queue.
+  bool WakeIfParked() {
+    if (!parked_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!waiting_task_) {
+      return false;
+    }
+    cond_.notify_one();
+    return true;
+  }
+
+ private:
+  void Execute() {
+    Thread::current_thread()->SetUserData(share_);
+    current_stealing_worker = this;
+    while (!stop_requested_) {
+      auto task = FindTask();
+      if (!task) {
+        task = Spin();
+      }
+      if (!task) {
+        task = Park();
+      }
+      if (task) {
+        task->Run();
+        task->Done(Status::OK());
+      }
+    }
+  }
+
+  ThreadPoolTask* FindTask() {
+    auto task = Pop(/* front= */ true);
+    if (task) {
+      return task;
+    }
+    if (share_->injected_tasks.pop(task)) {
+      return task;
+    }
+    // Start from the next worker, so thieves are spread over victims.
+    auto num_workers = share_->num_workers.load(std::memory_order_acquire);
+    for (size_t i = 1; i < num_workers; ++i) {
+      auto victim = share_->workers[(index_ + i) % num_workers].load(std::memory_order_acquire);
+      task = victim->Pop(/* front= */ false);
+      if (task) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  // Looks for a task for a while before going to sleep, since waking sleeping thread is
+  // expensive, both for the submitter and for the latency of the task.
+  ThreadPoolTask* Spin() {
+    auto spinning = share_->num_spinning.load(std::memory_order_acquire);
+    do {
+      if (spinning >= share_->max_spinning) {
+        return nullptr;
+      }
+    } while (!share_->num_spinning.compare_exchange_weak(spinning, spinning + 1));
+
+    ThreadPoolTask* task = nullptr;
+    for (auto i = FLAGS_rpc_thread_pool_spin_iterations; i > 0 && !stop_requested_; --i) {
+      task = FindTask();
+      if (task) {
+        break;
+      }
+      std::this_thread::yield();
+    }
+    // Submitters do not wake workers while there is a spinning one, relying on it to take their
+    // tasks. So the last spinner that is about to run a task hands over tasks submitted meanwhile.
+    // Pairs with fence in WorkStealingThreadPool::Enqueue, so either submitter sees that there is
+    // no spinning worker, or we see its task.
+    if (share_->num_spinning.fetch_sub(1, std::memory_order_seq_cst) == 1 && task &&
+        share_->HasQueuedTasks() && !share_->WakeParkedWorker()) {
+      share_->add_worker();
+    }
+    return task;
+  }
+
+  // Same protocol as Worker::PopTask, but tasks are looked for in all queues.
+  ThreadPoolTask* Park() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_task_ = true;
+    parked_.store(true, std::memory_order_relaxed);
+    auto se = ScopeExit([this] {
+      waiting_task_ = false;
+      parked_.store(false, std::memory_order_relaxed);
+    });
+
+    while (!stop_requested_) {
+      if (!added_to_parked_workers_) {
+        auto pushed = share_->parked_workers.push(this);
+        DCHECK(pushed); // BasketQueue always succeed.
+        added_to_parked_workers_ = true;
+      }
+
+      // Pairs with fence in WorkStealingThreadPool::Enqueue, so either submitter sees that we are
+      // parked, or we see its task.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto task = FindTask();
+      if (task) {
+        return task;
+      }
+
+      cond_.wait(lock);
+
+      task = FindTask();
+      if (task) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  WorkStealingShare* const share_;
+  const size_t index_;
+  scoped_refptr<yb::Thread> thread_;
+
+  simple_spinlock queue_lock_;
+  std::deque<ThreadPoolTask*> queue_;
+  std::atomic<size_t> queue_size_{0};
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::atomic<bool> stop_requested_ = {false};
+  std::atomic<bool> parked_ = {false};
+  bool waiting_task_ = false;
+  bool added_to_parked_workers_ = false;
+};
+
+bool WorkStealingShare::WakeParkedWorker() {
+  StealingWorker* worker = nullptr;
+  while (parked_workers.pop(worker)) {
+    if (worker->Notify()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingShare::HasQueuedTasks() {
+  if (!injected_tasks.empty()) {
+    return true;
+  }
+  auto num_created = num_workers.load(std::memory_order_acquire);
+  for (size_t i = 0; i != num_created; ++i) {
+    if (workers[i].load(std::memory_order_acquire)->HasQueuedTasks()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+class WorkStealingThreadPool : public ThreadPoolImpl {
+ public:
+  explicit WorkStealingThreadPool(ThreadPoolOptions options)
+      : share_(std::move(options)) {
+    workers_.resize(share_.options.max_workers);
+    share_.add_worker = [this] { AddWorker(); };
+  }
+
+  const ThreadPoolOptions& options() const override {
+    return share_.options;
+  }
+
+  bool Enqueue(ThreadPoolTask* task) override {
+    ++adding_;
+    if (closing_) {
+      --adding_;
+      task->Done(shutdown_status_);
+      return false;
+    }
+
+    auto* target = AffineWorker();
+    if (target) {
+      target->Push(task);
+    } else {
+      auto added = share_.injected_tasks.push(task);
+      DCHECK(added); // BasketQueue always succeed.
+    }
+
+    // Pairs with fence in StealingWorker::Park.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // A spinning worker takes the task, or hands it over when it is about to run another task.
+    bool woken = (target && target->WakeIfParked()) ||
+                 share_.num_spinning.load(std::memory_order_seq_cst) != 0 ||
+                 share_.WakeParkedWorker();
+    --adding_;
+
+    if (!woken) {
+      // All workers are busy.
+      AddWorker();
+    }
+    return true;
+  }
+
+  void Shutdown() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        CHECK(share_.injected_tasks.empty());
+        return;
+      }
+      closing_ = true;
+    }
+    auto num_workers = share_.num_workers.load(std::memory_order_acquire);
+    for (size_t i = 0; i != num_workers; ++i) {
+      workers_[i]->Stop();
+    }
+    // See SharedQueueThreadPool::Shutdown.
+    while (adding_ != 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    for (size_t i = 0; i != num_workers; ++i) {
+      workers_[i]->Join();
+      while (auto task = workers_[i]->Pop(/* front= */ true)) {
+        task->Done(shutdown_status_);
+      }
+    }
+    ThreadPoolTask* task = nullptr;
+    while (share_.injected_tasks.pop(task)) {
+      task->Done(shutdown_status_);
+    }
+  }
+
+  bool Owns(Thread* thread) override {
+    return thread && thread->user_data() == &share_;
+  }
+
+ private:
+  // Task submitted by worker of this pool is queued to this worker, otherwise submitting threads
+  // are spread over created workers.
+  StealingWorker* AffineWorker() {
+    auto* current = current_stealing_worker;
+    if (current && current->share() == &share_) {
+      return current;
+    }
+    auto num_workers = share_.num_workers.load(std::memory_order_acquire);
+    if (num_workers == 0) {
+      return nullptr;
+    }
+    return share_.workers[thread_affinity % num_workers].load(std::memory_order_acquire);
+  }
+
+  void AddWorker() {
+    if (share_.num_workers.load(std::memory_order_acquire) >= share_.options.max_workers) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto index = share_.num_workers.load(std::memory_order_acquire);
+    if (closing_ || index >= share_.options.max_workers) {
+      return;
+    }
+    workers_[index].reset(new StealingWorker(&share_, index));
+    share_.workers[index].store(workers_[index].get(), std::memory_order_release);
+    share_.num_workers.store(index + 1, std::memory_order_release);
+  }
+
+  WorkStealingShare share_;
+  std::vector<std::unique_ptr<StealingWorker>> workers_;
+  std::mutex mutex_;
+  std::atomic<bool> closing_ = {false};
+  std::atomic<size_t> adding_ = {0};
+  const Status shutdown_status_ = STATUS(Aborted, "Service is shutting down");
+};
+
+std::unique_ptr<ThreadPoolImpl> CreateThreadPoolImpl(ThreadPoolOptions options) {
+  if (options.work_stealing) {
+    return std::make_unique<WorkStealingThreadPool>(std::move(options));
+  }
+  return std::make_unique<SharedQueueThreadPool>(std::move(options));
+}
+
+} // namespace
+
 ThreadPool::ThreadPool(ThreadPoolOptions options)
-    : impl_(new Impl(std::move(options))) {
+    : impl_(CreateThreadPoolImpl(std::move(options))) {
 }
 
 ThreadPool::ThreadPool(ThreadPool&& rhs)
@@ -44,8 +44,13 @@ struct ThreadPoolOptions {
   std::string name;
   size_t queue_limit;
   size_t max_workers;
+  // Each worker has its own task queue, tasks are queued to the worker affine to the submitting
+  // thread, and idle workers steal tasks from busy ones. Otherwise all workers share one queue.
+  bool work_stealing = false;
 };
 
+class ThreadPoolImpl;
+
 class ThreadPool {
  public:
   explicit ThreadPool(ThreadPoolOptions options);
@@ -72,9 +77,7 @@ class ThreadPool {
   bool OwnsThisThread();
 
  private:
-  class Impl;
-
-  std::unique_ptr<Impl> impl_;
+  std::unique_ptr<ThreadPoolImpl> impl_;
 };
 
 } // namespace rpc
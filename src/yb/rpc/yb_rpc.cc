@@ -24,11 +24,14 @@
 #include "yb/rpc/reactor.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/serialization.h"
+#include "yb/rpc/tcp_stream.h"
 
 #include "yb/util/flag_tags.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/span_tracer.h"
+#include "yb/util/trace.h"
 
 using google::protobuf::io::CodedInputStream;
 using namespace yb::size_literals;
@@ -48,6 +51,12 @@ DEFINE_bool(enable_rpc_keepalive, true, "Whether to enable RPC keepalive mechani
 
 DEFINE_uint64(min_sidecar_buffer_size, 16_KB, "Minimal buffer to allocate for sidecar");
 
+DEFINE_bool(rpc_send_file_sidecars, true,
+            "Send file sidecars directly from file to socket using sendfile, when connection "
+            "is not encrypted. Otherwise file content is read to memory.");
+TAG_FLAG(rpc_send_file_sidecars, advanced);
+TAG_FLAG(rpc_send_file_sidecars, runtime);
+
 DEFINE_test_flag(int32, TEST_yb_inbound_big_calls_parse_delay_ms, false,
     "Test flag for simulating slow parsing of inbound calls larger than "
     "rpc_throttle_threshold_bytes");
@@ -289,6 +298,9 @@ Status YBInboundCall::ParseFrom(const MemTrackerPtr& mem_tracker, CallData* call
         header_.remote_method().InitializationErrorString());
   }
   remote_method_.FromPB(header_.remote_method());
+  // Caller sends its sampling decision, so only call from a caller without span tracing is a root.
+  trace_->set_span_trace_id(
+      header_.has_span_trace_id() ? header_.span_trace_id() : SampleSpanTrace());
 
   return Status::OK();
 }
@@ -306,6 +318,7 @@ size_t YBInboundCall::CopyToLastSidecarBuffer(const Slice& car) {
 }
 
 size_t YBInboundCall::AddRpcSidecar(Slice car) {
+  LOG_IF(DFATAL, file_sidecar_) << "File sidecar should be the last one";
   sidecar_offsets_.Add(total_sidecars_size_);
   total_sidecars_size_ += car.size();
   // Copy start of sidecar to existing buffer if present.
@@ -325,6 +338,21 @@ size_t YBInboundCall::AddRpcSidecar(Slice car) {
   return num_sidecars_++;
 }
 
+Result<size_t> YBInboundCall::AddRpcFileSidecar(FileRegion region) {
+  // Only plain TCP stream is able to send file content directly to socket.
+  ConnectionPtr conn = IsLocalCall() ? ConnectionPtr() : connection();
+  if (!FLAGS_rpc_send_file_sidecars || file_sidecar_ || !conn ||
+      conn->protocol() != TcpStream::StaticProtocol()) {
+    auto buffer = VERIFY_RESULT(region.Read());
+    return AddRpcSidecar(buffer.AsSlice());
+  }
+
+  sidecar_offsets_.Add(total_sidecars_size_);
+  total_sidecars_size_ += region.size();
+  file_sidecar_ = std::move(region);
+  return num_sidecars_++;
+}
+
 void YBInboundCall::ResetRpcSidecars() {
   if (consumption_) {
     for (const auto& buffer : sidecar_buffers_) {
@@ -336,6 +364,7 @@ void YBInboundCall::ResetRpcSidecars() {
   total_sidecars_size_ = 0;
   sidecar_buffers_.clear();
   sidecar_offsets_.Clear();
+  file_sidecar_ = FileRegion();
 }
 
 void YBInboundCall::ReserveSidecarSpace(size_t space) {
@@ -452,6 +481,26 @@ void YBInboundCall::Serialize(boost::container::small_vector_base<RefCntBuffer>*
     }
     sidecar_buffers_.clear();
   }
+  if (file_sidecar_) {
+    // Stream did not take file region, so we have to read it, see AddRpcFileSidecar.
+    auto buffer = file_sidecar_.Read();
+    if (buffer.ok()) {
+      output->push_back(std::move(*buffer));
+    } else {
+      // Frame size is already serialized, so send zeros that would not pass checksum verification.
+      LOG(DFATAL) << "Failed to read file sidecar: " << buffer.status();
+      RefCntBuffer zeros(file_sidecar_.size());
+      memset(zeros.data(), 0, zeros.size());
+      output->push_back(std::move(zeros));
+    }
+    file_sidecar_ = FileRegion();
+  }
+}
+
+FileRegion YBInboundCall::TakeFileRegion() {
+  FileRegion result;
+  std::swap(result, file_sidecar_);
+  return result;
 }
 
 Status YBInboundCall::ParseParam(google::protobuf::Message *message) {
@@ -125,6 +125,9 @@ class YBInboundCall : public InboundCall {
   // See RpcContext::AddRpcSidecar()
   virtual size_t AddRpcSidecar(Slice car);
 
+  // See RpcContext::AddRpcFileSidecar()
+  Result<size_t> AddRpcFileSidecar(FileRegion region);
+
   // See RpcContext::ResetRpcSidecars()
   void ResetRpcSidecars();
 
@@ -160,6 +163,8 @@ class YBInboundCall : public InboundCall {
   // The resulting slices refer to memory in this object.
   void Serialize(boost::container::small_vector_base<RefCntBuffer>* output) override;
 
+  FileRegion TakeFileRegion() override;
+
   void LogTrace() const override;
   std::string ToString() const override;
   bool DumpPB(const DumpRunningRpcsRequestPB& req, RpcCallInProgressPB* resp) override;
@@ -192,6 +197,8 @@ class YBInboundCall : public InboundCall {
   size_t total_sidecars_size_ = 0;
   boost::container::small_vector<RefCntBuffer, kMinBufferForSidecarSlices> sidecar_buffers_;
   google::protobuf::RepeatedField<uint32_t> sidecar_offsets_;
+  // Last sidecar, that is sent directly from file.
+  FileRegion file_sidecar_;
 
   // Serialize and queue the response.
   virtual void Respond(const google::protobuf::MessageLite& response, bool is_success);
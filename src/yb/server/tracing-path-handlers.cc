@@ -45,6 +45,7 @@
 
 #include "yb/gutil/strings/escaping.h"
 #include "yb/util/jsonwriter.h"
+#include "yb/util/span_tracer.h"
 #include "yb/util/debug/trace_event_impl.h"
 
 namespace yb {
@@ -70,7 +71,8 @@ enum Handler {
   kBeginRecording,
   kGetBufferPercentFull,
   kEndRecording,
-  kSimpleDump
+  kSimpleDump,
+  kSampledSpans
 };
 
 namespace {
@@ -205,6 +207,12 @@ void HandleTraceJsonPage(const Webserver::ArgumentMap &args,
   *output << TraceResultBuffer::FlushTraceLogToString();
 }
 
+// Dumps recently sampled spans, that could be loaded to chrome://tracing.
+void HandleSampledSpans(std::stringstream* output) {
+  JsonWriter writer(output, JsonWriter::COMPACT);
+  DumpSpansAsChromeTrace(&writer);
+}
+
 Status DoHandleRequest(Handler handler,
                        const Webserver::WebRequest& req,
                        std::stringstream* output) {
@@ -236,6 +244,9 @@ Status DoHandleRequest(Handler handler,
     case kSimpleDump:
       HandleTraceJsonPage(req.parsed_args, output);
       break;
+    case kSampledSpans:
+      HandleSampledSpans(output);
+      break;
   }
 
   return Status::OK();
@@ -269,7 +280,8 @@ void TracingPathHandlers::RegisterHandlers(Webserver* server) {
     { "/tracing/json/begin_recording", kBeginRecording },
     { "/tracing/json/get_buffer_percent_full", kGetBufferPercentFull },
     { "/tracing/json/end_recording", kEndRecording },
-    { "/tracing/json/simple_dump", kSimpleDump } };
+    { "/tracing/json/simple_dump", kSimpleDump },
+    { "/tracing/json/sampled_spans", kSampledSpans } };
 
   typedef pair<string, Handler> HandlerPair;
   for (const HandlerPair& e : handlers) {
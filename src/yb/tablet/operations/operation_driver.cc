@@ -45,6 +45,7 @@
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/span_tracer.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
@@ -369,6 +370,11 @@ void OperationDriver::ReplicationFinished(
     prepare_state_copy = prepare_state_;
   }
 
+  auto span_trace_id = trace_->span_trace_id();
+  if (PREDICT_FALSE(span_trace_id != 0)) {
+    RecordSpan("raft.replicate", span_trace_id, start_time_, MonoTime::Now());
+  }
+
   // If we have prepared and replicated, we're ready to move ahead and apply this operation.
   // Note that if we set the state to REPLICATION_FAILED above, ApplyOperation() will actually abort
   // the operation, i.e. ApplyTask() will never be called and the operation will never be applied to
@@ -429,6 +435,7 @@ Status OperationDriver::ApplyOperation(
 void OperationDriver::ApplyTask(int64_t leader_term, OpIds* applied_op_ids) {
   TRACE_EVENT_FLOW_END0("operation", "ApplyTask", this);
   ADOPT_TRACE(trace());
+  SCOPED_SPAN("tablet.apply_operation");
 
 #ifndef NDEBUG
   {
@@ -17,6 +17,8 @@
 
 #include "yb/common/pgsql_error.h"
 
+#include "yb/tablet/transaction_status_batcher.h"
+
 #include "yb/util/flag_tags.h"
 #include "yb/util/yb_pg_errcodes.h"
 
@@ -25,6 +27,12 @@ using namespace std::placeholders;
 DEFINE_test_flag(uint64, transaction_delay_status_reply_usec_in_tests, 0,
                  "For tests only. Delay handling status reply by specified amount of usec.");
 
+DEFINE_bool(enable_transaction_status_batcher, true,
+            "Send transaction status requests of participants via the node-wide batcher, that "
+            "combines requests to the same status tablet and caches final statuses.");
+TAG_FLAG(enable_transaction_status_batcher, advanced);
+TAG_FLAG(enable_transaction_status_batcher, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -183,6 +191,23 @@ boost::optional<TransactionStatus> RunningTransaction::GetStatusAt(
 
 void RunningTransaction::SendStatusRequest(
     int64_t serial_no, const RunningTransactionPtr& shared_self) {
+  auto* batcher = context_.participant_context_.status_batcher();
+  if (batcher && FLAGS_enable_transaction_status_batcher) {
+    // Participant waits for batched requests during shutdown, since they are not tracked by rpcs_.
+    context_.batched_status_requests_.fetch_add(1, std::memory_order_acq_rel);
+    batcher->RequestStatus(
+        metadata_.status_tablet, metadata_.transaction_id,
+        [this, serial_no, shared_self](
+            const Status& status, const tserver::GetTransactionStatusResponsePB& response) mutable {
+          auto& context = context_;
+          StatusReceived(status, response, serial_no, shared_self);
+          // Release transaction before notifying participant, since it could be destroyed after it.
+          shared_self.reset();
+          context.BatchedStatusRequestDone();
+        });
+    return;
+  }
+
   tserver::GetTransactionStatusRequestPB req;
   req.set_tablet_id(metadata_.status_tablet);
   req.add_transaction_id()->assign(
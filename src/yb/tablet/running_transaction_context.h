@@ -14,6 +14,9 @@
 #ifndef YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 #define YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 
+#include <atomic>
+#include <condition_variable>
+
 #include "yb/rpc/rpc.h"
 
 #include "yb/tablet/transaction_participant.h"
@@ -67,6 +70,14 @@ class RunningTransactionContext {
 
   virtual const std::string& LogPrefix() const = 0;
 
+  // Invoked when status request sent via TransactionStatusBatcher is completed.
+  void BatchedStatusRequestDone() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (batched_status_requests_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      batched_status_requests_cond_.notify_all();
+    }
+  }
+
   Delayer& delayer() {
     return delayer_;
   }
@@ -80,6 +91,11 @@ class RunningTransactionContext {
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  // Number of status requests sent via TransactionStatusBatcher that were not completed yet.
+  // Decremented under mutex_, so shutdown could wait for it on batched_status_requests_cond_.
+  std::atomic<size_t> batched_status_requests_{0};
+  std::condition_variable batched_status_requests_cond_;
+
   // Used only in tests.
   Delayer delayer_;
 };
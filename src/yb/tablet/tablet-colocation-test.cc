@@ -0,0 +1,119 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/wire_protocol.h"
+
+#include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/value.h"
+
+#include "yb/rocksdb/db.h"
+
+#include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/tablet-test-util.h"
+#include "yb/tablet/tablet.h"
+
+#include "yb/tserver/tserver_admin.pb.h"
+
+#include "yb/util/test_macros.h"
+
+DECLARE_int32(timestamp_history_retention_interval_sec);
+
+namespace yb {
+namespace tablet {
+
+class TabletColocationTest : public YBTabletTest {
+ public:
+  TabletColocationTest() : YBTabletTest(Schema({ ColumnSchema("key", STRING),
+                                                 ColumnSchema("val", STRING) },
+                                               1)) {
+    colocated_ = true;
+  }
+
+  void SetUp() override {
+    FLAGS_timestamp_history_retention_interval_sec = 0;
+    YBTabletTest::SetUp();
+  }
+
+ protected:
+  // Writes a row with the given key directly to the regular DB, under the given schema.
+  void WriteRow(const Schema& schema, const std::string& key) {
+    docdb::DocKey doc_key(schema);
+    doc_key.ResizeRangeComponents(1);
+    doc_key.SetRangeComponent(docdb::PrimitiveValue(key), 0 /* idx */);
+    const auto hybrid_time = clock()->Now();
+    docdb::SubDocKey sub_doc_key(
+        doc_key, docdb::PrimitiveValue::SystemColumnId(docdb::SystemColumnIds::kLivenessColumn),
+        DocHybridTime(hybrid_time));
+
+    rocksdb::WriteBatch write_batch;
+    write_batch.Put(
+        sub_doc_key.Encode().AsSlice(), docdb::Value(docdb::PrimitiveValue()).Encode());
+    docdb::ConsensusFrontiers frontiers;
+    set_op_id(OpId(1, ++last_op_index_), &frontiers);
+    set_hybrid_time(hybrid_time, &frontiers);
+    write_batch.SetFrontiers(&frontiers);
+    ASSERT_OK(tablet()->TEST_db()->Write(rocksdb::WriteOptions(), &write_batch));
+  }
+
+  int64_t last_op_index_ = 0;
+};
+
+// Dropping a table from a colocated tablet purges its rows from the shared RocksDB, while rows of
+// other tables stay intact.
+TEST_F(TabletColocationTest, DropTablePurgesRows) {
+  constexpr size_t kNumRows = 10;
+
+  const TableId table_id = GetPgsqlTableId(16384 /* database_oid */, 16385 /* table_oid */);
+  Schema table_schema({ ColumnSchema("key", STRING), ColumnSchema("val", STRING) },
+                      { ColumnId(10), ColumnId(11) }, 1);
+  TableInfoPB table_info;
+  table_info.set_table_id(table_id);
+  table_info.set_table_name("colocated_table");
+  table_info.set_table_type(TableType::PGSQL_TABLE_TYPE);
+  SchemaToPB(table_schema, table_info.mutable_schema());
+  ASSERT_OK(tablet()->AddTable(table_info));
+  // Schema stored in metadata has pgtable id assigned, so its rows are prefixed with it.
+  const Schema colocated_schema = ASSERT_RESULT(tablet()->metadata()->GetTableInfo(table_id))
+      ->schema;
+  ASSERT_TRUE(colocated_schema.has_pgtable_id());
+
+  for (size_t i = 0; i != kNumRows; ++i) {
+    WriteRow(colocated_schema, Format("row_$0", i));
+  }
+  WriteRow(schema(), "primary_row");
+  ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+  ASSERT_EQ(kNumRows + 1, tablet()->TEST_CountRegularDBRecords());
+
+  tserver::ChangeMetadataRequestPB req;
+  req.set_remove_table_id(table_id);
+  ChangeMetadataOperationState operation_state(tablet().get(), nullptr /* log */, &req);
+  operation_state.set_hybrid_time(clock()->Now());
+  operation_state.mutable_op_id()->set_term(1);
+  operation_state.mutable_op_id()->set_index(++last_op_index_);
+  ASSERT_OK(tablet()->RemoveTable(&operation_state));
+  ASSERT_NOK(tablet()->metadata()->GetTableInfo(table_id));
+  ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+
+  // Major compaction removes rows of the dropped table together with the table tombstone.
+  tablet()->ForceRocksDBCompactInTest();
+  ASSERT_EQ(1U, tablet()->TEST_CountRegularDBRecords());
+  const auto dump = tablet()->TEST_DocDBDumpStr();
+  ASSERT_STR_CONTAINS(dump, "primary_row");
+  ASSERT_EQ(std::string::npos, dump.find("\"row_")) << dump;
+}
+
+} // namespace tablet
+} // namespace yb
@@ -85,13 +85,15 @@ class TabletHarness {
           tablet_id("test_tablet_id"),
           root_dir(std::move(root_dir)),
           table_type(TableType::DEFAULT_TABLE_TYPE),
-          enable_metrics(true) {}
+          enable_metrics(true),
+          colocated(false) {}
 
     Env* env;
     string tablet_id;
     string root_dir;
     TableType table_type;
     bool enable_metrics;
+    bool colocated;
   };
 
   TabletHarness(const Schema& schema, Options options)
@@ -120,7 +122,8 @@ class TabletHarness {
                                                partition.second,
                                                boost::none /* index_info */,
                                                TABLET_DATA_READY,
-                                               &metadata));
+                                               &metadata,
+                                               options_.colocated));
     if (options_.enable_metrics) {
       metrics_registry_.reset(new MetricRegistry());
     }
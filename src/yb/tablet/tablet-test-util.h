@@ -101,6 +101,7 @@ class YBTabletTest : public YBTest {
   const Schema schema_;
   const Schema client_schema_;
   TableType table_type_;
+  bool colocated_ = false;
 
   std::unique_ptr<TabletHarness> harness_;
 };
@@ -32,6 +32,8 @@
 
 #include <time.h>
 
+#include <thread>
+
 #include <glog/logging.h>
 
 #include "yb/client/table.h"
@@ -40,8 +42,13 @@
 #include "yb/common/ql_expr.h"
 #include "yb/common/ql_rowwise_iterator_interface.h"
 
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/value.h"
+
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/join.h"
+#include "yb/gutil/strings/util.h"
+#include "yb/rocksdb/db.h"
 #include "yb/tablet/local_tablet_writer.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet-test-base.h"
@@ -62,6 +69,18 @@ namespace tablet {
 DEFINE_int32(testiterator_num_inserts, 1000,
              "Number of rows inserted in TestRowIterator/TestInsert");
 
+DEFINE_int32(write_throughput_num_inserts, 10000,
+             "Number of rows inserted by each mode of TestWriteThroughput");
+
+DEFINE_int32(write_throughput_num_threads, 4,
+             "Number of concurrent writers of the regular DB in TestWriteThroughput");
+
+DECLARE_bool(tablet_direct_memtable_writes);
+DECLARE_string(rocksdb_cold_data_dir);
+DECLARE_bool(rocksdb_fifo_compaction_for_ttl_tables);
+DECLARE_bool(enable_history_cutoff_propagation);
+DECLARE_int32(timestamp_history_retention_interval_sec);
+
 static_assert(to_underlying(TableType::YQL_TABLE_TYPE) ==
                   to_underlying(client::YBTableType::YQL_TABLE_TYPE),
               "Numeric code for YQL_TABLE_TYPE table type must be consistent");
@@ -72,6 +91,47 @@ static_assert(to_underlying(TableType::REDIS_TABLE_TYPE) ==
 template<class SETUP>
 class TestTablet : public TabletTestBase<SETUP> {
   typedef SETUP Type;
+
+ protected:
+  // Inserts count rows through the tablet starting from first_row, returns time it took.
+  MonoDelta InsertRows(bool direct, int64_t first_row, int64_t count) {
+    FLAGS_tablet_direct_memtable_writes = direct;
+    auto start = MonoTime::Now();
+    this->InsertTestRows(first_row, count, 0);
+    return MonoTime::Now() - start;
+  }
+
+  // Writes DocDB records from num_threads concurrent writers directly to the regular DB, since
+  // tablet operations are applied in hybrid time order. Returns time it took.
+  MonoDelta WriteRegularDBRecords(bool direct, int num_threads, int64_t per_thread) {
+    rocksdb::DB* db = this->tablet()->TEST_db();
+    auto start = MonoTime::Now();
+    std::vector<std::thread> writers;
+    for (int t = 0; t != num_threads; ++t) {
+      writers.emplace_back([this, db, direct, per_thread, t] {
+        for (int64_t i = 0; i != per_thread; ++i) {
+          docdb::SubDocKey sub_doc_key(
+              docdb::DocKey({ docdb::PrimitiveValue(Format("$0_$1_$2", direct, t, i)) }),
+              docdb::PrimitiveValue::SystemColumnId(docdb::SystemColumnIds::kLivenessColumn),
+              DocHybridTime(this->clock()->Now()));
+          rocksdb::WriteBatch write_batch;
+          write_batch.Put(
+              sub_doc_key.Encode().AsSlice(), docdb::Value(docdb::PrimitiveValue()).Encode());
+          if (direct) {
+            ASSERT_OK(db->DirectWrite(&write_batch));
+          } else {
+            rocksdb::WriteOptions write_options;
+            write_options.disableWAL = true;
+            ASSERT_OK(db->Write(write_options, &write_batch));
+          }
+        }
+      });
+    }
+    for (auto& writer : writers) {
+      writer.join();
+    }
+    return MonoTime::Now() - start;
+  }
 };
 TYPED_TEST_CASE(TestTablet, TabletTestHelperTypes);
 
@@ -215,5 +275,162 @@ TYPED_TEST(TestTablet, TestFlushedOpId) {
   ASSERT_EQ(id.index, start_index + 2*kCount);
 }
 
+// Checks that rows and records written directly to the memtable are stored the same way as
+// written via regular RocksDB writes, including concurrent writers.
+TYPED_TEST(TestTablet, TestDirectMemtableWrites) {
+  constexpr int64_t kCount = 100;
+  constexpr int kNumThreads = 4;
+
+  int64_t first_row = 0;
+  for (bool direct : {true, false}) {
+    this->InsertRows(direct, first_row, kCount);
+    first_row += kCount;
+  }
+
+  vector<string> rows;
+  ASSERT_OK(yb::tablet::DumpTablet(*this->tablet(), this->client_schema_, &rows));
+  ASSERT_EQ(static_cast<size_t>(first_row), rows.size());
+
+  const auto records_before = this->tablet()->TEST_CountRegularDBRecords();
+  for (bool direct : {true, false}) {
+    this->WriteRegularDBRecords(direct, kNumThreads, kCount);
+  }
+  ASSERT_EQ(records_before + static_cast<size_t>(2 * kNumThreads * kCount),
+            this->tablet()->TEST_CountRegularDBRecords());
+}
+
+// Compares write throughput of direct memtable writes with regular RocksDB writes.
+TYPED_TEST(TestTablet, TestWriteThroughput) {
+  if (!AllowSlowTests()) {
+    LOG(INFO) << "Skipping benchmark";
+    return;
+  }
+
+  const int64_t kCount = this->ClampRowCount(FLAGS_write_throughput_num_inserts);
+  int64_t first_row = 0;
+  for (bool direct : {true, false}) {
+    auto passed = this->InsertRows(direct, first_row, kCount);
+    first_row += kCount;
+    LOG(INFO) << (direct ? "Direct" : "Regular") << " memtable writes: " << kCount
+              << " rows in " << passed << ", "
+              << kCount / std::max(passed.ToSeconds(), 1e-6) << " rows/s";
+  }
+
+  const int num_threads = std::max(FLAGS_write_throughput_num_threads, 1);
+  const int64_t per_thread = kCount / num_threads;
+  for (bool direct : {true, false}) {
+    auto passed = this->WriteRegularDBRecords(direct, num_threads, per_thread);
+    LOG(INFO) << (direct ? "Direct" : "Regular") << " memtable writes by " << num_threads
+              << " threads: " << per_thread * num_threads << " records in " << passed << ", "
+              << per_thread * num_threads / std::max(passed.ToSeconds(), 1e-6) << " records/s";
+  }
+}
+
+// SST files placed in the cold data dir should remain readable after rocksdb_cold_data_dir is
+// cleared.
+TYPED_TEST(TestTablet, ReopenAfterColdDataDirCleared) {
+  constexpr int64_t kCount = 100;
+
+  FLAGS_rocksdb_cold_data_dir = this->GetTestPath("cold");
+  this->tablet()->StartShutdown();
+  this->tablet()->CompleteShutdown();
+  this->TabletReOpen();
+  const auto cold_dir = this->tablet()->metadata()->cold_rocksdb_dir();
+  ASSERT_FALSE(cold_dir.empty());
+
+  for (int i = 0; i != 2; ++i) {
+    this->InsertTestRows(i * kCount, kCount, 0);
+    ASSERT_OK(this->tablet()->Flush(FlushMode::kSync));
+  }
+  rocksdb::CompactRangeOptions compact_options;
+  compact_options.target_path_id = 1;
+  ASSERT_OK(this->tablet()->TEST_db()->CompactRange(compact_options, nullptr, nullptr));
+
+  std::vector<std::string> children;
+  ASSERT_OK(this->fs_manager()->env()->GetChildren(cold_dir, &children));
+  ASSERT_TRUE(std::any_of(children.begin(), children.end(), [](const std::string& name) {
+    return HasSuffixString(name, ".sst");
+  })) << AsString(children);
+
+  FLAGS_rocksdb_cold_data_dir.clear();
+  this->tablet()->StartShutdown();
+  this->tablet()->CompleteShutdown();
+  this->TabletReOpen();
+  ASSERT_EQ(cold_dir, this->tablet()->metadata()->cold_rocksdb_dir());
+
+  vector<string> rows;
+  ASSERT_OK(yb::tablet::DumpTablet(*this->tablet(), this->client_schema_, &rows));
+  ASSERT_EQ(static_cast<size_t>(2 * kCount), rows.size());
+}
+
+class TestTabletWithTtl : public YBTabletTest {
+ public:
+  TestTabletWithTtl() : YBTabletTest(CreateSchema()) {}
+
+  void InsertRows(int32_t count) {
+    LocalTabletWriter writer(tablet().get());
+    for (int32_t i = 0; i != count; ++i) {
+      QLWriteRequestPB req;
+      QLAddInt32HashValue(&req, i);
+      QLAddInt32ColumnValue(&req, kFirstColumnId + 1, i);
+      ASSERT_OK(writer.Write(&req));
+    }
+  }
+
+ private:
+  static Schema CreateSchema() {
+    Schema schema({ ColumnSchema("key", INT32, false, true),
+                    ColumnSchema("c1", INT32) }, 1);
+    schema.SetDefaultTimeToLive(3600 * 1000);
+    return schema;
+  }
+};
+
+// FIFO compaction supports only one db path, so it is not used for a tablet with cold data dir.
+TEST_F(TestTabletWithTtl, ReopenWithColdDataDirAndFifoCompaction) {
+  constexpr int32_t kCount = 100;
+
+  FLAGS_rocksdb_cold_data_dir = GetTestPath("cold");
+  tablet()->StartShutdown();
+  tablet()->CompleteShutdown();
+  TabletReOpen();
+  ASSERT_FALSE(tablet()->metadata()->cold_rocksdb_dir().empty());
+
+  InsertRows(kCount);
+  ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+
+  FLAGS_rocksdb_fifo_compaction_for_ttl_tables = true;
+  tablet()->StartShutdown();
+  tablet()->CompleteShutdown();
+  TabletReOpen();
+  ASSERT_EQ(rocksdb::kCompactionStyleUniversal,
+            tablet()->TEST_db()->GetOptions().compaction_style);
+
+  vector<string> rows;
+  ASSERT_OK(DumpTablet(*tablet(), client_schema(), &rows));
+  ASSERT_EQ(static_cast<size_t>(kCount), rows.size());
+}
+
+// Checking for expired files should not commit history cutoff, so reads at older time still work.
+TYPED_TEST(TestTablet, ProposedExpirationDirectiveDoesNotCommitCutoff) {
+  FLAGS_enable_history_cutoff_propagation = false;
+  FLAGS_timestamp_history_retention_interval_sec = 0;
+
+  auto* policy = this->tablet()->RetentionPolicy();
+  const auto read_time = this->tablet()->clock()->Now();
+
+  // Table has no TTL, so history cutoff is not even computed.
+  auto directive = policy->ProposedExpirationDirective();
+  ASSERT_TRUE(directive.table_ttl.Equals(docdb::Value::kMaxTtl));
+  ASSERT_FALSE(directive.history_cutoff.is_valid());
+  ASSERT_OK(policy->RegisterReaderTimestamp(read_time));
+  policy->UnregisterReaderTimestamp(read_time);
+
+  // Directive used by compaction commits history cutoff.
+  ASSERT_GT(policy->GetRetentionDirective().history_cutoff, read_time);
+  auto status = policy->RegisterReaderTimestamp(read_time);
+  ASSERT_TRUE(status.IsSnapshotTooOld()) << status;
+}
+
 } // namespace tablet
 } // namespace yb
@@ -78,7 +78,9 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_compaction_filter.h"
@@ -89,7 +91,9 @@
 #include "yb/docdb/lock_batch.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/primitive_value.h"
+#include "yb/docdb/primitive_value_util.h"
 #include "yb/docdb/redis_operation.h"
+#include "yb/docdb/value.h"
 
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/map-util.h"
@@ -123,12 +127,18 @@
 #include "yb/util/locks.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
+#include "yb/util/path_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/slice.h"
+#include "yb/util/span_tracer.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
 #include "yb/util/url-coding.h"
 
+using namespace yb::size_literals;  // NOLINT
+
 DEFINE_bool(tablet_do_dup_key_checks, true,
             "Whether to check primary keys for duplicate on insertion. "
             "Use at your own risk!");
@@ -190,6 +200,46 @@ TAG_FLAG(backfill_index_timeout_grace_margin_ms, runtime);
 DEFINE_bool(cleanup_intents_sst_files, true,
             "Cleanup intents files that are no more relevant to any running transaction.");
 
+DEFINE_uint64(apply_intents_ingest_threshold_bytes, 0,
+              "When the regular DB records produced by applying intents of a transaction are at "
+              "least this size, they are written to a separate SST file that is added to the "
+              "regular DB, instead of being written through the memtable. The file is added only "
+              "when its key range does not overlap existing data and no snapshots are held. "
+              "0 - disabled.");
+TAG_FLAG(apply_intents_ingest_threshold_bytes, advanced);
+TAG_FLAG(apply_intents_ingest_threshold_bytes, runtime);
+
+DEFINE_double(tablet_hot_keys_sampling_probability, 0.01,
+              "Probability of sampling a read or write operation to estimate the most frequently "
+              "accessed keys of the tablet. 0 - disabled.");
+TAG_FLAG(tablet_hot_keys_sampling_probability, advanced);
+TAG_FLAG(tablet_hot_keys_sampling_probability, runtime);
+
+DEFINE_int32(tablet_hot_keys_capacity, 64,
+             "Number of keys tracked by each of the tablet hot read and hot write keys sketches.");
+TAG_FLAG(tablet_hot_keys_capacity, advanced);
+
+DEFINE_bool(tablet_direct_memtable_writes, true,
+            "Apply Raft replicated write batches directly to the RocksDB memtable, forming "
+            "RocksDB write batch groups only when other writers are waiting. Concurrent memtable "
+            "inserts, see rocksdb_concurrent_memtable_writes, are used by such groups.");
+TAG_FLAG(tablet_direct_memtable_writes, advanced);
+TAG_FLAG(tablet_direct_memtable_writes, runtime);
+
+DEFINE_uint64(rocksdb_hot_data_size_bytes, 1_GB,
+              "Target size of SST files of the regular RocksDB kept in the tablet data dir, when "
+              "rocksdb_cold_data_dir is specified. Compactions place larger output files to the "
+              "cold data dir.");
+TAG_FLAG(rocksdb_hot_data_size_bytes, advanced);
+
+DEFINE_bool(rocksdb_fifo_compaction_for_ttl_tables, false,
+            "Use FIFO style compactions for the regular RocksDB of tables with default time to "
+            "live. SST files are never merged and are deleted once all their records have "
+            "expired. Should only be enabled for tables whose rows are not updated or deleted, "
+            "e.g. for time-series data. Applied when the tablet is opened. Ignored for tablets "
+            "that have a cold data dir, see rocksdb_cold_data_dir.");
+TAG_FLAG(rocksdb_fifo_compaction_for_ttl_tables, advanced);
+
 DEFINE_test_flag(int32, TEST_slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -208,6 +258,8 @@ DEFINE_test_flag(
 
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
+DECLARE_bool(rocksdb_concurrent_memtable_writes);
+DECLARE_string(rocksdb_cold_data_dir);
 
 using namespace std::placeholders;
 
@@ -352,6 +404,87 @@ docdb::PartialRangeKeyIntents UsePartialRangeKeyIntents(RaftGroupMetadata* metad
   return docdb::PartialRangeKeyIntents(metadata->table_type() == TableType::PGSQL_TABLE_TYPE);
 }
 
+bool ShouldSampleHotKeys() {
+  return RandomActWithProbability(FLAGS_tablet_hot_keys_sampling_probability);
+}
+
+// Returns prefix of the encoded key that is used as hot key. Hot keys are tracked at partition
+// granularity: up to hashed components for hash partitioned tables, i.e. all rows that share hash
+// columns are counted together, and whole doc key for range partitioned tables.
+Result<Slice> HotKeyPrefix(const Slice& encoded_key) {
+  auto id_size = VERIFY_RESULT(
+      docdb::DocKey::EncodedSize(encoded_key, docdb::DocKeyPart::UP_TO_ID));
+  auto sizes = VERIFY_RESULT(docdb::DocKey::EncodedHashPartAndDocKeySizes(encoded_key));
+  return Slice(encoded_key.data(), sizes.first > id_size ? sizes.first : sizes.second);
+}
+
+void AddHotKey(const Slice& encoded_key, HeavyHitters* hot_keys) {
+  auto prefix = HotKeyPrefix(encoded_key);
+  if (prefix.ok()) {
+    hot_keys->Add(*prefix);
+  } else {
+    VLOG(1) << "Failed to decode hot key " << encoded_key.ToDebugHexString() << ": "
+            << prefix.status();
+  }
+}
+
+void AddHotWriteKeys(const KeyValueWriteBatchPB& put_batch, HeavyHitters* hot_keys) {
+  // Consecutive pairs usually belong to the same row, so it is counted once per batch.
+  Slice last_prefix;
+  for (const auto& pair : put_batch.write_pairs()) {
+    auto prefix = HotKeyPrefix(pair.key());
+    if (!prefix.ok()) {
+      VLOG(1) << "Failed to decode hot key " << Slice(pair.key()).ToDebugHexString() << ": "
+              << prefix.status();
+      continue;
+    }
+    if (*prefix != last_prefix) {
+      hot_keys->Add(*prefix);
+      last_prefix = *prefix;
+    }
+  }
+}
+
+void AddHotReadKey(
+    const QLReadRequestPB& request, const Schema& schema, HeavyHitters* hot_keys) {
+  if (request.hashed_column_values().empty()) {
+    // Scan over multiple partitions.
+    return;
+  }
+  std::vector<PrimitiveValue> hashed_components;
+  auto status = docdb::QLKeyColumnValuesToPrimitiveValues(
+      request.hashed_column_values(), schema, 0, schema.num_hash_key_columns(),
+      &hashed_components);
+  if (status.ok()) {
+    docdb::DocKey doc_key(schema, request.hash_code(), std::move(hashed_components));
+    AddHotKey(doc_key.Encode().AsSlice(), hot_keys);
+  }
+}
+
+void AddHotReadKey(
+    const PgsqlReadRequestPB& request, const Schema& schema, HeavyHitters* hot_keys) {
+  if (request.has_ybctid_column_value()) {
+    AddHotKey(request.ybctid_column_value().value().binary_value(), hot_keys);
+    return;
+  }
+  if (!request.batch_arguments().empty()) {
+    for (const auto& batch_argument : request.batch_arguments()) {
+      AddHotKey(batch_argument.ybctid().value().binary_value(), hot_keys);
+    }
+    return;
+  }
+  if (request.partition_column_values().empty() || schema.num_hash_key_columns() == 0) {
+    return;
+  }
+  std::vector<PrimitiveValue> hashed_components;
+  auto status = docdb::InitKeyColumnPrimitiveValues(
+      request.partition_column_values(), schema, 0, &hashed_components);
+  if (status.ok()) {
+    docdb::DocKey doc_key(schema, request.hash_code(), std::move(hashed_components));
+    AddHotKey(doc_key.Encode().AsSlice(), hot_keys);
+  }
+}
+
 } // namespace
 
 string DocDbOpIds::ToString() const {
@@ -385,7 +518,9 @@ Tablet::Tablet(const TabletInitData& data)
       log_prefix_suffix_(data.log_prefix_suffix),
       is_sys_catalog_(data.is_sys_catalog),
       txns_enabled_(data.txns_enabled),
-      retention_policy_(std::make_shared<TabletRetentionPolicy>(clock_, metadata_.get())) {
+      retention_policy_(std::make_shared<TabletRetentionPolicy>(clock_, metadata_.get())),
+      hot_read_keys_(FLAGS_tablet_hot_keys_capacity),
+      hot_write_keys_(FLAGS_tablet_hot_keys_capacity) {
   CHECK(schema()->has_column_ids());
   LOG_WITH_PREFIX(INFO) << " Schema version for  " << metadata_->table_name() << " is "
                         << metadata_->schema_version();
@@ -589,6 +724,8 @@ Status Tablet::OpenKeyValueTablet() {
 
   rocksdb::Options rocksdb_options;
   InitRocksDBOptions(&rocksdb_options, LogPrefix(docdb::StorageDbType::kRegular));
+  docdb::SetMemTableConcurrentWrites(
+      rocksdb::ConcurrentWrites(FLAGS_rocksdb_concurrent_memtable_writes), &rocksdb_options);
   rocksdb_options.mem_tracker = MemTracker::FindOrCreateTracker(kRegularDB, mem_tracker_);
   rocksdb_options.block_based_table_mem_tracker =
       MemTracker::FindOrCreateTracker(
@@ -621,6 +758,53 @@ Status Tablet::OpenKeyValueTablet() {
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
 
+  const auto intents_compaction_style = rocksdb_options.compaction_style;
+  if (FLAGS_rocksdb_fifo_compaction_for_ttl_tables &&
+      rocksdb_options.compaction_style == rocksdb::kCompactionStyleUniversal &&
+      !docdb::TableTTL(metadata()->schema()).Equals(docdb::Value::kMaxTtl)) {
+    if (!metadata()->cold_rocksdb_dir().empty()) {
+      // FIFO compaction supports only one db path, while files of this tablet could already be
+      // placed to the cold dir.
+      LOG_WITH_PREFIX(WARNING)
+          << "Ignoring rocksdb_fifo_compaction_for_ttl_tables, since tablet has cold data dir "
+          << metadata()->cold_rocksdb_dir();
+    } else {
+      // Files are deleted only when DocDBCompactionFilterFactory reports them as expired, so
+      // expiry cost is proportional to the number of files rather than to the amount of data.
+      rocksdb_options.compaction_style = rocksdb::kCompactionStyleFIFO;
+      rocksdb_options.compaction_options_fifo.max_table_files_size =
+          std::numeric_limits<uint64_t>::max();
+    }
+  }
+
+  const bool cold_storage_enabled =
+      !FLAGS_rocksdb_cold_data_dir.empty() &&
+      rocksdb_options.compaction_style == rocksdb::kCompactionStyleUniversal;
+  auto cold_db_dir = metadata()->cold_rocksdb_dir();
+  if (cold_db_dir.empty() && cold_storage_enabled) {
+    // Recorded before RocksDB could place any file there, so the cold dir stays in db_paths after
+    // rocksdb_cold_data_dir is changed or cleared.
+    cold_db_dir = metadata()->configured_cold_rocksdb_dir();
+    metadata()->set_cold_rocksdb_dir(cold_db_dir);
+    RETURN_NOT_OK(metadata()->Flush());
+  }
+  if (!cold_db_dir.empty()) {
+    if (cold_storage_enabled && cold_db_dir != metadata()->configured_cold_rocksdb_dir()) {
+      LOG_WITH_PREFIX(WARNING) << "rocksdb_cold_data_dir was changed, keep using cold data dir "
+                               << cold_db_dir;
+    }
+    RETURN_NOT_OK(metadata()->fs_manager()->env()->CreateDirs(cold_db_dir));
+    // Flushed files and small compaction outputs stay in the data dir. Universal compaction
+    // merges files in time order, so larger outputs contain older data and are placed to the cold
+    // dir, see UniversalCompactionPicker::GetPathId. Both paths share the block cache.
+    // When cold storage is disabled, files in the cold dir are still read, while compaction
+    // outputs are placed to the data dir.
+    rocksdb_options.db_paths = {
+        {db_dir, cold_storage_enabled ? FLAGS_rocksdb_hot_data_size_bytes
+                                      : std::numeric_limits<uint64_t>::max()},
+        {cold_db_dir, std::numeric_limits<uint64_t>::max()}};
+  }
+
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
   rocksdb::Status rocksdb_open_status = rocksdb::DB::Open(rocksdb_options, db_dir, &db);
@@ -638,6 +822,12 @@ Status Tablet::OpenKeyValueTablet() {
   if (transaction_participant_) {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
     docdb::SetLogPrefix(&rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
+    // Intents are erased from memtable by single deletes, that requires exclusive memtable writer.
+    docdb::SetMemTableConcurrentWrites(rocksdb::ConcurrentWrites::kFalse, &rocksdb_options);
+    // Intents are short lived, so they are always kept in the data dir, and are cleaned up by
+    // regular compactions.
+    rocksdb_options.db_paths.clear();
+    rocksdb_options.compaction_style = intents_compaction_style;
 
     rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
       return std::bind(&Tablet::IntentsDbFlushFilter, this, _1);
@@ -880,12 +1070,15 @@ CHECKED_STATUS ResetRocksDB(
   }
 
   auto dir = (**db).GetName();
+  // SST files could also reside in the cold data dir.
+  auto destroy_options = options;
+  destroy_options.db_paths = (**db).GetDBOptions().db_paths;
   db->reset();
   if (!destroy) {
     return Status::OK();
   }
 
-  return rocksdb::DestroyDB(dir, options);
+  return rocksdb::DestroyDB(dir, destroy_options);
 }
 
 Status Tablet::ResetRocksDBs(bool destroy) {
@@ -967,6 +1160,10 @@ Status Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
   if (metrics_) {
     metrics_->rows_inserted->IncrementBy(write_request.write_batch().write_pairs().size());
   }
+  // Operations replayed during bootstrap are not sampled.
+  if (operation_state->consensus_round() && ShouldSampleHotKeys()) {
+    AddHotWriteKeys(put_batch, &hot_write_keys_);
+  }
 
   return ApplyOperationState(*operation_state, write_request.batch_idx(), put_batch);
 }
@@ -1033,6 +1230,7 @@ Status Tablet::ApplyKeyValueRowOperations(int64_t batch_idx,
   if (put_batch.write_pairs().empty() && put_batch.read_pairs().empty()) {
     return Status::OK();
   }
+  SCOPED_SPAN("docdb.apply_write_batch");
 
   // Could return failure only for cases where it is safe to skip applying operations to DB.
   // For instance where aborted transaction intents are written.
@@ -1066,12 +1264,19 @@ void Tablet::WriteToRocksDB(
 
   write_batch->SetFrontiers(frontiers);
 
-  // We are using Raft replication index for the RocksDB sequence number for
-  // all members of this write batch.
-  rocksdb::WriteOptions write_options;
-  InitRocksDBWriteOptions(&write_options);
+  rocksdb::Status rocksdb_write_status;
+  if (GetAtomicFlag(&FLAGS_tablet_direct_memtable_writes)) {
+    // Batch is already persisted and ordered by the Raft log, so WAL is not needed, and batch
+    // grouping is only needed when there are concurrent writers.
+    rocksdb_write_status = dest_db->DirectWrite(write_batch);
+  } else {
+    // We are using Raft replication index for the RocksDB sequence number for
+    // all members of this write batch.
+    rocksdb::WriteOptions write_options;
+    InitRocksDBWriteOptions(&write_options);
 
-  auto rocksdb_write_status = dest_db->Write(write_options, write_batch);
+    rocksdb_write_status = dest_db->Write(write_options, write_batch);
+  }
   if (!rocksdb_write_status.ok()) {
     LOG_WITH_PREFIX(FATAL) << "Failed to write a batch with " << write_batch->Count()
                            << " operations into RocksDB: " << rocksdb_write_status;
@@ -1167,6 +1372,7 @@ Status Tablet::HandleQLReadRequest(
     const QLReadRequestPB& ql_read_request,
     const TransactionMetadataPB& transaction_metadata,
     QLReadRequestResult* result) {
+  SCOPED_SPAN("docdb.ql_read");
   ScopedRWOperation scoped_read_operation(&pending_op_counter_, deadline);
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
@@ -1177,6 +1383,10 @@ Status Tablet::HandleQLReadRequest(
     return Status::OK();
   }
 
+  if (ShouldSampleHotKeys()) {
+    AddHotReadKey(ql_read_request, metadata()->schema(), &hot_read_keys_);
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata, /* is_ysql_catalog_table */ false);
   RETURN_NOT_OK(txn_op_ctx);
@@ -1464,6 +1674,7 @@ Status Tablet::HandlePgsqlReadRequest(
     const PgsqlReadRequestPB& pgsql_read_request,
     const TransactionMetadataPB& transaction_metadata,
     PgsqlReadRequestResult* result) {
+  SCOPED_SPAN("docdb.pgsql_read");
   ScopedRWOperation scoped_read_operation(&pending_op_counter_, deadline);
   RETURN_NOT_OK(scoped_read_operation);
   // TODO(neil) Work on metrics for PGSQL.
@@ -1478,6 +1689,10 @@ Status Tablet::HandlePgsqlReadRequest(
     return Status::OK();
   }
 
+  if (ShouldSampleHotKeys()) {
+    AddHotReadKey(pgsql_read_request, table_info->schema, &hot_read_keys_);
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(
           transaction_metadata,
@@ -1686,15 +1901,41 @@ void InitFrontiers(const Data& data, docdb::ConsensusFrontiers* frontiers) {
 // After that we delete both intent record and reverse index record.
 // TODO(dtxn) use multiple batches when applying really big transaction.
 Status Tablet::ApplyIntents(const TransactionApplyData& data) {
-  rocksdb::WriteBatch regular_write_batch;
-  RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-      data.transaction_id, data.commit_ht, &key_bounds_,
-      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */));
-
   // data.hybrid_time contains transaction commit time.
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
+
+  rocksdb::WriteBatch regular_write_batch;
+  const auto ingest_threshold = FLAGS_apply_intents_ingest_threshold_bytes;
+  if (ingest_threshold) {
+    docdb::IngestBatch ingest_batch;
+    RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
+        data.transaction_id, data.commit_ht, &key_bounds_, &ingest_batch, intents_db_.get()));
+    if (ingest_batch.data_size() >= ingest_threshold) {
+      // Ingested file is not tracked by flushed frontier, so if we restart before the regular DB
+      // is flushed, this apply would be replayed and the same records would be written again.
+      // That is harmless since they have the same keys and values.
+      auto sst_path = JoinPathSegments(
+          metadata_->rocksdb_dir(), Format("apply-$0.sst.tmp", data.transaction_id));
+      auto status = ingest_batch.Ingest(sst_path, frontiers, regular_db_.get());
+      if (status.ok()) {
+        VLOG_WITH_PREFIX(2) << "Ingested " << ingest_batch.data_size()
+                            << " bytes of intents of " << data.transaction_id;
+        return Status::OK();
+      }
+      // The most common reasons are that the key range of the transaction overlaps with existing
+      // data or that the regular DB holds snapshots, so fall back to regular write.
+      VLOG_WITH_PREFIX(1) << "Failed to ingest intents of " << data.transaction_id << ": "
+                          << status;
+    }
+    ingest_batch.AppendTo(&regular_write_batch);
+  } else {
+    RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
+        data.transaction_id, data.commit_ht, &key_bounds_,
+        &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */));
+  }
+
   WriteToRocksDB(&frontiers, &regular_write_batch, StorageDbType::kRegular);
   return Status::OK();
 }
@@ -1773,7 +2014,27 @@ Status Tablet::AddTable(const TableInfoPB& table_info) {
   return Status::OK();
 }
 
-Status Tablet::RemoveTable(const std::string& table_id) {
+Status Tablet::RemoveTable(ChangeMetadataOperationState* operation_state) {
+  const auto& table_id = operation_state->request()->remove_table_id();
+  if (metadata_->colocated()) {
+    // Write a table-level tombstone, so rows of the dropped table are reclaimed by the next major
+    // compaction instead of staying in the shared RocksDB forever. Writing it again during
+    // bootstrap replay is harmless, and the table could be already missing from the metadata then.
+    auto table_info = metadata_->GetTableInfo(table_id);
+    const Schema* schema = table_info.ok() ? &(*table_info)->schema : nullptr;
+    if (schema && (schema->has_cotable_id() || schema->has_pgtable_id())) {
+      ScopedRWOperation scoped_operation(&pending_op_counter_);
+      RETURN_NOT_OK(scoped_operation);
+      rocksdb::WriteBatch write_batch;
+      docdb::SubDocKey table_key(
+          docdb::DocKey(*schema), DocHybridTime(operation_state->hybrid_time()));
+      write_batch.Put(table_key.Encode().AsSlice(), docdb::Value::EncodedTombstone());
+      docdb::ConsensusFrontiers frontiers;
+      set_op_id(yb::OpId::FromPB(operation_state->op_id()), &frontiers);
+      set_hybrid_time(operation_state->hybrid_time(), &frontiers);
+      WriteToRocksDB(&frontiers, &write_batch, StorageDbType::kRegular);
+    }
+  }
   metadata_->RemoveTable(table_id);
   RETURN_NOT_OK(metadata_->Flush());
   return Status::OK();
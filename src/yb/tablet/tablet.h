@@ -79,6 +79,7 @@
 #include "yb/util/status.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/enums.h"
+#include "yb/util/heavy_hitters.h"
 
 #include "yb/gutil/thread_annotations.h"
 
@@ -377,7 +378,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   CHECKED_STATUS AddTable(const TableInfoPB& table_info);
 
   // Apply replicated remove table operation.
-  CHECKED_STATUS RemoveTable(const std::string& table_id);
+  CHECKED_STATUS RemoveTable(ChangeMetadataOperationState* operation_state);
 
   // Truncate this tablet by resetting the content of RocksDB.
   CHECKED_STATUS Truncate(TruncateOperationState* state);
@@ -417,6 +418,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Return handle to the metric entity of this tablet.
   const scoped_refptr<MetricEntity>& GetMetricEntity() const { return metric_entity_; }
 
+  // Most frequently read and written keys of this tablet, estimated from sampled operations.
+  // Keys are encoded doc keys, truncated after hashed components for hash partitioned tables.
+  const HeavyHitters& hot_read_keys() const { return hot_read_keys_; }
+  const HeavyHitters& hot_write_keys() const { return hot_write_keys_; }
+
   // Returns a reference to this tablet's memory tracker.
   const std::shared_ptr<MemTracker>& mem_tracker() const { return mem_tracker_; }
 
@@ -805,6 +811,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::shared_ptr<TabletRetentionPolicy> retention_policy_;
 
+  HeavyHitters hot_read_keys_;
+  HeavyHitters hot_write_keys_;
+
   DISALLOW_COPY_AND_ASSIGN(Tablet);
 };
 
@@ -47,6 +47,7 @@ class TransactionCoordinator;
 class TransactionCoordinatorContext;
 class TransactionParticipant;
 class TransactionParticipantContext;
+class TransactionStatusBatcher;
 class UpdateTxnOperationState;
 class WriteOperationState;
 
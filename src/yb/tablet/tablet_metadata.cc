@@ -70,6 +70,14 @@ TAG_FLAG(enable_tablet_orphaned_block_deletion, advanced);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, hidden);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, runtime);
 
+DEFINE_string(rocksdb_cold_data_dir, "",
+              "Directory on a cheaper and larger device, where regular RocksDB of each tablet "
+              "places SST files that outgrow rocksdb_hot_data_size_bytes during compaction. "
+              "Should be unique per server. Empty value places new SST files in the data dir. "
+              "Tablet keeps reading SST files from the cold data dir it used before, even after "
+              "this flag is changed or cleared.");
+TAG_FLAG(rocksdb_cold_data_dir, advanced);
+
 using std::shared_ptr;
 
 using base::subtle::Barrier_AtomicIncrement;
@@ -192,6 +200,7 @@ Status KvStoreInfo::LoadTablesFromPB(
 Status KvStoreInfo::LoadFromPB(const KvStoreInfoPB& pb, TableId primary_table_id) {
   kv_store_id = KvStoreId(pb.kv_store_id());
   rocksdb_dir = pb.rocksdb_dir();
+  cold_rocksdb_dir = pb.cold_rocksdb_dir();
   lower_bound_key = pb.lower_bound_key();
   upper_bound_key = pb.upper_bound_key();
   return LoadTablesFromPB(pb.tables(), primary_table_id);
@@ -200,6 +209,11 @@ Status KvStoreInfo::LoadFromPB(const KvStoreInfoPB& pb, TableId primary_table_id
 void KvStoreInfo::ToPB(TableId primary_table_id, KvStoreInfoPB* pb) const {
   pb->set_kv_store_id(kv_store_id.ToString());
   pb->set_rocksdb_dir(rocksdb_dir);
+  if (cold_rocksdb_dir.empty()) {
+    pb->clear_cold_rocksdb_dir();
+  } else {
+    pb->set_cold_rocksdb_dir(cold_rocksdb_dir);
+  }
   if (lower_bound_key.empty()) {
     pb->clear_lower_bound_key();
   } else {
@@ -316,7 +330,8 @@ Status RaftGroupMetadata::LoadOrCreate(FsManager* fs_manager,
                                     const Partition& partition,
                                     const boost::optional<IndexInfo>& index_info,
                                     const TabletDataState& initial_tablet_data_state,
-                                    RaftGroupMetadataPtr* metadata) {
+                                    RaftGroupMetadataPtr* metadata,
+                                    const bool colocated) {
   Status s = Load(fs_manager, raft_group_id, metadata);
   if (s.ok()) {
     if (!(*metadata)->schema().Equals(schema)) {
@@ -328,7 +343,9 @@ Status RaftGroupMetadata::LoadOrCreate(FsManager* fs_manager,
   } else if (s.IsNotFound()) {
     return CreateNew(fs_manager, table_id, raft_group_id, table_name, table_type,
                      schema, IndexMap(), partition_schema, partition, index_info,
-                     0 /* schema_version */, initial_tablet_data_state, metadata);
+                     0 /* schema_version */, initial_tablet_data_state, metadata,
+                     std::string() /* data_root_dir */, std::string() /* wal_root_dir */,
+                     colocated);
   } else {
     return s;
   }
@@ -409,6 +426,15 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb data directory " << rocksdb_dir;
   }
 
+  const auto cold_dir = cold_rocksdb_dir();
+  if (!cold_dir.empty()) {
+    if (fs_manager_->env()->FileExists(cold_dir)) {
+      auto s = fs_manager_->env()->DeleteRecursively(cold_dir);
+      LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb cold data directory " << cold_dir;
+    }
+    set_cold_rocksdb_dir(std::string());
+  }
+
   const auto intents_dir = rocksdb_dir + kIntentsDBSuffix;
   if (fs_manager_->env()->FileExists(intents_dir)) {
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
@@ -763,6 +789,25 @@ string RaftGroupMetadata::wal_root_dir() const {
   }
 }
 
+std::string RaftGroupMetadata::cold_rocksdb_dir() const {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  return kv_store_.cold_rocksdb_dir;
+}
+
+void RaftGroupMetadata::set_cold_rocksdb_dir(const std::string& cold_rocksdb_dir) {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  kv_store_.cold_rocksdb_dir = cold_rocksdb_dir;
+}
+
+std::string RaftGroupMetadata::configured_cold_rocksdb_dir() const {
+  const auto& rocksdb_dir = kv_store_.rocksdb_dir;
+  if (FLAGS_rocksdb_cold_data_dir.empty() || rocksdb_dir.empty()) {
+    return "";
+  }
+  return JoinPathSegments(
+      FLAGS_rocksdb_cold_data_dir, BaseName(DirName(rocksdb_dir)), BaseName(rocksdb_dir));
+}
+
 void RaftGroupMetadata::set_wal_retention_secs(uint32 wal_retention_secs) {
   std::lock_guard<MutexType> lock(data_mutex_);
   auto it = kv_store_.tables.find(primary_table_id_);
@@ -833,6 +878,8 @@ Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateSubtabletMetadata(
   metadata->kv_store_.lower_bound_key = lower_bound_key;
   metadata->kv_store_.upper_bound_key = upper_bound_key;
   metadata->kv_store_.rocksdb_dir = GetSubRaftGroupDataDir(raft_group_id);
+  // Checkpoint of the parent places all SST files to the data dir of the child.
+  metadata->kv_store_.cold_rocksdb_dir.clear();
   metadata->partition_ = partition;
   metadata->state_ = kInitialized;
   metadata->tablet_data_state_ = TABLET_DATA_UNKNOWN;
@@ -140,6 +140,10 @@ struct KvStoreInfo {
   // `rocksdb_dir + kIntentsDBSuffix` path.
   std::string rocksdb_dir;
 
+  // The directory where the regular RocksDB places SST files on cold storage, empty if cold
+  // storage was never used by this KV-store.
+  std::string cold_rocksdb_dir;
+
   // Optional inclusive lower bound and exclusive upper bound for keys served by this KV-store.
   // See docdb::KeyBounds.
   std::string lower_bound_key;
@@ -207,7 +211,8 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
                                      const Partition& partition,
                                      const boost::optional<IndexInfo>& index_info,
                                      const TabletDataState& initial_tablet_data_state,
-                                     RaftGroupMetadataPtr* metadata);
+                                     RaftGroupMetadataPtr* metadata,
+                                     const bool colocated = false);
 
   Result<const TableInfo*> GetTableInfo(const TableId& table_id) const;
 
@@ -324,6 +329,17 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   // /mnt/d0/yb-data/tserver/wals
   std::string wal_root_dir() const;
 
+  // Returns the dir for SST files of the regular RocksDB moved to cold storage, that is recorded
+  // when cold storage is first used. Returns empty string if cold storage was never used.
+  std::string cold_rocksdb_dir() const;
+
+  void set_cold_rocksdb_dir(const std::string& cold_rocksdb_dir);
+
+  // Returns the dir for SST files of the regular RocksDB in rocksdb_cold_data_dir, for example:
+  // /mnt/cold/table-<table_id>/tablet-<raft_group_id>
+  // Returns empty string when cold storage is not configured.
+  std::string configured_cold_rocksdb_dir() const;
+
   void SetSchema(const Schema& schema,
                  const IndexMap& index_map,
                  const std::vector<DeletedColumn>& deleted_cols,
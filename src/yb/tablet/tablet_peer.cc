@@ -154,7 +154,9 @@ TabletPeer::TabletPeer(
     const std::string& permanent_uuid,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     MetricRegistry* metric_registry,
-    TabletSplitter* tablet_splitter)
+    TabletSplitter* tablet_splitter,
+    TransactionStatusBatcher* status_batcher,
+    consensus::MultiRaftManager* multi_raft_manager)
     : meta_(meta),
       tablet_id_(meta->raft_group_id()),
       local_peer_pb_(local_peer_pb),
@@ -167,7 +169,9 @@ TabletPeer::TabletPeer(
       permanent_uuid_(permanent_uuid),
       preparing_operations_counter_(operation_tracker_.LogPrefix()),
       metric_registry_(metric_registry),
-      tablet_splitter_(tablet_splitter) {}
+      tablet_splitter_(tablet_splitter),
+      status_batcher_(status_batcher),
+      multi_raft_manager_(multi_raft_manager) {}
 
 TabletPeer::~TabletPeer() {
   std::lock_guard<simple_spinlock> lock(lock_);
@@ -267,7 +271,8 @@ Status TabletPeer::InitTabletPeer(
         tablet_->table_type(),
         raft_pool,
         retryable_requests,
-        split_op_id);
+        split_op_id,
+        multi_raft_manager_);
     has_consensus_.store(true, std::memory_order_release);
 
     tablet_->SetHybridTimeLeaseProvider(std::bind(&TabletPeer::HybridTimeLease, this, _1, _2));
@@ -96,6 +96,9 @@ class TabletPeer : public consensus::ConsensusContext,
 
   // Creates TabletPeer.
   // `tablet_splitter` will be used for applying split tablet Raft operation.
+  // `status_batcher` is used by transaction participant to request transaction statuses, could be
+  // nullptr.
+  // `multi_raft_manager` is used to coalesce Raft heartbeats to the same server, could be nullptr.
   TabletPeer(
       const RaftGroupMetadataPtr& meta,
       const consensus::RaftPeerPB& local_peer_pb,
@@ -103,7 +106,9 @@ class TabletPeer : public consensus::ConsensusContext,
       const std::string& permanent_uuid,
       Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
       MetricRegistry* metric_registry,
-      TabletSplitter* tablet_splitter);
+      TabletSplitter* tablet_splitter,
+      TransactionStatusBatcher* status_batcher = nullptr,
+      consensus::MultiRaftManager* multi_raft_manager = nullptr);
 
   ~TabletPeer();
 
@@ -287,6 +292,10 @@ class TabletPeer : public consensus::ConsensusContext,
     return client_future_;
   }
 
+  TransactionStatusBatcher* status_batcher() const override {
+    return status_batcher_;
+  }
+
   int64_t LeaderTerm() const override;
   consensus::LeaderStatus LeaderStatus(bool allow_stale = false) const;
 
@@ -454,6 +463,10 @@ class TabletPeer : public consensus::ConsensusContext,
 
   TabletSplitter* tablet_splitter_;
 
+  TransactionStatusBatcher* const status_batcher_;
+
+  consensus::MultiRaftManager* const multi_raft_manager_;
+
   DISALLOW_COPY_AND_ASSIGN(TabletPeer);
 };
 
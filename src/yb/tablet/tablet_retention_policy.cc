@@ -17,6 +17,7 @@
 #include "yb/common/transaction_error.h"
 
 #include "yb/docdb/doc_ttl_util.h"
+#include "yb/docdb/value.h"
 
 #include "yb/server/hybrid_clock.h"
 
@@ -63,10 +64,8 @@ HistoryRetentionDirective TabletRetentionPolicy::GetRetentionDirective() {
   HybridTime history_cutoff;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (FLAGS_enable_history_cutoff_propagation) {
-      history_cutoff = SanitizeHistoryCutoff(committed_history_cutoff_);
-    } else {
-      history_cutoff = EffectiveHistoryCutoff();
+    history_cutoff = ProposedHistoryCutoff();
+    if (!FLAGS_enable_history_cutoff_propagation) {
       committed_history_cutoff_ = std::max(history_cutoff, committed_history_cutoff_);
     }
   }
@@ -84,6 +83,24 @@ HistoryRetentionDirective TabletRetentionPolicy::GetRetentionDirective() {
               ShouldRetainDeleteMarkersInMajorCompaction())};
 }
 
+HistoryRetentionDirective TabletRetentionPolicy::ProposedExpirationDirective() {
+  HistoryRetentionDirective result;
+  result.table_ttl = TableTTL(metadata_.schema());
+  if (result.table_ttl.Equals(docdb::Value::kMaxTtl)) {
+    return result;
+  }
+  result.retain_delete_markers_in_major_compaction =
+      docdb::ShouldRetainDeleteMarkersInMajorCompaction(
+          ShouldRetainDeleteMarkersInMajorCompaction());
+  if (result.retain_delete_markers_in_major_compaction) {
+    return result;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  result.history_cutoff = ProposedHistoryCutoff();
+  return result;
+}
+
 Status TabletRetentionPolicy::RegisterReaderTimestamp(HybridTime timestamp) {
   std::lock_guard<std::mutex> lock(mutex_);
   if (timestamp < committed_history_cutoff_) {
@@ -129,6 +146,11 @@ HybridTime TabletRetentionPolicy::HistoryCutoffToPropagate(HybridTime last_write
   return EffectiveHistoryCutoff();
 }
 
+HybridTime TabletRetentionPolicy::ProposedHistoryCutoff() {
+  return FLAGS_enable_history_cutoff_propagation
+      ? SanitizeHistoryCutoff(committed_history_cutoff_) : EffectiveHistoryCutoff();
+}
+
 HybridTime TabletRetentionPolicy::EffectiveHistoryCutoff() {
   auto retention_delta = -FLAGS_timestamp_history_retention_interval_sec * 1s;
   // We try to garbage-collect history older than current time minus the configured retention
@@ -30,6 +30,8 @@ class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
 
   docdb::HistoryRetentionDirective GetRetentionDirective() override;
 
+  docdb::HistoryRetentionDirective ProposedExpirationDirective() override;
+
   // Tries to update history cutoff to proposed value, not allowing it to decrease.
   // Returns new committed history cutoff value.
   HybridTime UpdateCommittedHistoryCutoff(HybridTime new_value);
@@ -50,6 +52,9 @@ class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
   bool ShouldRetainDeleteMarkersInMajorCompaction() const;
   HybridTime EffectiveHistoryCutoff() REQUIRES(mutex_);
 
+  // Returns history cutoff that GetRetentionDirective would use, without committing it.
+  HybridTime ProposedHistoryCutoff() REQUIRES(mutex_);
+
   // Check proposed history cutoff against other restrictions (for instance min reading timestamp),
   // and returns most close value that satisfy them.
   HybridTime SanitizeHistoryCutoff(HybridTime proposed_history_cutoff) REQUIRES(mutex_);
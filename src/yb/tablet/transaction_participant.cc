@@ -155,6 +155,18 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     }
 
     rpcs_.Shutdown();
+    // Status requests sent via batcher are completed at most after RPC deadline.
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto wait_start = CoarseMonoClock::now();
+      while (batched_status_requests_.load(std::memory_order_acquire) != 0) {
+        if (batched_status_requests_cond_.wait_for(lock, 10s) == std::cv_status::timeout) {
+          LOG_WITH_PREFIX(WARNING)
+              << "Waiting for " << batched_status_requests_.load(std::memory_order_acquire)
+              << " batched status requests for " << MonoDelta(CoarseMonoClock::now() - wait_start);
+        }
+      }
+    }
     if (load_thread_.joinable()) {
       load_thread_.join();
     }
@@ -107,6 +107,9 @@ class TransactionParticipantContext {
   virtual const std::shared_future<client::YBClient*>& client_future() const = 0;
   virtual const server::ClockPtr& clock_ptr() const = 0;
 
+  // Node-wide batcher for transaction status requests, nullptr if not available.
+  virtual TransactionStatusBatcher* status_batcher() const = 0;
+
   // Fills RemoveIntentsData with information about replicated state.
   virtual void GetLastReplicatedData(RemoveIntentsData* data) = 0;
 
@@ -0,0 +1,239 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include <atomic>
+#include <mutex>
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/server/logical_clock.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const TabletId kStatusTablet = "status_tablet";
+
+// RPC that is completed by the test, or aborted by the batcher.
+class MockStatusRpc : public rpc::RpcCommand {
+ public:
+  MockStatusRpc(
+      const tserver::GetTransactionStatusRequestPB& req,
+      client::GetTransactionStatusCallback callback)
+      : req_(req), callback_(std::move(callback)),
+        deadline_(CoarseMonoClock::now() + 10s) {}
+
+  void SendRpc() override {}
+
+  std::string ToString() const override {
+    return "MockStatusRpc: " + req_.ShortDebugString();
+  }
+
+  void Finished(const Status& status) override {}
+
+  void Abort() override {
+    Complete(STATUS(Aborted, "Aborted"), tserver::GetTransactionStatusResponsePB());
+  }
+
+  CoarseTimePoint deadline() const override {
+    return deadline_;
+  }
+
+  void Complete(const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+    if (!completed_.exchange(true)) {
+      callback_(status, response);
+    }
+  }
+
+  std::vector<TransactionId> TransactionIds() const {
+    std::vector<TransactionId> result;
+    for (const auto& id : req_.transaction_id()) {
+      result.push_back(CHECK_RESULT(FullyDecodeTransactionId(id)));
+    }
+    return result;
+  }
+
+ private:
+  const tserver::GetTransactionStatusRequestPB req_;
+  const client::GetTransactionStatusCallback callback_;
+  const CoarseTimePoint deadline_;
+  std::atomic<bool> completed_{false};
+};
+
+struct StatusResult {
+  bool done = false;
+  Status status;
+  TransactionStatus txn_status = TransactionStatus::CREATED;
+
+  client::GetTransactionStatusCallback Callback() {
+    return [this](const Status& s, const tserver::GetTransactionStatusResponsePB& response) {
+      ASSERT_FALSE(done);
+      done = true;
+      status = s;
+      if (s.ok()) {
+        ASSERT_EQ(1, response.status().size());
+        txn_status = response.status(0);
+      }
+    };
+  }
+};
+
+tserver::GetTransactionStatusResponsePB MakeResponse(
+    std::initializer_list<TransactionStatus> statuses) {
+  tserver::GetTransactionStatusResponsePB response;
+  for (auto status : statuses) {
+    response.add_status(status);
+    response.add_status_hybrid_time(HybridTime::FromMicros(1000).ToUint64());
+  }
+  return response;
+}
+
+} // namespace
+
+class TransactionStatusBatcherTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    batcher_ = std::make_unique<TransactionStatusBatcher>(
+        [this](tserver::GetTransactionStatusRequestPB* req,
+               client::GetTransactionStatusCallback callback) {
+          auto rpc = std::make_shared<MockStatusRpc>(*req, std::move(callback));
+          std::lock_guard<std::mutex> lock(mutex_);
+          rpcs_.push_back(rpc);
+          return rpc;
+        },
+        server::ClockPtr(server::LogicalClock::CreateStartingAt(HybridTime::kInitial)));
+  }
+
+  void TearDown() override {
+    batcher_->Shutdown();
+    YBTest::TearDown();
+  }
+
+  size_t NumRpcs() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rpcs_.size();
+  }
+
+  std::shared_ptr<MockStatusRpc> Rpc(size_t idx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rpcs_[idx];
+  }
+
+  std::unique_ptr<TransactionStatusBatcher> batcher_;
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<MockStatusRpc>> rpcs_;
+};
+
+TEST_F(TransactionStatusBatcherTest, BatchRequests) {
+  const auto txn1 = TransactionId::GenerateRandom();
+  const auto txn2 = TransactionId::GenerateRandom();
+  const auto txn3 = TransactionId::GenerateRandom();
+  StatusResult result1, result2, result2_dup, result3;
+
+  batcher_->RequestStatus(kStatusTablet, txn1, result1.Callback());
+  ASSERT_EQ(1U, NumRpcs());
+  ASSERT_EQ((std::vector<TransactionId>{txn1}), Rpc(0)->TransactionIds());
+
+  // Requests that arrive while RPC is in flight are combined into the next RPC.
+  batcher_->RequestStatus(kStatusTablet, txn2, result2.Callback());
+  batcher_->RequestStatus(kStatusTablet, txn3, result3.Callback());
+  batcher_->RequestStatus(kStatusTablet, txn2, result2_dup.Callback());
+  ASSERT_EQ(1U, NumRpcs());
+
+  Rpc(0)->Complete(Status::OK(), MakeResponse({TransactionStatus::PENDING}));
+  ASSERT_TRUE(result1.done);
+  ASSERT_OK(result1.status);
+  ASSERT_EQ(TransactionStatus::PENDING, result1.txn_status);
+  ASSERT_FALSE(result2.done);
+
+  ASSERT_EQ(2U, NumRpcs());
+  // Duplicate requests for the same transaction share one entry.
+  ASSERT_EQ((std::vector<TransactionId>{txn2, txn3}), Rpc(1)->TransactionIds());
+  Rpc(1)->Complete(
+      Status::OK(), MakeResponse({TransactionStatus::COMMITTED, TransactionStatus::ABORTED}));
+  for (auto* result : {&result2, &result2_dup, &result3}) {
+    ASSERT_TRUE(result->done);
+    ASSERT_OK(result->status);
+  }
+  ASSERT_EQ(TransactionStatus::COMMITTED, result2.txn_status);
+  ASSERT_EQ(TransactionStatus::COMMITTED, result2_dup.txn_status);
+  ASSERT_EQ(TransactionStatus::ABORTED, result3.txn_status);
+
+  // Final status is answered from cache, without RPC.
+  StatusResult cached_result;
+  batcher_->RequestStatus(kStatusTablet, txn2, cached_result.Callback());
+  ASSERT_TRUE(cached_result.done);
+  ASSERT_EQ(TransactionStatus::COMMITTED, cached_result.txn_status);
+  ASSERT_EQ(2U, NumRpcs());
+}
+
+TEST_F(TransactionStatusBatcherTest, Failures) {
+  StatusResult result1, result2;
+  batcher_->RequestStatus(kStatusTablet, TransactionId::GenerateRandom(), result1.Callback());
+  batcher_->RequestStatus(kStatusTablet, TransactionId::GenerateRandom(), result2.Callback());
+  ASSERT_EQ(1U, NumRpcs());
+
+  // All callbacks of the batch are invoked with RPC error, for instance timeout.
+  Rpc(0)->Complete(STATUS(TimedOut, "Timed out"), tserver::GetTransactionStatusResponsePB());
+  ASSERT_TRUE(result1.done);
+  ASSERT_TRUE(result1.status.IsTimedOut()) << result1.status;
+  ASSERT_FALSE(result2.done);
+
+  // Response that does not match the request size fails the batch.
+  ASSERT_EQ(2U, NumRpcs());
+  Rpc(1)->Complete(
+      Status::OK(), MakeResponse({TransactionStatus::COMMITTED, TransactionStatus::COMMITTED}));
+  ASSERT_TRUE(result2.done);
+  ASSERT_TRUE(result2.status.IsIllegalState()) << result2.status;
+  ASSERT_EQ(2U, NumRpcs());
+}
+
+TEST_F(TransactionStatusBatcherTest, ShutdownWithRequestsInFlight) {
+  StatusResult in_flight, pending, other_tablet;
+  batcher_->RequestStatus(kStatusTablet, TransactionId::GenerateRandom(), in_flight.Callback());
+  batcher_->RequestStatus(kStatusTablet, TransactionId::GenerateRandom(), pending.Callback());
+  batcher_->RequestStatus(
+      "other_status_tablet", TransactionId::GenerateRandom(), other_tablet.Callback());
+  ASSERT_EQ(2U, NumRpcs());
+
+  // Shutdown fails pending requests and aborts RPCs in flight, without sending new ones.
+  batcher_->Shutdown();
+  for (auto* result : {&in_flight, &pending, &other_tablet}) {
+    ASSERT_TRUE(result->done);
+    ASSERT_TRUE(result->status.IsAborted()) << result->status;
+  }
+  ASSERT_EQ(2U, NumRpcs());
+
+  StatusResult after_shutdown;
+  batcher_->RequestStatus(
+      kStatusTablet, TransactionId::GenerateRandom(), after_shutdown.Callback());
+  ASSERT_TRUE(after_shutdown.done);
+  ASSERT_TRUE(after_shutdown.status.IsAborted()) << after_shutdown.status;
+  ASSERT_EQ(2U, NumRpcs());
+}
+
+} // namespace tablet
+} // namespace yb
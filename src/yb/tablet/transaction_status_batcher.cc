@@ -0,0 +1,332 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include <deque>
+
+#include <gflags/gflags.h>
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flag_tags.h"
+
+using namespace std::placeholders;
+
+DEFINE_uint64(transaction_status_batch_max_size, 128,
+              "Max number of transactions in status request sent by the node-wide transaction "
+              "status batcher.");
+TAG_FLAG(transaction_status_batch_max_size, advanced);
+
+DEFINE_int32(transaction_status_cache_ttl_ms, 1000,
+             "For how long the final status of a transaction is cached by the node-wide "
+             "transaction status batcher. 0 disables the cache.");
+TAG_FLAG(transaction_status_cache_ttl_ms, advanced);
+TAG_FLAG(transaction_status_cache_ttl_ms, runtime);
+
+DEFINE_uint64(transaction_status_cache_max_size, 100000,
+              "Max number of entries in the transaction status cache of the node-wide transaction "
+              "status batcher.");
+TAG_FLAG(transaction_status_cache_max_size, advanced);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+tserver::GetTransactionStatusResponsePB MakeResponse(
+    TransactionStatus status, uint64_t status_hybrid_time) {
+  tserver::GetTransactionStatusResponsePB response;
+  response.add_status(status);
+  response.add_status_hybrid_time(status_hybrid_time);
+  return response;
+}
+
+} // namespace
+
+class TransactionStatusBatcher::Impl {
+ public:
+  Impl(RpcFactory rpc_factory, server::ClockPtr clock)
+      : rpc_factory_(std::move(rpc_factory)), clock_(std::move(clock)) {}
+
+  ~Impl() {
+    Shutdown();
+  }
+
+  void Shutdown() {
+    std::vector<Waiter> waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        return;
+      }
+      closing_ = true;
+      for (auto& tablet_and_queue : queues_) {
+        auto& pending = tablet_and_queue.second.pending;
+        std::move(pending.begin(), pending.end(), std::back_inserter(waiters));
+        pending.clear();
+      }
+    }
+    const auto status = STATUS(Aborted, "Transaction status batcher is shutting down");
+    for (const auto& waiter : waiters) {
+      waiter.second(status, tserver::GetTransactionStatusResponsePB());
+    }
+    // Aborted RPCs fail their batches in StatusReceived.
+    rpcs_.Shutdown();
+  }
+
+  void RequestStatus(
+      const TabletId& status_tablet, const TransactionId& transaction_id,
+      client::GetTransactionStatusCallback callback) {
+    tserver::GetTransactionStatusRequestPB req;
+    TabletQueue* queue;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (closing_) {
+        lock.unlock();
+        callback(STATUS(Aborted, "Transaction status batcher is shutting down"),
+                 tserver::GetTransactionStatusResponsePB());
+        return;
+      }
+      auto it = cache_.find(transaction_id);
+      if (it != cache_.end() && it->second.expiration > CoarseMonoClock::now()) {
+        auto response = MakeResponse(it->second.status, it->second.status_hybrid_time);
+        lock.unlock();
+        callback(Status::OK(), response);
+        return;
+      }
+      auto queue_it = queues_.find(status_tablet);
+      if (queue_it == queues_.end()) {
+        queue_it = queues_.emplace(status_tablet, TabletQueue(rpcs_.InvalidHandle())).first;
+      }
+      queue = &queue_it->second;
+      queue->pending.emplace_back(transaction_id, std::move(callback));
+      if (!queue->in_flight.empty()) {
+        return;
+      }
+      PrepareRequestUnlocked(status_tablet, queue, &req);
+    }
+    Send(status_tablet, queue, &req);
+  }
+
+ private:
+  using Waiter = std::pair<TransactionId, client::GetTransactionStatusCallback>;
+  using Callbacks = std::vector<client::GetTransactionStatusCallback>;
+
+  struct TabletQueue {
+    explicit TabletQueue(rpc::Rpcs::Handle invalid_handle) : handle(invalid_handle) {}
+
+    // Waiters that will be sent with the next request.
+    std::vector<Waiter> pending;
+    // Transactions of the request in flight, in the same order as in request.
+    // Not empty while there is a request in flight.
+    std::vector<std::pair<TransactionId, Callbacks>> in_flight;
+    rpc::Rpcs::Handle handle;
+  };
+
+  struct CacheEntry {
+    TransactionStatus status;
+    uint64_t status_hybrid_time;
+    CoarseTimePoint expiration;
+  };
+
+  // Moves pending waiters of the queue to the in flight batch and fills request for it.
+  void PrepareRequestUnlocked(
+      const TabletId& status_tablet, TabletQueue* queue,
+      tserver::GetTransactionStatusRequestPB* req) {
+    const auto max_size = std::max<uint64_t>(FLAGS_transaction_status_batch_max_size, 1);
+    std::unordered_map<TransactionId, size_t, TransactionIdHash> indexes;
+    auto w = queue->pending.begin();
+    for (auto& waiter : queue->pending) {
+      auto it = indexes.find(waiter.first);
+      if (it != indexes.end()) {
+        queue->in_flight[it->second].second.push_back(std::move(waiter.second));
+      } else if (queue->in_flight.size() < max_size) {
+        indexes.emplace(waiter.first, queue->in_flight.size());
+        queue->in_flight.emplace_back(waiter.first, Callbacks{std::move(waiter.second)});
+      } else {
+        *w = std::move(waiter);
+        ++w;
+      }
+    }
+    queue->pending.erase(w, queue->pending.end());
+
+    req->set_tablet_id(status_tablet);
+    req->set_propagated_hybrid_time(clock_->Now().ToUint64());
+    for (const auto& entry : queue->in_flight) {
+      req->add_transaction_id()->assign(
+          pointer_cast<const char*>(entry.first.data()), entry.first.size());
+    }
+  }
+
+  void Send(
+      const TabletId& status_tablet, TabletQueue* queue,
+      tserver::GetTransactionStatusRequestPB* req) {
+    auto started = rpcs_.RegisterAndStart(
+        rpc_factory_(req, std::bind(&Impl::StatusReceived, this, _1, _2, status_tablet)),
+        &queue->handle);
+    if (!started) {
+      StatusReceived(
+          STATUS(Aborted, "Transaction status batcher is shutting down"),
+          tserver::GetTransactionStatusResponsePB(), status_tablet);
+    }
+  }
+
+  void StatusReceived(
+      const Status& status, const tserver::GetTransactionStatusResponsePB& response,
+      const TabletId& status_tablet) {
+    if (response.has_propagated_hybrid_time()) {
+      clock_->Update(HybridTime(response.propagated_hybrid_time()));
+    }
+
+    decltype(TabletQueue::in_flight) batch;
+    std::vector<Waiter> aborted_waiters;
+    tserver::GetTransactionStatusRequestPB req;
+    TabletQueue* next_queue = nullptr;
+    Status batch_status = status;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = queues_.find(status_tablet);
+      if (it == queues_.end()) {
+        LOG(DFATAL) << "Status received for unknown status tablet: " << status_tablet;
+        return;
+      }
+      auto& queue = it->second;
+      rpcs_.Unregister(&queue.handle);
+      batch.swap(queue.in_flight);
+
+      if (batch_status.ok() && response.status().size() != batch.size()) {
+        // Node with old software version would always return 1 status.
+        batch_status = STATUS_FORMAT(
+            IllegalState, "Bad response size, expected $0 entries, but found: $1",
+            batch.size(), response.ShortDebugString());
+      }
+      if (batch_status.ok()) {
+        CacheStatusesUnlocked(batch, response);
+      }
+
+      if (closing_) {
+        aborted_waiters.swap(queue.pending);
+      }
+      if (!queue.pending.empty()) {
+        PrepareRequestUnlocked(status_tablet, &queue, &req);
+        next_queue = &queue;
+      } else {
+        queues_.erase(it);
+      }
+    }
+
+    if (next_queue) {
+      Send(status_tablet, next_queue, &req);
+    }
+
+    for (size_t i = 0; i != batch.size(); ++i) {
+      tserver::GetTransactionStatusResponsePB txn_response;
+      if (batch_status.ok()) {
+        txn_response = MakeResponse(
+            response.status(i),
+            i < response.status_hybrid_time().size() ? response.status_hybrid_time(i)
+                                                     : HybridTime::kMax.ToUint64());
+        if (i < response.num_replicated_batches().size()) {
+          txn_response.add_num_replicated_batches(response.num_replicated_batches(i));
+        }
+      }
+      for (const auto& callback : batch[i].second) {
+        callback(batch_status, txn_response);
+      }
+    }
+
+    const auto aborted_status = STATUS(Aborted, "Transaction status batcher is shutting down");
+    for (const auto& waiter : aborted_waiters) {
+      waiter.second(aborted_status, tserver::GetTransactionStatusResponsePB());
+    }
+  }
+
+  void CacheStatusesUnlocked(
+      const decltype(TabletQueue::in_flight)& batch,
+      const tserver::GetTransactionStatusResponsePB& response) {
+    const auto ttl_ms = FLAGS_transaction_status_cache_ttl_ms;
+    if (ttl_ms <= 0) {
+      return;
+    }
+    const auto now = CoarseMonoClock::now();
+    // Since all entries have the same ttl, the expiration order matches the insertion order.
+    while (!cache_queue_.empty() &&
+           (cache_queue_.front().first <= now ||
+            cache_.size() >= FLAGS_transaction_status_cache_max_size)) {
+      auto it = cache_.find(cache_queue_.front().second);
+      if (it != cache_.end() && it->second.expiration == cache_queue_.front().first) {
+        cache_.erase(it);
+      }
+      cache_queue_.pop_front();
+    }
+
+    const auto expiration = now + std::chrono::milliseconds(ttl_ms);
+    for (size_t i = 0; i != batch.size(); ++i) {
+      auto txn_status = response.status(i);
+      // Only final statuses could be cached, since they never change.
+      if ((txn_status != TransactionStatus::COMMITTED &&
+           txn_status != TransactionStatus::ABORTED) ||
+          i >= response.status_hybrid_time().size() ||
+          cache_.size() >= FLAGS_transaction_status_cache_max_size) {
+        continue;
+      }
+      const auto& txn_id = batch[i].first;
+      cache_[txn_id] = CacheEntry{txn_status, response.status_hybrid_time(i), expiration};
+      cache_queue_.emplace_back(expiration, txn_id);
+    }
+  }
+
+  const RpcFactory rpc_factory_;
+  const server::ClockPtr clock_;
+  rpc::Rpcs rpcs_;
+
+  std::mutex mutex_;
+  bool closing_ = false;
+  std::unordered_map<TabletId, TabletQueue> queues_;
+  std::unordered_map<TransactionId, CacheEntry, TransactionIdHash> cache_;
+  std::deque<std::pair<CoarseTimePoint, TransactionId>> cache_queue_;
+};
+
+TransactionStatusBatcher::TransactionStatusBatcher(
+    std::shared_future<client::YBClient*> client_future, server::ClockPtr clock)
+    : TransactionStatusBatcher(
+          [client_future](tserver::GetTransactionStatusRequestPB* req,
+                          client::GetTransactionStatusCallback callback) {
+            return client::GetTransactionStatus(
+                TransactionRpcDeadline(), nullptr /* tablet */, client_future.get(), req,
+                std::move(callback));
+          },
+          std::move(clock)) {
+}
+
+TransactionStatusBatcher::TransactionStatusBatcher(RpcFactory rpc_factory, server::ClockPtr clock)
+    : impl_(new Impl(std::move(rpc_factory), std::move(clock))) {
+}
+
+TransactionStatusBatcher::~TransactionStatusBatcher() {}
+
+void TransactionStatusBatcher::Shutdown() {
+  impl_->Shutdown();
+}
+
+void TransactionStatusBatcher::RequestStatus(
+    const TabletId& status_tablet, const TransactionId& transaction_id,
+    client::GetTransactionStatusCallback callback) {
+  impl_->RequestStatus(status_tablet, transaction_id, std::move(callback));
+}
+
+} // namespace tablet
+} // namespace yb
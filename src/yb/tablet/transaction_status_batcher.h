@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+#define YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/transaction.h"
+
+#include "yb/server/clock.h"
+
+namespace yb {
+namespace tablet {
+
+// Multiplexes transaction status requests of all tablets on the node.
+// At most one GetTransactionStatus RPC is in flight per status tablet. Requests that arrive while
+// it is in flight are combined into the next RPC to the same status tablet.
+// Final statuses (COMMITTED and ABORTED) are cached for a short time, so requests for
+// transactions that already finished are answered without RPC.
+class TransactionStatusBatcher {
+ public:
+  // Creates GetTransactionStatus RPC for the request, that invokes callback when completed.
+  typedef std::function<rpc::RpcCommandPtr(
+      tserver::GetTransactionStatusRequestPB*, client::GetTransactionStatusCallback)> RpcFactory;
+
+  TransactionStatusBatcher(
+      std::shared_future<client::YBClient*> client_future, server::ClockPtr clock);
+
+  // Used by tests to send requests without YBClient.
+  TransactionStatusBatcher(RpcFactory rpc_factory, server::ClockPtr clock);
+  ~TransactionStatusBatcher();
+
+  // Fails all pending requests with Aborted status and waits for in flight RPCs to complete.
+  void Shutdown();
+
+  // Requests status of specified transaction from its status tablet.
+  // Callback is always invoked, possibly synchronously. Response passed to callback contains
+  // exactly one status entry, so it could be handled the same way as response to
+  // GetTransactionStatus RPC for a single transaction.
+  void RequestStatus(
+      const TabletId& status_tablet, const TransactionId& transaction_id,
+      client::GetTransactionStatusCallback callback);
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_STATUS_BATCHER_H
@@ -0,0 +1,343 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_sequence_cache.h"
+
+#include "yb/client/client.h"
+#include "yb/client/session.h"
+#include "yb/client/table.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/common/entity_ids.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/threadpool.h"
+
+#include "yb/yql/pggate/util/pg_doc_data.h"
+
+using namespace std::literals;
+
+DEFINE_int32(ysql_sequence_cache_reservation_size, 1000,
+             "Number of values of postgres sequence, that tablet server reserves in the sequences "
+             "data table at once, to hand them out to local postgres backends.");
+TAG_FLAG(ysql_sequence_cache_reservation_size, advanced);
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+const auto kSessionTimeout = 60s;
+
+// Absolute value of increment, as unsigned, so it does not overflow for min int64.
+uint64_t AbsIncrement(int64_t increment) {
+  return increment > 0 ? static_cast<uint64_t>(increment)
+                       : static_cast<uint64_t>(-(increment + 1)) + 1;
+}
+
+// Number of increments that could be applied to value before it goes beyond bound.
+uint64_t StepsTo(int64_t value, int64_t bound, int64_t increment) {
+  if (increment > 0) {
+    return bound >= value
+        ? (static_cast<uint64_t>(bound) - static_cast<uint64_t>(value)) / AbsIncrement(increment)
+        : 0;
+  }
+  return bound <= value
+      ? (static_cast<uint64_t>(value) - static_cast<uint64_t>(bound)) / AbsIncrement(increment)
+      : 0;
+}
+
+// Returns value + steps * increment, caller should ensure that result does not overflow.
+int64_t Advance(int64_t value, uint64_t steps, int64_t increment) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(value) + steps * static_cast<uint64_t>(increment));
+}
+
+CHECKED_STATUS CheckResponse(const PgsqlResponsePB& response) {
+  if (response.status() != PgsqlResponsePB::PGSQL_STATUS_OK) {
+    return STATUS_FORMAT(
+        RuntimeError, "Sequences data table operation failed: $0", response.error_message());
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+bool PgSequenceCache::Params::operator==(const Params& rhs) const {
+  return catalog_version == rhs.catalog_version && increment == rhs.increment &&
+         min_value == rhs.min_value && max_value == rhs.max_value && cycle == rhs.cycle;
+}
+
+PgSequenceCache::PgSequenceCache(ClientProvider client_provider)
+    : client_provider_(std::move(client_provider)) {
+  CHECK_OK(ThreadPoolBuilder("pg_seq").set_max_threads(4).Build(&thread_pool_));
+}
+
+PgSequenceCache::~PgSequenceCache() {
+  Shutdown();
+}
+
+void PgSequenceCache::Shutdown() {
+  thread_pool_->Shutdown();
+}
+
+PgSequenceCache::EntryPtr PgSequenceCache::GetEntry(const SequenceKey& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& result = entries_[key];
+  if (!result) {
+    result = std::make_shared<Entry>();
+  }
+  return result;
+}
+
+void PgSequenceCache::Reserve(
+    const ReserveSequenceValuesRequestPB& req, PgSequenceValuesCallback callback) {
+  if (req.count() <= 0 || req.increment() == 0) {
+    callback(STATUS_FORMAT(
+        InvalidArgument, "Invalid sequence values reservation: $0", req.ShortDebugString()));
+    return;
+  }
+
+  Params params;
+  params.catalog_version = req.ysql_catalog_version();
+  params.increment = req.increment();
+  params.min_value = req.min_value();
+  params.max_value = req.max_value();
+  params.cycle = req.cycle();
+
+  SequenceKey key(req.db_oid(), req.seq_oid());
+  auto entry = GetEntry(key);
+  {
+    std::unique_lock<std::mutex> lock(entry->mutex);
+    if (!(entry->params == params)) {
+      // Sequence was altered, values reserved with old parameters should not be used.
+      entry->params = params;
+      entry->has_range = false;
+    }
+    if (entry->has_range && entry->waiters.empty()) {
+      auto values = TakeFromRange(entry.get(), req.count());
+      lock.unlock();
+      callback(values);
+      return;
+    }
+    entry->waiters.push_back(Waiter{req.count(), std::move(callback)});
+    if (entry->reserving) {
+      return;
+    }
+    entry->reserving = true;
+  }
+
+  auto status = thread_pool_->SubmitFunc(
+      std::bind(&PgSequenceCache::ReserveRange, this, key, entry));
+  if (!status.ok()) {
+    std::vector<Waiter> waiters;
+    {
+      std::lock_guard<std::mutex> lock(entry->mutex);
+      waiters.swap(entry->waiters);
+      entry->reserving = false;
+    }
+    for (const auto& waiter : waiters) {
+      waiter.callback(status);
+    }
+  }
+}
+
+void PgSequenceCache::Discard(int64_t db_oid, int64_t seq_oid) {
+  EntryPtr entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(SequenceKey(db_oid, seq_oid));
+    if (it == entries_.end()) {
+      return;
+    }
+    entry = it->second;
+    entries_.erase(it);
+  }
+  std::lock_guard<std::mutex> lock(entry->mutex);
+  entry->has_range = false;
+  ++entry->generation;
+}
+
+PgSequenceValues PgSequenceCache::TakeFromRange(Entry* entry, int64_t count) {
+  const auto increment = entry->params.increment;
+  uint64_t steps = std::min(StepsTo(entry->next, entry->last, increment),
+                            static_cast<uint64_t>(count - 1));
+  PgSequenceValues result;
+  result.first = entry->next;
+  result.last = Advance(entry->next, steps, increment);
+  result.count = steps + 1;
+  if (result.last == entry->last) {
+    entry->has_range = false;
+  } else {
+    entry->next = result.last + increment;
+  }
+  return result;
+}
+
+void PgSequenceCache::ReserveRange(const SequenceKey& key, const EntryPtr& entry) {
+  for (;;) {
+    Params params;
+    uint64_t generation;
+    int64_t count;
+    {
+      std::lock_guard<std::mutex> lock(entry->mutex);
+      params = entry->params;
+      generation = entry->generation;
+      count = entry->waiters.front().count;
+    }
+
+    auto reserved = DoReserveRange(
+        key, params, std::max<int64_t>(count, FLAGS_ysql_sequence_cache_reservation_size));
+
+    std::vector<std::pair<Waiter, Result<PgSequenceValues>>> ready;
+    bool done;
+    {
+      std::lock_guard<std::mutex> lock(entry->mutex);
+      if (!reserved.ok() || reserved->count == 0) {
+        // Failure and exhausted sequence are reported to all waiters.
+        for (auto& waiter : entry->waiters) {
+          ready.emplace_back(std::move(waiter), reserved);
+        }
+        entry->waiters.clear();
+      } else if (params == entry->params && generation == entry->generation) {
+        entry->has_range = true;
+        entry->next = reserved->first;
+        entry->last = reserved->last;
+        auto it = entry->waiters.begin();
+        for (; it != entry->waiters.end() && entry->has_range; ++it) {
+          auto values = TakeFromRange(entry.get(), it->count);
+          ready.emplace_back(std::move(*it), values);
+        }
+        entry->waiters.erase(entry->waiters.begin(), it);
+      }
+      // Otherwise sequence was altered or discarded during reservation, so the reserved range is
+      // dropped and reservation is repeated with actual parameters.
+      done = entry->waiters.empty();
+      if (done) {
+        entry->reserving = false;
+      }
+    }
+
+    for (const auto& p : ready) {
+      p.first.callback(p.second);
+    }
+    if (done) {
+      return;
+    }
+  }
+}
+
+Result<client::YBTablePtr> PgSequenceCache::GetTable() {
+  std::lock_guard<std::mutex> lock(table_mutex_);
+  if (!table_) {
+    table_ = VERIFY_RESULT(client_provider_()->OpenTable(
+        GetPgsqlTableId(kPgSequencesDataDatabaseOid, kPgSequencesDataTableOid)));
+  }
+  return table_;
+}
+
+Result<PgSequenceValues> PgSequenceCache::DoReserveRange(
+    const SequenceKey& key, const Params& params, int64_t count) {
+  auto table = VERIFY_RESULT(GetTable());
+  const auto last_value_column_id = table->schema().ColumnId(kPgSequenceLastValueColIdx);
+  const auto is_called_column_id = table->schema().ColumnId(kPgSequenceIsCalledColIdx);
+  auto session = client_provider_()->NewSession();
+  session->SetTimeout(kSessionTimeout);
+
+  for (;;) {
+    std::shared_ptr<client::YBPgsqlReadOp> read_op(table->NewPgsqlSelect());
+    auto* read_request = read_op->mutable_request();
+    read_request->set_ysql_catalog_version(params.catalog_version);
+    read_request->add_partition_column_values()->mutable_value()->set_int64_value(key.first);
+    read_request->add_partition_column_values()->mutable_value()->set_int64_value(key.second);
+    read_request->add_targets()->set_column_id(last_value_column_id);
+    read_request->add_targets()->set_column_id(is_called_column_id);
+    read_request->mutable_column_refs()->add_ids(last_value_column_id);
+    read_request->mutable_column_refs()->add_ids(is_called_column_id);
+    RETURN_NOT_OK(session->ReadSync(read_op));
+    RETURN_NOT_OK(CheckResponse(read_op->response()));
+
+    Slice cursor;
+    int64_t row_count = 0;
+    pggate::PgDocData::LoadCache(read_op->rows_data(), &row_count, &cursor);
+    if (row_count == 0 || pggate::PgDocData::ReadDataHeader(&cursor).is_null()) {
+      return STATUS_FORMAT(NotFound, "Unable to find relation for sequence $0", key.second);
+    }
+    int64_t last_value = 0;
+    cursor.remove_prefix(pggate::PgDocData::ReadNumber(&cursor, &last_value));
+    if (pggate::PgDocData::ReadDataHeader(&cursor).is_null()) {
+      return STATUS_FORMAT(NotFound, "Unable to find relation for sequence $0", key.second);
+    }
+    bool is_called = false;
+    pggate::PgDocData::ReadNumber(&cursor, &is_called);
+
+    const auto bound = params.increment > 0 ? params.max_value : params.min_value;
+    PgSequenceValues result;
+    if (!is_called) {
+      result.first = last_value;
+    } else if (StepsTo(last_value, bound, params.increment) > 0) {
+      result.first = last_value + params.increment;
+    } else if (params.cycle) {
+      result.first = params.increment > 0 ? params.min_value : params.max_value;
+    } else {
+      // Sequence is exhausted.
+      return result;
+    }
+    auto steps = std::min(StepsTo(result.first, bound, params.increment),
+                          static_cast<uint64_t>(count - 1));
+    result.last = Advance(result.first, steps, params.increment);
+    result.count = steps + 1;
+
+    // Conditional update detects concurrent reservations by other tablet servers and backends,
+    // in which case the whole procedure is repeated.
+    std::shared_ptr<client::YBPgsqlWriteOp> write_op(table->NewPgsqlUpdate());
+    auto* write_request = write_op->mutable_request();
+    write_request->set_ysql_catalog_version(params.catalog_version);
+    write_request->add_partition_column_values()->mutable_value()->set_int64_value(key.first);
+    write_request->add_partition_column_values()->mutable_value()->set_int64_value(key.second);
+
+    auto* column_value = write_request->add_column_new_values();
+    column_value->set_column_id(last_value_column_id);
+    column_value->mutable_expr()->mutable_value()->set_int64_value(result.last);
+    column_value = write_request->add_column_new_values();
+    column_value->set_column_id(is_called_column_id);
+    column_value->mutable_expr()->mutable_value()->set_bool_value(true);
+
+    auto* where_pb = write_request->mutable_where_expr()->mutable_condition();
+    where_pb->set_op(QL_OP_AND);
+    auto* cond = where_pb->add_operands()->mutable_condition();
+    cond->set_op(QL_OP_EQUAL);
+    cond->add_operands()->set_column_id(last_value_column_id);
+    cond->add_operands()->mutable_value()->set_int64_value(last_value);
+    cond = where_pb->add_operands()->mutable_condition();
+    cond->set_op(QL_OP_EQUAL);
+    cond->add_operands()->set_column_id(is_called_column_id);
+    cond->add_operands()->mutable_value()->set_bool_value(is_called);
+
+    write_request->mutable_column_refs()->add_ids(last_value_column_id);
+    write_request->mutable_column_refs()->add_ids(is_called_column_id);
+
+    RETURN_NOT_OK(session->ApplyAndFlush(write_op));
+    RETURN_NOT_OK(CheckResponse(write_op->response()));
+    if (!write_op->response().skipped()) {
+      VLOG(2) << "Reserved values of sequence " << key.first << "/" << key.second << ": "
+              << result.first << " - " << result.last;
+      return result;
+    }
+  }
+}
+
+} // namespace tserver
+} // namespace yb
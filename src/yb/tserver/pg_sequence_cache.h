@@ -0,0 +1,132 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_PG_SEQUENCE_CACHE_H
+#define YB_TSERVER_PG_SEQUENCE_CACHE_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/util/result.h"
+
+namespace yb {
+
+class ThreadPool;
+
+namespace tserver {
+
+class ReserveSequenceValuesRequestPB;
+
+// Values reserved for postgres backend: first, first + increment, ..., last.
+struct PgSequenceValues {
+  int64_t first = 0;
+  int64_t last = 0;
+  // Zero when sequence is exhausted.
+  int64_t count = 0;
+};
+
+typedef std::function<void(const Result<PgSequenceValues>&)> PgSequenceValuesCallback;
+
+// Range of values of postgres sequence cached by tablet server.
+// The range is reserved in the sequences data table with a single conditional update, so local
+// postgres backends obtain sequence values without touching the table for each nextval.
+// Values that were reserved but not handed out are lost when tablet server restarts, the same way
+// as values cached by postgres backend itself.
+// Cached range is dropped when catalog version changes, i.e. after ALTER SEQUENCE. But setval is
+// not a DDL, so it drops only the range cached by the tablet server local to the backend that
+// called it. Ranges cached by other tablet servers are used until exhausted.
+class PgSequenceCache {
+ public:
+  typedef std::function<client::YBClient*()> ClientProvider;
+
+  explicit PgSequenceCache(ClientProvider client_provider);
+  ~PgSequenceCache();
+
+  void Shutdown();
+
+  // Reserves values for request. Callback is invoked once values are available, that could happen
+  // synchronously when values are taken from cached range.
+  void Reserve(const ReserveSequenceValuesRequestPB& req, PgSequenceValuesCallback callback);
+
+  // Drops cached range of specified sequence.
+  void Discard(int64_t db_oid, int64_t seq_oid);
+
+ private:
+  typedef std::pair<int64_t, int64_t> SequenceKey;
+
+  struct Params {
+    uint64_t catalog_version = 0;
+    int64_t increment = 0;
+    int64_t min_value = 0;
+    int64_t max_value = 0;
+    bool cycle = false;
+
+    bool operator==(const Params& rhs) const;
+  };
+
+  struct Waiter {
+    int64_t count;
+    PgSequenceValuesCallback callback;
+  };
+
+  struct Entry {
+    std::mutex mutex;
+    Params params;
+    // Range of reserved values that were not handed out yet: next, next + increment, ..., last.
+    bool has_range = false;
+    int64_t next = 0;
+    int64_t last = 0;
+    // Requests waiting for range to be reserved.
+    std::vector<Waiter> waiters;
+    bool reserving = false;
+    // Incremented when cached range is discarded, so range reserved concurrently is not used.
+    uint64_t generation = 0;
+  };
+
+  typedef std::shared_ptr<Entry> EntryPtr;
+
+  EntryPtr GetEntry(const SequenceKey& key);
+
+  // Hands out at most count values from cached range of entry.
+  static PgSequenceValues TakeFromRange(Entry* entry, int64_t count);
+
+  // Reserves new range for entry and serves waiting requests.
+  void ReserveRange(const SequenceKey& key, const EntryPtr& entry);
+
+  // Reserves range of at most count values in the sequences data table.
+  Result<PgSequenceValues> DoReserveRange(
+      const SequenceKey& key, const Params& params, int64_t count);
+
+  Result<client::YBTablePtr> GetTable();
+
+  const ClientProvider client_provider_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+
+  std::mutex mutex_;
+  std::unordered_map<SequenceKey, EntryPtr, boost::hash<SequenceKey>> entries_;
+
+  std::mutex table_mutex_;
+  client::YBTablePtr table_;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_PG_SEQUENCE_CACHE_H
@@ -0,0 +1,115 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_table_cache.h"
+
+#include "yb/client/client.h"
+#include "yb/client/table.h"
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+void FillTableInfo(const client::YBTable& table, OpenPgTableResponsePB* info) {
+  info->set_table_id(table.id());
+  info->set_namespace_id(table.name().namespace_id());
+  info->set_namespace_name(table.name().namespace_name());
+  info->set_table_name(table.name().table_name());
+  info->set_table_type(client::YBTable::ClientToPBTableType(table.table_type()));
+  SchemaToPB(table.InternalSchema(), info->mutable_schema());
+  info->set_schema_version(table.schema().version());
+  table.partition_schema().ToPB(info->mutable_partition_schema());
+  table.index_map().ToPB(info->mutable_indexes());
+  if (table.IsIndex()) {
+    table.index_info().ToPB(info->mutable_index_info());
+  }
+  info->set_colocated(table.colocated());
+  for (const auto& partition : table.GetPartitions()) {
+    info->add_partitions(partition);
+  }
+}
+
+} // namespace
+
+PgTableCache::PgTableCache(
+    ClientProvider client_provider, CatalogVersionProvider catalog_version_provider)
+    : client_provider_(std::move(client_provider)),
+      catalog_version_provider_(std::move(catalog_version_provider)) {
+}
+
+PgTableCache::~PgTableCache() {
+}
+
+PgTableCache::EntryPtr PgTableCache::GetEntry(
+    const TableId& table_id, uint64_t catalog_version,
+    std::unique_ptr<std::promise<Result<InfoPtr>>>* load_promise) {
+  catalog_version = std::max(catalog_version, catalog_version_provider_());
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (catalog_version > catalog_version_) {
+    VLOG(1) << "Catalog version changed from " << catalog_version_ << " to " << catalog_version
+            << ", dropping " << entries_.size() << " cached tables";
+    entries_.clear();
+    catalog_version_ = catalog_version;
+  }
+  auto& result = entries_[table_id];
+  if (!result) {
+    result = std::make_shared<Entry>();
+    *load_promise = std::make_unique<std::promise<Result<InfoPtr>>>();
+    result->info = (**load_promise).get_future().share();
+  }
+  return result;
+}
+
+Result<PgTableCache::InfoPtr> PgTableCache::Load(const TableId& table_id) {
+  VLOG(2) << "Loading table " << table_id;
+  auto table = VERIFY_RESULT(client_provider_()->OpenTable(table_id));
+  auto info = std::make_shared<OpenPgTableResponsePB>();
+  FillTableInfo(*table, info.get());
+  return info;
+}
+
+Status PgTableCache::Get(
+    const TableId& table_id, uint64_t catalog_version, OpenPgTableResponsePB* resp) {
+  std::unique_ptr<std::promise<Result<InfoPtr>>> load_promise;
+  auto entry = GetEntry(table_id, catalog_version, &load_promise);
+  if (load_promise) {
+    // Loaded without holding any lock, since it is a round trip to master.
+    auto info = Load(table_id);
+    if (!info.ok()) {
+      // Failure is reported to requests waiting for this load, but is not cached.
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(table_id);
+      if (it != entries_.end() && it->second == entry) {
+        entries_.erase(it);
+      }
+    }
+    load_promise->set_value(std::move(info));
+  }
+  const auto& info = entry->info.get();
+  RETURN_NOT_OK(info);
+  resp->CopyFrom(**info);
+  return Status::OK();
+}
+
+void PgTableCache::Invalidate(const TableId& table_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.erase(table_id);
+}
+
+} // namespace tserver
+} // namespace yb
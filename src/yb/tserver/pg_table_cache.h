@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_PG_TABLE_CACHE_H
+#define YB_TSERVER_PG_TABLE_CACHE_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids.h"
+
+#include "yb/util/result.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace tserver {
+
+class OpenPgTableResponsePB;
+
+// Descriptors of postgres tables shared by all postgres backends of the tablet server.
+// Each descriptor is loaded from master once, instead of being loaded by every new backend.
+// Whole cache is dropped when catalog version changes, since any table could be altered.
+// Descriptor of a table is dropped when one of its tablets is split, since its partitions change.
+class PgTableCache {
+ public:
+  typedef std::function<client::YBClient*()> ClientProvider;
+  typedef std::function<uint64_t()> CatalogVersionProvider;
+
+  PgTableCache(ClientProvider client_provider, CatalogVersionProvider catalog_version_provider);
+  ~PgTableCache();
+
+  // Fills resp with descriptor of specified table, loading it from master when it is not cached.
+  CHECKED_STATUS Get(
+      const TableId& table_id, uint64_t catalog_version, OpenPgTableResponsePB* resp);
+
+  // Drops cached descriptor of the table. Load that is in progress is not affected, but its result
+  // is not cached.
+  void Invalidate(const TableId& table_id);
+
+ private:
+  typedef std::shared_ptr<const OpenPgTableResponsePB> InfoPtr;
+
+  struct Entry {
+    // Set by the request that loads descriptor from master. Concurrent requests for the same table
+    // wait for this load instead of starting their own.
+    std::shared_future<Result<InfoPtr>> info;
+  };
+
+  typedef std::shared_ptr<Entry> EntryPtr;
+
+  // Returns entry for the table, and promise that should be fulfilled when caller has to load it.
+  EntryPtr GetEntry(
+      const TableId& table_id, uint64_t catalog_version,
+      std::unique_ptr<std::promise<Result<InfoPtr>>>* load_promise);
+
+  Result<InfoPtr> Load(const TableId& table_id);
+
+  const ClientProvider client_provider_;
+  const CatalogVersionProvider catalog_version_provider_;
+
+  std::mutex mutex_;
+  // Catalog version that cached descriptors correspond to.
+  uint64_t catalog_version_ = 0;
+  std::unordered_map<TableId, EntryPtr> entries_;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_PG_TABLE_CACHE_H
@@ -263,6 +263,8 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
   // them to the right path.
   kv_store->clear_rocksdb_dir();
   superblock_->clear_wal_dir();
+  // All SST files are downloaded to rocksdb_dir, cold storage of the source is not used here.
+  kv_store->clear_cold_rocksdb_dir();
 
   superblock_->set_tablet_data_state(tablet::TABLET_DATA_COPYING);
   wal_seqnos_.assign(resp.deprecated_wal_segment_seqnos().begin(),
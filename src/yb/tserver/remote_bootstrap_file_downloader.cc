@@ -49,6 +49,12 @@ DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
+DEFINE_bool(remote_bootstrap_fetch_data_in_sidecar, true,
+            "Ask remote bootstrap source to send file chunks in RPC sidecars, so they could be "
+            "sent directly from file to socket and written to file without protobuf copies.");
+TAG_FLAG(remote_bootstrap_fetch_data_in_sidecar, advanced);
+TAG_FLAG(remote_bootstrap_fetch_data_in_sidecar, runtime);
+
 // RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
 #define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
   RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
@@ -58,6 +64,14 @@ namespace tserver {
 
 namespace {
 
+// Returns data of the chunk, that is either embedded in the chunk or stored in RPC sidecar.
+Result<Slice> ChunkData(const DataChunkPB& chunk, const rpc::RpcController& controller) {
+  if (!chunk.has_sidecar_idx()) {
+    return Slice(chunk.data());
+  }
+  return controller.GetSidecar(chunk.sidecar_idx());
+}
+
 // Decode the remote error into a human-readable Status object.
 CHECKED_STATUS ExtractRemoteError(
     const rpc::ErrorStatusPB& remote_error, const Status& original_status) {
@@ -182,29 +196,36 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
       max_length = std::min(max_length, decltype(max_length)(max_size));
     }
     req.set_max_length(max_length);
+    req.set_data_in_sidecar(FLAGS_remote_bootstrap_fetch_data_in_sidecar);
 
     FetchDataResponsePB resp;
     auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
       return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
+    }, [&resp, &controller]() {
+      auto data = ChunkData(resp.chunk(), controller);
+      return resp.ByteSize() + (resp.chunk().has_sidecar_idx() && data.ok() ? data->size() : 0);
+    });
     RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+    // Data in sidecar refers to the response buffer, so it is written to file without copying.
+    auto data = VERIFY_RESULT_PREPEND(
+        ChunkData(resp.chunk(), controller), Format("Error getting data item $0", data_id));
+    DCHECK_LE(data.size(), max_length);
 
     // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk(), data),
                           Format("Error validating data item $0", data_id));
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
+    RETURN_NOT_OK(appendable->Append(data));
     VLOG_WITH_PREFIX(3)
-        << "resp size: " << resp.ByteSize() << ", chunk size: " << resp.chunk().data().size();
+        << "resp size: " << resp.ByteSize() << ", chunk size: " << data.size();
 
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
+    if (offset + data.size() == resp.chunk().total_data_length()) {
       done = true;
     }
-    offset += resp.chunk().data().size();
+    offset += data.size();
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
+      periodic_sync_unsynced_bytes += data.size();
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
         RETURN_NOT_OK(appendable->Sync());
         periodic_sync_unsynced_bytes = 0;
@@ -217,7 +238,8 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   return Status::OK();
 }
 
-Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
+Status RemoteBootstrapFileDownloader::VerifyData(
+    uint64_t offset, const DataChunkPB& chunk, const Slice& data) {
   // Verify the offset is what we expected.
   if (offset != chunk.offset()) {
     return STATUS_FORMAT(
@@ -226,11 +248,11 @@ Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChun
   }
 
   // Verify the checksum.
-  uint32_t crc32 = crc::Crc32c(chunk.data().data(), chunk.data().length());
+  uint32_t crc32 = crc::Crc32c(data.data(), data.size());
   if (PREDICT_FALSE(crc32 != chunk.crc32())) {
     return STATUS_FORMAT(
         Corruption, "CRC32 does not match at offset $0 size $1: $2 vs $3",
-        offset, chunk.data().size(), crc32, chunk.crc32());
+        offset, data.size(), crc32, chunk.crc32());
   }
   return Status::OK();
 }
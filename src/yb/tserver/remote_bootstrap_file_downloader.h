@@ -67,7 +67,7 @@ class RemoteBootstrapFileDownloader {
   }
 
  private:
-  CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
+  CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& chunk, const Slice& data);
 
   const std::string& LogPrefix() const {
     return log_prefix_;
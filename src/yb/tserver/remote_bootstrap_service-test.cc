@@ -132,11 +132,13 @@ class RemoteBootstrapServiceTest : public RemoteBootstrapTest {
   Status DoFetchData(const string& session_id, const DataIdPB& data_id,
                      uint64_t* offset, int64_t* max_length,
                      FetchDataResponsePB* resp,
-                     RpcController* controller) {
+                     RpcController* controller,
+                     bool data_in_sidecar = false) {
     controller->set_timeout(MonoDelta::FromSeconds(1.0));
     FetchDataRequestPB req;
     req.set_session_id(session_id);
     req.mutable_data_id()->CopyFrom(data_id);
+    req.set_data_in_sidecar(data_in_sidecar);
     if (offset) {
       req.set_offset(*offset);
     }
@@ -372,6 +374,36 @@ TEST_F(RemoteBootstrapServiceTest, TestFetchLog) {
   AssertDataEqual(slice.data(), slice.size(), resp.chunk());
 }
 
+// Test that RocksDB files sent directly from file in RPC sidecar match files sent in response.
+TEST_F(RemoteBootstrapServiceTest, TestFetchRocksDBFileInSidecar) {
+  string session_id;
+  tablet::RaftGroupReplicaSuperBlockPB superblock;
+  ASSERT_OK(DoBeginValidRemoteBootstrapSession(&session_id, &superblock));
+  ASSERT_GT(superblock.kv_store().rocksdb_files_size(), 0);
+
+  for (const auto& file_pb : superblock.kv_store().rocksdb_files()) {
+    if (file_pb.size_bytes() == 0) {
+      continue;
+    }
+    auto data_id = AsDataTypeId(file_pb.name());
+    FetchDataResponsePB resp;
+    RpcController controller;
+    ASSERT_OK(DoFetchData(session_id, data_id, nullptr, nullptr, &resp, &controller));
+    ASSERT_FALSE(resp.chunk().has_sidecar_idx());
+
+    FetchDataResponsePB sidecar_resp;
+    RpcController sidecar_controller;
+    ASSERT_OK(DoFetchData(session_id, data_id, nullptr, nullptr, &sidecar_resp,
+                          &sidecar_controller, /* data_in_sidecar= */ true));
+    ASSERT_TRUE(sidecar_resp.chunk().has_sidecar_idx());
+    ASSERT_TRUE(sidecar_resp.chunk().data().empty());
+    auto data = ASSERT_RESULT(sidecar_controller.GetSidecar(sidecar_resp.chunk().sidecar_idx()));
+    ASSERT_EQ(resp.chunk().data(), data.ToBuffer());
+    ASSERT_EQ(resp.chunk().crc32(), sidecar_resp.chunk().crc32());
+    ASSERT_EQ(resp.chunk().total_data_length(), sidecar_resp.chunk().total_data_length());
+  }
+}
+
 // Test that the remote bootstrap session timeout works properly.
 TEST_F(RemoteBootstrapServiceTest, TestSessionTimeout) {
   // This flag should be seen by the service due to TSO.
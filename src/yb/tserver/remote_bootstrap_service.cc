@@ -251,7 +251,9 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   GetDataPieceInfo info = {
     .offset = req->offset(),
     .client_maxlen = rate_limit == 0 ? req->max_length() : std::min(req->max_length(), rate_limit),
+    .send_file = req->data_in_sidecar(),
     .data = std::string(),
+    .file_region = rpc::FileRegion(),
     .data_size = 0,
     .error_code = RemoteBootstrapErrorPB::UNKNOWN_ERROR,
   };
@@ -262,11 +264,25 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   RPC_RETURN_NOT_OK(session->GetDataPiece(data_id, &info),
                     info.error_code, "Unable to get piece of data file");
 
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
-  uint32_t crc32 = Crc32c(info.data.data(), info.data.length());
-
   DataChunkPB* data_chunk = resp->mutable_chunk();
-  *data_chunk->mutable_data() = std::move(info.data);
+  uint32_t crc32 = 0;
+  if (info.file_region) {
+    session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.file_region.size());
+    // Checksum is calculated over mapped file, so data is not copied to user space.
+    RPC_RETURN_NOT_OK(info.file_region.VisitMapped([&crc32](Slice data) {
+                        crc32 = Crc32c(data.data(), data.size());
+                      }),
+                      RemoteBootstrapErrorPB::IO_ERROR, "Unable to calculate checksum");
+    auto sidecar_idx = context.AddRpcFileSidecar(std::move(info.file_region));
+    RPC_RETURN_NOT_OK(ResultToStatus(sidecar_idx),
+                      RemoteBootstrapErrorPB::IO_ERROR, "Unable to add file sidecar");
+    data_chunk->mutable_data()->clear();
+    data_chunk->set_sidecar_idx(static_cast<int32_t>(*sidecar_idx));
+  } else {
+    session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
+    crc32 = Crc32c(info.data.data(), info.data.length());
+    *data_chunk->mutable_data() = std::move(info.data);
+  }
   data_chunk->set_total_data_length(info.data_size);
   data_chunk->set_offset(info.offset);
 
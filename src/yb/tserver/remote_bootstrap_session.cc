@@ -378,6 +378,21 @@ Status ReadFileChunkToBuf(RandomAccessFile* file, const string& data_name, GetDa
   return Status::OK();
 }
 
+// Prepares region of a file to be sent directly from the file to the socket, without reading it.
+Status PrepareFileRegion(
+    const std::string& file_path, const string& data_name, GetDataPieceInfo* info) {
+  auto file = rpc::ReadOnlyFile::Open(file_path);
+  if (!file.ok()) {
+    info->error_code = RemoteBootstrapErrorPB::IO_ERROR;
+    return file.status().CloneAndPrepend(Format("Unable to open file for $0", data_name));
+  }
+  auto response_data_size = VERIFY_RESULT_PREPEND(
+      GetResponseDataSize(info), Format("Error reading $0", data_name));
+  info->file_region = rpc::FileRegion(std::move(*file), info->offset, response_data_size);
+  TRACE("Remote bootstrap: $0: $1 bytes prepared for sending", data_name, response_data_size);
+  return Status::OK();
+}
+
 } // namespace
 
 Env* RemoteBootstrapSession::env() const {
@@ -450,6 +465,9 @@ Status RemoteBootstrapSession::GetDataPiece(const DataIdPB& data_id, GetDataPiec
   }
   DCHECK(info->client_maxlen == 0 || info->data.size() <= info->client_maxlen)
       << "client_maxlen: " << info->client_maxlen << ", data->size(): " << info->data.size();
+  DCHECK(info->client_maxlen == 0 || info->file_region.size() <= info->client_maxlen)
+      << "client_maxlen: " << info->client_maxlen << ", file_region: "
+      << info->file_region.ToString();
 
   return Status::OK();
 }
@@ -486,6 +504,13 @@ Status RemoteBootstrapSession::GetFilePiece(
                                        file_name, path));
   }
 
+  auto data_name = Substitute("rocksdb file $0", file_name);
+  // File region refers to the file by descriptor, so it could be used only for real files.
+  if (info->send_file && env == Env::Default()) {
+    info->data_size = VERIFY_RESULT(env->GetFileSize(file_path));
+    return PrepareFileRegion(file_path, data_name, info);
+  }
+
   std::unique_ptr<RandomAccessFile> readable_file;
 
   RETURN_NOT_OK(env->NewRandomAccessFile(file_path, &readable_file));
@@ -495,8 +520,7 @@ Status RemoteBootstrapSession::GetFilePiece(
   VLOG(2) << "Reading RocksDB file. File path: " << file_path << ", file size: " << info->data_size
           << ", inode: " << inode;
 
-  RETURN_NOT_OK(ReadFileChunkToBuf(
-      readable_file.get(), Substitute("rocksdb file $0", file_name), info));
+  RETURN_NOT_OK(ReadFileChunkToBuf(readable_file.get(), data_name, info));
 
   return Status::OK();
 }
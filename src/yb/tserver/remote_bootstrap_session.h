@@ -44,6 +44,7 @@
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/stl_util.h"
+#include "yb/rpc/file_region.h"
 #include "yb/tserver/remote_bootstrap.pb.h"
 #include "yb/util/env_util.h"
 #include "yb/util/net/rate_limiter.h"
@@ -66,9 +67,12 @@ struct GetDataPieceInfo {
   // Input
   uint64_t offset;
   int64_t client_maxlen;
+  // Whether the piece could be returned as file_region instead of data.
+  bool send_file = false;
 
   // Output
   std::string data;
+  rpc::FileRegion file_region;
   int64_t data_size;
   RemoteBootstrapErrorPB::Code error_code;
 
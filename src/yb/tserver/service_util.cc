@@ -31,6 +31,27 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
       error, s, ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR, context);
 }
 
+Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager, const std::string& tablet_id) {
+  std::shared_ptr<tablet::TabletPeer> result;
+  Status status = tablet_manager->GetTabletPeer(tablet_id, &result);
+  if (PREDICT_FALSE(!status.ok())) {
+    TabletServerErrorPB::Code code = status.IsServiceUnavailable() ?
+                                     TabletServerErrorPB::UNKNOWN_ERROR :
+                                     TabletServerErrorPB::TABLET_NOT_FOUND;
+    return status.CloneAndAddErrorCode(TabletServerError(code));
+  }
+
+  // Check RUNNING state.
+  tablet::RaftGroupStatePB state = result->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    return STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStateError(state))
+        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+
+  return result;
+}
+
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
   std::shared_ptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
   if (!consensus) {
@@ -58,15 +58,35 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
 
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer);
 
+// Looks up the peer of the tablet and checks that it is RUNNING. Returned error status contains
+// TabletServerError code that should be reported to the caller.
+Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager, const std::string& tablet_id);
+
 // Template helpers.
 
+// Checks that the request is addressed to this server, empty destination UUID is accepted.
+// Returned error status contains WRONG_SERVER_UUID error code.
+template<class ReqClass>
+Status CheckUuidMatch(TabletPeerLookupIf* tablet_manager,
+                      const char* method_name,
+                      const ReqClass* req) {
+  const string& local_uuid = tablet_manager->NodeInstance().permanent_uuid();
+  if (PREDICT_FALSE(!req->dest_uuid().empty() && req->dest_uuid() != local_uuid)) {
+    return STATUS_SUBSTITUTE(InvalidArgument,
+        "$0: Wrong destination UUID requested. Local UUID: $1. Requested UUID: $2",
+        method_name, local_uuid, req->dest_uuid())
+        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::WRONG_SERVER_UUID));
+  }
+  return Status::OK();
+}
+
 template<class ReqClass, class RespClass>
 bool CheckUuidMatchOrRespond(TabletPeerLookupIf* tablet_manager,
                              const char* method_name,
                              const ReqClass* req,
                              RespClass* resp,
                              rpc::RpcContext* context) {
-  const string& local_uuid = tablet_manager->NodeInstance().permanent_uuid();
   if (req->dest_uuid().empty()) {
     // Maintain compat in release mode, but complain.
     string msg = strings::Substitute("$0: Missing destination UUID in request from $1: $2",
@@ -78,10 +98,8 @@ bool CheckUuidMatchOrRespond(TabletPeerLookupIf* tablet_manager,
 #endif
     return true;
   }
-  if (PREDICT_FALSE(req->dest_uuid() != local_uuid)) {
-    const Status s = STATUS_SUBSTITUTE(InvalidArgument,
-        "$0: Wrong destination UUID requested. Local UUID: $1. Requested UUID: $2",
-        method_name, local_uuid, req->dest_uuid());
+  const Status s = CheckUuidMatch(tablet_manager, method_name, req);
+  if (PREDICT_FALSE(!s.ok())) {
     LOG(WARNING) << s.ToString() << ": from " << context->requestor_string()
                  << ": " << req->ShortDebugString();
     SetupErrorAndRespond(resp->mutable_error(), s,
@@ -127,25 +145,10 @@ Result<std::shared_ptr<tablet::TabletPeer>> LookupTabletPeerOrRespond(
     const string& tablet_id,
     RespClass* resp,
     rpc::RpcContext* context) {
-  std::shared_ptr<tablet::TabletPeer> result;
-  Status status = tablet_manager->GetTabletPeer(tablet_id, &result);
-  if (PREDICT_FALSE(!status.ok())) {
-    TabletServerErrorPB::Code code = status.IsServiceUnavailable() ?
-                                     TabletServerErrorPB::UNKNOWN_ERROR :
-                                     TabletServerErrorPB::TABLET_NOT_FOUND;
-    SetupErrorAndRespond(resp->mutable_error(), status, code, context);
-    return status;
+  auto result = LookupTabletPeer(tablet_manager, tablet_id);
+  if (PREDICT_FALSE(!result.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), result.status(), context);
   }
-
-  // Check RUNNING state.
-  tablet::RaftGroupStatePB state = result->state();
-  if (PREDICT_FALSE(state != tablet::RUNNING)) {
-    Status s = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStateError(state))
-        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
-    SetupErrorAndRespond(resp->mutable_error(), s, context);
-    return s;
-  }
-
   return result;
 }
 
@@ -0,0 +1,125 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/shared_exchange_service.h"
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_header.pb.h"
+
+#include "yb/tserver/tserver_service.proxy.h"
+#include "yb/tserver/tserver_shared_mem.h"
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+template <class Req, class Resp>
+struct SharedExchangeCallData {
+  Req req;
+  Resp resp;
+  rpc::RpcController controller;
+  std::string serialized_resp;
+  // Keeps service alive until response is sent.
+  ScopedOperation operation;
+};
+
+} // namespace
+
+SharedExchangeService::SharedExchangeService(
+    SharedExchange* exchange, const std::string& tserver_uuid, rpc::ProxyCache* proxy_cache)
+    // Empty host port means that calls are handled by services of the local messenger.
+    : proxy_(std::make_shared<TabletServerServiceProxy>(proxy_cache, HostPort())),
+      server_(exchange, tserver_uuid,
+              std::bind(&SharedExchangeService::Handle, this, std::placeholders::_1,
+                        std::placeholders::_2, std::placeholders::_3, std::placeholders::_4)),
+      running_calls_("Shared exchange service: ") {
+}
+
+SharedExchangeService::~SharedExchangeService() {
+  Shutdown();
+}
+
+Status SharedExchangeService::Start() {
+  return server_.Start();
+}
+
+void SharedExchangeService::Shutdown() {
+  // Poller thread is joined here, so no new calls are started after it.
+  server_.Shutdown();
+  // Calls in flight respond via this service, so wait for them to complete.
+  running_calls_.Shutdown();
+}
+
+void SharedExchangeService::RespondFailure(size_t slot, const Status& status) {
+  AppStatusPB status_pb;
+  StatusToPB(status, &status_pb);
+  server_.RespondFailure(slot, status_pb.SerializeAsString());
+}
+
+void SharedExchangeService::Handle(
+    size_t slot, uint32_t method, Slice request, CoarseTimePoint deadline) {
+  switch (static_cast<TServerSharedExchangeMethod>(method)) {
+    case TServerSharedExchangeMethod::kRead:
+      Invoke<ReadRequestPB, ReadResponsePB>(
+          slot, request, deadline, &TabletServerServiceProxy::ReadAsync);
+      return;
+    case TServerSharedExchangeMethod::kWrite:
+      Invoke<WriteRequestPB, WriteResponsePB>(
+          slot, request, deadline, &TabletServerServiceProxy::WriteAsync);
+      return;
+  }
+  RespondFailure(slot, STATUS_FORMAT(NotSupported, "Unknown shared exchange method: $0", method));
+}
+
+template <class Req, class Resp, class ProxyMethod>
+void SharedExchangeService::Invoke(
+    size_t slot, Slice request, CoarseTimePoint deadline, ProxyMethod proxy_method) {
+  auto data = std::make_shared<SharedExchangeCallData<Req, Resp>>();
+  if (!data->req.ParseFromArray(request.data(), static_cast<int>(request.size()))) {
+    RespondFailure(slot, STATUS(Corruption, "Failed to parse shared exchange request"));
+    return;
+  }
+  data->controller.set_deadline(deadline);
+  data->operation = ScopedOperation(&running_calls_);
+  ((*proxy_).*proxy_method)(
+      data->req, &data->resp, &data->controller, [this, slot, data] {
+    auto status = data->controller.status();
+    const auto* error = data->controller.error_response();
+    if (!status.ok() && error && error->code() == rpc::ErrorStatusPB::ERROR_SERVER_TOO_BUSY) {
+      // Client resends such requests via RPC, that handles busy server with backoff.
+      status = STATUS(ServiceUnavailable, "Tablet server is too busy");
+    }
+    if (!status.ok()) {
+      RespondFailure(slot, status);
+    } else {
+      std::vector<Slice> sidecars;
+      data->resp.SerializeToString(&data->serialized_resp);
+      for (int idx = 0;; ++idx) {
+        auto sidecar = data->controller.GetSidecar(idx);
+        if (!sidecar.ok()) {
+          break;
+        }
+        sidecars.push_back(*sidecar);
+      }
+      server_.Respond(slot, data->serialized_resp, sidecars);
+    }
+    // Callback could outlive the call, so release the service right after responding.
+    data->operation = ScopedOperation();
+  });
+}
+
+} // namespace tserver
+} // namespace yb
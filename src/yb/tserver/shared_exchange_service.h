@@ -0,0 +1,60 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_SHARED_EXCHANGE_SERVICE_H
+#define YB_TSERVER_SHARED_EXCHANGE_SERVICE_H
+
+#include <memory>
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/operation_counter.h"
+#include "yb/util/shared_mem_exchange.h"
+
+namespace yb {
+namespace tserver {
+
+class TabletServerServiceProxy;
+
+// Serves Read and Write requests that local postgres backends send via shared memory exchange.
+// Requests are dispatched to the tablet server service as local calls, so they are processed
+// exactly as requests received via RPC, but without socket round trips.
+class SharedExchangeService {
+ public:
+  SharedExchangeService(
+      SharedExchange* exchange, const std::string& tserver_uuid, rpc::ProxyCache* proxy_cache);
+  ~SharedExchangeService();
+
+  CHECKED_STATUS Start();
+  void Shutdown();
+
+ private:
+  void Handle(size_t slot, uint32_t method, Slice request, CoarseTimePoint deadline);
+
+  // Sends status to the client, serialized as AppStatusPB, so error codes attached to it are
+  // preserved.
+  void RespondFailure(size_t slot, const Status& status);
+
+  template <class Req, class Resp, class ProxyMethod>
+  void Invoke(size_t slot, Slice request, CoarseTimePoint deadline, ProxyMethod proxy_method);
+
+  std::shared_ptr<TabletServerServiceProxy> proxy_;
+  SharedExchangeServer server_;
+  // Calls that were passed to the tablet server service and did not respond yet.
+  OperationCounter running_calls_;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_SHARED_EXCHANGE_SERVICE_H
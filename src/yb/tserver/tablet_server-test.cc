@@ -31,8 +31,11 @@
 //
 
 #include "yb/consensus/log-test-base.h"
+#include "yb/consensus/multi_raft_batcher.h"
+#include "yb/consensus/raft_consensus.h"
 
 #include "yb/common/ql_value.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/gutil/strings/escaping.h"
 #include "yb/gutil/strings/substitute.h"
@@ -84,6 +87,10 @@ DECLARE_int32(metrics_retirement_age_ms);
 DECLARE_string(block_manager);
 DECLARE_string(rpc_bind_addresses);
 DECLARE_bool(disable_clock_sync_error);
+DECLARE_double(tablet_hot_keys_sampling_probability);
+DECLARE_int32(multi_raft_batch_size);
+DECLARE_int32(multi_raft_heartbeat_window_ms);
+DECLARE_int32(consensus_rpc_timeout_ms);
 
 // Declare these metrics prototypes for simpler unit testing of their behavior.
 METRIC_DECLARE_counter(rows_inserted);
@@ -822,6 +829,126 @@ TEST_F(TabletServerTest, TestWriteOutOfBounds) {
   }
 }
 
+// Heartbeats of several tablets are sent in a single MultiRaftUpdateConsensus RPC, and error for
+// unknown tablet is reported only in its own response.
+TEST_F(TabletServerTest, TestMultiRaftHeartbeatBatch) {
+  const char* kSecondTabletId = "TestMultiRaftSecondTablet";
+  const std::string kUnknownTabletId = "TestMultiRaftUnknownTablet";
+  Schema schema = SchemaBuilder(schema_).Build();
+  ASSERT_OK(mini_server_->AddTestTablet(
+      "TestMultiRaftSecondTable", kSecondTabletId, schema, YQL_TABLE_TYPE));
+  ASSERT_OK(WaitForTabletRunning(kSecondTabletId));
+
+  // Batch is sent only when it is full, so responses are received only if all requests were
+  // combined into one RPC.
+  FLAGS_multi_raft_batch_size = 3;
+  FLAGS_multi_raft_heartbeat_window_ms = 60000;
+
+  auto batcher = std::make_shared<consensus::MultiRaftHeartbeatBatcher>(
+      HostPort::FromBoundEndpoint(mini_server_->bound_rpc_addr()), proxy_cache_.get(),
+      client_messenger_.get());
+
+  const std::vector<std::string> tablet_ids = {kTabletId, kSecondTabletId, kUnknownTabletId};
+  std::vector<consensus::ConsensusRequestPB> requests(tablet_ids.size());
+  std::vector<consensus::ConsensusResponsePB> responses(tablet_ids.size());
+  std::vector<RpcController> controllers(tablet_ids.size());
+  CountDownLatch latch(tablet_ids.size());
+  for (size_t i = 0; i != tablet_ids.size(); ++i) {
+    auto& req = requests[i];
+    req.set_dest_uuid(mini_server_->server()->fs_manager()->uuid());
+    req.set_tablet_id(tablet_ids[i]);
+    req.set_caller_uuid("fake_leader");
+    req.set_caller_term(0);
+    req.mutable_committed_op_id()->set_term(0);
+    req.mutable_committed_op_id()->set_index(0);
+    batcher->AddRequestToBatch(&req, &responses[i], &controllers[i], [&latch] {
+      latch.CountDown();
+    });
+  }
+  ASSERT_TRUE(latch.WaitFor(MonoDelta::FromSeconds(30)));
+
+  for (size_t i = 0; i != tablet_ids.size(); ++i) {
+    SCOPED_TRACE(Format(
+        "Tablet: $0, response: $1", tablet_ids[i], responses[i].ShortDebugString()));
+    ASSERT_OK(controllers[i].status());
+    if (tablet_ids[i] == kUnknownTabletId) {
+      ASSERT_TRUE(responses[i].has_error());
+      ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, responses[i].error().code());
+    } else {
+      // Stale term is rejected by consensus of the tablet, but not by the tablet server.
+      ASSERT_FALSE(responses[i].has_error());
+      ASSERT_EQ(mini_server_->server()->fs_manager()->uuid(), responses[i].responder_uuid());
+    }
+  }
+}
+
+// Tablet that stalls while handling its update does not fail the whole batch, and failure of the
+// batch is reported to each tablet without resending.
+TEST_F(TabletServerTest, TestMultiRaftHeartbeatBatchStalledTablet) {
+  const char* kSecondTabletId = "TestMultiRaftSecondTablet";
+  Schema schema = SchemaBuilder(schema_).Build();
+  ASSERT_OK(mini_server_->AddTestTablet(
+      "TestMultiRaftSecondTable", kSecondTabletId, schema, YQL_TABLE_TYPE));
+  ASSERT_OK(WaitForTabletRunning(kSecondTabletId));
+
+  const std::vector<std::string> tablet_ids = {kTabletId, kSecondTabletId};
+  FLAGS_multi_raft_batch_size = tablet_ids.size();
+  FLAGS_multi_raft_heartbeat_window_ms = 60000;
+  FLAGS_consensus_rpc_timeout_ms = 4000;
+
+  auto batcher = std::make_shared<consensus::MultiRaftHeartbeatBatcher>(
+      HostPort::FromBoundEndpoint(mini_server_->bound_rpc_addr()), proxy_cache_.get(),
+      client_messenger_.get());
+
+  std::vector<consensus::ConsensusRequestPB> requests(tablet_ids.size());
+  std::vector<consensus::ConsensusResponsePB> responses(tablet_ids.size());
+  std::vector<RpcController> controllers(tablet_ids.size());
+  auto send_batch = [&] {
+    CountDownLatch latch(tablet_ids.size());
+    for (size_t i = 0; i != tablet_ids.size(); ++i) {
+      auto& req = requests[i];
+      req.set_dest_uuid(mini_server_->server()->fs_manager()->uuid());
+      req.set_tablet_id(tablet_ids[i]);
+      req.set_caller_uuid("fake_leader");
+      req.set_caller_term(0);
+      req.mutable_committed_op_id()->set_term(0);
+      req.mutable_committed_op_id()->set_index(0);
+      responses[i].Clear();
+      controllers[i].Reset();
+      batcher->AddRequestToBatch(&req, &responses[i], &controllers[i], [&latch] {
+        latch.CountDown();
+      });
+    }
+    return latch.WaitFor(MonoDelta::FromSeconds(30));
+  };
+
+  // Update of the first tablet takes longer than the batch deadline, i.e. half of the RPC timeout.
+  // So update of the second tablet is not started, but the batch is answered in time.
+  tablet_peer_->raft_consensus()->TEST_DelayUpdate(MonoDelta::FromSeconds(3));
+  ASSERT_TRUE(send_batch());
+  for (size_t i = 0; i != tablet_ids.size(); ++i) {
+    SCOPED_TRACE(Format(
+        "Tablet: $0, response: $1", tablet_ids[i], responses[i].ShortDebugString()));
+    ASSERT_OK(controllers[i].status());
+    if (tablet_ids[i] == kTabletId) {
+      ASSERT_FALSE(responses[i].has_error());
+    } else {
+      ASSERT_TRUE(responses[i].has_error());
+      ASSERT_TRUE(StatusFromPB(responses[i].error().status()).IsTimedOut());
+    }
+  }
+
+  // Batch RPC times out, each tablet observes this status instead of having its request resent.
+  tablet_peer_->raft_consensus()->TEST_DelayUpdate(MonoDelta::FromSeconds(6));
+  ASSERT_TRUE(send_batch());
+  for (size_t i = 0; i != tablet_ids.size(); ++i) {
+    SCOPED_TRACE(Format("Tablet: $0", tablet_ids[i]));
+    auto status = controllers[i].status();
+    ASSERT_TRUE(status.IsTimedOut()) << status;
+  }
+  tablet_peer_->raft_consensus()->TEST_DelayUpdate(MonoDelta::kZero);
+}
+
 namespace {
 
 void CalcTestRowChecksum(uint64_t *out, int32_t key, uint8_t string_field_defined = true) {
@@ -895,5 +1022,34 @@ TEST_F(TabletServerTest, TestChecksumScan) {
   ASSERT_EQ(first_crc, resp.checksum());
 }
 
+TEST_F(TabletServerTest, TestHotKeys) {
+  constexpr int kNumRows = 10;
+  constexpr int kNumHotKeyWrites = 5;
+  FLAGS_tablet_hot_keys_sampling_probability = 1;
+
+  InsertTestRowsRemote(0, 1, kNumRows);
+  for (int i = 0; i != kNumHotKeyWrites; ++i) {
+    InsertTestRowsRemote(0, 1, 1);
+  }
+
+  GetTabletHotKeysRequestPB req;
+  req.set_tablet_id(kTabletId);
+  req.set_limit(1);
+  GetTabletHotKeysResponsePB resp;
+  RpcController controller;
+  ASSERT_OK(proxy_->GetTabletHotKeys(req, &resp, &controller));
+  ASSERT_FALSE(resp.has_error()) << resp.error().DebugString();
+  ASSERT_EQ(kNumRows + kNumHotKeyWrites, resp.sampled_writes());
+  ASSERT_EQ(1, resp.write_keys().size());
+  ASSERT_EQ(kNumHotKeyWrites + 1, resp.write_keys(0).count());
+
+  EasyCurl c;
+  faststring buf;
+  ASSERT_OK(c.FetchURL(Substitute("http://$0/tablet-hot-keys?id=$1",
+                                  yb::ToString(mini_server_->bound_http_addr()), kTabletId),
+                       &buf));
+  ASSERT_STR_CONTAINS(buf.ToString(), "Hot Keys for Tablet");
+}
+
 } // namespace tserver
 } // namespace yb
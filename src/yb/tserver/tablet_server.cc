@@ -51,6 +51,7 @@
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tserver/heartbeater_factory.h"
 #include "yb/tserver/metrics_snapshotter.h"
+#include "yb/tserver/shared_exchange_service.h"
 #include "yb/tserver/tablet_service.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver-path-handlers.h"
@@ -112,6 +113,11 @@ DEFINE_bool(enable_direct_local_tablet_server_call,
             "Enable direct call to local tablet server");
 TAG_FLAG(enable_direct_local_tablet_server_call, advanced);
 
+DEFINE_bool(enable_pg_shared_exchange, true,
+            "Accept read and write requests from local postgres backends via shared memory, "
+            "instead of loopback RPC.");
+TAG_FLAG(enable_pg_shared_exchange, advanced);
+
 DEFINE_string(redis_proxy_bind_address, "", "Address to bind the redis proxy to");
 DEFINE_int32(redis_proxy_webserver_port, 0, "Webserver port for redis proxy");
 
@@ -240,6 +246,11 @@ Status TabletServer::Init() {
 
   heartbeater_ = CreateHeartbeater(opts_, this);
 
+  if (FLAGS_enable_pg_shared_exchange) {
+    shared_exchange_ = std::make_unique<TServerSharedExchange>(
+        VERIFY_RESULT(TServerSharedExchange::Create()));
+  }
+
   if (FLAGS_tserver_enable_metrics_snapshotter) {
     metrics_snapshotter_.reset(new MetricsSnapshotter(opts_, this));
   }
@@ -326,6 +337,12 @@ Status TabletServer::Start() {
     proxy_ = std::make_shared<TabletServerServiceProxy>(proxy_cache_.get(), HostPort());
   }
 
+  if (shared_exchange_) {
+    shared_exchange_service_ = std::make_unique<SharedExchangeService>(
+        shared_exchange_->get(), permanent_uuid(), proxy_cache_.get());
+    RETURN_NOT_OK(shared_exchange_service_->Start());
+  }
+
   RETURN_NOT_OK(heartbeater_->Start());
 
   if (FLAGS_tserver_enable_metrics_snapshotter) {
@@ -351,6 +368,10 @@ void TabletServer::Shutdown() {
       WARN_NOT_OK(metrics_snapshotter_->Stop(), "Failed to stop TS Metrics Snapshotter thread");
     }
 
+    if (shared_exchange_service_) {
+      shared_exchange_service_->Shutdown();
+    }
+
     {
       std::lock_guard<simple_spinlock> l(lock_);
       tablet_server_service_ = nullptr;
@@ -458,6 +479,10 @@ int TabletServer::GetSharedMemoryFd() {
   return shared_object_.GetFd();
 }
 
+int TabletServer::GetSharedExchangeFd() {
+  return shared_exchange_ ? shared_exchange_->GetFd() : -1;
+}
+
 void TabletServer::SetYSQLCatalogVersion(uint64_t new_version) {
   std::lock_guard<simple_spinlock> l(lock_);
   if (new_version > ysql_catalog_version_) {
@@ -68,6 +68,7 @@ constexpr const char* const kTcMallocMaxThreadCacheBytes = "tcmalloc.max_total_t
 
 class Heartbeater;
 class MetricsSnapshotter;
+class SharedExchangeService;
 class TabletServerPathHandlers;
 class TSTabletManager;
 
@@ -188,6 +189,10 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Returns the file descriptor of this tablet server's shared memory segment.
   int GetSharedMemoryFd();
 
+  // Returns the file descriptor of the shared memory segment used by local postgres backends to
+  // send requests to this tablet server, or -1 if it is disabled.
+  int GetSharedExchangeFd();
+
   // Currently only used by cdc.
   virtual int32_t cluster_config_version() const {
     return std::numeric_limits<int32_t>::max();
@@ -263,6 +268,10 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Shared memory owned by the tablet server.
   TServerSharedObject shared_object_;
 
+  // Shared memory used to exchange requests and responses with local postgres backends.
+  std::unique_ptr<TServerSharedExchange> shared_exchange_;
+  std::unique_ptr<SharedExchangeService> shared_exchange_service_;
+
   std::atomic<client::TransactionPool*> transaction_pool_{nullptr};
   std::mutex transaction_pool_mutex_;
   std::unique_ptr<client::TransactionManager> transaction_manager_holder_;
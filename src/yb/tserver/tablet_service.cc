@@ -35,8 +35,12 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
 #include "yb/client/transaction.h"
 #include "yb/client/transaction_pool.h"
 
@@ -57,6 +61,7 @@
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/escaping.h"
 #include "yb/master/sys_catalog_constants.h"
+#include "yb/rpc/inbound_call.h"
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -483,7 +488,104 @@ class ScanResultChecksummer {
 
 TabletServiceImpl::TabletServiceImpl(TabletServerIf* server)
     : TabletServerServiceIf(server->MetricEnt()),
-      server_(server) {
+      server_(server),
+      pg_sequence_cache_([server] { return &server->tablet_manager()->client(); }),
+      pg_table_cache_([server] { return &server->tablet_manager()->client(); },
+                      [server] { return server->ysql_catalog_version(); }) {
+}
+
+namespace {
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+// Scans serialized QL or PGSQL read request up to the current limit of input.
+// Request is considered a point read when it has any of the point_fields, that restrict it to a
+// single partition key, and does not have paging state, i.e. does not continue a scan.
+bool IsPointReadRequest(
+    CodedInputStream* input, std::initializer_list<int> point_fields, int paging_state_field) {
+  bool result = false;
+  for (;;) {
+    auto tag = input->ReadTag();
+    if (tag == 0) {
+      return result;
+    }
+    auto field = WireFormatLite::GetTagFieldNumber(tag);
+    if (field == paging_state_field) {
+      return false;
+    }
+    if (std::find(point_fields.begin(), point_fields.end(), field) != point_fields.end()) {
+      result = true;
+    }
+    if (!WireFormatLite::SkipField(input, tag)) {
+      return false;
+    }
+  }
+}
+
+// Classifies serialized ReadRequestPB, without parsing it completely.
+// Read is a scan when any of its QL or PGSQL requests is not a point read.
+bool IsScanReadRequest(const Slice& serialized_request) {
+  CodedInputStream input(serialized_request.data(), static_cast<int>(serialized_request.size()));
+  for (;;) {
+    auto tag = input.ReadTag();
+    if (tag == 0) {
+      return false;
+    }
+    auto field = WireFormatLite::GetTagFieldNumber(tag);
+    if (field != ReadRequestPB::kQlBatchFieldNumber &&
+        field != ReadRequestPB::kPgsqlBatchFieldNumber) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+    uint32_t length;
+    if (!input.ReadVarint32(&length)) {
+      return false;
+    }
+    auto limit = input.PushLimit(length);
+    bool point_read = field == ReadRequestPB::kQlBatchFieldNumber
+        ? IsPointReadRequest(
+              &input, {QLReadRequestPB::kHashedColumnValuesFieldNumber},
+              QLReadRequestPB::kPagingStateFieldNumber)
+        : IsPointReadRequest(
+              &input,
+              {PgsqlReadRequestPB::kYbctidColumnValueFieldNumber,
+               PgsqlReadRequestPB::kPartitionColumnValuesFieldNumber,
+               PgsqlReadRequestPB::kBatchArgumentsFieldNumber},
+              PgsqlReadRequestPB::kPagingStateFieldNumber);
+    if (!point_read) {
+      return true;
+    }
+    input.PopLimit(limit);
+  }
+}
+
+const std::unordered_map<std::string, rpc::CallPriority> kTabletServiceCallPriorities = {
+  {"UpdateTransaction", rpc::CallPriority::kLatencySensitive},
+  {"GetTransactionStatus", rpc::CallPriority::kLatencySensitive},
+  {"GetTransactionStatusAtParticipant", rpc::CallPriority::kLatencySensitive},
+  {"AbortTransaction", rpc::CallPriority::kLatencySensitive},
+  {"ListTablets", rpc::CallPriority::kBackground},
+  {"ListTabletsForTabletServer", rpc::CallPriority::kBackground},
+  {"GetLogLocation", rpc::CallPriority::kBackground},
+  {"Checksum", rpc::CallPriority::kBackground},
+  {"ImportData", rpc::CallPriority::kBackground},
+  {"GetTabletStatus", rpc::CallPriority::kBackground},
+  {"GetTabletHotKeys", rpc::CallPriority::kBackground},
+};
+
+} // namespace
+
+rpc::CallPriority TabletServiceImpl::GetCallPriority(const rpc::InboundCall& call) const {
+  const auto& method_name = call.method_name();
+  if (method_name == "Read") {
+    return IsScanReadRequest(call.serialized_request()) ? rpc::CallPriority::kBulk
+                                                        : rpc::CallPriority::kLatencySensitive;
+  }
+  auto it = kTabletServiceCallPriorities.find(method_name);
+  return it != kTabletServiceCallPriorities.end() ? it->second : rpc::CallPriority::kNormal;
 }
 
 TabletServiceAdminImpl::TabletServiceAdminImpl(TabletServer* server)
@@ -1335,6 +1437,8 @@ Status TabletServiceImpl::CheckPeerIsReady(const TabletPeer& tablet_peer) {
   }
   if (tablet_peer.tablet()->metadata()->tablet_data_state() ==
       tablet::TabletDataState::TABLET_DATA_SPLIT) {
+    // Partitions of the table changed, so its cached descriptor is stale.
+    pg_table_cache_.Invalidate(tablet_peer.tablet()->metadata()->table_id());
     return STATUS(
         IllegalState,
         Format(
@@ -1985,6 +2089,15 @@ ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& me
 ConsensusServiceImpl::~ConsensusServiceImpl() {
 }
 
+rpc::CallPriority ConsensusServiceImpl::GetCallPriority(const rpc::InboundCall& call) const {
+  const auto& method_name = call.method_name();
+  if (method_name == "UpdateConsensus" || method_name == "MultiRaftUpdateConsensus" ||
+      method_name == "RequestConsensusVote") {
+    return rpc::CallPriority::kCritical;
+  }
+  return rpc::CallPriority::kNormal;
+}
+
 void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
                                            ConsensusResponsePB* resp,
                                            rpc::RpcContext context) {
@@ -1992,17 +2105,11 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   if (!CheckUuidMatchOrRespond(tablet_manager_, "UpdateConsensus", req, resp, &context)) {
     return;
   }
-  auto tablet_peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
-      tablet_manager_, req->tablet_id(), resp, &context));
-
-  // Submit the update directly to the TabletPeer's Consensus instance.
-  shared_ptr<Consensus> consensus;
-  if (!GetConsensusOrRespond(tablet_peer, resp, &context, &consensus)) return;
 
   // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
   // gives us a const request, but we need to be able to move messages out of the request for
   // efficiency.
-  Status s = consensus->Update(
+  Status s = ApplyConsensusUpdate(
       const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline());
   if (PREDICT_FALSE(!s.ok())) {
     // Clear the response first, since a partially-filled response could
@@ -2010,19 +2117,79 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
     // in embedded optional messages.
     resp->Clear();
 
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::UNKNOWN_ERROR,
-                         &context);
+    SetupErrorAndRespond(resp->mutable_error(), s, &context);
     return;
   }
 
+  context.RespondSuccess();
+}
+
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
+  // Updates are applied one after another, so a tablet that stalls delays the ones after it.
+  // Updates are not started after half of the time left to the client deadline, so the batch is
+  // answered before the client gives up on it. Those updates fail with TimedOut, only affecting
+  // their own tablets.
+  auto deadline = context.GetClientDeadline();
+  if (deadline != CoarseTimePoint::max()) {
+    auto now = CoarseMonoClock::now();
+    deadline = now + std::max<CoarseDuration>(deadline - now, CoarseDuration::zero()) / 2;
+  }
+  for (const auto& consensus_req : req->consensus_request()) {
+    // See UpdateConsensus about const_cast.
+    UpdateConsensusInBatch(
+        const_cast<ConsensusRequestPB*>(&consensus_req), resp->add_consensus_response(),
+        deadline);
+  }
+  context.RespondSuccess();
+}
+
+void ConsensusServiceImpl::UpdateConsensusInBatch(
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, CoarseTimePoint deadline) {
+  Status s = CheckUuidMatch(tablet_manager_, "MultiRaftUpdateConsensus", req);
+  if (s.ok() && CoarseMonoClock::now() >= deadline) {
+    s = STATUS_FORMAT(TimedOut, "Batch deadline passed before update of $0", req->tablet_id());
+  }
+  if (s.ok()) {
+    s = ApplyConsensusUpdate(req, resp, deadline);
+  }
+  if (PREDICT_FALSE(!s.ok())) {
+    // Batch is answered as a whole, so errors of individual updates are reported in their
+    // responses instead of failing the RPC.
+    resp->Clear();
+    auto ts_error = TabletServerError::FromStatus(s);
+    StatusToPB(s, resp->mutable_error()->mutable_status());
+    resp->mutable_error()->set_code(
+        ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR);
+  }
+}
+
+Status ConsensusServiceImpl::ApplyConsensusUpdate(
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, CoarseTimePoint deadline) {
+  auto tablet_peer = VERIFY_RESULT(LookupTabletPeer(tablet_manager_, req->tablet_id()));
+
+  // Submit the update directly to the TabletPeer's Consensus instance.
+  auto consensus = tablet_peer->shared_consensus();
+  if (!consensus) {
+    return STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running")
+        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+  }
+
+  Status s = consensus->Update(req, resp, deadline);
+  if (PREDICT_FALSE(!s.ok())) {
+    return s.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::UNKNOWN_ERROR));
+  }
+
   auto tablet = tablet_peer->shared_tablet();
   if (tablet) {
     resp->set_num_sst_files(tablet->GetCurrentVersionNumSSTFiles());
   }
 
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
-  context.RespondSuccess();
+  return Status::OK();
 }
 
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
@@ -2413,6 +2580,35 @@ void TabletServiceImpl::GetTabletStatus(const GetTabletStatusRequestPB* req,
   context.RespondSuccess();
 }
 
+void TabletServiceImpl::GetTabletHotKeys(const GetTabletHotKeysRequestPB* req,
+                                         GetTabletHotKeysResponsePB* resp,
+                                         rpc::RpcContext context) {
+  auto peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context));
+  auto tablet = peer->shared_tablet();
+  if (!tablet) {
+    SetupErrorAndRespond(resp->mutable_error(),
+                         STATUS_FORMAT(IllegalState, "Tablet $0 not running", req->tablet_id()),
+                         TabletServerErrorPB::TABLET_NOT_RUNNING, &context);
+    return;
+  }
+
+  auto fill_keys = [limit = req->limit()](
+      const HeavyHitters& hot_keys, google::protobuf::RepeatedPtrField<HotKeyPB>* out) {
+    for (auto& entry : hot_keys.TopK(limit)) {
+      auto* key = out->Add();
+      key->set_key(std::move(entry.key));
+      key->set_count(entry.count);
+      key->set_error(entry.error);
+    }
+  };
+  fill_keys(tablet->hot_read_keys(), resp->mutable_read_keys());
+  fill_keys(tablet->hot_write_keys(), resp->mutable_write_keys());
+  resp->set_sampled_reads(tablet->hot_read_keys().total());
+  resp->set_sampled_writes(tablet->hot_write_keys().total());
+  context.RespondSuccess();
+}
+
 void TabletServiceImpl::IsTabletServerReady(const IsTabletServerReadyRequestPB* req,
                                             IsTabletServerReadyResponsePB* resp,
                                             rpc::RpcContext context) {
@@ -2440,7 +2636,50 @@ void TabletServiceImpl::TakeTransaction(const TakeTransactionRequestPB* req,
   context.RespondSuccess();
 }
 
+void TabletServiceImpl::ReserveSequenceValues(const ReserveSequenceValuesRequestPB* req,
+                                              ReserveSequenceValuesResponsePB* resp,
+                                              rpc::RpcContext context) {
+  if (req->discard_cached()) {
+    pg_sequence_cache_.Discard(req->db_oid(), req->seq_oid());
+    context.RespondSuccess();
+    return;
+  }
+
+  auto context_ptr = std::make_shared<rpc::RpcContext>(std::move(context));
+  pg_sequence_cache_.Reserve(
+      *req, [resp, context_ptr](const Result<PgSequenceValues>& values) {
+    if (!values.ok()) {
+      SetupErrorAndRespond(resp->mutable_error(), values.status(),
+                           TabletServerErrorPB::UNKNOWN_ERROR, context_ptr.get());
+      return;
+    }
+    resp->set_first_value(values->first);
+    resp->set_last_value(values->last);
+    resp->set_num_values(values->count);
+    context_ptr->RespondSuccess();
+  });
+}
+
+void TabletServiceImpl::OpenPgTable(const OpenPgTableRequestPB* req,
+                                    OpenPgTableResponsePB* resp,
+                                    rpc::RpcContext context) {
+  if (req->invalidate()) {
+    pg_table_cache_.Invalidate(req->table_id());
+    context.RespondSuccess();
+    return;
+  }
+
+  auto status = pg_table_cache_.Get(req->table_id(), req->ysql_catalog_version(), resp);
+  if (!status.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR,
+                         &context);
+    return;
+  }
+  context.RespondSuccess();
+}
+
 void TabletServiceImpl::Shutdown() {
+  pg_sequence_cache_.Shutdown();
 }
 
 scoped_refptr<Histogram> TabletServer::GetMetricsHistogram(
@@ -43,6 +43,8 @@
 #include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/tablet_peer.h"
 
+#include "yb/tserver/pg_sequence_cache.h"
+#include "yb/tserver/pg_table_cache.h"
 #include "yb/tserver/tablet_server_interface.h"
 #include "yb/tserver/tserver_admin.service.h"
 #include "yb/tserver/tserver_service.service.h"
@@ -66,6 +68,8 @@ class TabletServiceImpl : public TabletServerServiceIf {
 
   explicit TabletServiceImpl(TabletServerIf* server);
 
+  rpc::CallPriority GetCallPriority(const rpc::InboundCall& call) const override;
+
   void Write(const WriteRequestPB* req, WriteResponsePB* resp, rpc::RpcContext context) override;
 
   void Read(const ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext context) override;
@@ -124,6 +128,10 @@ class TabletServiceImpl : public TabletServerServiceIf {
                        GetTabletStatusResponsePB* resp,
                        rpc::RpcContext context) override;
 
+  void GetTabletHotKeys(const GetTabletHotKeysRequestPB* req,
+                        GetTabletHotKeysResponsePB* resp,
+                        rpc::RpcContext context) override;
+
   void IsTabletServerReady(const IsTabletServerReadyRequestPB* req,
                            IsTabletServerReadyResponsePB* resp,
                            rpc::RpcContext context) override;
@@ -132,6 +140,14 @@ class TabletServiceImpl : public TabletServerServiceIf {
                        TakeTransactionResponsePB* resp,
                        rpc::RpcContext context) override;
 
+  void ReserveSequenceValues(const ReserveSequenceValuesRequestPB* req,
+                             ReserveSequenceValuesResponsePB* resp,
+                             rpc::RpcContext context) override;
+
+  void OpenPgTable(const OpenPgTableRequestPB* req,
+                   OpenPgTableResponsePB* resp,
+                   rpc::RpcContext context) override;
+
   void Shutdown() override;
 
  private:
@@ -175,6 +191,9 @@ class TabletServiceImpl : public TabletServerServiceIf {
   void CompleteRead(ReadContext* read_context);
 
   TabletServerIf *const server_;
+
+  PgSequenceCache pg_sequence_cache_;
+  PgTableCache pg_table_cache_;
 };
 
 class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
@@ -254,10 +273,16 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
 
   virtual ~ConsensusServiceImpl();
 
+  rpc::CallPriority GetCallPriority(const rpc::InboundCall& call) const override;
+
   virtual void UpdateConsensus(const consensus::ConsensusRequestPB *req,
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
+                                consensus::MultiRaftConsensusResponsePB *resp,
+                                rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -295,6 +320,19 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies one update of MultiRaftUpdateConsensus, errors are reported via resp. Update is not
+  // started if deadline of the batch has already passed.
+  void UpdateConsensusInBatch(
+      consensus::ConsensusRequestPB* req, consensus::ConsensusResponsePB* resp,
+      CoarseTimePoint deadline);
+
+  // Passes update to consensus of the local peer of the requested tablet. Used by both
+  // UpdateConsensus and MultiRaftUpdateConsensus. Returned error status contains TabletServerError
+  // code that should be reported to the caller.
+  CHECKED_STATUS ApplyConsensusUpdate(
+      consensus::ConsensusRequestPB* req, consensus::ConsensusResponsePB* resp,
+      CoarseTimePoint deadline);
+
   TabletPeerLookupIf* tablet_manager_;
 };
 
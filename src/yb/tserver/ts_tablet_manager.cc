@@ -50,6 +50,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -79,6 +80,7 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tablet/transaction_status_batcher.h"
 #include "yb/tablet/operations/split_operation.h"
 
 #include "yb/tserver/heartbeater.h"
@@ -499,6 +501,10 @@ Status TSTabletManager::Init() {
       FLAGS_tserver_yb_client_default_timeout_ms / 1000, "" /* tserver_uuid */,
       &server_->options(), server_->metric_entity(), server_->mem_tracker(),
       server_->messenger());
+  status_batcher_ = std::make_unique<tablet::TransactionStatusBatcher>(
+      async_client_init_->get_client_future(), scoped_refptr<server::Clock>(server_->clock()));
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache());
 
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
@@ -1134,7 +1140,7 @@ Result<TabletPeerPtr> TSTabletManager::CreateAndRegisterTabletPeer(
   TabletPeerPtr tablet_peer(new tablet::TabletPeer(
       meta, local_peer_pb_, scoped_refptr<server::Clock>(server_->clock()), fs_manager_->uuid(),
       Bind(&TSTabletManager::ApplyChange, Unretained(this), meta->raft_group_id()),
-      metric_registry_, this));
+      metric_registry_, this, status_batcher_.get(), multi_raft_manager_.get()));
   RETURN_NOT_OK(RegisterTablet(meta->raft_group_id(), tablet_peer, mode));
   return tablet_peer;
 }
@@ -1404,6 +1410,9 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
 }
 
 void TSTabletManager::StartShutdown() {
+  if (status_batcher_) {
+    status_batcher_->Shutdown();
+  }
   async_client_init_->Shutdown();
 
   if (background_task_) {
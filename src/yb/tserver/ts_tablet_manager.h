@@ -514,6 +514,12 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   boost::optional<yb::client::AsyncClientInitialiser> async_client_init_;
 
+  // Transaction status requests of all tablet peers are sent via this batcher.
+  std::unique_ptr<tablet::TransactionStatusBatcher> status_batcher_;
+
+  // Coalesces Raft heartbeats of all tablet peers going to the same server.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   TabletPeers shutting_down_peers_;
 
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -42,6 +43,7 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
@@ -209,7 +211,8 @@ void HandleTabletPage(
       {"tablet-consensus-status", "Consensus Status"},
       {"log-anchors", "Tablet Log Anchors"},
       {"transactions", "Transactions"},
-      {"rocksdb", "RocksDB" }};
+      {"rocksdb", "RocksDB" },
+      {"tablet-hot-keys", "Hot Keys"}};
 
   auto encoded_tablet_id = UrlEncodeToString(tablet_id);
   for (const auto& entry : entries) {
@@ -313,6 +316,40 @@ void HandleRocksDBPage(
   DumpRocksDB("Intents", doc_db.intents, output);
 }
 
+void DumpHotKeys(const char* title, const HeavyHitters& hot_keys, std::ostream* out) {
+  *out << "<h2>" << title << "</h2>" << std::endl;
+  *out << "<p>Sampled accesses: " << hot_keys.total() << "</p>" << std::endl;
+  *out << "<table class='table table-striped'>" << std::endl;
+  *out << "  <tr><th>Key</th><th>Count</th><th>Max Overestimation</th></tr>" << std::endl;
+  for (const auto& entry : hot_keys.TopK(std::numeric_limits<size_t>::max())) {
+    docdb::DocKey doc_key;
+    Slice key(entry.key);
+    auto status = doc_key.DecodeFrom(&key);
+    *out << Format("  <tr><td>$0</td><td>$1</td><td>$2</td></tr>",
+                   EscapeForHtmlToString(status.ok() ? doc_key.ToString()
+                                                     : Slice(entry.key).ToDebugHexString()),
+                   entry.count, entry.error) << std::endl;
+  }
+  *out << "</table>" << std::endl;
+}
+
+void HandleHotKeysPage(
+    const std::string& tablet_id, const tablet::TabletPeerPtr& peer,
+    const Webserver::WebRequest& req, std::stringstream* output) {
+  auto tablet = peer->shared_tablet();
+  if (!tablet) {
+    *output << "Tablet " << EscapeForHtmlToString(tablet_id) << " not running";
+    return;
+  }
+
+  *output << "<h1>Hot Keys for Tablet " << EscapeForHtmlToString(tablet_id) << "</h1>"
+          << std::endl;
+  *output << "<p>Estimated from sampled operations, keys of hash partitioned tables include only "
+          << "hashed components.</p>" << std::endl;
+  DumpHotKeys("Reads", tablet->hot_read_keys(), output);
+  DumpHotKeys("Writes", tablet->hot_write_keys(), output);
+}
+
 template<class F>
 void RegisterTabletPathHandler(
     Webserver* web_server, TabletServer* tserver, const std::string& path, const F& f) {
@@ -348,6 +385,7 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
   RegisterTabletPathHandler(server, tserver_, "/log-anchors", &HandleLogAnchorsPage);
   RegisterTabletPathHandler(server, tserver_, "/transactions", &HandleTransactionsPage);
   RegisterTabletPathHandler(server, tserver_, "/rocksdb", &HandleRocksDBPage);
+  RegisterTabletPathHandler(server, tserver_, "/tablet-hot-keys", &HandleHotKeysPage);
   server->RegisterPathHandler(
       "/", "Dashboards",
       std::bind(&TabletServerPathHandlers::HandleDashboardsPage, this, _1, _2), true /* styled */,
@@ -16,6 +16,7 @@
 
 #include <atomic>
 
+#include "yb/util/enums.h"
 #include "yb/util/shared_mem.h"
 
 #include "yb/tserver/tserver_util_fwd.h"
@@ -23,6 +24,10 @@
 namespace yb {
 namespace tserver {
 
+// Methods of the tablet server service, that could be invoked by local processes via shared
+// memory exchange.
+YB_DEFINE_ENUM(TServerSharedExchangeMethod, (kRead)(kWrite));
+
 class TServerSharedData {
  public:
   TServerSharedData() {
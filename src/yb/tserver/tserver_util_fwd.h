@@ -17,10 +17,14 @@
 #include "yb/util/shared_mem.h"
 
 namespace yb {
+
+class SharedExchange;
+
 namespace tserver {
 
 class TServerSharedData;
 typedef SharedMemoryObject<TServerSharedData> TServerSharedObject;
+typedef SharedMemoryObject<SharedExchange> TServerSharedExchange;
 
 } // namespace tserver
 } // namespace yb
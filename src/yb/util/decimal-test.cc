@@ -13,6 +13,7 @@
 
 #include "yb/util/decimal.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
@@ -262,6 +263,83 @@ TEST_F(DecimalTest, TestBigDecimalEncoding) {
   EXPECT_TRUE(is_out_of_range);
 }
 
+TEST_F(DecimalTest, TestAddition) {
+  // Pairs of operands and expected sum. Some of them fit 128-bit integer addition, others require
+  // digit by digit addition.
+  struct AdditionCase {
+    const char* lhs;
+    const char* rhs;
+    const char* sum;
+  };
+  const std::vector<AdditionCase> cases = {
+      {"0.1", "0.2", "0.3"},
+      {"-1.5", "1.5", "0"},
+      {"0", "-2.5", "-2.5"},
+      {"123.456", "-0.456", "123"},
+      {"-0.001", "-999.999", "-1000"},
+      {"9999999999999999999999999999999999999", "1", "1e+37"},
+      {"99999999999999999999999999999999999999", "1", "1e+38"},
+      {"1e30", "1e-10", "1.0000000000000000000000000000000000000001e+30"},
+      {"-1e30", "1e-10", "-9.999999999999999999999999999999999999999e+29"},
+  };
+  for (const auto& test_case : cases) {
+    SCOPED_TRACE(Format("$0 + $1", test_case.lhs, test_case.rhs));
+    Decimal lhs(test_case.lhs);
+    Decimal rhs(test_case.rhs);
+    Decimal expected(test_case.sum);
+    ASSERT_EQ(expected, lhs + rhs);
+    ASSERT_EQ(expected, rhs + lhs);
+  }
+}
+
+TEST_F(DecimalTest, TestArithmeticPerf) {
+  constexpr int kNumValues = 1000;
+  constexpr int kNumIterations = 1000000;
+  std::vector<Decimal> values;
+  values.reserve(kNumValues);
+  for (int i = 0; i != kNumValues; ++i) {
+    values.emplace_back(Format("$0.25", i));
+  }
+
+  Decimal sum("0");
+  auto start = MonoTime::Now();
+  for (int i = 0; i != kNumIterations; ++i) {
+    sum = sum + values[i % kNumValues];
+  }
+  auto passed = MonoTime::Now() - start;
+  LOG(INFO) << "Added " << kNumIterations << " decimals in " << passed << ", "
+            << passed.ToNanoseconds() / kNumIterations << "ns per addition";
+  ASSERT_EQ(Decimal("499750000"), sum);
+
+  int num_less = 0;
+  start = MonoTime::Now();
+  for (int i = 0; i != kNumIterations; ++i) {
+    num_less += values[i % kNumValues] < values[(i + 1) % kNumValues];
+  }
+  passed = MonoTime::Now() - start;
+  LOG(INFO) << "Compared " << kNumIterations << " decimals in " << passed << ", "
+            << passed.ToNanoseconds() / kNumIterations << "ns per comparison";
+  ASSERT_EQ(kNumIterations - kNumIterations / kNumValues, num_less);
+
+  size_t encoded_size = 0;
+  start = MonoTime::Now();
+  for (int i = 0; i != kNumIterations; ++i) {
+    encoded_size += values[i % kNumValues].EncodeToComparable().size();
+  }
+  passed = MonoTime::Now() - start;
+  LOG(INFO) << "Encoded " << kNumIterations << " decimals to " << encoded_size << " bytes in "
+            << passed << ", " << passed.ToNanoseconds() / kNumIterations << "ns per decimal";
+
+  Decimal decoded;
+  start = MonoTime::Now();
+  for (int i = 0; i != kNumIterations; ++i) {
+    ASSERT_OK(decoded.DecodeFromComparable(values[i % kNumValues].EncodeToComparable()));
+  }
+  passed = MonoTime::Now() - start;
+  LOG(INFO) << "Encoded and decoded " << kNumIterations << " decimals in " << passed << ", "
+            << passed.ToNanoseconds() / kNumIterations << "ns per decimal";
+}
+
 TEST_F(DecimalTest, TestFloatDoubleCanonicalization) {
   const float float_nan_0 = CreateFloat(1, 0b11111111, (1 << 22));
   const float float_nan_1 = CreateFloat(0, 0b11111111, 1);
@@ -11,6 +11,7 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <vector>
 #include <limits>
 #include <iomanip>
@@ -276,9 +277,8 @@ string Decimal::EncodeToComparable() const {
     return string(1, static_cast<char>(128));
   }
   // We reserve two bits for sign: -, zero, and +. Their sign portions are resp. '00', '10', '11'.
-  string exponent = exponent_.EncodeToComparable(/* num_reserved_bits */ 2);
-  const string mantissa = EncodeToDigitPairs(digits_);
-  string output = exponent + mantissa;
+  string output = exponent_.EncodeToComparable(/* num_reserved_bits */ 2);
+  output += EncodeToDigitPairs(digits_);
   // The first two (reserved) bits are set to 1 here.
   output[0] |= 0xc0;
   // For negatives, everything is complemented (including the sign bits) which were set to 1 above.
@@ -455,11 +455,85 @@ Decimal DecimalFromComparable(const std::string& str) {
   return DecimalFromComparable(Slice(str));
 }
 
+namespace {
+
+// Max number of digits in the aligned mantissas that are added using 128-bit integers.
+// Sum of two such mantissas is less than 2 * 10^37, so it cannot overflow.
+constexpr int64_t kMaxFastAddDigits = 37;
+// Bound on exponents handled by the fast path, so that differences of positions cannot overflow.
+constexpr int64_t kMaxFastAddExponent = 1LL << 32;
+
+} // namespace
+
+// Fast path for the common case of decimals with small exponents and not too many digits.
+// Both mantissas are aligned to the lowest digit position and added as 128-bit integers.
+bool Decimal::TryAddSmall(const Decimal& other, Decimal* result) const {
+  auto exponent = exponent_.ToInt64();
+  auto other_exponent = other.exponent_.ToInt64();
+  if (!exponent.ok() || !other_exponent.ok() ||
+      std::abs(*exponent) > kMaxFastAddExponent ||
+      std::abs(*other_exponent) > kMaxFastAddExponent ||
+      static_cast<int64_t>(digits_.size()) > kMaxFastAddDigits ||
+      static_cast<int64_t>(other.digits_.size()) > kMaxFastAddDigits) {
+    return false;
+  }
+  // Position of the lowest digit, i.e. this = mantissa * 10^low.
+  int64_t low = *exponent - static_cast<int64_t>(digits_.size());
+  int64_t other_low = *other_exponent - static_cast<int64_t>(other.digits_.size());
+  int64_t min_low = std::min(low, other_low);
+  if (std::max(*exponent, *other_exponent) - min_low > kMaxFastAddDigits) {
+    return false;
+  }
+
+  auto aligned_mantissa = [min_low](const Decimal& decimal, int64_t decimal_low) {
+    __int128 mantissa = 0;
+    for (auto digit : decimal.digits_) {
+      mantissa = mantissa * 10 + digit;
+    }
+    for (int64_t i = min_low; i != decimal_low; ++i) {
+      mantissa *= 10;
+    }
+    return decimal.is_positive_ ? mantissa : -mantissa;
+  };
+  __int128 sum = aligned_mantissa(*this, low) + aligned_mantissa(other, other_low);
+
+  result->clear();
+  if (sum == 0) {
+    return true;
+  }
+  result->is_positive_ = sum > 0;
+  if (sum < 0) {
+    sum = -sum;
+  }
+  auto& digits = result->digits_;
+  while (sum != 0) {
+    digits.push_back(static_cast<uint8_t>(sum % 10));
+    sum /= 10;
+  }
+  std::reverse(digits.begin(), digits.end());
+  result->exponent_ = VarInt(min_low + static_cast<int64_t>(digits.size()));
+  result->make_canonical();
+  return true;
+}
+
 // Normalize so that both Decimals have same exponent and same number of digits
 // Add digits considering sign
 // Canonicalize result
 
 Decimal Decimal::operator+(const Decimal& other) const {
+  if (digits_.empty()) {
+    return other;
+  }
+  if (other.digits_.empty()) {
+    return *this;
+  }
+  {
+    Decimal result;
+    if (TryAddSmall(other, &result)) {
+      return result;
+    }
+  }
+
   Decimal decimal(digits_, exponent_, is_positive_);
   Decimal other1(other.digits_, other.exponent_, other.is_positive_);
 
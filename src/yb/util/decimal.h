@@ -165,6 +165,10 @@ class Decimal {
   bool is_canonical() const;
   void make_canonical();
 
+  // Adds other to this using 128-bit integer arithmetic. Returns false when the aligned mantissas
+  // could overflow it, the general digit by digit addition should be used in that case.
+  bool TryAddSmall(const Decimal& other, Decimal* result) const;
+
   std::vector<uint8_t> digits_;
   VarInt exponent_;
   bool is_positive_;
@@ -118,6 +118,41 @@ void HdrHistogram::ResetPercentiles() {
   NoBarrier_Store(&max_value_, 0);
 }
 
+void HdrHistogram::MergeFrom(const HdrHistogram& other) {
+  DCHECK_EQ(highest_trackable_value_, other.highest_trackable_value_);
+  DCHECK_EQ(num_significant_digits_, other.num_significant_digits_);
+
+  NoBarrier_AtomicIncrement(&total_sum_, NoBarrier_Load(&other.total_sum_));
+  NoBarrier_AtomicIncrement(&current_sum_, NoBarrier_Load(&other.current_sum_));
+  {
+    Atomic64 other_min = NoBarrier_Load(&other.min_value_);
+    Atomic64 min_val;
+    while (other_min < (min_val = NoBarrier_Load(&min_value_))) {
+      if (NoBarrier_CompareAndSwap(&min_value_, min_val, other_min) == min_val) break;
+    }
+  }
+
+  uint64_t total_merged_count = 0;
+  for (int i = 0; i < counts_array_length_; i++) {
+    uint64_t count = NoBarrier_Load(&other.counts_[i]);
+    if (count) {
+      NoBarrier_AtomicIncrement(&counts_[i], count);
+      total_merged_count += count;
+    }
+  }
+
+  {
+    Atomic64 other_max = NoBarrier_Load(&other.max_value_);
+    Atomic64 max_val;
+    while (other_max > (max_val = NoBarrier_Load(&max_value_))) {
+      if (NoBarrier_CompareAndSwap(&max_value_, max_val, other_max) == max_val) break;
+    }
+  }
+  // Keep current count consistent with the merged counts, see copy constructor.
+  NoBarrier_AtomicIncrement(&total_count_, NoBarrier_Load(&other.total_count_));
+  NoBarrier_AtomicIncrement(&current_count_, total_merged_count);
+}
+
 bool HdrHistogram::IsValidHighestTrackableValue(uint64_t highest_trackable_value) {
   return highest_trackable_value >= kMinHighestTrackableValue;
 }
@@ -184,6 +184,10 @@ class HdrHistogram {
   // Preserves the values for TotalSum and TotalCount.
   void ResetPercentiles();
 
+  // Adds data recorded by other, that should have the same configuration params.
+  // Like copy constructor, it is not a consistent snapshot of other.
+  void MergeFrom(const HdrHistogram& other);
+
   // Get the percentile at a given value
   // TODO: implement
   // double PercentileAtOrBelowValue(uint64_t value) const;
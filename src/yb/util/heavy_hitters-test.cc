@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include <map>
+
+#include "yb/util/heavy_hitters.h"
+#include "yb/util/random_util.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+class HeavyHittersTest : public YBTest {
+};
+
+TEST_F(HeavyHittersTest, Simple) {
+  HeavyHitters hitters(2);
+  hitters.Add("a");
+  hitters.Add("b", 3);
+  hitters.Add("a");
+  auto top = hitters.TopK(10);
+  ASSERT_EQ(2, top.size());
+  ASSERT_EQ("b", top[0].key);
+  ASSERT_EQ(3, top[0].count);
+  ASSERT_EQ("a", top[1].key);
+  ASSERT_EQ(2, top[1].count);
+
+  // Evicts "a" with minimal count, "c" inherits its count as error.
+  hitters.Add("c", 2);
+  top = hitters.TopK(10);
+  ASSERT_EQ(2, top.size());
+  ASSERT_EQ("c", top[0].key);
+  ASSERT_EQ(4, top[0].count);
+  ASSERT_EQ(2, top[0].error);
+  ASSERT_EQ("b", top[1].key);
+  ASSERT_EQ(7, hitters.total());
+
+  ASSERT_EQ(1, hitters.TopK(1).size());
+
+  hitters.Clear();
+  ASSERT_TRUE(hitters.TopK(10).empty());
+  ASSERT_EQ(0, hitters.total());
+}
+
+TEST_F(HeavyHittersTest, Skewed) {
+  constexpr size_t kCapacity = 32;
+  constexpr int kNumHotKeys = 5;
+  constexpr int kNumColdKeys = 10000;
+  constexpr int kNumOperations = 200000;
+
+  HeavyHitters hitters(kCapacity);
+  std::map<std::string, uint64_t> counts;
+  for (int i = 0; i != kNumOperations; ++i) {
+    // Half of operations go to few hot keys, other half spread over many cold keys.
+    auto key = RandomActWithProbability(0.5)
+        ? Format("hot$0", RandomUniformInt(0, kNumHotKeys - 1))
+        : Format("cold$0", RandomUniformInt(0, kNumColdKeys - 1));
+    hitters.Add(key);
+    ++counts[key];
+  }
+
+  ASSERT_EQ(kNumOperations, hitters.total());
+  auto top = hitters.TopK(kNumHotKeys);
+  ASSERT_EQ(kNumHotKeys, top.size());
+  for (const auto& entry : top) {
+    SCOPED_TRACE(entry.ToString());
+    ASSERT_EQ("hot", entry.key.substr(0, 3));
+    auto actual = counts[entry.key];
+    ASSERT_GE(entry.count, actual);
+    ASSERT_LE(entry.count - entry.error, actual);
+  }
+}
+
+} // namespace yb
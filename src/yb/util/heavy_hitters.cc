@@ -0,0 +1,81 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/util/heavy_hitters.h"
+
+#include "yb/util/format.h"
+
+namespace yb {
+
+std::string HeavyHitters::Entry::ToString() const {
+  return Format("{ key: $0 count: $1 error: $2 }", Slice(key).ToDebugHexString(), count, error);
+}
+
+HeavyHitters::HeavyHitters(size_t capacity) : capacity_(capacity) {
+}
+
+HeavyHitters::~HeavyHitters() {
+}
+
+void HeavyHitters::Add(const Slice& key, uint64_t weight) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  total_ += weight;
+
+  auto& by_key = entries_.get<KeyTag>();
+  auto it = by_key.find(key.ToBuffer());
+  if (it != by_key.end()) {
+    by_key.modify(it, [weight](Entry& entry) { entry.count += weight; });
+    return;
+  }
+
+  if (entries_.size() < capacity_) {
+    entries_.insert(Entry{key.ToBuffer(), weight, 0});
+    return;
+  }
+
+  // Replace key with minimal count, new key inherits its count as error.
+  auto& by_count = entries_.get<CountTag>();
+  auto min_it = by_count.begin();
+  if (min_it == by_count.end()) {
+    return;
+  }
+  by_count.modify(min_it, [&key, weight](Entry& entry) {
+    entry.key.assign(key.cdata(), key.size());
+    entry.error = entry.count;
+    entry.count += weight;
+  });
+}
+
+std::vector<HeavyHitters::Entry> HeavyHitters::TopK(size_t limit) const {
+  std::vector<Entry> result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& by_count = entries_.get<CountTag>();
+  for (auto it = by_count.rbegin(); it != by_count.rend() && result.size() < limit; ++it) {
+    result.push_back(*it);
+  }
+  return result;
+}
+
+uint64_t HeavyHitters::total() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_;
+}
+
+void HeavyHitters::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  total_ = 0;
+}
+
+} // namespace yb
@@ -0,0 +1,94 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_UTIL_HEAVY_HITTERS_H
+#define YB_UTIL_HEAVY_HITTERS_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+
+// Streaming estimator of the most frequent keys, based on the Space-Saving algorithm
+// (Metwally, Agrawal, El Abbadi, "Efficient Computation of Frequent and Top-k Elements in Data
+// Streams").
+//
+// At most capacity keys are tracked. When an untracked key arrives and the summary is full, the
+// key with the minimal count is evicted and the new key takes over its count, remembering it as
+// the error bound. So the count of a tracked key is never underestimated and overestimated by at
+// most error, and every key with frequency above total / capacity is guaranteed to be tracked.
+//
+// Thread safe.
+class HeavyHitters {
+ public:
+  struct Entry {
+    std::string key;
+    uint64_t count;
+    // Upper bound of overestimation of count.
+    uint64_t error;
+
+    std::string ToString() const;
+  };
+
+  explicit HeavyHitters(size_t capacity);
+  ~HeavyHitters();
+
+  void Add(const Slice& key, uint64_t weight = 1);
+
+  // Returns up to limit tracked keys, ordered by descending count.
+  std::vector<Entry> TopK(size_t limit) const;
+
+  // Total weight of all added keys, including evicted ones.
+  uint64_t total() const;
+
+  void Clear();
+
+ private:
+  class CountTag;
+  class KeyTag;
+
+  typedef boost::multi_index_container<
+    Entry,
+    boost::multi_index::indexed_by<
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<KeyTag>,
+        boost::multi_index::member<Entry, std::string, &Entry::key>
+      >,
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<CountTag>,
+        boost::multi_index::member<Entry, uint64_t, &Entry::count>
+      >
+    >
+  > Entries;
+
+  const size_t capacity_;
+
+  mutable std::mutex mutex_;
+  Entries entries_ GUARDED_BY(mutex_);
+  uint64_t total_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_HEAVY_HITTERS_H
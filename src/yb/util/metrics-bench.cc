@@ -0,0 +1,116 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include "yb/gutil/ref_counted.h"
+#include "yb/gutil/strings/substitute.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
+#include "yb/util/test_util.h"
+#include "yb/util/thread.h"
+
+DEFINE_int32(metrics_bench_increments, 1000000,
+             "Number of increments done by each thread in metrics benchmark");
+
+DECLARE_int32(metrics_histogram_max_shards);
+
+METRIC_DEFINE_entity(bench_entity);
+
+METRIC_DEFINE_counter(bench_entity, bench_counter, "Bench Counter",
+                      MetricUnit::kRequests, "Bench counter");
+METRIC_DEFINE_histogram(bench_entity, bench_histogram, "Bench Histogram",
+                        MetricUnit::kMicroseconds, "Bench histogram", 1000000, 3);
+
+namespace yb {
+
+class MetricsBench : public YBTest {
+ protected:
+  // Runs f in num_threads threads, returns time passed until all of them completed.
+  MonoDelta RunWithManyThreads(const std::function<void()>& f, int num_threads) {
+    std::vector<scoped_refptr<Thread>> threads;
+    auto start = MonoTime::Now();
+    for (int i = 0; i != num_threads; ++i) {
+      scoped_refptr<Thread> thread;
+      CHECK_OK(Thread::Create("bench", strings::Substitute("thread$0", i), f, &thread));
+      threads.push_back(thread);
+    }
+    for (auto& thread : threads) {
+      CHECK_OK(ThreadJoiner(thread.get()).Join());
+    }
+    return MonoTime::Now() - start;
+  }
+
+  // Measures how throughput of hot histogram scales with number of updating threads.
+  void BenchmarkHistogram(int max_shards);
+
+  MetricRegistry registry_;
+};
+
+void MetricsBench::BenchmarkHistogram(int max_shards) {
+  FLAGS_metrics_histogram_max_shards = max_shards;
+  int max_threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+  int num_increments = FLAGS_metrics_bench_increments;
+  for (int num_threads = 1;; num_threads = std::min(num_threads * 2, max_threads)) {
+    auto entity = METRIC_ENTITY_bench_entity.Instantiate(
+        &registry_, strings::Substitute("bench-$0-$1", max_shards, num_threads));
+    auto histogram = METRIC_bench_histogram.Instantiate(entity);
+    auto time = RunWithManyThreads([histogram, num_increments] {
+      for (int i = 0; i != num_increments; ++i) {
+        histogram->Increment(i % 1000 + 1);
+      }
+    }, num_threads);
+    ASSERT_EQ(static_cast<uint64_t>(num_threads) * num_increments, histogram->TotalCount());
+
+    LOG(INFO) << "Histogram, max shards: " << max_shards << ", threads: " << num_threads << ": "
+              << 1.0 * num_threads * num_increments / time.ToSeconds() << " ops/s";
+    if (num_threads == max_threads) {
+      break;
+    }
+  }
+}
+
+TEST_F(MetricsBench, Counter) {
+  int max_threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+  int num_increments = FLAGS_metrics_bench_increments;
+  for (int num_threads = 1;; num_threads = std::min(num_threads * 2, max_threads)) {
+    scoped_refptr<Counter> counter = new Counter(&METRIC_bench_counter);
+    auto time = RunWithManyThreads([counter, num_increments] {
+      for (int i = 0; i != num_increments; ++i) {
+        counter->Increment();
+      }
+    }, num_threads);
+    ASSERT_EQ(num_threads * num_increments, counter->value());
+
+    LOG(INFO) << "Counter, threads: " << num_threads << ": "
+              << 1.0 * num_threads * num_increments / time.ToSeconds() << " ops/s";
+    if (num_threads == max_threads) {
+      break;
+    }
+  }
+}
+
+TEST_F(MetricsBench, Histogram) {
+  BenchmarkHistogram(1);
+}
+
+TEST_F(MetricsBench, ShardedHistogram) {
+  BenchmarkHistogram(std::max<int>(std::thread::hardware_concurrency(), 1));
+}
+
+} // namespace yb
@@ -31,10 +31,13 @@
 //
 #include "yb/util/metrics.h"
 
+#include <sched.h>
+
 #include <iostream>
 #include <map>
 #include <regex>
 #include <set>
+#include <thread>
 
 #include <gflags/gflags.h>
 
@@ -44,6 +47,7 @@
 #include "yb/gutil/singleton.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/histogram.pb.h"
@@ -65,6 +69,12 @@ DEFINE_string(metric_node_name, "DEFAULT_NODE_NAME",
 DEFINE_bool(expose_metric_histogram_percentiles, true,
             "Should we expose the percentiles information for metrics histograms.");
 
+DEFINE_int32(metrics_histogram_max_shards, 1,
+             "Maximal number of per-CPU shards of a histogram metric. Sharding reduces contention "
+             "on histograms updated from many CPUs, but each shard holds a full copy of buckets, "
+             "and there are histograms per tablet. So it is off by default, i.e. set to 1.");
+TAG_FLAG(metrics_histogram_max_shards, advanced);
+
 // Process/server-wide metrics should go into the 'server' entity.
 // More complex applications will define other entities.
 METRIC_DEFINE_entity(server);
@@ -755,18 +765,79 @@ scoped_refptr<Histogram> HistogramPrototype::Instantiate(
 // Histogram
 /////////////////////////////////////////////////
 
+namespace {
+
+size_t CurrentCpu() {
+#if defined(__APPLE__)
+  // OSX doesn't have a way to get the CPU, so we'll pick one based on the thread.
+  return std::hash<std::thread::id>()(std::this_thread::get_id());
+#else
+  auto cpu = sched_getcpu();
+  return cpu >= 0 ? cpu : 0;
+#endif // defined(__APPLE__)
+}
+
+} // namespace
+
 Histogram::Histogram(const HistogramPrototype* proto)
   : Metric(proto),
     histogram_(new HdrHistogram(proto->max_trackable_value(), proto->num_sig_digits())),
+    num_shards_(std::max(std::min(base::NumCPUs(), FLAGS_metrics_histogram_max_shards), 1)),
+    shards_(new std::atomic<HdrHistogram*>[num_shards_]),
     export_percentiles_(proto->export_percentiles()) {
+  shards_[0].store(histogram_.get(), std::memory_order_relaxed);
+  for (size_t i = 1; i != num_shards_; ++i) {
+    shards_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+Histogram::~Histogram() {
+  for (size_t i = 1; i != num_shards_; ++i) {
+    delete shards_[i].load(std::memory_order_acquire);
+  }
+}
+
+HdrHistogram* Histogram::Shard() {
+  auto& shard = shards_[CurrentCpu() % num_shards_];
+  auto result = shard.load(std::memory_order_acquire);
+  if (PREDICT_TRUE(result != nullptr)) {
+    return result;
+  }
+  std::unique_ptr<HdrHistogram> new_shard(new HdrHistogram(
+      histogram_->highest_trackable_value(), histogram_->num_significant_digits()));
+  if (shard.compare_exchange_strong(result, new_shard.get(), std::memory_order_acq_rel)) {
+    return new_shard.release();
+  }
+  // Another thread of the same CPU created shard concurrently.
+  return result;
 }
 
 void Histogram::Increment(int64_t value) {
-  histogram_->Increment(value);
+  Shard()->Increment(value);
 }
 
 void Histogram::IncrementBy(int64_t value, int64_t amount) {
-  histogram_->IncrementBy(value, amount);
+  Shard()->IncrementBy(value, amount);
+}
+
+std::unique_ptr<HdrHistogram> Histogram::MergedHistogram() const {
+  std::unique_ptr<HdrHistogram> result(new HdrHistogram(*histogram_));
+  for (size_t i = 1; i != num_shards_; ++i) {
+    auto shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      result->MergeFrom(*shard);
+    }
+  }
+  return result;
+}
+
+void Histogram::ResetPercentiles() const {
+  for (size_t i = 0; i != num_shards_; ++i) {
+    auto shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      shard->ResetPercentiles();
+    }
+  }
 }
 
 Status Histogram::WriteAsJson(JsonWriter* writer,
@@ -780,12 +851,13 @@ Status Histogram::WriteAsJson(JsonWriter* writer,
 
 CHECKED_STATUS Histogram::WriteForPrometheus(
     PrometheusWriter* writer, const MetricEntity::AttributeMap& attr) const {
-  HdrHistogram snapshot(*histogram_);
+  auto merged = MergedHistogram();
+  const HdrHistogram& snapshot = *merged;
   // HdrHistogram reports percentiles based on all the data points from the
   // begining of time. We are interested in the percentiles based on just
   // the "newly-arrived" data. So, we will reset the histogram's percentiles
   // between each invocation.
-  histogram_->ResetPercentiles();
+  ResetPercentiles();
 
   // Representing the sum and count require suffixed names.
   std::string hist_name = prototype_->name();
@@ -818,12 +890,13 @@ CHECKED_STATUS Histogram::WriteForPrometheus(
 
 Status Histogram::GetAndResetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
                                                  const MetricJsonOptions& opts) const {
-  HdrHistogram snapshot(*histogram_);
+  auto merged = MergedHistogram();
+  const HdrHistogram& snapshot = *merged;
   // HdrHistogram reports percentiles based on all the data points from the
   // begining of time. We are interested in the percentiles based on just
   // the "newly-arrived" data. So, we will reset the histogram's percentiles
   // between each invocation.
-  histogram_->ResetPercentiles();
+  ResetPercentiles();
 
   snapshot_pb->set_name(prototype_->name());
   if (opts.include_schema_info) {
@@ -858,22 +931,29 @@ Status Histogram::GetAndResetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_p
 }
 
 uint64_t Histogram::CountInBucketForValueForTests(uint64_t value) const {
-  return histogram_->CountInBucketForValue(value);
+  return MergedHistogram()->CountInBucketForValue(value);
 }
 
 uint64_t Histogram::TotalCount() const {
-  return histogram_->TotalCount();
+  uint64_t result = 0;
+  for (size_t i = 0; i != num_shards_; ++i) {
+    auto shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      result += shard->TotalCount();
+    }
+  }
+  return result;
 }
 
 uint64_t Histogram::MinValueForTests() const {
-  return histogram_->MinValue();
+  return MergedHistogram()->MinValue();
 }
 
 uint64_t Histogram::MaxValueForTests() const {
-  return histogram_->MaxValue();
+  return MergedHistogram()->MaxValue();
 }
 double Histogram::MeanValueForTests() const {
-  return histogram_->MeanValue();
+  return MergedHistogram()->MeanValue();
 }
 
 ScopedLatencyMetric::ScopedLatencyMetric(
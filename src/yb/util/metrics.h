@@ -239,6 +239,8 @@
 /////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
@@ -1263,8 +1265,13 @@ class Histogram : public Metric {
 
   // Returns a pointer to the underlying histogram. The implementation of HdrHistogram
   //   // is thread safe.
+  // When histogram is sharded, see metrics_histogram_max_shards, it is only the first shard,
+  // so use MergedHistogram to get all recorded values.
   const HdrHistogram* histogram() const { return histogram_.get(); }
 
+  // Returns a copy of the data recorded by all shards of the histogram.
+  std::unique_ptr<HdrHistogram> MergedHistogram() const;
+
   uint64_t CountInBucketForValueForTests(uint64_t value) const;
   uint64_t MinValueForTests() const;
   uint64_t MaxValueForTests() const;
@@ -1275,8 +1282,19 @@ class Histogram : public Metric {
   FRIEND_TEST(MetricsTest, ResetHistogramTest);
   friend class MetricEntity;
   explicit Histogram(const HistogramPrototype* proto);
+  ~Histogram();
+
+  // Returns shard updated by the current CPU, creating it if necessary.
+  HdrHistogram* Shard();
+
+  void ResetPercentiles() const;
 
+  // Values are recorded to per-CPU shards, so hot histograms do not bounce cache lines between
+  // cores. Shards are created on first update from the corresponding CPU and merged when the
+  // histogram is read. The first shard is histogram_.
   const gscoped_ptr<HdrHistogram> histogram_;
+  const size_t num_shards_;
+  const std::unique_ptr<std::atomic<HdrHistogram*>[]> shards_;
   const ExportPercentiles export_percentiles_;
   DISALLOW_COPY_AND_ASSIGN(Histogram);
 };
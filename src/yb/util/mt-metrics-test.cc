@@ -40,6 +40,7 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/debug/leakcheck_disabler.h"
+#include "yb/util/hdr_histogram.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
@@ -49,6 +50,8 @@
 DEFINE_int32(mt_metrics_test_num_threads, 4,
              "Number of threads to spawn in mt metrics tests");
 
+DECLARE_int32(metrics_histogram_max_shards);
+
 METRIC_DEFINE_entity(test_entity);
 
 namespace yb {
@@ -85,8 +88,17 @@ static void RunWithManyThreads(std::function<void()>* f, int num_threads) {
   }
 }
 
+// Call increment on a Histogram a bunch of times.
+static void CountWithHistogram(scoped_refptr<Histogram> histogram, int num_increments) {
+  for (int i = 0; i < num_increments; i++) {
+    histogram->Increment(i % 1000 + 1);
+  }
+}
+
 METRIC_DEFINE_counter(test_entity, test_counter, "Test Counter",
                       MetricUnit::kRequests, "Test counter");
+METRIC_DEFINE_histogram(test_entity, test_histogram, "Test Histogram",
+                        MetricUnit::kMicroseconds, "Test histogram", 1000000, 3);
 
 // Ensure that incrementing a counter is thread-safe.
 TEST_F(MultiThreadedMetricsTest, CounterIncrementTest) {
@@ -98,6 +110,27 @@ TEST_F(MultiThreadedMetricsTest, CounterIncrementTest) {
   ASSERT_EQ(num_threads * num_increments, counter->value());
 }
 
+// Ensure that values recorded to histogram shards by concurrent threads are all merged.
+TEST_F(MultiThreadedMetricsTest, HistogramIncrementTest) {
+  FLAGS_metrics_histogram_max_shards = 4;
+  scoped_refptr<MetricEntity> entity = METRIC_ENTITY_test_entity.Instantiate(&registry_, "my-test");
+  scoped_refptr<Histogram> histogram = METRIC_test_histogram.Instantiate(entity);
+  int num_threads = FLAGS_mt_metrics_test_num_threads;
+  int num_increments = 10000;
+  std::function<void()> f = std::bind(CountWithHistogram, histogram, num_increments);
+  RunWithManyThreads(&f, num_threads);
+  const uint64_t total = num_threads * num_increments;
+  ASSERT_EQ(total, histogram->TotalCount());
+  ASSERT_EQ(1U, histogram->MinValueForTests());
+  ASSERT_EQ(1000U, histogram->MaxValueForTests());
+  ASSERT_EQ(total / 1000, histogram->CountInBucketForValueForTests(500));
+
+  auto merged = histogram->MergedHistogram();
+  ASSERT_EQ(total, merged->TotalCount());
+  ASSERT_EQ(total, merged->CurrentCount());
+  ASSERT_EQ(total / 1000 * 500500, merged->TotalSum());
+}
+
 // Helper function to register a bunch of counters in a loop.
 void MultiThreadedMetricsTest::RegisterCounters(
     const scoped_refptr<MetricEntity>& metric_entity,
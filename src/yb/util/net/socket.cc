@@ -36,11 +36,18 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <signal.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+
 #include <limits>
+#include <mutex>
 #include <numeric>
 #include <string>
 
@@ -73,6 +80,24 @@ TAG_FLAG(socket_inject_short_recvs, unsafe);
 
 namespace yb {
 
+namespace {
+
+#if defined(__linux__)
+// sendfile does not accept MSG_NOSIGNAL, so SIGPIPE is ignored process wide before the first call.
+void IgnoreSigPipe() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    struct sigaction act;
+    act.sa_handler = SIG_IGN;
+    sigemptyset(&act.sa_mask);
+    act.sa_flags = 0;
+    PCHECK(sigaction(SIGPIPE, &act, nullptr) == 0);
+  });
+}
+#endif // defined(__linux__)
+
+} // namespace
+
 size_t IoVecsFullSize(const IoVecs& io_vecs) {
   return std::accumulate(io_vecs.begin(), io_vecs.end(), 0ULL, [](size_t p, const iovec& v) {
     return p + v.iov_len;
@@ -280,6 +305,14 @@ Status Socket::SetReuseAddr(bool flag) {
   return Status::OK();
 }
 
+Status Socket::SetReusePort(bool flag) {
+  int int_flag = flag ? 1 : 0;
+  if (setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &int_flag, sizeof(int_flag)) == -1) {
+    return STATUS(NetworkError, "Failed to set SO_REUSEPORT", Errno(errno));
+  }
+  return Status::OK();
+}
+
 Status Socket::BindAndListen(const Endpoint& sockaddr,
                              int listenQueueSize) {
   RETURN_NOT_OK(SetReuseAddr(true));
@@ -447,6 +480,40 @@ Status Socket::Writev(const struct ::iovec *iov, int iov_len,
   return Status::OK();
 }
 
+Status Socket::SendFile(int file_fd, uint64_t offset, int32_t amt, int32_t *nwritten) {
+  if (PREDICT_FALSE(amt <= 0)) {
+    return STATUS(
+        NetworkError, StringPrintf("invalid sendfile of %" PRId32 " bytes", amt), Errno(EINVAL));
+  }
+  DCHECK_GE(fd_, 0);
+
+#if defined(__linux__)
+  IgnoreSigPipe();
+  off_t file_offset = offset;
+  auto res = ::sendfile(fd_, file_fd, &file_offset, amt);
+  if (PREDICT_FALSE(res < 0)) {
+    return STATUS(NetworkError, "sendfile error", Errno(errno));
+  }
+  *nwritten = static_cast<int32_t>(res);
+#else
+  // Socket has SO_NOSIGPIPE set, see SetNoSigPipe.
+  off_t len = amt;
+  auto res = ::sendfile(file_fd, fd_, offset, &len, nullptr, 0);
+  // Non blocking socket could send part of data and fail with EAGAIN.
+  if (PREDICT_FALSE(res < 0 && (errno != EAGAIN || len == 0))) {
+    return STATUS(NetworkError, "sendfile error", Errno(errno));
+  }
+  *nwritten = static_cast<int32_t>(len);
+#endif // defined(__linux__)
+  // No progress on a non-empty region means the file is shorter than expected, retrying would
+  // never complete the write.
+  if (PREDICT_FALSE(*nwritten == 0)) {
+    return STATUS_FORMAT(
+        IOError, "sendfile reached end of file at offset $0, $1 bytes left to send", offset, amt);
+  }
+  return Status::OK();
+}
+
 // Mostly follows writen() from Stevens (2004) or Kerrisk (2010).
 Status Socket::BlockingWrite(const uint8_t *buf, size_t buflen, size_t *nwritten,
     const MonoTime& deadline) {
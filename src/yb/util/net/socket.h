@@ -111,6 +111,11 @@ class Socket {
   // Sets SO_REUSEADDR to 'flag'. Should be used prior to Bind().
   CHECKED_STATUS SetReuseAddr(bool flag);
 
+  // Sets SO_REUSEPORT to 'flag'. Should be used prior to Bind().
+  // Allows several sockets to listen on the same endpoint, kernel distributes incoming
+  // connections between them.
+  CHECKED_STATUS SetReusePort(bool flag);
+
   // Convenience method to invoke the common sequence:
   // 1) SetReuseAddr(true)
   // 2) Bind()
@@ -146,6 +151,10 @@ class Socket {
 
   CHECKED_STATUS Writev(const struct ::iovec *iov, int iov_len, int32_t *nwritten);
 
+  // Sends up to amt bytes of file_fd starting at offset, without copying them to user space.
+  // Returns IOError when no bytes could be sent because the file ends before offset.
+  CHECKED_STATUS SendFile(int file_fd, uint64_t offset, int32_t amt, int32_t *nwritten);
+
   // Blocking Write call, returns IOError unless full buffer is sent.
   // Underlying Socket expected to be in blocking mode. Fails if any Write() sends 0 bytes.
   // Returns OK if buflen bytes were sent, otherwise IOError.
@@ -12,11 +12,16 @@
 //
 
 #include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <future>
 #include <thread>
 #include <gtest/gtest.h>
 
 #include "yb/util/test_util.h"
 #include "yb/util/shared_mem.h"
+#include "yb/util/shared_mem_exchange.h"
 
 using namespace std::literals;
 
@@ -459,5 +464,200 @@ TEST_F(SharedMemoryTest, BadSegment) {
   ASSERT_NOK(SharedData::OpenReadOnly(-1));
 }
 
+namespace {
+
+Status ExchangeSend(
+    SharedExchangeClient* client, uint32_t method, const std::string& request,
+    SharedExchangeClient::Callback callback, CoarseDuration timeout = 10s) {
+  return client->Send(
+      method, request.size(),
+      [&request](uint8_t* out) { memcpy(out, request.data(), request.size()); },
+      CoarseMonoClock::now() + timeout, std::move(callback));
+}
+
+Result<SharedExchangeResponse> ExchangeCall(
+    SharedExchangeClient* client, uint32_t method, const std::string& request,
+    CoarseDuration timeout = 10s) {
+  std::promise<Result<SharedExchangeResponse>> promise;
+  RETURN_NOT_OK(ExchangeSend(
+      client, method, request,
+      [&promise](Result<SharedExchangeResponse> response) {
+        promise.set_value(std::move(response));
+      },
+      timeout));
+  return promise.get_future().get();
+}
+
+} // namespace
+
+TEST_F(SharedMemoryTest, Exchange) {
+  typedef SharedMemoryObject<SharedExchange> SharedExchangeObject;
+  auto server_object = ASSERT_RESULT(SharedExchangeObject::Create());
+  auto client_object = ASSERT_RESULT(SharedExchangeObject::OpenReadWrite(server_object.GetFd()));
+  SharedExchangeClient client(client_object.get());
+  ASSERT_OK(client.Start());
+
+  ASSERT_TRUE(ExchangeCall(&client, 0, "test").status().IsServiceUnavailable());
+
+  constexpr uint32_t kEchoMethod = 1;
+  constexpr uint32_t kBigResponseMethod = 2;
+  constexpr uint32_t kFailMethod = 3;
+  constexpr uint32_t kNoResponseMethod = 4;
+  const std::string big_sidecar(SharedExchange::kSlotSize * 5 / 2, 'x');
+  SharedExchangeServer* server_ptr = nullptr;
+  SharedExchangeServer server(
+      server_object.get(), "server_uuid",
+      [&server_ptr, &big_sidecar](
+          size_t slot, uint32_t method, Slice request, CoarseTimePoint deadline) {
+    switch (method) {
+      case kEchoMethod:
+        server_ptr->Respond(slot, request, {Slice("sidecar")});
+        return;
+      case kBigResponseMethod:
+        server_ptr->Respond(slot, request, {Slice(big_sidecar)});
+        return;
+      case kFailMethod:
+        server_ptr->RespondFailure(slot, Slice("Too busy"));
+        return;
+      case kNoResponseMethod:
+        return;
+    }
+    FAIL() << "Unexpected method: " << method;
+  });
+  server_ptr = &server;
+  ASSERT_OK(server.Start());
+  ASSERT_TRUE(client_object->ServerRunning());
+  ASSERT_EQ("server_uuid", client_object->server_id().ToBuffer());
+
+  for (int i = 0; i != 100; ++i) {
+    auto request = "request_" + std::to_string(i);
+    auto response = ASSERT_RESULT(ExchangeCall(&client, kEchoMethod, request));
+    ASSERT_FALSE(response.failed);
+    ASSERT_EQ(request, response.body.ToBuffer());
+    ASSERT_EQ(1, response.sidecars.size());
+    ASSERT_EQ("sidecar", response.sidecars[0].ToBuffer());
+  }
+
+  // Response that does not fit into a slot is transferred in chunks.
+  auto response = ASSERT_RESULT(ExchangeCall(&client, kBigResponseMethod, "big"));
+  ASSERT_EQ("big", response.body.ToBuffer());
+  ASSERT_EQ(1, response.sidecars.size());
+  ASSERT_EQ(big_sidecar, response.sidecars[0].ToBuffer());
+
+  response = ASSERT_RESULT(ExchangeCall(&client, kFailMethod, "fail"));
+  ASSERT_TRUE(response.failed);
+  ASSERT_EQ("Too busy", response.body.ToBuffer());
+  ASSERT_TRUE(response.sidecars.empty());
+
+  ASSERT_TRUE(ExchangeCall(&client, kNoResponseMethod, "lost", 100ms)
+                  .status().IsTimedOut());
+  response = ASSERT_RESULT(ExchangeCall(&client, kEchoMethod, "after_timeout"));
+  ASSERT_EQ("after_timeout", response.body.ToBuffer());
+
+  client.Shutdown();
+  server.Shutdown();
+  ASSERT_FALSE(client_object->ServerRunning());
+}
+
+// Slots of a killed client are reclaimed by the server, while other clients keep running.
+TEST_F(SharedMemoryTest, ExchangeReclaimDeadClientSlots) {
+  typedef SharedMemoryObject<SharedExchange> SharedExchangeObject;
+  auto server_object = ASSERT_RESULT(SharedExchangeObject::Create());
+  auto client_object = ASSERT_RESULT(SharedExchangeObject::OpenReadWrite(server_object.GetFd()));
+
+  constexpr uint32_t kEchoMethod = 1;
+  // Requests of this method are answered by the test.
+  constexpr uint32_t kHoldMethod = 2;
+  std::mutex mutex;
+  std::vector<size_t> held_slots;
+  SharedExchangeServer* server_ptr = nullptr;
+  SharedExchangeServer server(
+      server_object.get(), "server_uuid",
+      [&server_ptr, &mutex, &held_slots](
+          size_t slot, uint32_t method, Slice request, CoarseTimePoint deadline) {
+    if (method == kEchoMethod) {
+      server_ptr->Respond(slot, request, {});
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    held_slots.push_back(slot);
+  });
+  server_ptr = &server;
+  ASSERT_OK(server.Start());
+
+  auto num_held_slots = [&mutex, &held_slots] {
+    std::lock_guard<std::mutex> lock(mutex);
+    return held_slots.size();
+  };
+  auto respond_held = [&server, &mutex, &held_slots] {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto slot : held_slots) {
+      server.Respond(slot, Slice("held"), {});
+    }
+    held_slots.clear();
+  };
+
+  // Child process occupies all slots but one and dies without waiting for responses.
+  int pipe_fds[2];
+  ASSERT_EQ(0, pipe(pipe_fds));
+  pid_t child_pid = fork();
+  if (child_pid == 0) {
+    SharedExchangeClient child_client(client_object.get());
+    CHECK_OK(child_client.Start());
+    for (size_t i = 0; i != SharedExchange::kNumSlots - 1; ++i) {
+      CHECK_OK(ExchangeSend(
+          &child_client, kHoldMethod, "child", [](Result<SharedExchangeResponse>) {}, 60s));
+    }
+    char ready = 1;
+    CHECK_EQ(1, write(pipe_fds[1], &ready, 1));
+    for (;;) {
+      pause();
+    }
+  }
+  char ready = 0;
+  ASSERT_EQ(1, read(pipe_fds[0], &ready, 1));
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+  ASSERT_OK(WaitFor([&num_held_slots] {
+    return num_held_slots() == SharedExchange::kNumSlots - 1;
+  }, 10s, "Requests of child received"));
+
+  SharedExchangeClient client(client_object.get());
+  ASSERT_OK(client.Start());
+  auto response = ASSERT_RESULT(ExchangeCall(&client, kEchoMethod, "alive"));
+  ASSERT_EQ("alive", response.body.ToBuffer());
+
+  ASSERT_EQ(0, kill(child_pid, SIGKILL));
+  int status;
+  ASSERT_EQ(child_pid, waitpid(child_pid, &status, 0));
+  response = ASSERT_RESULT(ExchangeCall(&client, kEchoMethod, "still_alive"));
+  ASSERT_EQ("still_alive", response.body.ToBuffer());
+
+  // Responses to the dead client are dropped, and its slots become available again.
+  respond_held();
+  std::atomic<size_t> num_responses{0};
+  for (size_t i = 0; i != SharedExchange::kNumSlots; ++i) {
+    ASSERT_OK(WaitFor([&client, &num_responses] {
+      return ExchangeSend(
+          &client, kHoldMethod, "parent",
+          [&num_responses](Result<SharedExchangeResponse> response) {
+            ASSERT_OK(response);
+            ASSERT_EQ("held", response->body.ToBuffer());
+            ++num_responses;
+          }).ok();
+    }, 10s, "Slot reclaimed"));
+  }
+  ASSERT_OK(WaitFor([&num_held_slots] {
+    return num_held_slots() == SharedExchange::kNumSlots;
+  }, 10s, "Requests of parent received"));
+  respond_held();
+  ASSERT_OK(WaitFor([&num_responses] {
+    return num_responses.load() == SharedExchange::kNumSlots;
+  }, 10s, "Responses received"));
+
+  client.Shutdown();
+  server.Shutdown();
+}
+
 }  // namespace util
 }  // namespace yb
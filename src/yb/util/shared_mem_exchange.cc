@@ -0,0 +1,578 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/shared_mem_exchange.h"
+
+#include <signal.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#endif
+
+#include <thread>
+
+#include <boost/optional.hpp>
+
+#include <glog/logging.h>
+
+#include "yb/gutil/casts.h"
+#include "yb/gutil/linux_syscall_support.h"
+#include "yb/gutil/macros.h"
+
+#include "yb/util/errno.h"
+#include "yb/util/status.h"
+#include "yb/util/thread.h"
+
+using namespace std::literals;
+
+namespace yb {
+
+namespace {
+
+#if defined(__linux__)
+#define USE_FUTEX 1
+#else
+#define USE_FUTEX 0
+#endif
+
+// Max time to wait in a single futex call, so changes of the exchange state that are not
+// signalled, like death of a client, are noticed.
+const auto kMaxWaitTime = 100ms;
+
+// Number of checks for new responses before client goes to sleep. Local requests are usually
+// handled in tens of microseconds, so a short spin avoids futex round trip for them.
+constexpr int kSpinIterations = 100;
+
+// Response layout: failed flag (1 byte), body size (4 bytes), body, number of sidecars (4 bytes),
+// and size (4 bytes) followed by data for each sidecar. Body of failed response is the error.
+constexpr size_t kUInt32Size = sizeof(uint32_t);
+
+// Waits while value at address is equal to expected, but not after deadline.
+void WaitOnAddress(std::atomic<uint32_t>* address, uint32_t expected, CoarseTimePoint deadline) {
+  auto now = CoarseMonoClock::now();
+  if (now >= deadline) {
+    return;
+  }
+  auto wait_time = std::min<CoarseDuration>(deadline - now, kMaxWaitTime);
+#if USE_FUTEX
+  auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(wait_time).count();
+  kernel_timespec ts;
+  ts.tv_sec = nanos / 1000000000;
+  ts.tv_nsec = nanos % 1000000000;
+  // Not private futex, since address is in memory shared between processes.
+  sys_futex(reinterpret_cast<int32_t*>(address), FUTEX_WAIT, static_cast<int32_t>(expected), &ts);
+#else
+  (void)address;
+  (void)expected;
+  std::this_thread::sleep_for(std::min<CoarseDuration>(wait_time, 50us));
+#endif
+}
+
+void WakeAddress(std::atomic<uint32_t>* address) {
+#if USE_FUTEX
+  sys_futex(reinterpret_cast<int32_t*>(address), FUTEX_WAKE, INT_MAX, nullptr /* timeout */);
+#else
+  (void)address;
+#endif
+}
+
+void PutUInt32(uint32_t value, uint8_t** out) {
+  memcpy(*out, &value, kUInt32Size);
+  *out += kUInt32Size;
+}
+
+uint8_t* CopyBytes(const Slice& source, uint8_t* out) {
+  memcpy(out, source.data(), source.size());
+  return out + source.size();
+}
+
+Result<uint32_t> GetUInt32(Slice* input) {
+  if (input->size() < kUInt32Size) {
+    return STATUS(Corruption, "Truncated shared exchange response");
+  }
+  uint32_t result;
+  memcpy(&result, input->data(), kUInt32Size);
+  input->remove_prefix(kUInt32Size);
+  return result;
+}
+
+Result<Slice> GetBytes(Slice* input) {
+  auto size = VERIFY_RESULT(GetUInt32(input));
+  if (input->size() < size) {
+    return STATUS(Corruption, "Truncated shared exchange response");
+  }
+  Slice result(input->data(), size);
+  input->remove_prefix(size);
+  return result;
+}
+
+Result<SharedExchangeResponse> ParseResponse(std::string data) {
+  SharedExchangeResponse response;
+  response.data = std::make_unique<std::string>(std::move(data));
+  Slice input(*response.data);
+  if (input.empty()) {
+    return STATUS(Corruption, "Empty shared exchange response");
+  }
+  response.failed = input[0] != 0;
+  input.remove_prefix(1);
+  response.body = VERIFY_RESULT(GetBytes(&input));
+  auto num_sidecars = VERIFY_RESULT(GetUInt32(&input));
+  response.sidecars.reserve(num_sidecars);
+  for (uint32_t i = 0; i != num_sidecars; ++i) {
+    response.sidecars.push_back(VERIFY_RESULT(GetBytes(&input)));
+  }
+  return response;
+}
+
+bool ProcessAlive(int32_t pid) {
+  return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+} // namespace
+
+SharedExchange::SharedExchange() {
+  // See TServerSharedData for why it is important.
+  LOG_IF(FATAL, !request_seq_.is_lock_free() || !slots_[0].owner_pid.is_lock_free())
+      << "Shared memory atomics must be lock-free";
+}
+
+bool SharedExchange::ServerRunning() const {
+  return server_running_.load(std::memory_order_acquire) != 0;
+}
+
+Slice SharedExchange::server_id() const {
+  return Slice(server_id_, server_id_size_);
+}
+
+SharedExchange::SlotState SharedExchange::GetState(const Slot& slot) {
+  return static_cast<SlotState>(slot.state.load(std::memory_order_acquire));
+}
+
+bool SharedExchange::ChangeState(Slot* slot, SlotState from, SlotState to) {
+  auto expected = static_cast<uint32_t>(from);
+  return slot->state.compare_exchange_strong(
+      expected, static_cast<uint32_t>(to), std::memory_order_acq_rel);
+}
+
+void SharedExchange::SetState(Slot* slot, SlotState state) {
+  slot->state.store(static_cast<uint32_t>(state), std::memory_order_release);
+}
+
+void SharedExchange::FreeSlot(Slot* slot) {
+  SetState(slot, SlotState::kFree);
+  slot->owner_pid.store(0, std::memory_order_release);
+}
+
+void SharedExchange::NotifyServer() {
+  request_seq_.fetch_add(1, std::memory_order_seq_cst);
+  if (server_waiting_.load(std::memory_order_seq_cst)) {
+    WakeAddress(&request_seq_);
+  }
+}
+
+void SharedExchange::NotifyClients() {
+  response_seq_.fetch_add(1, std::memory_order_seq_cst);
+  if (clients_waiting_.load(std::memory_order_seq_cst)) {
+    WakeAddress(&response_seq_);
+  }
+}
+
+Result<size_t> SharedExchange::SendRequest(
+    uint32_t method, size_t request_size, const std::function<void(uint8_t*)>& request_writer,
+    CoarseTimePoint deadline) {
+  if (!ServerRunning()) {
+    return STATUS(ServiceUnavailable, "Shared exchange server is not running");
+  }
+  if (request_size > kSlotSize) {
+    return STATUS_FORMAT(ServiceUnavailable, "Request too big for shared exchange: $0",
+                         request_size);
+  }
+
+  const auto pid = getpid();
+  // Start search from different slots in different processes, to decrease contention.
+  const size_t start = static_cast<size_t>(pid) % kNumSlots;
+  for (size_t i = 0; i != kNumSlots; ++i) {
+    const size_t idx = (start + i) % kNumSlots;
+    auto* slot = &slots_[idx];
+    // Setting owner is the claim itself, so there is no moment when slot is in use without
+    // a valid owner.
+    int32_t expected_pid = 0;
+    if (!slot->owner_pid.compare_exchange_strong(
+            expected_pid, pid, std::memory_order_acq_rel)) {
+      continue;
+    }
+    SetState(slot, SlotState::kClaimed);
+    slot->method = method;
+    slot->deadline = deadline;
+    slot->size = static_cast<uint32_t>(request_size);
+    request_writer(slot->data);
+    SetState(slot, SlotState::kRequestReady);
+    NotifyServer();
+    return idx;
+  }
+  return STATUS(ServiceUnavailable, "No free shared exchange slot");
+}
+
+void SharedExchange::Abandon(Slot* slot) {
+  for (;;) {
+    auto state = GetState(*slot);
+    switch (state) {
+      case SlotState::kRequestReady: FALLTHROUGH_INTENDED;
+      case SlotState::kResponseReady: FALLTHROUGH_INTENDED;
+      case SlotState::kChunkRequested:
+        // Server does not own slot in those states, so it could be freed right away.
+        if (ChangeState(slot, state, SlotState::kFree)) {
+          slot->owner_pid.store(0, std::memory_order_release);
+          return;
+        }
+        break;
+      case SlotState::kProcessing:
+        // Server will free slot when it completes processing.
+        if (ChangeState(slot, state, SlotState::kAbandoned)) {
+          return;
+        }
+        break;
+      default:
+        return;
+    }
+  }
+}
+
+SharedExchangeClient::SharedExchangeClient(SharedExchange* exchange) : exchange_(exchange) {
+}
+
+SharedExchangeClient::~SharedExchangeClient() {
+  Shutdown();
+}
+
+Status SharedExchangeClient::Start() {
+  return Thread::Create("shared_exchange", "client", &SharedExchangeClient::Run, this, &thread_);
+}
+
+void SharedExchangeClient::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) {
+      return;
+    }
+    stop_ = true;
+  }
+  cond_.notify_all();
+  WakeAddress(&exchange_->response_seq_);
+  if (thread_) {
+    thread_->Join();
+  }
+
+  std::vector<Call> calls;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    calls.swap(calls_);
+  }
+  for (auto& call : calls) {
+    exchange_->Abandon(&exchange_->slots_[call.slot]);
+    call.callback(STATUS(Aborted, "Shared exchange client is shutting down"));
+  }
+}
+
+Status SharedExchangeClient::Send(
+    uint32_t method, size_t request_size, const std::function<void(uint8_t*)>& request_writer,
+    CoarseTimePoint deadline, Callback callback) {
+  // Request is sent under the lock, so shutdown could not miss the call.
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stop_) {
+    return STATUS(ServiceUnavailable, "Shared exchange client is shut down");
+  }
+  auto slot = VERIFY_RESULT(exchange_->SendRequest(method, request_size, request_writer, deadline));
+  calls_.push_back(Call{slot, deadline, std::string(), std::move(callback)});
+  cond_.notify_one();
+  return Status::OK();
+}
+
+void SharedExchangeClient::Run() {
+  std::vector<std::pair<Callback, Result<SharedExchangeResponse>>> done;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    if (calls_.empty()) {
+      cond_.wait(lock);
+      continue;
+    }
+    auto seq = exchange_->response_seq_.load(std::memory_order_acquire);
+    ProcessCalls(&done);
+    if (!done.empty()) {
+      lock.unlock();
+      for (auto& call : done) {
+        call.first(std::move(call.second));
+      }
+      done.clear();
+      lock.lock();
+      continue;
+    }
+
+    auto deadline = CoarseMonoClock::now() + kMaxWaitTime;
+    for (const auto& call : calls_) {
+      deadline = std::min(deadline, call.deadline);
+    }
+    lock.unlock();
+    for (int i = 0; i != kSpinIterations &&
+                    exchange_->response_seq_.load(std::memory_order_acquire) == seq; ++i) {
+    }
+    exchange_->clients_waiting_.fetch_add(1, std::memory_order_seq_cst);
+    if (exchange_->response_seq_.load(std::memory_order_seq_cst) == seq) {
+      WaitOnAddress(&exchange_->response_seq_, seq, deadline);
+    }
+    exchange_->clients_waiting_.fetch_sub(1, std::memory_order_acq_rel);
+    lock.lock();
+  }
+}
+
+void SharedExchangeClient::ProcessCalls(
+    std::vector<std::pair<Callback, Result<SharedExchangeResponse>>>* done) {
+  using SlotState = SharedExchange::SlotState;
+  const auto now = CoarseMonoClock::now();
+  auto it = calls_.begin();
+  while (it != calls_.end()) {
+    auto* slot = &exchange_->slots_[it->slot];
+    auto state = SharedExchange::GetState(*slot);
+    boost::optional<Result<SharedExchangeResponse>> result;
+    if (state == SlotState::kRequestReady || state == SlotState::kProcessing ||
+        state == SlotState::kChunkRequested) {
+      if (now >= it->deadline) {
+        exchange_->Abandon(slot);
+        result.emplace(STATUS(TimedOut, "Timed out waiting for shared exchange response"));
+      }
+    } else if (state != SlotState::kResponseReady) {
+      // Slot was reclaimed by server, i.e. it decided that we are dead.
+      result.emplace(STATUS_FORMAT(IllegalState, "Unexpected shared exchange slot state: $0",
+                                   static_cast<uint32_t>(state)));
+    } else {
+      it->data.append(pointer_cast<const char*>(slot->data), slot->size);
+      if (it->data.size() < slot->response_size) {
+        SharedExchange::SetState(slot, SlotState::kChunkRequested);
+        exchange_->NotifyServer();
+      } else {
+        SharedExchange::FreeSlot(slot);
+        result.emplace(ParseResponse(std::move(it->data)));
+      }
+    }
+    if (!result) {
+      ++it;
+      continue;
+    }
+    done->emplace_back(std::move(it->callback), std::move(*result));
+    it = calls_.erase(it);
+  }
+}
+
+SharedExchangeServer::SharedExchangeServer(
+    SharedExchange* exchange, const std::string& server_id, Handler handler)
+    : exchange_(exchange), server_id_(server_id), handler_(std::move(handler)),
+      pending_responses_(SharedExchange::kNumSlots) {
+}
+
+SharedExchangeServer::~SharedExchangeServer() {
+  Shutdown();
+}
+
+Status SharedExchangeServer::Start() {
+  if (server_id_.size() > SharedExchange::kMaxServerIdSize) {
+    return STATUS_FORMAT(InvalidArgument, "Server id too long: $0", server_id_);
+  }
+  // Slots could be left in use by clients of the previous server process.
+  for (auto& slot : exchange_->slots_) {
+    SharedExchange::FreeSlot(&slot);
+  }
+  memcpy(exchange_->server_id_, server_id_.data(), server_id_.size());
+  exchange_->server_id_size_ = static_cast<uint32_t>(server_id_.size());
+  exchange_->server_running_.store(1, std::memory_order_release);
+  return Thread::Create("shared_exchange", "poller", &SharedExchangeServer::Run, this, &thread_);
+}
+
+void SharedExchangeServer::Shutdown() {
+  exchange_->server_running_.store(0, std::memory_order_release);
+  if (stop_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  WakeAddress(&exchange_->request_seq_);
+  if (thread_) {
+    thread_->Join();
+  }
+}
+
+void SharedExchangeServer::Run() {
+  auto next_reclaim_time = CoarseMonoClock::now();
+  while (!stop_.load(std::memory_order_acquire)) {
+    auto seq = exchange_->request_seq_.load(std::memory_order_acquire);
+    ProcessSlots();
+
+    auto now = CoarseMonoClock::now();
+    if (now >= next_reclaim_time) {
+      ReclaimDeadClientSlots();
+      next_reclaim_time = now + 1s;
+    }
+
+    exchange_->server_waiting_.store(1, std::memory_order_seq_cst);
+    if (exchange_->request_seq_.load(std::memory_order_seq_cst) == seq &&
+        !stop_.load(std::memory_order_acquire)) {
+      WaitOnAddress(&exchange_->request_seq_, seq, now + kMaxWaitTime);
+    }
+    exchange_->server_waiting_.store(0, std::memory_order_release);
+  }
+}
+
+void SharedExchangeServer::ProcessSlots() {
+  using SlotState = SharedExchange::SlotState;
+  for (size_t i = 0; i != SharedExchange::kNumSlots; ++i) {
+    auto& slot = exchange_->slots_[i];
+    auto state = SharedExchange::GetState(slot);
+    if (state == SlotState::kChunkRequested) {
+      if (SharedExchange::ChangeState(&slot, state, SlotState::kProcessing)) {
+        WriteChunk(i);
+      }
+    } else if (state == SlotState::kRequestReady) {
+      if (!SharedExchange::ChangeState(&slot, state, SlotState::kProcessing)) {
+        continue;
+      }
+      {
+        // Drop leftovers of response, that was abandoned by the previous owner of this slot.
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_responses_[i] = std::make_pair(std::string(), 0);
+      }
+      handler_(i, slot.method, Slice(slot.data, slot.size), slot.deadline);
+    }
+  }
+}
+
+void SharedExchangeServer::Respond(
+    size_t slot_idx, const Slice& body, const std::vector<Slice>& sidecars) {
+  DoRespond(slot_idx, false /* failed */, body, sidecars);
+}
+
+void SharedExchangeServer::RespondFailure(size_t slot_idx, const Slice& error) {
+  DoRespond(slot_idx, true /* failed */, error, {});
+}
+
+void SharedExchangeServer::DoRespond(
+    size_t slot_idx, bool failed, const Slice& body, const std::vector<Slice>& sidecars) {
+  using SlotState = SharedExchange::SlotState;
+  auto& slot = exchange_->slots_[slot_idx];
+
+  size_t size = 1 + kUInt32Size + body.size() + kUInt32Size;
+  for (const auto& sidecar : sidecars) {
+    size += kUInt32Size + sidecar.size();
+  }
+
+  std::string overflow;
+  uint8_t* out = slot.data;
+  if (size > SharedExchange::kSlotSize) {
+    overflow.resize(size);
+    out = pointer_cast<uint8_t*>(&overflow[0]);
+  }
+
+  *out++ = failed ? 1 : 0;
+  PutUInt32(static_cast<uint32_t>(body.size()), &out);
+  out = CopyBytes(body, out);
+  PutUInt32(static_cast<uint32_t>(sidecars.size()), &out);
+  for (const auto& sidecar : sidecars) {
+    PutUInt32(static_cast<uint32_t>(sidecar.size()), &out);
+    out = CopyBytes(sidecar, out);
+  }
+
+  slot.response_size = size;
+  if (overflow.empty()) {
+    slot.size = static_cast<uint32_t>(size);
+    if (!SharedExchange::ChangeState(&slot, SlotState::kProcessing, SlotState::kResponseReady)) {
+      // Client is not waiting for response anymore.
+      SharedExchange::FreeSlot(&slot);
+      return;
+    }
+    exchange_->NotifyClients();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_responses_[slot_idx] = std::make_pair(std::move(overflow), 0);
+  }
+  WriteChunk(slot_idx);
+}
+
+void SharedExchangeServer::WriteChunk(size_t slot_idx) {
+  using SlotState = SharedExchange::SlotState;
+  auto& slot = exchange_->slots_[slot_idx];
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& pending = pending_responses_[slot_idx];
+    if (pending.first.empty()) {
+      LOG(DFATAL) << "No pending response for shared exchange slot " << slot_idx;
+      SharedExchange::FreeSlot(&slot);
+      exchange_->NotifyClients();
+      return;
+    }
+    auto size = std::min(pending.first.size() - pending.second, SharedExchange::kSlotSize);
+    memcpy(slot.data, pending.first.data() + pending.second, size);
+    slot.size = static_cast<uint32_t>(size);
+    pending.second += size;
+    if (pending.second >= pending.first.size()) {
+      pending = std::make_pair(std::string(), 0);
+    }
+  }
+  if (!SharedExchange::ChangeState(&slot, SlotState::kProcessing, SlotState::kResponseReady)) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_responses_[slot_idx] = std::make_pair(std::string(), 0);
+    }
+    SharedExchange::FreeSlot(&slot);
+    return;
+  }
+  exchange_->NotifyClients();
+}
+
+void SharedExchangeServer::ReclaimDeadClientSlots() {
+  using SlotState = SharedExchange::SlotState;
+  for (auto& slot : exchange_->slots_) {
+    auto pid = slot.owner_pid.load(std::memory_order_acquire);
+    if (pid == 0 || ProcessAlive(pid)) {
+      continue;
+    }
+    // Owner is set before slot leaves kFree state and reset after it returns to it. So if owner
+    // did not change while state was read, the state belongs to the dead owner, and only the
+    // server could move slot out of it.
+    auto state = SharedExchange::GetState(slot);
+    if (slot.owner_pid.load(std::memory_order_acquire) != pid) {
+      continue;
+    }
+    switch (state) {
+      case SlotState::kAbandoned:
+        // Server frees slot when it completes processing.
+        continue;
+      case SlotState::kProcessing:
+        if (SharedExchange::ChangeState(&slot, state, SlotState::kAbandoned)) {
+          LOG(INFO) << "Abandoning shared exchange slot of dead process " << pid;
+        }
+        continue;
+      case SlotState::kFree:
+        // Owner died right after claiming slot, or right after freeing it.
+        slot.owner_pid.compare_exchange_strong(pid, 0, std::memory_order_acq_rel);
+        continue;
+      default:
+        if (SharedExchange::ChangeState(&slot, state, SlotState::kFree)) {
+          LOG(INFO) << "Reclaiming shared exchange slot of dead process " << pid;
+          slot.owner_pid.store(0, std::memory_order_release);
+        }
+        continue;
+    }
+  }
+}
+
+} // namespace yb
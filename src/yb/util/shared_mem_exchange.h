@@ -0,0 +1,246 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_SHARED_MEM_EXCHANGE_H
+#define YB_UTIL_SHARED_MEM_EXCHANGE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/result.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+
+class Thread;
+
+// Response received via shared memory exchange. Body and sidecars point into data.
+struct SharedExchangeResponse {
+  // Set when server responded with RespondFailure. In this case body contains the error passed
+  // by the server, for instance serialized status, and there are no sidecars.
+  bool failed = false;
+  // Held by pointer, so body and sidecars stay valid when response is moved.
+  std::unique_ptr<std::string> data;
+  Slice body;
+  std::vector<Slice> sidecars;
+};
+
+// Area placed in shared memory, used to pass requests from processes on the same host to the
+// server and responses back without going through the network stack.
+// It consists of a fixed number of slots, each slot holds at most one call at a time.
+// Client claims a free slot, writes request to it and receives response in the same slot.
+// Server polls for ready requests, handles them asynchronously and writes responses back.
+// Responses that do not fit into a slot are transferred in several chunks.
+//
+// All fields are lock-free atomics or plain data, since any client process could crash at any
+// point. Slots owned by dead processes are reclaimed by the server.
+class SharedExchange {
+ public:
+  static constexpr size_t kNumSlots = 64;
+  static constexpr size_t kSlotSize = 256_KB;
+  static constexpr size_t kMaxServerIdSize = 64;
+
+  SharedExchange();
+
+  SharedExchange(const SharedExchange&) = delete;
+  void operator=(const SharedExchange&) = delete;
+
+  // Returns true if server is accepting requests.
+  bool ServerRunning() const;
+
+  // Id of the server, i.e. tablet server uuid. Valid only when ServerRunning() is true.
+  Slice server_id() const;
+
+ private:
+  friend class SharedExchangeClient;
+  friend class SharedExchangeServer;
+
+  enum class SlotState : uint32_t {
+    // Slot is not used.
+    kFree,
+    // Slot was claimed by client, that is writing request to it.
+    kClaimed,
+    // Request is ready to be picked by server.
+    kRequestReady,
+    // Server is handling request.
+    kProcessing,
+    // Response, or its chunk, is ready to be read by client.
+    kResponseReady,
+    // Client read chunk of response and waits for next one.
+    kChunkRequested,
+    // Client stopped waiting for response, server should free slot after processing.
+    kAbandoned,
+  };
+
+  struct Slot {
+    std::atomic<uint32_t> state{static_cast<uint32_t>(SlotState::kFree)};
+    // Pid of the process that owns slot, 0 when slot is free. Client claims slot by setting it,
+    // before changing state, and it is reset only after state became kFree. So server never sees
+    // a used slot with pid of the previous owner.
+    std::atomic<int32_t> owner_pid{0};
+    uint32_t method = 0;
+    // Deadline of the call. Coarse mono clock is system-wide, so it has the same meaning in client
+    // and server processes.
+    CoarseTimePoint deadline;
+    // Size of data stored in slot: request or current chunk of response.
+    uint32_t size = 0;
+    // Full size of response, could be greater than size when response is transferred in chunks.
+    uint64_t response_size = 0;
+    uint8_t data[kSlotSize];
+  };
+
+  static SlotState GetState(const Slot& slot);
+  static bool ChangeState(Slot* slot, SlotState from, SlotState to);
+  static void SetState(Slot* slot, SlotState state);
+
+  // Marks slot as free and releases its ownership.
+  static void FreeSlot(Slot* slot);
+
+  // Claims a free slot and writes request to it. Returns index of the slot.
+  // Returns ServiceUnavailable if request was not sent.
+  Result<size_t> SendRequest(
+      uint32_t method, size_t request_size, const std::function<void(uint8_t*)>& request_writer,
+      CoarseTimePoint deadline);
+
+  void NotifyServer();
+  void NotifyClients();
+
+  // Stops waiting for response in slot.
+  void Abandon(Slot* slot);
+
+  std::atomic<uint32_t> server_running_{0};
+  char server_id_[kMaxServerIdSize];
+  uint32_t server_id_size_ = 0;
+
+  // Incremented by client each time server should look at slots.
+  std::atomic<uint32_t> request_seq_{0};
+  // Set while server is waiting on request_seq_, so clients do not wake it unnecessarily.
+  std::atomic<uint32_t> server_waiting_{0};
+
+  // Incremented by server each time a response, or its chunk, is written to a slot.
+  std::atomic<uint32_t> response_seq_{0};
+  // Number of client threads waiting on response_seq_.
+  std::atomic<uint32_t> clients_waiting_{0};
+
+  Slot slots_[kNumSlots];
+};
+
+// Client side of the shared memory exchange. Requests are sent without blocking the caller,
+// responses are received by a thread of the client and passed to callbacks.
+class SharedExchangeClient {
+ public:
+  // Invoked on the client thread with response or failure, for instance TimedOut.
+  // Should not block, since it delays other responses.
+  typedef std::function<void(Result<SharedExchangeResponse>)> Callback;
+
+  explicit SharedExchangeClient(SharedExchange* exchange);
+  ~SharedExchangeClient();
+
+  CHECKED_STATUS Start();
+
+  // Calls of requests in flight are invoked with Aborted status.
+  void Shutdown();
+
+  SharedExchange* exchange() const {
+    return exchange_;
+  }
+
+  // Sends request to the server. Request of request_size bytes is serialized by request_writer
+  // directly into shared memory.
+  // Returns ServiceUnavailable if request was not sent, i.e. server is not running, there is no
+  // free slot or request is too big. In this case callback is not invoked and caller could safely
+  // use other transport. Otherwise callback is invoked once response is received or deadline
+  // passed. Failures reported by server are passed as failed response.
+  CHECKED_STATUS Send(
+      uint32_t method, size_t request_size, const std::function<void(uint8_t*)>& request_writer,
+      CoarseTimePoint deadline, Callback callback);
+
+ private:
+  struct Call {
+    size_t slot;
+    CoarseTimePoint deadline;
+    // Received part of response.
+    std::string data;
+    Callback callback;
+  };
+
+  void Run();
+
+  // Checks slots of calls in flight, completed calls are moved to done.
+  void ProcessCalls(std::vector<std::pair<Callback, Result<SharedExchangeResponse>>>* done);
+
+  SharedExchange* const exchange_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool stop_ = false;
+  std::vector<Call> calls_;
+
+  scoped_refptr<Thread> thread_;
+};
+
+// Server side of the shared memory exchange. Polls exchange for requests and passes them to
+// handler. Handler should eventually call Respond for each request it received.
+class SharedExchangeServer {
+ public:
+  // Handler is invoked on the polling thread with slot index, method, request and deadline.
+  // Request points into shared memory and is valid only until handler returns.
+  typedef std::function<void(
+      size_t slot, uint32_t method, Slice request, CoarseTimePoint deadline)> Handler;
+
+  SharedExchangeServer(SharedExchange* exchange, const std::string& server_id, Handler handler);
+  ~SharedExchangeServer();
+
+  CHECKED_STATUS Start();
+  void Shutdown();
+
+  // Sends response to the request in specified slot.
+  void Respond(size_t slot, const Slice& body, const std::vector<Slice>& sidecars);
+
+  // Reports failure of the request in specified slot. Error is passed to the client as is, so
+  // it could carry full status serialized by the caller.
+  void RespondFailure(size_t slot, const Slice& error);
+
+ private:
+  void DoRespond(size_t slot_idx, bool failed, const Slice& body,
+                 const std::vector<Slice>& sidecars);
+
+  void Run();
+  void ProcessSlots();
+  void WriteChunk(size_t slot_idx);
+  void ReclaimDeadClientSlots();
+
+  SharedExchange* const exchange_;
+  const std::string server_id_;
+  const Handler handler_;
+
+  std::atomic<bool> stop_{false};
+  scoped_refptr<Thread> thread_;
+
+  std::mutex mutex_;
+  // Responses that did not fit into slot, with offset of next chunk to send.
+  std::vector<std::pair<std::string, size_t>> pending_responses_;
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_SHARED_MEM_EXCHANGE_H
@@ -0,0 +1,287 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/span_tracer.h"
+
+#include <inttypes.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "yb/gutil/stringprintf.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/jsonwriter.h"
+#include "yb/util/random_util.h"
+#include "yb/util/thread.h"
+
+DEFINE_int32(span_trace_sample_every_n, 1000,
+             "Sample 1 of N root RPC calls for span tracing. 0 disables span tracing.");
+TAG_FLAG(span_trace_sample_every_n, advanced);
+TAG_FLAG(span_trace_sample_every_n, runtime);
+
+DEFINE_int32(span_trace_buffer_size, 1024,
+             "Number of last spans kept by each thread that records sampled spans.");
+TAG_FLAG(span_trace_buffer_size, advanced);
+
+namespace yb {
+
+namespace {
+
+__thread uint64_t current_span_trace_decision = kSpanTraceNotDecided;
+
+struct Span {
+  const char* name;
+  uint64_t trace_id;
+  int64_t start_us;
+  int64_t duration_us;
+};
+
+// Slot of the ring buffer, protected by seqlock. Version is 2 * (index + 1) when slot contains
+// span with specified index, and odd while the slot is being written.
+struct SpanSlot {
+  std::atomic<uint64_t> version{0};
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint64_t> trace_id{0};
+  std::atomic<int64_t> start_us{0};
+  std::atomic<int64_t> duration_us{0};
+};
+
+// Ring buffer of spans recorded by a single thread. Only the owning thread writes to it, while
+// dump could read it concurrently.
+class ThreadSpans {
+ public:
+  ThreadSpans(int64_t tid, std::string thread_name, size_t capacity)
+      : tid_(tid), thread_name_(std::move(thread_name)), capacity_(capacity),
+        slots_(new SpanSlot[capacity]) {}
+
+  void Add(const Span& span) {
+    auto index = next_.load(std::memory_order_relaxed);
+    auto& slot = slots_[index % capacity_];
+    slot.version.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(span.name, std::memory_order_relaxed);
+    slot.trace_id.store(span.trace_id, std::memory_order_relaxed);
+    slot.start_us.store(span.start_us, std::memory_order_relaxed);
+    slot.duration_us.store(span.duration_us, std::memory_order_relaxed);
+    slot.version.store(2 * index + 2, std::memory_order_release);
+    next_.store(index + 1, std::memory_order_release);
+  }
+
+  void Collect(std::vector<Span>* out) const {
+    auto end = next_.load(std::memory_order_acquire);
+    auto begin = end > capacity_ ? end - capacity_ : 0;
+    for (auto index = begin; index != end; ++index) {
+      const auto& slot = slots_[index % capacity_];
+      auto version = slot.version.load(std::memory_order_acquire);
+      if (version != 2 * index + 2) {
+        // Slot was already overwritten by a newer span.
+        continue;
+      }
+      Span span = {
+        slot.name.load(std::memory_order_relaxed),
+        slot.trace_id.load(std::memory_order_relaxed),
+        slot.start_us.load(std::memory_order_relaxed),
+        slot.duration_us.load(std::memory_order_relaxed),
+      };
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.version.load(std::memory_order_relaxed) == version) {
+        out->push_back(span);
+      }
+    }
+  }
+
+  int64_t tid() const {
+    return tid_;
+  }
+
+  const std::string& thread_name() const {
+    return thread_name_;
+  }
+
+ private:
+  const int64_t tid_;
+  const std::string thread_name_;
+  const size_t capacity_;
+  std::unique_ptr<SpanSlot[]> slots_;
+  std::atomic<size_t> next_{0};
+};
+
+typedef std::shared_ptr<ThreadSpans> ThreadSpansPtr;
+
+// Buffers of all live threads that recorded spans.
+// Buffer is dropped when its thread exits, so spans of exited threads are lost.
+class SpanRegistry {
+ public:
+  static SpanRegistry& Instance() {
+    // Never destroyed, so exiting threads could safely unregister their buffers.
+    static SpanRegistry* instance = new SpanRegistry;
+    return *instance;
+  }
+
+  ThreadSpansPtr Register() {
+    auto* thread = Thread::current_thread();
+    auto result = std::make_shared<ThreadSpans>(
+        Thread::CurrentThreadId(), thread ? thread->name() : std::string(),
+        std::max(FLAGS_span_trace_buffer_size, 1));
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.push_back(result);
+    return result;
+  }
+
+  void Unregister(const ThreadSpansPtr& spans) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.erase(std::remove(threads_.begin(), threads_.end(), spans), threads_.end());
+  }
+
+  std::vector<ThreadSpansPtr> Threads() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threads_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<ThreadSpansPtr> threads_;
+};
+
+// Lazily registers buffer of the current thread, so only threads that record spans allocate it.
+class ThreadSpansHolder {
+ public:
+  ~ThreadSpansHolder() {
+    if (spans_) {
+      SpanRegistry::Instance().Unregister(spans_);
+    }
+  }
+
+  ThreadSpans& Get() {
+    if (!spans_) {
+      spans_ = SpanRegistry::Instance().Register();
+    }
+    return *spans_;
+  }
+
+ private:
+  ThreadSpansPtr spans_;
+};
+
+thread_local ThreadSpansHolder thread_spans;
+
+int64_t ToMicroseconds(MonoTime time) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      time.ToSteadyTimePoint().time_since_epoch()).count();
+}
+
+} // namespace
+
+uint64_t SampleSpanTrace() {
+  auto every_n = GetAtomicFlag(&FLAGS_span_trace_sample_every_n);
+  if (every_n <= 0 || !RandomWithChance(every_n)) {
+    return 0;
+  }
+  uint64_t result;
+  do {
+    result = RandomUniformInt<uint64_t>();
+  } while (result == 0 || result == kSpanTraceNotDecided);
+  return result;
+}
+
+uint64_t CurrentSpanTraceDecision() {
+  return current_span_trace_decision;
+}
+
+void RecordSpan(const char* name, uint64_t trace_id, MonoTime start, MonoTime finish) {
+  auto start_us = ToMicroseconds(start);
+  thread_spans.Get().Add(Span {
+    name, trace_id, start_us, ToMicroseconds(finish) - start_us
+  });
+}
+
+void DumpSpansAsChromeTrace(JsonWriter* writer) {
+  const int64_t pid = getpid();
+  std::vector<Span> spans;
+
+  writer->StartObject();
+  writer->String("traceEvents");
+  writer->StartArray();
+  for (const auto& thread : SpanRegistry::Instance().Threads()) {
+    spans.clear();
+    thread->Collect(&spans);
+    if (spans.empty()) {
+      continue;
+    }
+    if (!thread->thread_name().empty()) {
+      writer->StartObject();
+      writer->String("name");
+      writer->String("thread_name");
+      writer->String("ph");
+      writer->String("M");
+      writer->String("pid");
+      writer->Int64(pid);
+      writer->String("tid");
+      writer->Int64(thread->tid());
+      writer->String("args");
+      writer->StartObject();
+      writer->String("name");
+      writer->String(thread->thread_name());
+      writer->EndObject();
+      writer->EndObject();
+    }
+    for (const auto& span : spans) {
+      writer->StartObject();
+      writer->String("name");
+      writer->String(span.name);
+      writer->String("cat");
+      writer->String("span");
+      writer->String("ph");
+      writer->String("X");
+      writer->String("ts");
+      writer->Int64(span.start_us);
+      writer->String("dur");
+      writer->Int64(span.duration_us);
+      writer->String("pid");
+      writer->Int64(pid);
+      writer->String("tid");
+      writer->Int64(thread->tid());
+      writer->String("args");
+      writer->StartObject();
+      writer->String("trace_id");
+      writer->String(StringPrintf("%016" PRIx64, span.trace_id));
+      writer->EndObject();
+      writer->EndObject();
+    }
+  }
+  writer->EndArray();
+  writer->String("displayTimeUnit");
+  writer->String("ms");
+  writer->EndObject();
+}
+
+ScopedSpanTraceId::ScopedSpanTraceId(uint64_t decision)
+    : old_decision_(current_span_trace_decision) {
+  current_span_trace_decision = decision;
+}
+
+ScopedSpanTraceId::~ScopedSpanTraceId() {
+  current_span_trace_decision = old_decision_;
+}
+
+} // namespace yb
@@ -0,0 +1,115 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Sampled span tracer, cheap enough to be always on in production.
+//
+// A root of the trace (outbound or inbound RPC call) decides whether it is sampled, picking 1 of
+// span_trace_sample_every_n calls. Sampled call gets non zero span trace id, unsampled call gets 0.
+// This decision is propagated with yb::Trace objects inside the process and with the RPC request
+// header between processes, so calls made on behalf of unsampled root are not sampled again.
+// Spans are recorded only for sampled traces, to lock-free per-thread ring buffers, so old spans
+// are overwritten by new ones. Collected spans are exported in Chrome trace JSON format.
+//
+// Span names should be static strings of form "<component>.<operation>", i.e. "rpc.inbound_call",
+// and should not be changed, so collected traces could be compared across versions.
+
+#ifndef YB_UTIL_SPAN_TRACER_H
+#define YB_UTIL_SPAN_TRACER_H
+
+#include <stdint.h>
+
+#include <limits>
+
+#include <boost/preprocessor/cat.hpp>
+
+#include "yb/gutil/macros.h"
+#include "yb/gutil/port.h"
+
+#include "yb/util/monotime.h"
+
+#define SCOPED_SPAN(name) ::yb::ScopedSpan BOOST_PP_CAT(scoped_span_, __LINE__)(name)
+
+namespace yb {
+
+class JsonWriter;
+
+// Sampling decision of a trace is its span trace id, 0 when the trace is not sampled, or
+// kSpanTraceNotDecided when the trace does not belong to any root yet.
+constexpr uint64_t kSpanTraceNotDecided = std::numeric_limits<uint64_t>::max();
+
+// Returns span trace id for new root of a trace, or 0 when it is not sampled.
+uint64_t SampleSpanTrace();
+
+// Returns the specified decision, or samples new root when it is not decided.
+inline uint64_t DecideSpanTrace(uint64_t decision) {
+  return decision == kSpanTraceNotDecided ? SampleSpanTrace() : decision;
+}
+
+// Returns span trace id for the specified decision, 0 when trace is not sampled or not decided.
+inline uint64_t SpanTraceIdOf(uint64_t decision) {
+  return decision == kSpanTraceNotDecided ? 0 : decision;
+}
+
+// Returns sampling decision of the trace adopted by the current thread.
+uint64_t CurrentSpanTraceDecision();
+
+// Returns span trace id of the trace adopted by the current thread, or 0 if it is not sampled.
+inline uint64_t CurrentSpanTraceId() {
+  return SpanTraceIdOf(CurrentSpanTraceDecision());
+}
+
+// Records span of the specified trace. name should be a static string.
+void RecordSpan(const char* name, uint64_t trace_id, MonoTime start, MonoTime finish);
+
+// Writes spans collected by all threads as Chrome trace JSON object.
+void DumpSpansAsChromeTrace(JsonWriter* writer);
+
+// Sets sampling decision of the current thread for the duration of the scope.
+class ScopedSpanTraceId {
+ public:
+  explicit ScopedSpanTraceId(uint64_t decision);
+  ~ScopedSpanTraceId();
+
+ private:
+  uint64_t old_decision_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedSpanTraceId);
+};
+
+// Records span covering the scope, if the current thread runs sampled trace.
+class ScopedSpan {
+ public:
+  explicit ScopedSpan(const char* name)
+      : name_(name), trace_id_(CurrentSpanTraceId()) {
+    if (PREDICT_FALSE(trace_id_ != 0)) {
+      start_ = MonoTime::Now();
+    }
+  }
+
+  ~ScopedSpan() {
+    if (PREDICT_FALSE(trace_id_ != 0)) {
+      RecordSpan(name_, trace_id_, start_, MonoTime::Now());
+    }
+  }
+
+ private:
+  const char* const name_;
+  const uint64_t trace_id_;
+  MonoTime start_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedSpan);
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_SPAN_TRACER_H
@@ -37,6 +37,9 @@
 // Need to add rapidjson.h to the list of recognized third-party libraries in our linter.
 #include <rapidjson/rapidjson.h>  // NOLINT
 
+#include "yb/gutil/stringprintf.h"
+#include "yb/util/jsonwriter.h"
+#include "yb/util/span_tracer.h"
 #include "yb/util/trace.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/debug/trace_event_synthetic_delay.h"
@@ -44,6 +47,8 @@
 #include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
 
+DECLARE_int32(span_trace_sample_every_n);
+
 using yb::debug::TraceLog;
 using yb::debug::TraceResultBuffer;
 using yb::debug::CategoryFilter;
@@ -838,5 +843,73 @@ TEST_F(TraceTest, TestVLogAndEchoToConsole) {
   tl->SetDisabled();
 }
 
+// Span trace id should be propagated by traces, and only spans of sampled traces recorded.
+TEST_F(TraceTest, TestSampledSpans) {
+  FLAGS_span_trace_sample_every_n = 1;
+  auto trace_id = SampleSpanTrace();
+  ASSERT_NE(0U, trace_id);
+  ASSERT_EQ(0U, CurrentSpanTraceId());
+
+  scoped_refptr<Trace> root(new Trace);
+  root->set_span_trace_id(trace_id);
+  {
+    ADOPT_TRACE(root.get());
+    ASSERT_EQ(trace_id, CurrentSpanTraceId());
+    scoped_refptr<Trace> child(new Trace);
+    ASSERT_EQ(trace_id, child->span_trace_id());
+    SCOPED_SPAN("test.sampled");
+  }
+  ASSERT_EQ(0U, CurrentSpanTraceId());
+  {
+    SCOPED_SPAN("test.not_sampled");
+  }
+
+  std::stringstream out;
+  JsonWriter writer(&out, JsonWriter::COMPACT);
+  DumpSpansAsChromeTrace(&writer);
+  Document doc;
+  doc.Parse<0>(out.str().c_str());
+  ASSERT_TRUE(doc.IsObject()) << out.str();
+  const Value& events = doc["traceEvents"];
+  ASSERT_TRUE(events.IsArray());
+
+  const string expected_trace_id = StringPrintf("%016" PRIx64, trace_id);
+  int num_sampled = 0;
+  for (rapidjson::SizeType i = 0; i < events.Size(); ++i) {
+    const Value& event = events[i];
+    if (string(event["ph"].GetString()) != "X") {
+      continue;
+    }
+    string name = event["name"].GetString();
+    ASSERT_NE("test.not_sampled", name);
+    if (name == "test.sampled") {
+      ASSERT_EQ(expected_trace_id, event["args"]["trace_id"].GetString());
+      ASSERT_GE(event["dur"].GetInt64(), 0);
+      ++num_sampled;
+    }
+  }
+  ASSERT_EQ(1, num_sampled);
+}
+
+// Trace created on behalf of unsampled root should not be sampled again.
+TEST_F(TraceTest, TestUnsampledSpanTraceDecision) {
+  FLAGS_span_trace_sample_every_n = 1;
+  ASSERT_EQ(kSpanTraceNotDecided, CurrentSpanTraceDecision());
+
+  scoped_refptr<Trace> root(new Trace);
+  ASSERT_EQ(kSpanTraceNotDecided, root->span_trace_decision());
+  ASSERT_EQ(0U, root->span_trace_id());
+  root->set_span_trace_id(0);
+  {
+    ADOPT_TRACE(root.get());
+    ASSERT_EQ(0U, CurrentSpanTraceDecision());
+    scoped_refptr<Trace> child(new Trace);
+    ASSERT_EQ(0U, child->span_trace_decision());
+    ASSERT_EQ(0U, DecideSpanTrace(child->span_trace_decision()));
+  }
+  ASSERT_EQ(kSpanTraceNotDecided, CurrentSpanTraceDecision());
+  ASSERT_NE(0U, DecideSpanTrace(CurrentSpanTraceDecision()));
+}
+
 } // namespace debug
 } // namespace yb
@@ -159,7 +159,8 @@ int64_t GetCurrentMicrosFast(MonoTime now) {
 } // namespace
 
 ScopedAdoptTrace::ScopedAdoptTrace(Trace* t)
-    : old_trace_(Trace::threadlocal_trace_), is_enabled_(GetAtomicFlag(&FLAGS_enable_tracing)) {
+    : old_trace_(Trace::threadlocal_trace_), is_enabled_(GetAtomicFlag(&FLAGS_enable_tracing)),
+      span_trace_id_(t ? t->span_trace_decision() : kSpanTraceNotDecided) {
   if (is_enabled_) {
     trace_ = t;
     Trace::threadlocal_trace_ = t;
@@ -212,7 +213,7 @@ struct TraceEntry {
   }
 };
 
-Trace::Trace() {
+Trace::Trace() : span_trace_decision_(CurrentSpanTraceDecision()) {
 }
 
 ThreadSafeObjectPool<ThreadSafeArena>& ArenaPool() {
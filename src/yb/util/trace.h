@@ -49,6 +49,7 @@
 #include "yb/util/atomic.h"
 #include "yb/util/locks.h"
 #include "yb/util/memory/arena_fwd.h"
+#include "yb/util/span_tracer.h"
 
 DECLARE_bool(enable_tracing);
 
@@ -157,6 +158,22 @@ class Trace : public RefCountedThreadSafe<Trace> {
   // Attaches the given trace which will get appended at the end when Dumping.
   void AddChildTrace(Trace* child_trace);
 
+  // Id of the sampled span trace that this trace belongs to, 0 if it is not sampled.
+  uint64_t span_trace_id() const {
+    return SpanTraceIdOf(span_trace_decision());
+  }
+
+  // Sampling decision of the span trace, see kSpanTraceNotDecided.
+  // New trace inherits sampling decision of the current thread.
+  uint64_t span_trace_decision() const {
+    return span_trace_decision_.load(std::memory_order_relaxed);
+  }
+
+  // Sets the decision, 0 marks the trace as not sampled.
+  void set_span_trace_id(uint64_t value) {
+    span_trace_decision_.store(value, std::memory_order_relaxed);
+  }
+
   // Return the current trace attached to this thread, if there is one.
   static Trace* CurrentTrace() {
     return threadlocal_trace_;
@@ -200,6 +217,8 @@ class Trace : public RefCountedThreadSafe<Trace> {
 
   int64_t trace_start_time_usec_ = 0;
 
+  std::atomic<uint64_t> span_trace_decision_;
+
   std::vector<scoped_refptr<Trace> > child_traces_;
 
   DISALLOW_COPY_AND_ASSIGN(Trace);
@@ -221,6 +240,8 @@ class ScopedAdoptTrace {
   Trace* old_trace_;
   scoped_refptr<Trace> trace_;
   bool is_enabled_ = false;
+  // Span trace id is adopted even when tracing is disabled, since span tracing is sampled.
+  ScopedSpanTraceId span_trace_id_;
 
   DISALLOW_COPY_AND_ASSIGN(ScopedAdoptTrace);
 };
@@ -132,6 +132,35 @@ TEST_F(VarIntTest, TestArithmetic) {
   ASSERT_EQ(VarInt(-1), VarInt(23) + VarInt(3) + VarInt(-27));
 }
 
+TEST_F(VarIntTest, TestInlineOverflow) {
+  // 2^127 - 1 is the largest value stored inline, operations crossing it switch to BIGNUM.
+  auto max_inline = ASSERT_RESULT(VarInt::CreateFromString(
+      "170141183460469231731687303715884105727"));
+  auto min_big = ASSERT_RESULT(VarInt::CreateFromString(
+      "170141183460469231731687303715884105728"));
+  ASSERT_EQ(min_big, max_inline + VarInt(1));
+  ASSERT_EQ(max_inline, min_big - VarInt(1));
+  ASSERT_EQ("170141183460469231731687303715884105728", (max_inline + VarInt(1)).ToString());
+  ASSERT_EQ("-170141183460469231731687303715884105728",
+            (VarInt(0) - max_inline - VarInt(1)).ToString());
+  ASSERT_EQ("340282366920938463463374607431768211454", (max_inline + max_inline).ToString());
+  ASSERT_EQ(VarInt(0), (max_inline + max_inline) - max_inline - max_inline);
+  ASSERT_LT(max_inline, min_big);
+  ASSERT_GT(VarInt(0) - max_inline, VarInt(0) - min_big);
+
+  for (const auto& value : {max_inline, min_big, VarInt(0) - max_inline, VarInt(0) - min_big}) {
+    SCOPED_TRACE(Format("Value: $0", value));
+    VarInt decoded;
+    size_t size;
+    auto encoded = value.EncodeToComparable();
+    ASSERT_OK(decoded.DecodeFromComparable(encoded, &size));
+    ASSERT_EQ(encoded.size(), size);
+    ASSERT_EQ(value, decoded);
+    ASSERT_OK(decoded.DecodeFromTwosComplement(value.EncodeToTwosComplement()));
+    ASSERT_EQ(value, decoded);
+  }
+}
+
 TEST_F(VarIntTest, ComparableEncodingWithReserve) {
   constexpr int kNumReservedBits = 2;
   for (int i = 0; i != 0xffff; ++i) {
@@ -22,60 +22,189 @@ void BigNumDeleter::operator()(BIGNUM* bn) const {
   BN_free(bn);
 }
 
-ATTRIBUTE_NO_SANITIZE_UNDEFINED VarInt::VarInt(int64_t int64_val) : impl_(BN_new()) {
-  if (int64_val >= 0) {
-    BN_set_word(impl_.get(), int64_val);
-  } else {
-    BN_set_word(impl_.get(), -int64_val);
-    BN_set_negative(impl_.get(), 1);
+namespace {
+
+// Max number of decimal digits that always fits into inline representation, 10^38 < 2^127.
+constexpr size_t kMaxSmallDecimalDigits = 38;
+
+constexpr int kMaxSmallBits = 127;
+
+size_t CountBits(unsigned __int128 value) {
+  uint64_t high = static_cast<uint64_t>(value >> 64);
+  if (high) {
+    return 128 - __builtin_clzll(high);
   }
+  uint64_t low = static_cast<uint64_t>(value);
+  return low ? 64 - __builtin_clzll(low) : 0;
 }
 
-VarInt::VarInt() : impl_(BN_new()) {}
+// Inline values have magnitude below 2^127, so the minimal 128-bit value is not allowed.
+bool IsValidSmallInt(__int128 value) {
+  return value != static_cast<__int128>(static_cast<unsigned __int128>(1) << 127);
+}
+
+} // namespace
+
+VarInt::VarInt(int64_t int64_val) : small_value_(int64_val) {}
 
-VarInt::VarInt(const VarInt& var_int) : impl_(BN_dup(var_int.impl_.get())) {}
+VarInt::VarInt() {}
+
+VarInt::VarInt(const VarInt& var_int)
+    : small_value_(var_int.small_value_),
+      impl_(var_int.impl_ ? BN_dup(var_int.impl_.get()) : nullptr) {}
+
+VarInt::VarInt(BigNumPtr&& rhs) {
+  ResetBigNum(std::move(rhs));
+}
 
 VarInt& VarInt::operator=(const VarInt& rhs) {
-  impl_.reset(BN_dup(rhs.impl_.get()));
+  small_value_ = rhs.small_value_;
+  impl_.reset(rhs.impl_ ? BN_dup(rhs.impl_.get()) : nullptr);
   return *this;
 }
 
+bool VarInt::IsNegative() const {
+  return impl_ ? BN_is_negative(impl_.get()) : small_value_ < 0;
+}
+
+VarInt::SmallUInt VarInt::SmallMagnitude() const {
+  // Unsigned negation, so no overflow is possible here.
+  return small_value_ < 0 ? -static_cast<SmallUInt>(small_value_)
+                          : static_cast<SmallUInt>(small_value_);
+}
+
+size_t VarInt::NumBits() const {
+  return impl_ ? BN_num_bits(impl_.get()) : CountBits(SmallMagnitude());
+}
+
+void VarInt::MagnitudeToBin(uint8_t* out) const {
+  if (impl_) {
+    BN_bn2bin(impl_.get(), out);
+    return;
+  }
+  auto value = SmallMagnitude();
+  for (auto p = out + (NumBits() + 7) / 8; p != out;) {
+    *--p = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+void VarInt::SetFromBin(const uint8_t* data, size_t len, bool negative) {
+  while (len > 0 && *data == 0) {
+    ++data;
+    --len;
+  }
+  if (len > sizeof(SmallUInt) || (len == sizeof(SmallUInt) && (*data & 0x80))) {
+    impl_.reset(BN_bin2bn(data, len, nullptr /* ret */));
+    if (negative) {
+      BN_set_negative(impl_.get(), 1);
+    }
+    return;
+  }
+  SmallUInt value = 0;
+  for (auto end = data + len; data != end; ++data) {
+    value = (value << 8) | *data;
+  }
+  small_value_ = negative ? -static_cast<SmallInt>(value) : static_cast<SmallInt>(value);
+  impl_.reset();
+}
+
+const BIGNUM* VarInt::BigNum(BigNumPtr* holder) const {
+  if (impl_) {
+    return impl_.get();
+  }
+  uint8_t buffer[sizeof(SmallUInt)];
+  MagnitudeToBin(buffer);
+  holder->reset(BN_bin2bn(buffer, (NumBits() + 7) / 8, nullptr /* ret */));
+  if (small_value_ < 0) {
+    BN_set_negative(holder->get(), 1);
+  }
+  return holder->get();
+}
+
+void VarInt::ResetBigNum(BigNumPtr&& value) {
+  if (BN_num_bits(value.get()) > kMaxSmallBits) {
+    impl_ = std::move(value);
+    return;
+  }
+  uint8_t buffer[sizeof(SmallUInt)];
+  auto len = BN_bn2bin(value.get(), buffer);
+  SetFromBin(buffer, len, BN_is_negative(value.get()));
+}
+
 std::string VarInt::ToString() const {
-  char* temp = BN_bn2dec(impl_.get());
-  std::string result(temp);
-  OPENSSL_free(temp);
-  return result;
+  if (impl_) {
+    char* temp = BN_bn2dec(impl_.get());
+    std::string result(temp);
+    OPENSSL_free(temp);
+    return result;
+  }
+  // Enough for 39 digits of 2^127 and sign.
+  char buffer[40];
+  auto end = buffer + sizeof(buffer);
+  auto p = end;
+  auto value = SmallMagnitude();
+  do {
+    *--p = '0' + static_cast<char>(value % 10);
+    value /= 10;
+  } while (value);
+  if (small_value_ < 0) {
+    *--p = '-';
+  }
+  return std::string(p, end);
 }
 
 Result<int64_t> VarInt::ToInt64() const {
-  BN_ULONG value = BN_get_word(impl_.get());
-  bool negative = BN_is_negative(impl_.get());
-  // Casting minimal signed value to unsigned type of the same size returns its absolute value.
-  int64_t bound = negative ? std::numeric_limits<int64_t>::min()
-                           : std::numeric_limits<int64_t>::max();
-
-  if (value > bound) {
+  if (impl_ || small_value_ < std::numeric_limits<int64_t>::min() ||
+      small_value_ > std::numeric_limits<int64_t>::max()) {
     return STATUS_FORMAT(
         InvalidArgument, "VarInt $0 cannot be converted to int64 due to overflow", *this);
   }
-  return negative ? -value : value;
+  return static_cast<int64_t>(small_value_);
 }
 
 Status VarInt::FromString(const char* cstr) {
   if (*cstr == '+') {
     ++cstr;
   }
+  const char* digits = *cstr == '-' ? cstr + 1 : cstr;
+  size_t len = 0;
+  while (len <= kMaxSmallDecimalDigits && isdigit(digits[len])) {
+    ++len;
+  }
+  if (len != 0 && len <= kMaxSmallDecimalDigits && digits[len] == 0) {
+    SmallInt value = 0;
+    for (auto p = digits; p != digits + len; ++p) {
+      value = value * 10 + (*p - '0');
+    }
+    small_value_ = digits != cstr ? -value : value;
+    impl_.reset();
+    return Status::OK();
+  }
   BIGNUM* temp = nullptr;
   int parsed = BN_dec2bn(&temp, cstr);
-  impl_.reset(temp);
+  BigNumPtr value(temp);
   if (parsed == 0 || parsed != strlen(cstr)) {
+    small_value_ = 0;
+    impl_.reset();
     return STATUS_FORMAT(InvalidArgument, "Cannot parse varint: $0", cstr);
   }
+  ResetBigNum(std::move(value));
   return Status::OK();
 }
 
 int VarInt::CompareTo(const VarInt& other) const {
-  return BN_cmp(impl_.get(), other.impl_.get());
+  if (!impl_ && !other.impl_) {
+    return small_value_ < other.small_value_ ? -1 : small_value_ > other.small_value_ ? 1 : 0;
+  }
+  if (impl_ && other.impl_) {
+    return BN_cmp(impl_.get(), other.impl_.get());
+  }
+  // Value stored in BIGNUM always has larger magnitude than inline one.
+  if (impl_) {
+    return BN_is_negative(impl_.get()) ? -1 : 1;
+  }
+  return BN_is_negative(other.impl_.get()) ? 1 : -1;
 }
 
 template <class T>
@@ -93,12 +222,12 @@ std::string VarInt::EncodeToComparable(size_t num_reserved_bits) const {
   // to handle complex case when it wraps byte.
   DCHECK_LT(num_reserved_bits, 8);
 
-  if (BN_is_zero(impl_.get())) {
+  if (Sign() == 0) {
     // Zero is encoded as positive value of length 0.
     return std::string(1, 0x80 >> num_reserved_bits);
   }
 
-  auto num_bits = BN_num_bits(impl_.get());
+  auto num_bits = NumBits();
   // The minimal number of bits that is required to encode this number:
   // sign bit, bits in value representation and reserved bits.
   size_t total_num_bits = num_bits + 1 + num_reserved_bits;
@@ -120,7 +249,7 @@ std::string VarInt::EncodeToComparable(size_t num_reserved_bits) const {
     result[offset - 1] = 0;
   }
   auto data = pointer_cast<unsigned char*>(const_cast<char*>(result.data()));
-  BN_bn2bin(impl_.get(), data + offset);
+  MagnitudeToBin(data + offset);
   size_t idx = 0;
   // Fill header with ones. We also fill reserved bits with ones for simplicity, then it will be
   // reset to zero.
@@ -134,7 +263,7 @@ std::string VarInt::EncodeToComparable(size_t num_reserved_bits) const {
   // Merge last byte of header with possible first byte of number body.
   data[idx] |= 0xff ^ ((1 << (8 - num_ones)) - 1);
   // Negative number is inverted.
-  if (BN_is_negative(impl_.get())) {
+  if (IsNegative()) {
     FlipBits(data, result.size());
   }
   // Set reserved bits to 0.
@@ -154,16 +283,17 @@ Status VarInt::DecodeFromComparable(const Slice &slice, size_t *num_decoded_byte
     return STATUS(Corruption, "Cannot decode varint from empty slice");
   }
   bool negative = (slice[0] & (0x80 >> num_reserved_bits)) == 0;
-  std::vector<uint8_t> buffer(slice.data(), slice.end());
-  if (negative) {
-    FlipBits(buffer.data(), buffer.size());
-  }
-  if (num_reserved_bits) {
-    buffer[0] |= ~((1 << (8 - num_reserved_bits)) - 1);
-  }
+  // Bytes are decoded without copying the slice, header is parsed from the inverted bytes for
+  // negative numbers, and reserved bits are treated as ones.
+  const uint8_t flip_mask = negative ? 0xff : 0;
+  const uint8_t reserved_mask = num_reserved_bits ? ~((1 << (8 - num_reserved_bits)) - 1) : 0;
+  auto byte_at = [&slice, flip_mask, reserved_mask](size_t i) -> uint8_t {
+    uint8_t result = slice[i] ^ flip_mask;
+    return i == 0 ? result | reserved_mask : result;
+  };
   size_t idx = 0;
   size_t num_ones = 0;
-  while (buffer[idx] == 0xff) {
+  while (byte_at(idx) == 0xff) {
     ++idx;
     if (idx >= len) {
       return STATUS_FORMAT(
@@ -172,9 +302,10 @@ Status VarInt::DecodeFromComparable(const Slice &slice, size_t *num_decoded_byte
     }
     num_ones += 8;
   }
+  uint8_t first_byte = byte_at(idx);
   uint8_t temp = 0x80;
-  while (buffer[idx] & temp) {
-    buffer[idx] ^= temp;
+  while (first_byte & temp) {
+    first_byte ^= temp;
     ++num_ones;
     temp >>= 1;
   }
@@ -185,10 +316,20 @@ Status VarInt::DecodeFromComparable(const Slice &slice, size_t *num_decoded_byte
         slice.ToDebugHexString(), num_ones);
   }
   *num_decoded_bytes = num_ones;
-  impl_.reset(BN_bin2bn(buffer.data() + idx, num_ones - idx, nullptr /* ret */));
-  if (negative) {
-    BN_set_negative(impl_.get(), 1);
+
+  size_t body_len = num_ones - idx;
+  uint8_t small_buffer[sizeof(SmallUInt) + 1];
+  std::vector<uint8_t> big_buffer;
+  uint8_t* body = small_buffer;
+  if (body_len > sizeof(small_buffer)) {
+    big_buffer.resize(body_len);
+    body = big_buffer.data();
+  }
+  body[0] = first_byte;
+  for (size_t i = 1; i < body_len; ++i) {
+    body[i] = byte_at(idx + i);
   }
+  SetFromBin(body, body_len, negative);
 
   return Status::OK();
 }
@@ -203,10 +344,10 @@ Status VarInt::DecodeFromComparable(const string& str) {
 }
 
 std::string VarInt::EncodeToTwosComplement() const {
-  if (BN_is_zero(impl_.get())) {
+  if (Sign() == 0) {
     return std::string(1, 0);
   }
-  size_t num_bits = BN_num_bits(impl_.get());
+  size_t num_bits = NumBits();
   size_t offset = num_bits % kBitsPerWord == 0 ? 1 : 0;
   size_t count = (num_bits + kBitsPerWord - 1) / kBitsPerWord + offset;
   std::string result(count, 0);
@@ -214,8 +355,8 @@ std::string VarInt::EncodeToTwosComplement() const {
   if (offset) {
     *data = 0;
   }
-  BN_bn2bin(impl_.get(), data + offset);
-  if (BN_is_negative(impl_.get())) {
+  MagnitudeToBin(data + offset);
+  if (IsNegative()) {
     FlipBits(data, result.size());
     unsigned char* back = data + result.size();
     while (--back >= data && *back == 0xff) {
@@ -237,8 +378,7 @@ Status VarInt::DecodeFromTwosComplement(const std::string& input) {
   }
   bool negative = (input[0] & 0x80) != 0;
   if (!negative) {
-    impl_.reset(BN_bin2bn(
-        pointer_cast<const unsigned char*>(input.data()), input.size(), nullptr /* ret */));
+    SetFromBin(pointer_cast<const uint8_t*>(input.data()), input.size(), false /* negative */);
     return Status::OK();
   }
   std::string copy(input);
@@ -249,22 +389,25 @@ Status VarInt::DecodeFromTwosComplement(const std::string& input) {
   }
   --*back;
   FlipBits(data, copy.size());
-  impl_.reset(BN_bin2bn(data, input.size(), nullptr /* ret */));
-  BN_set_negative(impl_.get(), 1);
+  SetFromBin(data, copy.size(), true /* negative */);
 
   return Status::OK();
 }
 
 const VarInt& VarInt::Negate() {
-  BN_set_negative(impl_.get(), 1 - BN_is_negative(impl_.get()));
+  if (impl_) {
+    BN_set_negative(impl_.get(), 1 - BN_is_negative(impl_.get()));
+  } else {
+    small_value_ = -small_value_;
+  }
   return *this;
 }
 
 int VarInt::Sign() const {
-  if (BN_is_zero(impl_.get())) {
-    return 0;
+  if (impl_) {
+    return BN_is_negative(impl_.get()) ? -1 : 1;
   }
-  return BN_is_negative(impl_.get()) ? -1 : 1;
+  return small_value_ < 0 ? -1 : small_value_ > 0 ? 1 : 0;
 }
 
 std::ostream& operator<<(ostream& os, const VarInt& v) {
@@ -273,14 +416,28 @@ std::ostream& operator<<(ostream& os, const VarInt& v) {
 }
 
 VarInt operator+(const VarInt& lhs, const VarInt& rhs) {
+  VarInt result;
+  if (!lhs.impl_ && !rhs.impl_ &&
+      !__builtin_add_overflow(lhs.small_value_, rhs.small_value_, &result.small_value_) &&
+      IsValidSmallInt(result.small_value_)) {
+    return result;
+  }
+  BigNumPtr lhs_holder, rhs_holder;
   BigNumPtr temp(BN_new());
-  CHECK(BN_add(temp.get(), lhs.impl_.get(), rhs.impl_.get()));
+  CHECK(BN_add(temp.get(), lhs.BigNum(&lhs_holder), rhs.BigNum(&rhs_holder)));
   return VarInt(std::move(temp));
 }
 
 VarInt operator-(const VarInt& lhs, const VarInt& rhs) {
+  VarInt result;
+  if (!lhs.impl_ && !rhs.impl_ &&
+      !__builtin_sub_overflow(lhs.small_value_, rhs.small_value_, &result.small_value_) &&
+      IsValidSmallInt(result.small_value_)) {
+    return result;
+  }
+  BigNumPtr lhs_holder, rhs_holder;
   BigNumPtr temp(BN_new());
-  CHECK(BN_sub(temp.get(), lhs.impl_.get(), rhs.impl_.get()));
+  CHECK(BN_sub(temp.get(), lhs.BigNum(&lhs_holder), rhs.BigNum(&rhs_holder)));
   return VarInt(std::move(temp));
 }
 
@@ -41,6 +41,10 @@ typedef std::unique_ptr<BIGNUM, BigNumDeleter> BigNumPtr;
 // order.
 //
 // Two other ways to encode VarInt are also provided, which are used for Decimal encodings.
+//
+// Values whose magnitude fits into 127 bits are stored inline as a 128-bit integer, so the common
+// case of construction, arithmetic, comparison and encoding does not allocate. BIGNUM is only used
+// for larger values, i.e. when an operation overflows the inline representation.
 
 // For signed int this metafunction returns int64_t, for unsigned - uint64_t.
 template<class T>
@@ -200,8 +204,34 @@ class VarInt {
   int Sign() const;
 
  private:
-  explicit VarInt(BigNumPtr&& rhs) : impl_(std::move(rhs)) {}
+  typedef __int128 SmallInt;
+  typedef unsigned __int128 SmallUInt;
+
+  // Takes ownership of rhs, switching to the inline representation when the value fits it.
+  explicit VarInt(BigNumPtr&& rhs);
+
+  bool IsNegative() const;
+
+  // Absolute value of the inline representation.
+  SmallUInt SmallMagnitude() const;
+
+  // Number of significant bits in the absolute value.
+  size_t NumBits() const;
+
+  // Writes big-endian absolute value to out, using exactly (NumBits() + 7) / 8 bytes.
+  void MagnitudeToBin(uint8_t* out) const;
+
+  // Sets value from big-endian absolute value and sign.
+  void SetFromBin(const uint8_t* data, size_t len, bool negative);
+
+  // Returns BIGNUM with the same value. Uses holder for storage when value is stored inline.
+  const BIGNUM* BigNum(BigNumPtr* holder) const;
+
+  void ResetBigNum(BigNumPtr&& value);
 
+  // Valid when impl_ is null, in that case its absolute value is less than 2^127.
+  SmallInt small_value_ = 0;
+  // Non null only for values that do not fit into small_value_.
   BigNumPtr impl_;
 
   friend VarInt operator+(const VarInt& lhs, const VarInt& rhs);
@@ -24,6 +24,7 @@
 
 #include "yb/client/batcher.h"
 #include "yb/client/error.h"
+#include "yb/client/schema.h"
 #include "yb/client/session.h"
 #include "yb/client/table.h"
 #include "yb/client/table_alterer.h"
@@ -31,15 +32,19 @@
 #include "yb/client/transaction.h"
 #include "yb/client/yb_op.h"
 
+#include "yb/common/partition.h"
+#include "yb/common/pg_system_attr.h"
 #include "yb/common/pgsql_error.h"
 #include "yb/common/ql_expr.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/row_mark.h"
 #include "yb/common/transaction_error.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/primitive_value.h"
 
+#include "yb/tserver/tserver_service.proxy.h"
 #include "yb/tserver/tserver_shared_mem.h"
 
 #include "yb/util/logging.h"
@@ -96,10 +101,8 @@ static constexpr const char* const kPgSequenceDbOidColName = "db_oid";
 static constexpr const char* const kPgSequenceSeqOidColName = "seq_oid";
 
 static constexpr const char* const kPgSequenceLastValueColName = "last_value";
-static constexpr const size_t kPgSequenceLastValueColIdx = 2;
 
 static constexpr const char* const kPgSequenceIsCalledColName = "is_called";
-static constexpr const size_t kPgSequenceIsCalledColIdx = 3;
 
 string GetStatusStringSet(const client::CollectedErrors& errors) {
   std::set<string> status_strings;
@@ -604,6 +607,12 @@ Status PgSession::UpdateSequenceTuple(int64_t db_oid,
   if (skipped) {
     *skipped = psql_write->response().skipped();
   }
+
+  if (!expected_last_val) {
+    // Sequence value was set explicitly, so values cached by local tablet server are obsolete.
+    // Caches of other tablet servers are not affected, the same way as caches of other backends.
+    RETURN_NOT_OK(DiscardTServerSequenceCache(db_oid, seq_oid));
+  }
   return Status::OK();
 }
 
@@ -667,7 +676,8 @@ Status PgSession::DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   delete_request->add_partition_column_values()->mutable_value()->set_int64_value(db_oid);
   delete_request->add_partition_column_values()->mutable_value()->set_int64_value(seq_oid);
 
-  return session_->ApplyAndFlush(std::move(psql_delete));
+  RETURN_NOT_OK(session_->ApplyAndFlush(std::move(psql_delete)));
+  return DiscardTServerSequenceCache(db_oid, seq_oid);
 }
 
 Status PgSession::DeleteDBSequences(int64_t db_oid) {
@@ -690,6 +700,70 @@ Status PgSession::DeleteDBSequences(int64_t db_oid) {
   return session_->ApplyAndFlush(std::move(psql_delete));
 }
 
+tserver::TabletServerServiceProxy& PgSession::TabletServerProxy() {
+  if (!tablet_server_proxy_) {
+    tablet_server_proxy_ = std::make_unique<tserver::TabletServerServiceProxy>(
+        &client_->proxy_cache(), HostPort((**tserver_shared_object_).endpoint()));
+  }
+  return *tablet_server_proxy_;
+}
+
+Status PgSession::DiscardTServerSequenceCache(int64_t db_oid, int64_t seq_oid) {
+  if (!TServerSequenceCacheAvailable()) {
+    return Status::OK();
+  }
+  tserver::ReserveSequenceValuesRequestPB req;
+  tserver::ReserveSequenceValuesResponsePB resp;
+  req.set_db_oid(db_oid);
+  req.set_seq_oid(seq_oid);
+  req.set_discard_cached(true);
+  rpc::RpcController controller;
+  controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_pg_yb_session_timeout_ms));
+  return TabletServerProxy().ReserveSequenceValues(req, &resp, &controller);
+}
+
+bool PgSession::TServerSequenceCacheAvailable() const {
+  return FLAGS_ysql_sequence_cache_in_tserver && tserver_shared_object_;
+}
+
+Status PgSession::ReserveSequenceValues(int64_t db_oid,
+                                        int64_t seq_oid,
+                                        uint64_t ysql_catalog_version,
+                                        int64_t increment,
+                                        int64_t min_value,
+                                        int64_t max_value,
+                                        bool cycle,
+                                        int64_t count,
+                                        int64_t *first_val,
+                                        int64_t *last_val,
+                                        int64_t *num_vals) {
+  if (!TServerSequenceCacheAvailable()) {
+    return STATUS(IllegalState, "Sequence cache of local tablet server is not available");
+  }
+
+  tserver::ReserveSequenceValuesRequestPB req;
+  tserver::ReserveSequenceValuesResponsePB resp;
+  req.set_db_oid(db_oid);
+  req.set_seq_oid(seq_oid);
+  req.set_ysql_catalog_version(ysql_catalog_version);
+  req.set_increment(increment);
+  req.set_min_value(min_value);
+  req.set_max_value(max_value);
+  req.set_cycle(cycle);
+  req.set_count(count);
+  rpc::RpcController controller;
+  controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_pg_yb_session_timeout_ms));
+  RETURN_NOT_OK(TabletServerProxy().ReserveSequenceValues(req, &resp, &controller));
+  if (resp.has_error()) {
+    return StatusFromPB(resp.error().status());
+  }
+
+  *first_val = resp.first_value();
+  *last_val = resp.last_value();
+  *num_vals = resp.num_values();
+  return Status::OK();
+}
+
 //--------------------------------------------------------------------------------------------------
 
 unique_ptr<client::YBTableCreator> PgSession::NewTableCreator() {
@@ -726,7 +800,17 @@ Result<PgTableDesc::ScopedRefPtr> PgSession::LoadTable(const PgObjectId& table_i
   auto cached_yb_table = table_cache_.find(yb_table_id);
   if (cached_yb_table == table_cache_.end()) {
     VLOG(4) << "Table cache MISS: " << table_id;
-    Status s = client_->OpenTable(yb_table_id, &table);
+    Status s;
+    if (FLAGS_ysql_use_tserver_table_cache && tserver_shared_object_) {
+      auto result = LoadTableFromTServer(yb_table_id);
+      if (result.ok()) {
+        table = std::move(*result);
+      } else {
+        s = result.status();
+      }
+    } else {
+      s = client_->OpenTable(yb_table_id, &table);
+    }
     if (!s.ok()) {
       VLOG(3) << "LoadTable: Server returns an error: " << s;
       // TODO: NotFound might not always be the right status here.
@@ -744,9 +828,54 @@ Result<PgTableDesc::ScopedRefPtr> PgSession::LoadTable(const PgObjectId& table_i
   return make_scoped_refptr<PgTableDesc>(table);
 }
 
+Result<client::YBTablePtr> PgSession::LoadTableFromTServer(const TableId& yb_table_id) {
+  tserver::OpenPgTableRequestPB req;
+  tserver::OpenPgTableResponsePB resp;
+  req.set_table_id(yb_table_id);
+  req.set_ysql_catalog_version((**tserver_shared_object_).ysql_catalog_version());
+  rpc::RpcController controller;
+  controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_pg_yb_session_timeout_ms));
+  RETURN_NOT_OK(TabletServerProxy().OpenPgTable(req, &resp, &controller));
+  if (resp.has_error()) {
+    return StatusFromPB(resp.error().status());
+  }
+
+  client::YBTableInfo info;
+  info.table_name = YBTableName(
+      YQL_DATABASE_PGSQL, resp.namespace_id(), resp.namespace_name(), resp.table_name());
+  info.table_name.set_table_id(resp.table_id());
+  info.table_id = resp.table_id();
+  auto schema = std::make_unique<Schema>();
+  RETURN_NOT_OK(SchemaFromPB(resp.schema(), schema.get()));
+  info.schema.Reset(std::move(schema));
+  info.schema.set_version(resp.schema_version());
+  RETURN_NOT_OK(PartitionSchema::FromPB(
+      resp.partition_schema(), client::internal::GetSchema(info.schema), &info.partition_schema));
+  RETURN_NOT_OK(client::YBTable::PBToClientTableType(resp.table_type(), &info.table_type));
+  info.index_map.FromPB(resp.indexes());
+  if (resp.has_index_info()) {
+    info.index_info.emplace(resp.index_info());
+  }
+  info.colocated = resp.colocated();
+  return client_->OpenTable(
+      info, std::vector<std::string>(resp.partitions().begin(), resp.partitions().end()));
+}
+
 void PgSession::InvalidateTableCache(const PgObjectId& table_id) {
   const TableId yb_table_id = table_id.GetYBTableId();
   table_cache_.erase(yb_table_id);
+  if (FLAGS_ysql_use_tserver_table_cache && tserver_shared_object_) {
+    // Table was altered or dropped by this backend, so other backends should not get its old
+    // descriptor until catalog version bump reaches the tablet server.
+    tserver::OpenPgTableRequestPB req;
+    tserver::OpenPgTableResponsePB resp;
+    req.set_table_id(yb_table_id);
+    req.set_invalidate(true);
+    rpc::RpcController controller;
+    controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_pg_yb_session_timeout_ms));
+    WARN_NOT_OK(TabletServerProxy().OpenPgTable(req, &resp, &controller),
+                Format("Failed to invalidate cached table $0", table_id));
+  }
 }
 
 void PgSession::StartOperationsBuffering() {
@@ -870,11 +999,93 @@ Result<uint64_t> PgSession::GetSharedCatalogVersion() {
   }
 }
 
-bool PgSession::ForeignKeyReferenceExists(uint32_t table_id, std::string&& ybctid) {
-  PgForeignKeyReference reference = {table_id, std::move(ybctid)};
+Result<bool> PgSession::ForeignKeyReferenceExists(const PgObjectId& table_id,
+                                                  std::string&& ybctid) {
+  PgForeignKeyReference reference = {table_id.object_oid, std::move(ybctid)};
+  if (fk_reference_cache_.find(reference) != fk_reference_cache_.end()) {
+    return true;
+  }
+
+  // Read the requested reference together with other pending references to the same table.
+  std::vector<std::string> ybctids;
+  ybctids.push_back(reference.ybctid);
+  fk_reference_intent_.erase(reference);
+  const size_t max_batch_size = FLAGS_ysql_session_max_batch_size;
+  for (auto it = fk_reference_intent_.begin();
+       it != fk_reference_intent_.end() && ybctids.size() < max_batch_size;) {
+    if (it->table_id == table_id.object_oid) {
+      ybctids.push_back(it->ybctid);
+      it = fk_reference_intent_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  PgTableDesc::ScopedRefPtr desc = VERIFY_RESULT(LoadTable(table_id));
+  // One read operation per tablet, each one looks up all ybctids of its tablet.
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> partition_ops(desc->GetPartitionCount());
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> ops;
+  for (const auto& ybctid : ybctids) {
+    int partition = 0;
+    if (partition_ops.size() > 1) {
+      uint16 hash_code = VERIFY_RESULT(docdb::DocKey::DecodeHash(ybctid));
+      partition = desc->FindPartitionStartIndex(
+          PartitionSchema::EncodeMultiColumnHashValue(hash_code));
+      SCHECK(partition >= 0 && static_cast<size_t>(partition) < partition_ops.size(), InternalError,
+             "Ybctid value is not within partition boundary");
+    }
+    auto& op = partition_ops[partition];
+    if (!op) {
+      op.reset(desc->NewPgsqlSelect());
+      auto* req = op->mutable_request();
+      // Used by "client::yb_op" to set the hash code of the request.
+      req->mutable_ybctid_column_value()->mutable_value()->set_binary_value(ybctid);
+      req->add_targets()->set_column_id(static_cast<int>(PgSystemAttrNum::kYBTupleId));
+      // Same lock as taken by the "SELECT ... FOR KEY SHARE" of the regular check.
+      req->set_row_mark_type(RowMarkType::ROW_MARK_KEYSHARE);
+      // Absent rows are FK violations, that are reported by the regular check.
+      req->set_skip_missing_batch_arguments(true);
+      ops.push_back(op);
+    }
+    auto* batch_arg = op->mutable_request()->add_batch_arguments();
+    batch_arg->set_order(op->request().batch_arguments_size() - 1);
+    batch_arg->mutable_ybctid()->mutable_value()->set_binary_value(ybctid);
+  }
+
+  VLOG(2) << "Reading " << ybctids.size() << " foreign key references of table "
+          << table_id.ToString() << " with " << ops.size() << " operations";
+  auto run_result = VERIFY_RESULT(RunAsync(
+      ops, table_id, nullptr /* read_time */, true /* force_non_bufferable */));
+  if (run_result.InProgress()) {
+    RETURN_NOT_OK(run_result.GetStatus());
+  }
+  for (const auto& op : ops) {
+    RETURN_NOT_OK(HandleResponse(*op, table_id));
+    Slice cursor;
+    int64_t row_count = 0;
+    PgDocData::LoadCache(op->rows_data(), &row_count, &cursor);
+    for (int64_t i = 0; i < row_count; ++i) {
+      PgWireDataHeader header = PgDocData::ReadDataHeader(&cursor);
+      SCHECK(!header.is_null(), InternalError, "System column ybctid cannot be NULL");
+      int64_t data_size;
+      size_t read_size = PgDocData::ReadNumber(&cursor, &data_size);
+      cursor.remove_prefix(read_size);
+      fk_reference_cache_.emplace(
+          table_id.object_oid, std::string(cursor.cdata(), data_size));
+      cursor.remove_prefix(data_size);
+    }
+  }
+
   return fk_reference_cache_.find(reference) != fk_reference_cache_.end();
 }
 
+void PgSession::AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid) {
+  PgForeignKeyReference reference = {table_id, std::move(ybctid)};
+  if (fk_reference_cache_.find(reference) == fk_reference_cache_.end()) {
+    fk_reference_intent_.emplace(std::move(reference));
+  }
+}
+
 Status PgSession::CacheForeignKeyReference(uint32_t table_id, std::string&& ybctid) {
   PgForeignKeyReference reference = {table_id, std::move(ybctid)};
   fk_reference_cache_.emplace(reference);
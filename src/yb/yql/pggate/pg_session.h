@@ -33,6 +33,12 @@
 #include "yb/yql/pggate/pg_tabledesc.h"
 
 namespace yb {
+namespace tserver {
+
+class TabletServerServiceProxy;
+
+} // namespace tserver
+
 namespace pggate {
 
 YB_STRONGLY_TYPED_BOOL(OpBuffered);
@@ -166,6 +172,24 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   CHECKED_STATUS DeleteDBSequences(int64_t db_oid);
 
+  // Whether sequence values could be reserved from range cached by local tablet server.
+  bool TServerSequenceCacheAvailable() const;
+
+  // Reserves at most count values of sequence from range cached by local tablet server.
+  // Reserved values are first_val, first_val + increment, ..., last_val. Zero num_vals means that
+  // sequence reached its bound.
+  CHECKED_STATUS ReserveSequenceValues(int64_t db_oid,
+                                       int64_t seq_oid,
+                                       uint64_t ysql_catalog_version,
+                                       int64_t increment,
+                                       int64_t min_value,
+                                       int64_t max_value,
+                                       bool cycle,
+                                       int64_t count,
+                                       int64_t *first_val,
+                                       int64_t *last_val,
+                                       int64_t *num_vals);
+
   // API for schema operations.
   // TODO(neil) Schema should be a sub-database that have some specialized property.
   CHECKED_STATUS CreateSchema(const std::string& schema_name, bool if_not_exist);
@@ -251,6 +275,7 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   void InvalidateForeignKeyReferenceCache() {
     fk_reference_cache_.clear();
+    fk_reference_intent_.clear();
   }
 
   // Check if initdb has already been run before. Needed to make initdb idempotent.
@@ -260,9 +285,13 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // the shared memory has not been initialized (e.g. in initdb).
   Result<uint64_t> GetSharedCatalogVersion();
 
-  // Returns true if the row referenced by ybctid exists in FK reference cache (Used for caching
-  // foreign key checks).
-  bool ForeignKeyReferenceExists(uint32_t table_id, std::string&& ybctid);
+  // Returns true if the row referenced by ybctid exists (Used for caching foreign key checks).
+  // When the row is not in FK reference cache, it is read from the table together with up to
+  // ysql_session_max_batch_size pending intents for the same table, using one read per tablet.
+  Result<bool> ForeignKeyReferenceExists(const PgObjectId& table_id, std::string&& ybctid);
+
+  // Adds intent to check the row referenced by ybctid, so it is read in batch with other rows.
+  void AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid);
 
   // Adds the row referenced by ybctid to FK reference cache.
   CHECKED_STATUS CacheForeignKeyReference(uint32_t table_id, std::string&& ybctid);
@@ -279,6 +308,15 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   CHECKED_STATUS FlushBufferedOperationsImpl();
   CHECKED_STATUS FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional);
 
+  tserver::TabletServerServiceProxy& TabletServerProxy();
+
+  // Loads table descriptor from table cache of local tablet server.
+  Result<client::YBTablePtr> LoadTableFromTServer(const TableId& yb_table_id);
+
+  // Drops range of sequence values cached by local tablet server, if any.
+  // Ranges cached by other tablet servers are not affected, see ysql_sequence_cache_in_tserver.
+  CHECKED_STATUS DiscardTServerSequenceCache(int64_t db_oid, int64_t seq_oid);
+
   // Helper class to run multiple operations on single session.
   // This class allows to keep implementation of RunAsync template method simple
   // without moving its implementation details into header file.
@@ -351,6 +389,8 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   std::unordered_map<TableId, std::shared_ptr<client::YBTable>> table_cache_;
   std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>> fk_reference_cache_;
+  // References that will be checked later, i.e. queued FK check triggers of current statement.
+  std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>> fk_reference_intent_;
 
   // Should write operations be buffered?
   bool buffering_enabled_ = false;
@@ -360,6 +400,9 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   const tserver::TServerSharedObject* const tserver_shared_object_;
   const YBCPgCallbacks& pg_callbacks_;
+
+  // Proxy to local tablet server, created on first use.
+  std::unique_ptr<tserver::TabletServerServiceProxy> tablet_server_proxy_;
 };
 
 }  // namespace pggate
@@ -36,6 +36,8 @@
 
 #include "yb/tserver/tserver_shared_mem.h"
 
+#include "yb/util/shared_mem_exchange.h"
+
 DECLARE_string(rpc_bind_addresses);
 DECLARE_bool(use_node_to_node_encryption);
 DECLARE_string(certs_dir);
@@ -86,6 +88,16 @@ std::unique_ptr<tserver::TServerSharedObject> InitTServerSharedObject() {
       tserver::TServerSharedObject::OpenReadOnly(FLAGS_pggate_tserver_shm_fd)));
 }
 
+std::unique_ptr<tserver::TServerSharedExchange> InitTServerSharedExchange() {
+  if (YBCIsInitDbModeEnvVarSet() || FLAGS_pggate_ignore_tserver_shm ||
+      FLAGS_pggate_tserver_shm_exchange_fd == -1) {
+    return nullptr;
+  }
+  // Clients write requests to the exchange, so it is opened in read-write mode.
+  return std::make_unique<tserver::TServerSharedExchange>(CHECK_RESULT(
+      tserver::TServerSharedExchange::OpenReadWrite(FLAGS_pggate_tserver_shm_exchange_fd)));
+}
+
 } // namespace
 
 using std::make_shared;
@@ -137,6 +149,7 @@ PgApiImpl::PgApiImpl(const YBCPgTypeEntity *YBCDataTypeArray, int count, YBCPgCa
                          messenger_holder_.messenger.get()),
       clock_(new server::HybridClock()),
       tserver_shared_object_(InitTServerSharedObject()),
+      tserver_shared_exchange_(InitTServerSharedExchange()),
       pg_txn_manager_(new PgTxnManager(&async_client_init_, clock_, tserver_shared_object_.get())),
       pg_callbacks_(callbacks) {
   CHECK_OK(clock_->Init());
@@ -151,6 +164,9 @@ PgApiImpl::PgApiImpl(const YBCPgTypeEntity *YBCDataTypeArray, int count, YBCPgCa
 }
 
 PgApiImpl::~PgApiImpl() {
+  if (shared_exchange_client_) {
+    shared_exchange_client_->Shutdown();
+  }
   messenger_holder_.messenger->Shutdown();
   async_client_init_.client()->Shutdown();
 }
@@ -180,6 +196,12 @@ Status PgApiImpl::DestroyEnv(PgEnv *pg_env) {
 Status PgApiImpl::InitSession(const PgEnv *pg_env,
                               const string& database_name) {
   CHECK(!pg_session_);
+  if (tserver_shared_exchange_ && !shared_exchange_client_) {
+    shared_exchange_client_ = std::make_unique<SharedExchangeClient>(
+        tserver_shared_exchange_->get());
+    RETURN_NOT_OK(shared_exchange_client_->Start());
+    client()->SetSharedExchange(shared_exchange_client_.get());
+  }
   auto session = make_scoped_refptr<PgSession>(client(),
                                                database_name,
                                                pg_txn_manager_,
@@ -250,6 +272,26 @@ Status PgApiImpl::DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return pg_session_->DeleteSequenceTuple(db_oid, seq_oid);
 }
 
+bool PgApiImpl::IsTServerSequenceCacheEnabled() {
+  return pg_session_->TServerSequenceCacheAvailable();
+}
+
+Status PgApiImpl::ReserveSequenceValues(int64_t db_oid,
+                                        int64_t seq_oid,
+                                        uint64_t ysql_catalog_version,
+                                        int64_t increment,
+                                        int64_t min_value,
+                                        int64_t max_value,
+                                        bool cycle,
+                                        int64_t count,
+                                        int64_t *first_val,
+                                        int64_t *last_val,
+                                        int64_t *num_vals) {
+  return pg_session_->ReserveSequenceValues(
+      db_oid, seq_oid, ysql_catalog_version, increment, min_value, max_value, cycle, count,
+      first_val, last_val, num_vals);
+}
+
 
 //--------------------------------------------------------------------------------------------------
 
@@ -973,10 +1015,15 @@ Status PgApiImpl::ExitSeparateDdlTxnMode(bool success) {
   return pg_txn_manager_->ExitSeparateDdlTxnMode(success);
 }
 
-bool PgApiImpl::ForeignKeyReferenceExists(YBCPgOid table_id, std::string&& ybctid) {
+Result<bool> PgApiImpl::ForeignKeyReferenceExists(const PgObjectId& table_id,
+                                                  std::string&& ybctid) {
   return pg_session_->ForeignKeyReferenceExists(table_id, std::move(ybctid));
 }
 
+void PgApiImpl::AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid) {
+  pg_session_->AddForeignKeyReferenceIntent(table_id, std::move(ybctid));
+}
+
 Status PgApiImpl::CacheForeignKeyReference(YBCPgOid table_id, std::string&& ybctid) {
   return pg_session_->CacheForeignKeyReference(table_id, std::move(ybctid));
 }
@@ -41,6 +41,9 @@
 #include "yb/server/hybrid_clock.h"
 
 namespace yb {
+
+class SharedExchangeClient;
+
 namespace pggate {
 
 //--------------------------------------------------------------------------------------------------
@@ -115,6 +118,20 @@ class PgApiImpl {
 
   CHECKED_STATUS DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
+  bool IsTServerSequenceCacheEnabled();
+
+  CHECKED_STATUS ReserveSequenceValues(int64_t db_oid,
+                                       int64_t seq_oid,
+                                       uint64_t ysql_catalog_version,
+                                       int64_t increment,
+                                       int64_t min_value,
+                                       int64_t max_value,
+                                       bool cycle,
+                                       int64_t count,
+                                       int64_t *first_val,
+                                       int64_t *last_val,
+                                       int64_t *num_vals);
+
   // Delete statement.
   CHECKED_STATUS DeleteStatement(PgStatement *handle);
 
@@ -409,7 +426,8 @@ class PgApiImpl {
   CHECKED_STATUS OperatorAppendArg(PgExpr *op_handle, PgExpr *arg);
 
   // Foreign key reference caching.
-  bool ForeignKeyReferenceExists(YBCPgOid table_id, std::string&& ybctid);
+  Result<bool> ForeignKeyReferenceExists(const PgObjectId& table_id, std::string&& ybctid);
+  void AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS CacheForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS DeleteForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
   void ClearForeignKeyReferenceCache();
@@ -444,6 +462,12 @@ class PgApiImpl {
   // Local tablet-server shared memory segment handle.
   std::unique_ptr<tserver::TServerSharedObject> tserver_shared_object_;
 
+  // Local tablet-server shared memory exchange, used to send requests to tablets led locally.
+  std::unique_ptr<tserver::TServerSharedExchange> tserver_shared_exchange_;
+
+  // Receives responses to requests sent via tserver_shared_exchange_.
+  std::unique_ptr<SharedExchangeClient> shared_exchange_client_;
+
   scoped_refptr<PgTxnManager> pg_txn_manager_;
 
   // Mapping table of YugaByte and PostgreSQL datatypes.
@@ -42,6 +42,10 @@ DEFINE_string(pggate_master_addresses, "",
 DEFINE_int32(pggate_tserver_shm_fd, -1,
               "File descriptor of the local tablet server's shared memory.");
 
+DEFINE_int32(pggate_tserver_shm_exchange_fd, -1,
+             "File descriptor of the local tablet server's shared memory exchange, used to send "
+             "read and write requests to tablets led by the local tablet server.");
+
 DEFINE_test_flag(bool, pggate_ignore_tserver_shm, false,
               "Ignore the shared memory of the local tablet server.");
 
@@ -98,6 +102,18 @@ DEFINE_bool(ysql_serializable_isolation_for_ddl_txn, false,
             "By default, repeatable read isolation is used. "
             "This flag should go away once full transactional DDL is implemented.");
 
+// Known limitation: setval discards only the range cached by the local tablet server. Other tablet
+// servers keep handing out values from their ranges until those are exhausted, the same way as
+// setval does not affect values already cached by other postgres backends.
+DEFINE_bool(ysql_sequence_cache_in_tserver, false,
+            "Whether postgres backends obtain sequence values from range cached by local tablet "
+            "server, instead of updating the sequences data table on each cache miss. "
+            "setval does not affect ranges already cached by other tablet servers.");
+
+DEFINE_bool(ysql_use_tserver_table_cache, false,
+            "Whether postgres backends load table descriptors from cache shared by all backends "
+            "of local tablet server, instead of loading them from master.");
+
 DEFINE_int32(ysql_select_parallelism, -1,
             "Number of read requests to issue in parallel to tablets of a table "
             "for SELECT.");
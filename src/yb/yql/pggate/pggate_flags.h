@@ -22,6 +22,7 @@ DECLARE_int32(pggate_ybclient_reactor_threads);
 DECLARE_string(pggate_proxy_bind_address);
 DECLARE_string(pggate_master_addresses);
 DECLARE_int32(pggate_tserver_shm_fd);
+DECLARE_int32(pggate_tserver_shm_exchange_fd);
 DECLARE_bool(pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_request_limit);
 DECLARE_int32(ysql_prefetch_limit);
@@ -41,5 +42,7 @@ DECLARE_bool(ysql_beta_feature_roles);
 DECLARE_bool(ysql_beta_feature_extension);
 DECLARE_bool(ysql_enable_manual_sys_table_txn_ctl);
 DECLARE_bool(ysql_serializable_isolation_for_ddl_txn);
+DECLARE_bool(ysql_sequence_cache_in_tserver);
+DECLARE_bool(ysql_use_tserver_table_cache);
 
 #endif  // YB_YQL_PGGATE_PGGATE_FLAGS_H
@@ -240,6 +240,26 @@ YBCStatus YBCDeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return ToYBCStatus(pgapi->DeleteSequenceTuple(db_oid, seq_oid));
 }
 
+bool YBCIsTServerSequenceCacheEnabled() {
+  return pgapi->IsTServerSequenceCacheEnabled();
+}
+
+YBCStatus YBCReserveSequenceValues(int64_t db_oid,
+                                   int64_t seq_oid,
+                                   uint64_t ysql_catalog_version,
+                                   int64_t increment,
+                                   int64_t min_value,
+                                   int64_t max_value,
+                                   bool cycle,
+                                   int64_t count,
+                                   int64_t *first_val,
+                                   int64_t *last_val,
+                                   int64_t *num_vals) {
+  return ToYBCStatus(pgapi->ReserveSequenceValues(
+      db_oid, seq_oid, ysql_catalog_version, increment, min_value, max_value, cycle, count,
+      first_val, last_val, num_vals));
+}
+
 // Table Operations -------------------------------------------------------------------------------
 
 YBCStatus YBCPgNewCreateTable(const char *database_name,
@@ -645,8 +665,17 @@ YBCStatus YBCPgExitSeparateDdlTxnMode(bool success) {
 }
 
 // Referential Integrity Caching
-bool YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
-  return pgapi->ForeignKeyReferenceExists(table_id, std::string(ybctid, ybctid_size));
+YBCStatus YBCForeignKeyReferenceExists(YBCPgOid database_oid,
+                                       YBCPgOid table_id,
+                                       const char* ybctid,
+                                       int64_t ybctid_size,
+                                       bool* res) {
+  return ExtractValueFromResult(pgapi->ForeignKeyReferenceExists(
+      PgObjectId(database_oid, table_id), std::string(ybctid, ybctid_size)), res);
+}
+
+void YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
+  pgapi->AddForeignKeyReferenceIntent(table_id, std::string(ybctid, ybctid_size));
 }
 
 YBCStatus YBCCacheForeignKeyReference(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
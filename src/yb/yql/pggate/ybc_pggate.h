@@ -96,6 +96,24 @@ YBCStatus YBCReadSequenceTuple(int64_t db_oid,
 
 YBCStatus YBCDeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
+// Whether sequence values should be reserved from range cached by local tablet server.
+bool YBCIsTServerSequenceCacheEnabled();
+
+// Reserves at most count values of sequence from range cached by local tablet server.
+// Reserved values are first_val, first_val + increment, ..., last_val. Zero num_vals means that
+// sequence reached its bound.
+YBCStatus YBCReserveSequenceValues(int64_t db_oid,
+                                   int64_t seq_oid,
+                                   uint64_t ysql_catalog_version,
+                                   int64_t increment,
+                                   int64_t min_value,
+                                   int64_t max_value,
+                                   bool cycle,
+                                   int64_t count,
+                                   int64_t *first_val,
+                                   int64_t *last_val,
+                                   int64_t *num_vals);
+
 // Create database.
 YBCStatus YBCPgNewCreateDatabase(const char *database_name,
                                  YBCPgOid database_oid,
@@ -389,8 +407,16 @@ YBCStatus YBCPgNewOperator(YBCPgStatement stmt, const char *opname,
 YBCStatus YBCPgOperatorAppendArg(YBCPgExpr op_handle, YBCPgExpr arg);
 
 // Referential Integrity Check Caching.
-// Check if foreign key reference exists in cache.
-bool YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
+// Check if foreign key reference exists. The reference is read from the referenced table (together
+// with the pending intents for the same table) when it is not in cache yet.
+YBCStatus YBCForeignKeyReferenceExists(YBCPgOid database_oid,
+                                       YBCPgOid table_id,
+                                       const char* ybctid,
+                                       int64_t ybctid_size,
+                                       bool* res);
+
+// Add an intent to check foreign key reference, so it is read in batch with other intents.
+void YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
 
 // Add an entry to foreign key reference cache.
 YBCStatus YBCCacheForeignKeyReference(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
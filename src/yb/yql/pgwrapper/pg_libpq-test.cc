@@ -1110,5 +1110,111 @@ TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(NumberOfInitialRpcs)) {
   ASSERT_LT(rpcs_during, 150);
 }
 
+class PgLibPqTServerSequenceCacheTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_sequence_cache_in_tserver=true");
+    options->extra_tserver_flags.push_back("--ysql_sequence_cache_reservation_size=100");
+  }
+};
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(TServerSequenceCache),
+          PgLibPqTServerSequenceCacheTest) {
+  constexpr int kThreads = 4;
+  constexpr int kValuesPerThread = 250;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE SEQUENCE s"));
+
+  TestThreadHolder holder;
+  std::mutex mutex;
+  std::set<int64_t> values;
+  for (int i = 0; i != kThreads; ++i) {
+    holder.AddThread([this, &mutex, &values] {
+      auto conn = ASSERT_RESULT(Connect());
+      for (int j = 0; j != kValuesPerThread; ++j) {
+        auto value = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT nextval('s')"));
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_TRUE(values.insert(value).second) << "Duplicate value: " << value;
+      }
+    });
+  }
+  holder.WaitAndStop(60s);
+
+  // All values were reserved from the same tablet server, so there should be no gaps.
+  ASSERT_EQ(values.size(), static_cast<size_t>(kThreads * kValuesPerThread));
+  ASSERT_EQ(*values.begin(), 1);
+  ASSERT_EQ(*values.rbegin(), kThreads * kValuesPerThread);
+
+  // Explicitly set value should be visible to the next nextval.
+  ASSERT_OK(conn.Execute("SELECT setval('s', 10000)"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT nextval('s')")), 10001);
+
+  ASSERT_OK(conn.Execute("CREATE SEQUENCE bounded MAXVALUE 3"));
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT nextval('bounded')")), i);
+  }
+  auto result = conn.FetchValue<int64_t>("SELECT nextval('bounded')");
+  ASSERT_NOK(result);
+  ASSERT_STR_CONTAINS(result.status().ToString(), "reached maximum value");
+}
+
+class PgLibPqTServerTableCacheTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_use_tserver_table_cache=true");
+  }
+};
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(TServerTableCache),
+          PgLibPqTServerTableCacheTest) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn1.Execute("CREATE TABLE t (a INT PRIMARY KEY, b INT)"));
+  ASSERT_OK(conn1.Execute("INSERT INTO t (a, b) VALUES (1, 1)"));
+
+  auto conn2 = ASSERT_RESULT(Connect());
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int32_t>("SELECT b FROM t WHERE a = 1")), 1);
+
+  // Descriptor cached by tablet server should be dropped after table was altered.
+  ASSERT_OK(conn1.Execute("ALTER TABLE t ADD COLUMN c INT"));
+  auto conn3 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn3.Execute("INSERT INTO t (a, b, c) VALUES (2, 2, 2)"));
+  ASSERT_EQ(ASSERT_RESULT(conn1.FetchValue<int32_t>("SELECT c FROM t WHERE a = 2")), 2);
+
+  ASSERT_OK(conn1.Execute("DROP TABLE t"));
+  ASSERT_OK(conn1.Execute("CREATE TABLE t (a INT PRIMARY KEY, d TEXT)"));
+  auto conn4 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn4.Execute("INSERT INTO t (a, d) VALUES (1, 'value')"));
+  ASSERT_EQ(ASSERT_RESULT(conn1.FetchValue<std::string>("SELECT d FROM t WHERE a = 1")), "value");
+}
+
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(BatchedForeignKeyCheck)) {
+  constexpr int kRows = 500;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE parent (k INT PRIMARY KEY, v INT UNIQUE)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO parent SELECT i, i FROM generate_series(1, $0) AS i", kRows));
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE child (k INT PRIMARY KEY, pk INT REFERENCES parent (k), "
+      "pv INT REFERENCES parent (v))"));
+
+  // References of all rows are checked with batched reads.
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, i, $0 + 1 - i FROM generate_series(1, $0) AS i", kRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM child")), kRows);
+
+  // A single missing reference fails the whole statement.
+  auto status = conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, i - $0, 1 FROM generate_series($0 + 1, $0 + $0 + 1) AS i",
+      kRows);
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "violates foreign key constraint");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM child")), kRows);
+
+  // References cached within a transaction are not used after parent row is deleted.
+  ASSERT_OK(conn.Execute("DELETE FROM child WHERE pk = 1 OR pv = 1"));
+  ASSERT_OK(conn.Execute("DELETE FROM parent WHERE k = 1"));
+  ASSERT_NOK(conn.Execute("INSERT INTO child VALUES (-1, 1, 2)"));
+}
+
 } // namespace pgwrapper
 } // namespace yb
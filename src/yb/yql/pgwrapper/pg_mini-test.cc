@@ -85,6 +85,7 @@ class PgMiniTest : public YBMiniClusterTestBase<MiniCluster> {
         pg_ts->options()->fs_opts.data_paths.front() + "/pg_data",
         pg_ts->server()->GetSharedMemoryFd()));
     pg_process_conf.master_addresses = pg_ts->options()->master_addresses_flag;
+    pg_process_conf.tserver_shm_exchange_fd = pg_ts->server()->GetSharedExchangeFd();
     pg_process_conf.force_disable_log_file = true;
 
     LOG(INFO) << "Starting PostgreSQL server listening on "
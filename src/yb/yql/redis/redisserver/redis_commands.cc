@@ -71,7 +71,7 @@ namespace redisserver {
 
 #define REDIS_COMMANDS \
     ((get, Get, 2, READ)) \
-    ((mget, MGet, -2, READ)) \
+    ((mget, MGet, -2, LOCAL)) \
     ((hget, HGet, 3, READ)) \
     ((tsget, TsGet, 3, READ)) \
     ((hmget, HMGet, -3, READ)) \
@@ -90,7 +90,7 @@ namespace redisserver {
     ((zcard, ZCard, 2, READ)) \
     ((rename, Rename, 3, LOCAL)) \
     ((set, Set, -3, WRITE)) \
-    ((mset, MSet, -3, WRITE)) \
+    ((mset, MSet, -3, LOCAL)) \
     ((hset, HSet, 4, WRITE)) \
     ((hmset, HMSet, -4, WRITE)) \
     ((hincrby, HIncrBy, 4, WRITE)) \
@@ -652,6 +652,7 @@ class RenameData : public std::enable_shared_from_this<RenameData> {
   std::shared_ptr<client::YBRedisWriteOp> write_dest_ttl_op_;
   std::shared_ptr<client::YBRedisWriteOp> delete_src_op_;
   std::atomic_int num_tablets_{0};
+  bool src_deleted_ = false;
 
   client::YBSession* session_;
   StatusFunctor src_functor_, dest_functor_;
@@ -819,6 +820,17 @@ class RenameData : public std::enable_shared_from_this<RenameData> {
       RespondWithError("Could not apply deleteOps/write_dest_op_.");
       return;
     }
+    // When source and destination belong to the same tablet, e.g. share the same {tag}, source
+    // is deleted in the same write request. So destination is overwritten and source is deleted
+    // atomically, in a single Raft round.
+    if (num_tablets_.load(std::memory_order_acquire) == 1) {
+      auto status = session_->Apply(delete_src_op_);
+      if (!status.ok()) {
+        RespondWithError("Could not apply delete_src_op_.");
+        return;
+      }
+      src_deleted_ = true;
+    }
     session_->FlushAsync([retained_self = shared_from_this()](const Status& s) {
       if (!s.ok()) {
         LOG(ERROR) << "Writing to dest during a Rename failed. " << s;
@@ -854,6 +866,11 @@ class RenameData : public std::enable_shared_from_this<RenameData> {
 
   void BeginDeleteSrc() {
     VLOG(1) << "4. BeginDeleteSrc";
+    if (src_deleted_) {
+      RedisResponsePB response;
+      Respond(&response);
+      return;
+    }
     auto status = session_->Apply(delete_src_op_);
     if (!status.ok()) {
       RespondWithError("Could not apply delete_src_op_.");
@@ -877,6 +894,150 @@ void HandleRename(LocalCommandData data) {
   rename_data->Execute();
 }
 
+// Command that operates on several keys, all of which should belong to the same hash slot, like in
+// Redis Cluster. Keys that share the same {tag} belong to the same slot, so all operations of the
+// command are sent to one tablet in a single request. Such request is applied as one DocWriteBatch
+// in a single Raft round, i.e. the command is atomic and takes one round trip.
+class MultiKeyCommand : public std::enable_shared_from_this<MultiKeyCommand> {
+ public:
+  typedef std::function<void(RedisResponsePB*)> ResponseBuilder;
+
+  explicit MultiKeyCommand(const LocalCommandData& data) : data_(data) {}
+
+  void AddOperation(std::shared_ptr<client::YBRedisOp> op) {
+    ops_.push_back(std::move(op));
+  }
+
+  // Executes added operations, response_builder is invoked to fill response once they are done.
+  void Execute(ResponseBuilder response_builder) {
+    response_builder_ = std::move(response_builder);
+    if (!data_.table()) {
+      RespondWithError("Table is not open");
+      return;
+    }
+    std::string partition_key;
+    for (size_t i = 0; i != ops_.size(); ++i) {
+      std::string op_partition_key;
+      auto status = ops_[i]->GetPartitionKey(&op_partition_key);
+      if (!status.ok()) {
+        RespondWithError(status.message().ToBuffer());
+        return;
+      }
+      if (i == 0) {
+        partition_key = std::move(op_partition_key);
+      } else if (op_partition_key != partition_key) {
+        RespondWithError("CROSSSLOT Keys in request don't hash to the same slot");
+        return;
+      }
+    }
+    data_.Apply(
+        std::bind(&MultiKeyCommand::Store, shared_from_this(), _1, _2), partition_key,
+        ManualResponse::kTrue);
+  }
+
+ private:
+  bool Store(client::YBSession* session, const StatusFunctor& callback) {
+    callback_ = callback;
+    for (const auto& op : ops_) {
+      auto status = session->Apply(op);
+      if (!status.ok()) {
+        Processed(status);
+        return true;
+      }
+    }
+    session->FlushAsync([retained_self = shared_from_this()](const Status& status) {
+      retained_self->Processed(status);
+    });
+    return true;
+  }
+
+  void Processed(const Status& status) {
+    if (!status.ok()) {
+      LOG(ERROR) << "Executing " << data_.arg(0).ToBuffer() << " failed: " << status;
+      RespondWithError(status.message().ToBuffer());
+      return;
+    }
+    RedisResponsePB response;
+    response.set_code(RedisResponsePB::OK);
+    response_builder_(&response);
+    Respond(&response);
+  }
+
+  void RespondWithError(const string& msg) {
+    RedisResponsePB response;
+    response.set_code(RedisResponsePB_RedisStatusCode_SERVER_ERROR);
+    response.set_error_message(msg);
+    Respond(&response);
+  }
+
+  void Respond(RedisResponsePB* response) {
+    data_.Respond(response);
+    if (callback_) {
+      callback_(Status::OK());
+    }
+  }
+
+  LocalCommandData data_;
+  std::vector<std::shared_ptr<client::YBRedisOp>> ops_;
+  ResponseBuilder response_builder_;
+  StatusFunctor callback_;
+};
+
+void HandleMSet(LocalCommandData data) {
+  if (data.arg_size() % 2 == 0) {
+    RedisResponsePB response;
+    response.set_code(RedisResponsePB_RedisStatusCode_SERVER_ERROR);
+    response.set_error_message("ERR: Wrong number of arguments.");
+    data.Respond(&response);
+    return;
+  }
+
+  auto command = std::make_shared<MultiKeyCommand>(data);
+  auto table = data.context()->table();
+  for (size_t i = 1; i < data.arg_size(); i += 2) {
+    const auto& key = data.arg(i);
+    const auto& value = data.arg(i + 1);
+    auto op = std::make_shared<client::YBRedisWriteOp>(table);
+    op->mutable_request()->mutable_set_request();
+    auto key_value = op->mutable_request()->mutable_key_value();
+    key_value->set_key(key.cdata(), key.size());
+    key_value->add_value(value.cdata(), value.size());
+    key_value->set_type(REDIS_TYPE_STRING);
+    command->AddOperation(std::move(op));
+  }
+  command->Execute([](RedisResponsePB* response) {
+    response->set_status_response("OK");
+  });
+}
+
+void HandleMGet(LocalCommandData data) {
+  auto command = std::make_shared<MultiKeyCommand>(data);
+  auto table = data.context()->table();
+  std::vector<std::shared_ptr<client::YBRedisReadOp>> ops;
+  for (size_t i = 1; i < data.arg_size(); ++i) {
+    const auto& key = data.arg(i);
+    auto op = std::make_shared<client::YBRedisReadOp>(table);
+    op->mutable_request()->mutable_get_request()->set_request_type(RedisGetRequestPB::GET);
+    op->mutable_request()->mutable_key_value()->set_key(key.cdata(), key.size());
+    ops.push_back(op);
+    command->AddOperation(std::move(op));
+  }
+  command->Execute([ops = std::move(ops)](RedisResponsePB* response) {
+    auto array_response = response->mutable_array_response();
+    for (const auto& op : ops) {
+      // Like in Redis, missing keys and keys that do not hold a string are returned as nil.
+      const auto& op_response = op->response();
+      if (op_response.code() == RedisResponsePB::OK && op_response.has_string_response()) {
+        AddElements(redisserver::EncodeAsBulkString(op_response.string_response()),
+                    array_response);
+      } else {
+        array_response->add_elements(kNilResponse);
+      }
+    }
+    array_response->set_encoded(true);
+  });
+}
+
 class KeysProcessor : public std::enable_shared_from_this<KeysProcessor> {
  public:
   explicit KeysProcessor(const LocalCommandData& data)
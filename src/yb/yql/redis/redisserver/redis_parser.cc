@@ -166,15 +166,6 @@ CHECKED_STATUS ParseSetNX(YBRedisWriteOp *op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
-// TODO: support MSET
-CHECKED_STATUS ParseMSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
-  if (args.size() < 3 || args.size() % 2 == 0) {
-    return STATUS_SUBSTITUTE(InvalidCommand,
-        "An MSET request must have at least 3, odd number of arguments, found $0", args.size());
-  }
-  return STATUS(InvalidCommand, "MSET command not yet supported");
-}
-
 CHECKED_STATUS ParseHSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
   const auto& key = args[1];
   const auto& subkey = args[2];
@@ -532,11 +523,6 @@ CHECKED_STATUS ParseHGetLikeCommands(YBRedisReadOp* op, const RedisClientCommand
   return ParseCollection(op, args, boost::none, add_string_subkey, remove_duplicates);
 }
 
-// TODO: Support MGET
-CHECKED_STATUS ParseMGet(YBRedisReadOp* op, const RedisClientCommand& args) {
-  return STATUS(InvalidCommand, "MGET command not yet supported");
-}
-
 CHECKED_STATUS ParseHGet(YBRedisReadOp* op, const RedisClientCommand& args) {
   return ParseHGetLikeCommands(op, args, RedisGetRequestPB_GetRequestType_HGET);
 }
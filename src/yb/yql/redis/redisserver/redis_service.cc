@@ -411,7 +411,7 @@ class Block : public std::enable_shared_from_this<Block> {
       if (applied_operations) {
         // Allow local calls in this thread only if no one is waiting behind us.
         session_->set_allow_local_calls_in_curr_thread(
-            allow_local_calls_in_curr_thread && this->next_ == nullptr);
+            allow_local_calls_in_curr_thread && next_.empty());
         session_->FlushAsync(std::move(callback));
       }
     } else {
@@ -419,10 +419,11 @@ class Block : public std::enable_shared_from_this<Block> {
     }
   }
 
-  BlockPtr SetNext(const BlockPtr& next) {
-    BlockPtr result = std::move(next_);
-    next_ = next;
-    return result;
+  // Makes next to be launched after this block, and after all other its predecessors, are
+  // processed.
+  void AddNext(const BlockPtr& next) {
+    next_.push_back(next);
+    next->predecessors_.fetch_add(1, std::memory_order_relaxed);
   }
 
   std::string ToString() const {
@@ -496,8 +497,11 @@ class Block : public std::enable_shared_from_this<Block> {
       session_pool_->Release(session_);
       session_.reset();
     }
-    if (next_) {
-      next_->Launch(session_pool_, allow_local_calls_in_curr_thread);
+    allow_local_calls_in_curr_thread = allow_local_calls_in_curr_thread && next_.size() == 1;
+    for (const auto& next : next_) {
+      if (next->predecessors_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        next->Launch(session_pool_, allow_local_calls_in_curr_thread);
+      }
     }
     context_.reset();
   }
@@ -544,53 +548,41 @@ class Block : public std::enable_shared_from_this<Block> {
   MonoTime start_;
   SessionPool* session_pool_;
   std::shared_ptr<client::YBSession> session_;
-  BlockPtr next_;
+  // Blocks of the next stage, see TabletOperations.
+  boost::container::small_vector<BlockPtr, 2> next_;
+  // Number of blocks of the previous stage that were not processed yet.
+  std::atomic<size_t> predecessors_{0};
   int num_retries_ = 1;
 };
 
 typedef std::array<rpc::RpcMethodMetrics, kOperationTypeMapSize> InternalMetrics;
 
-struct BlockData {
-  explicit BlockData(Arena* arena) : used_keys(UsedKeys::allocator_type(arena)) {}
-
-  std::string ToString() const {
-    return Format("{ used_keys: $0 block: $1 count: $2 }", used_keys, block, count);
-  }
-
-  typedef MCUnorderedSet<Slice, Slice::Hash> UsedKeys;
-  UsedKeys used_keys;
-  BlockPtr block;
-  size_t count = 0;
-};
-
+// Plans execution of operations of a single tablet.
+// Operations are split into stages, executed one after another. Each stage contains at most one
+// read block and one write block, that are sent to the tablet concurrently. Every operation is
+// placed to the earliest stage that preserves its order relative to previous operations with the
+// same key: it could share the stage with operations of the same type, but should go after the
+// stage of the last operation of the opposite type. So independent keys are reordered and all
+// reads (writes) that do not depend on a preceding write (read) are sent in a single RPC, instead
+// of starting a new batch on each switch between reads and writes.
+// Local operations are barriers, they form a separate stage after all previous operations.
 class TabletOperations {
  public:
   explicit TabletOperations(Arena* arena)
-      : read_data_(arena), write_data_(arena) {
-  }
-
-  BlockData& data(OperationType type) {
-    switch (type) {
-      case OperationType::kRead:
-        return read_data_;
-      case OperationType::kWrite:
-        return write_data_;
-      case OperationType::kNone: FALLTHROUGH_INTENDED;
-      case OperationType::kLocal:
-        FATAL_INVALID_ENUM_VALUE(OperationType, type);
-    }
-    FATAL_INVALID_ENUM_VALUE(OperationType, type);
+      : stages_(Stages::allocator_type(arena)), key_stages_(KeyStages::allocator_type(arena)) {
   }
 
   void Done(SessionPool* session_pool, bool allow_local_calls_in_curr_thread) {
-    if (flush_head_) {
-      flush_head_->Launch(session_pool, allow_local_calls_in_curr_thread);
-    } else {
-      if (read_data_.block) {
-        read_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
+    for (size_t i = 1; i < stages_.size(); ++i) {
+      for (const auto* prev : stages_[i - 1].blocks()) {
+        for (const auto* next : stages_[i].blocks()) {
+          (**prev).AddNext(*next);
+        }
       }
-      if (write_data_.block) {
-        write_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
+    }
+    if (!stages_.empty()) {
+      for (const auto* block : stages_.front().blocks()) {
+        (**block).Launch(session_pool, allow_local_calls_in_curr_thread);
       }
     }
   }
@@ -600,149 +592,113 @@ class TabletOperations {
                Operation* operation,
                const InternalMetrics& metrics_internal) {
     auto type = operation->type();
+    size_t stage;
     if (type == OperationType::kLocal) {
-      ProcessLocalOperation(context, arena, operation, metrics_internal);
-      return;
-    }
-    boost::container::small_vector<Slice, RedisClientCommand::static_capacity> keys;
-    operation->GetKeys(&keys);
-    CheckConflicts(type, keys);
-    auto& data = this->data(type);
-    if (!data.block) {
-      ArenaAllocator<Block> alloc(arena);
-      data.block = std::allocate_shared<Block>(
-          alloc, context, alloc, metrics_internal[static_cast<size_t>(OperationType::kRead)]);
-      if (last_conflict_type_ == OperationType::kLocal) {
-        last_local_block_->SetNext(data.block);
-        last_conflict_type_ = type;
-      } else if (type == last_conflict_type_) {
-        auto old_value = this->data(Opposite(type)).block->SetNext(data.block);
-        if (old_value) {
-          LOG(DFATAL) << "Opposite already had next block: "
-                      << operation->call().serialized_request().ToDebugString();
+      stage = stages_.size();
+      min_stage_ = stage + 1;
+    } else {
+      boost::container::small_vector<Slice, RedisClientCommand::static_capacity> keys;
+      operation->GetKeys(&keys);
+      stage = min_stage_;
+      for (const auto& key : keys) {
+        auto it = key_stages_.find(key);
+        if (it == key_stages_.end()) {
+          continue;
+        }
+        auto same = it->second.stage(type);
+        if (same != KeyStage::kNoStage) {
+          stage = std::max(stage, same);
         }
+        auto opposite = it->second.stage(Opposite(type));
+        if (opposite != KeyStage::kNoStage) {
+          stage = std::max(stage, opposite + 1);
+        }
+      }
+      for (const auto& key : keys) {
+        auto& key_stage = key_stages_[key].stage(type);
+        key_stage = key_stage == KeyStage::kNoStage ? stage : std::max(key_stage, stage);
       }
     }
-    data.block->AddOperation(operation);
-    RememberKeys(type, &keys);
-  }
-
-  std::string ToString() const {
-    return Format("{ read_data: $0 write_data: $1 flush_head: $2 last_local_block: $3 "
-                  "last_conflict_type: $4 }",
-                  read_data_, write_data_, flush_head_, last_local_block_, last_conflict_type_);
-  }
 
- private:
-  void ProcessLocalOperation(const BatchContextPtr& context,
-                             Arena* arena,
-                             Operation* operation,
-                             const InternalMetrics& metrics_internal) {
-    ArenaAllocator<Block> alloc(arena);
-    auto block = std::allocate_shared<Block>(
-        alloc, context, alloc, metrics_internal[static_cast<size_t>(OperationType::kLocal)]);
-    switch (last_conflict_type_) {
-      case OperationType::kNone:
-        if (read_data_.block) {
-          flush_head_ = read_data_.block;
-          if (write_data_.block) {
-            read_data_.block->SetNext(write_data_.block);
-            write_data_.block->SetNext(block);
-          } else {
-            read_data_.block->SetNext(block);
-          }
-        } else if (write_data_.block) {
-          flush_head_ = write_data_.block;
-          write_data_.block->SetNext(block);
-        } else {
-          flush_head_ = block;
-        }
-        break;
-      case OperationType::kRead:
-        read_data_.block->SetNext(block);
-        break;
-      case OperationType::kWrite:
-        write_data_.block->SetNext(block);
-        break;
-      case OperationType::kLocal:
-        last_local_block_->SetNext(block);
-        break;
+    if (stage >= stages_.size()) {
+      stages_.resize(stage + 1);
+    }
+    auto& block = stages_[stage].block(type);
+    if (!block) {
+      ArenaAllocator<Block> alloc(arena);
+      block = std::allocate_shared<Block>(
+          alloc, context, alloc, metrics_internal[static_cast<size_t>(type)]);
     }
-    read_data_.block = nullptr;
-    read_data_.used_keys.clear();
-    write_data_.block = nullptr;
-    write_data_.used_keys.clear();
-    last_local_block_ = block;
-    last_conflict_type_ = OperationType::kLocal;
     block->AddOperation(operation);
   }
 
-  void ConflictFound(OperationType type) {
-    auto& data = this->data(type);
-    auto& opposite_data = this->data(Opposite(type));
-
-    switch (last_conflict_type_) {
-      case OperationType::kNone:
-        flush_head_ = opposite_data.block;
-        opposite_data.block->SetNext(data.block);
-        break;
-      case OperationType::kWrite:
-      case OperationType::kRead:
-        data.block = nullptr;
-        data.used_keys.clear();
-        break;
-      case OperationType::kLocal:
-        last_local_block_->SetNext(data.block);
-        break;
-    }
-    last_conflict_type_ = type;
+  std::string ToString() const {
+    return Format("{ stages: $0 min_stage: $1 }", stages_, min_stage_);
   }
 
-  void CheckConflicts(OperationType type, const RedisKeyList& keys) {
-    if (last_conflict_type_ == type) {
-      return;
-    }
-    if (last_conflict_type_ == OperationType::kLocal) {
-      return;
-    }
-    auto& opposite = data(Opposite(type));
-    bool conflict = false;
-    for (const auto& key : keys) {
-      if (opposite.used_keys.count(key)) {
-        conflict = true;
-        break;
+ private:
+  struct Stage {
+    BlockPtr read;
+    BlockPtr write;
+    BlockPtr local;
+
+    BlockPtr& block(OperationType type) {
+      switch (type) {
+        case OperationType::kRead:
+          return read;
+        case OperationType::kWrite:
+          return write;
+        case OperationType::kLocal:
+          return local;
+        case OperationType::kNone:
+          FATAL_INVALID_ENUM_VALUE(OperationType, type);
       }
+      FATAL_INVALID_ENUM_VALUE(OperationType, type);
     }
-    if (conflict) {
-      ConflictFound(type);
+
+    boost::container::small_vector<const BlockPtr*, 2> blocks() const {
+      boost::container::small_vector<const BlockPtr*, 2> result;
+      for (const auto* block : {&read, &write, &local}) {
+        if (*block) {
+          result.push_back(block);
+        }
+      }
+      return result;
     }
-  }
 
-  void RememberKeys(OperationType type, RedisKeyList* keys) {
-    BlockData* dest;
-    switch (type) {
-      case OperationType::kRead:
-        dest = &read_data_;
-        break;
-      case OperationType::kWrite:
-        dest = &write_data_;
-        break;
-      case OperationType::kNone: FALLTHROUGH_INTENDED;
-      case OperationType::kLocal:
-        FATAL_INVALID_ENUM_VALUE(OperationType, type);
+    std::string ToString() const {
+      return Format("{ read: $0 write: $1 local: $2 }", read, write, local);
     }
-    for (auto& key : *keys) {
-      dest->used_keys.insert(std::move(key));
+  };
+
+  // Stages of the last read and the last write of a key.
+  struct KeyStage {
+    static constexpr size_t kNoStage = std::numeric_limits<size_t>::max();
+
+    size_t read = kNoStage;
+    size_t write = kNoStage;
+
+    size_t& stage(OperationType type) {
+      switch (type) {
+        case OperationType::kRead:
+          return read;
+        case OperationType::kWrite:
+          return write;
+        case OperationType::kNone: FALLTHROUGH_INTENDED;
+        case OperationType::kLocal:
+          FATAL_INVALID_ENUM_VALUE(OperationType, type);
+      }
+      FATAL_INVALID_ENUM_VALUE(OperationType, type);
     }
-  }
+  };
 
-  BlockData read_data_;
-  BlockData write_data_;
-  BlockPtr flush_head_;
-  BlockPtr last_local_block_;
+  typedef MCVector<Stage> Stages;
+  typedef MCUnorderedMap<Slice, KeyStage, Slice::Hash> KeyStages;
 
-  // Type of command that caused last conflict between reads and writes.
-  OperationType last_conflict_type_ = OperationType::kNone;
+  Stages stages_;
+  KeyStages key_stages_;
+  // Stage right after the last local operation, following operations cannot be placed before it.
+  size_t min_stage_ = 0;
 };
 
 YB_STRONGLY_TYPED_BOOL(IsMonitorMessage);
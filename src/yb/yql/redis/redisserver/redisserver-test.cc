@@ -12,9 +12,12 @@
 //
 
 #include <chrono>
+#include <cmath>
 #include <cstdio>
+#include <map>
 #include <memory>
 #include <random>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -51,6 +54,7 @@ DECLARE_uint64(redis_max_queued_bytes);
 DECLARE_int64(redis_rpc_block_size);
 DECLARE_bool(redis_safe_batch);
 DECLARE_bool(emulate_redis_responses);
+DECLARE_bool(redis_use_sorted_set_rank_index);
 DECLARE_bool(test_tserver_timeout);
 DECLARE_bool(enable_backpressure_mode_for_testing);
 DECLARE_bool(yedis_enable_flush);
@@ -1337,6 +1341,25 @@ TEST_F_EX(TestRedisService, SafeBatchPipeline, TestRedisServiceSafeBatch) {
   LOG(INFO) << yb::Format("Safe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+// Each key is written, read, overwritten and read again, so operations on the same key depend on
+// each other, while operations on different keys could be reordered.
+TEST_F_EX(TestRedisService, SafeBatchInterleavedPipeline, TestRedisServiceSafeBatch) {
+  std::string command, response;
+  for (size_t i = 0; i != kPipelineKeys; ++i) {
+    auto key = Format("interleaved_$0", i);
+    for (auto value : {ValueForKey(i), ValueForKey(i) + 1}) {
+      auto value_str = std::to_string(value);
+      command += Format("set $0 $1\r\nget $0\r\n", key, value_str);
+      response += Format("+OK\r\n$$$0\r\n$1\r\n", value_str.length(), value_str);
+    }
+  }
+  auto start = std::chrono::steady_clock::now();
+  SendCommandAndExpectResponse(__LINE__, command, response);
+  auto time = std::chrono::steady_clock::now() - start;
+  LOG(INFO) << Format("Interleaved pipeline: $0ms",
+                      std::chrono::duration_cast<std::chrono::milliseconds>(time).count());
+}
+
 TEST_F(TestRedisService, BatchedCommandMulti) {
   SendCommandAndExpectResponse(
       __LINE__,
@@ -2950,6 +2973,33 @@ TEST_F(TestRedisService, TestRenameSameTablet) {
   SyncClient();
 }
 
+TEST_F(TestRedisService, TestMultiKeySameSlot) {
+  DoRedisTestOk(__LINE__, {"SET", "{user}2", "old"});
+  SyncClient();
+
+  DoRedisTestOk(__LINE__, {"MSET", "{user}1", "v1", "{user}2", "v2", "{user}3", "v3"});
+  SyncClient();
+
+  DoRedisTestBulkString(__LINE__, {"GET", "{user}1"}, "v1");
+  DoRedisTestBulkString(__LINE__, {"GET", "{user}2"}, "v2");
+  DoRedisTestResultsArray(
+      __LINE__, {"MGET", "{user}3", "{user}missing", "{user}1"},
+      {RedisReply(RedisReplyType::kString, "v3"), RedisReply(),
+       RedisReply(RedisReplyType::kString, "v1")});
+  SyncClient();
+
+  // Keys without common tag belong to different slots.
+  DoRedisTestExpectError(__LINE__, {"MSET", "{user}1", "v4", "other", "v5"});
+  DoRedisTestExpectError(__LINE__, {"MGET", "{user}1", "other"});
+  DoRedisTestExpectError(__LINE__, {"MSET", "{user}1", "v4", "{user}2"});
+  SyncClient();
+
+  DoRedisTestBulkString(__LINE__, {"GET", "{user}1"}, "v1");
+  DoRedisTestNull(__LINE__, {"GET", "other"});
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestRenameSameTabletRandomized) {
   // Rename to a key in the same tablet
   // randomized 1/24 odds of being in the same tablet as k0.
@@ -3666,6 +3716,99 @@ TEST_F(TestRedisService, TestZRange) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestZRangeRankIndex) {
+  constexpr int kNumMembers = 500;
+  constexpr int kNumUpdates = 100;
+  constexpr int kNumRemovals = 150;
+
+  // Members ordered by score, then by member.
+  std::set<std::pair<double, string>> members;
+  std::map<string, double> scores;
+  auto score_for = [](int i) {
+    // Scores of different magnitude and sign, so members fall into many buckets of the index.
+    return (i * 37 % 201 - 100) * std::pow(4.0, i % 6) * 0.25;
+  };
+  auto add = [&](const string& member, double score) {
+    auto it = scores.find(member);
+    if (it != scores.end()) {
+      members.erase({it->second, member});
+    }
+    scores[member] = score;
+    members.emplace(score, member);
+    DoRedisTestIntRange(__LINE__, {"ZADD", "z_rank", std::to_string(score), member}, 0, 1);
+  };
+
+  for (int i = 0; i != kNumMembers; ++i) {
+    add(Format("m$0", i), score_for(i));
+  }
+  for (int i = 0; i != kNumUpdates; ++i) {
+    add(Format("m$0", i * 3), score_for(i + kNumMembers));
+  }
+  for (int i = 0; i != kNumRemovals; ++i) {
+    auto member = Format("m$0", i * 3 + 1);
+    members.erase({scores[member], member});
+    scores.erase(member);
+    DoRedisTestInt(__LINE__, {"ZREM", "z_rank", member}, 1);
+  }
+  SyncClient();
+
+  const int card = members.size();
+  DoRedisTestInt(__LINE__, {"ZCARD", "z_rank"}, card);
+
+  vector<string> ordered;
+  for (const auto& entry : members) {
+    ordered.push_back(entry.second);
+  }
+  vector<string> reversed(ordered.rbegin(), ordered.rend());
+
+  for (bool use_index : {true, false}) {
+    FLAGS_redis_use_sorted_set_rank_index = use_index;
+    for (int start = 0; start < card; start += 23) {
+      for (int length : {1, 7, 60}) {
+        const int end = std::min(start + length, card);
+        DoRedisTestArray(
+            __LINE__,
+            {"ZRANGE", "z_rank", std::to_string(start), std::to_string(end - 1)},
+            vector<string>(ordered.begin() + start, ordered.begin() + end));
+        DoRedisTestArray(
+            __LINE__,
+            {"ZREVRANGE", "z_rank", std::to_string(start), std::to_string(end - 1)},
+            vector<string>(reversed.begin() + start, reversed.begin() + end));
+      }
+    }
+    DoRedisTestArray(__LINE__, {"ZRANGE", "z_rank", "-3", "-1"},
+                     vector<string>(ordered.end() - 3, ordered.end()));
+    SyncClient();
+  }
+  FLAGS_redis_use_sorted_set_rank_index = true;
+
+  // Each member in its own bucket, so every range except the first one starts in a later bucket.
+  constexpr int kNumBucketMembers = 12;
+  vector<string> bucket_members;
+  for (int i = 0; i != kNumBucketMembers; ++i) {
+    bucket_members.push_back(Format("b$0", i));
+    DoRedisTestInt(
+        __LINE__, {"ZADD", "z_buckets", std::to_string(std::pow(16.0, i)), bucket_members.back()},
+        1);
+  }
+  SyncClient();
+  vector<string> bucket_members_reversed(bucket_members.rbegin(), bucket_members.rend());
+  for (int start = 0; start != kNumBucketMembers; ++start) {
+    for (int end = start; end != std::min(start + 3, kNumBucketMembers); ++end) {
+      DoRedisTestArray(
+          __LINE__, {"ZRANGE", "z_buckets", std::to_string(start), std::to_string(end)},
+          vector<string>(bucket_members.begin() + start, bucket_members.begin() + end + 1));
+      DoRedisTestArray(
+          __LINE__, {"ZREVRANGE", "z_buckets", std::to_string(start), std::to_string(end)},
+          vector<string>(bucket_members_reversed.begin() + start,
+                         bucket_members_reversed.begin() + end + 1));
+    }
+  }
+  SyncClient();
+
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestZScore) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;